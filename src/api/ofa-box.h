@@ -41,6 +41,7 @@ G_BEGIN_DECLS
 typedef gint64                          ofxCounter;
 typedef gdouble                         ofxAmount;
 typedef struct _ofsBoxData              ofsBoxData;
+typedef struct _ofaBoxArena             ofaBoxArena;
 
 typedef enum {
 	OFA_TYPE_AMOUNT = 1,
@@ -71,6 +72,12 @@ typedef enum {
  * @csv_zero_as_empty: whether a zero counter or amount should be
  *  exported as an empty string (NULL strings and timestamps are
  *  always exported as empty strings)
+ * @interned: whether a string value should be interned, i.e. shared
+ *  with all other interned equal values; this is meant for the
+ *  low-cardinality identifiers (account numbers, ledger mnemonics,
+ *  user names, ...) which are repeated through large datasets;
+ *  two interned values of the same pool are equal if and only if they
+ *  share the same address
  *
  * This structure is to be defined by each #ofoBase derived object
  * which would wish banalize its dataset. Each elementary data is
@@ -83,6 +90,7 @@ typedef struct {
 	ofeBoxType   type;
 	gboolean     import;
 	gboolean     csv_zero_as_empty;
+	gboolean     interned;
 }
 	ofsBoxDef;
 
@@ -123,6 +131,8 @@ gchar           *ofa_box_dbms_get_columns_list( const ofsBoxDef *defs );
 
 GList           *ofa_box_dbms_parse_result    ( const ofsBoxDef *defs, GSList *row );
 
+GList           *ofa_box_dbms_parse_result_ex ( const ofsBoxDef *defs, GSList *row, ofaBoxArena *arena );
+
 gchar           *ofa_box_csv_get_header       ( const ofsBoxDef *defs,
 													ofaStreamFormat *format );
 
@@ -165,6 +175,12 @@ void             ofa_box_set_value            ( const GList *fields_list, gint i
 
 void             ofa_box_free_fields_list     ( GList *fields_list );
 
+ofaBoxArena     *ofa_box_arena_new            ( void );
+
+ofaBoxArena     *ofa_box_arena_ref            ( ofaBoxArena *arena );
+
+void             ofa_box_arena_unref          ( ofaBoxArena *arena );
+
 const ofsBoxDef *ofa_box_data_get_def         ( const ofsBoxData *box );
 
 gconstpointer    ofa_box_data_get_value       ( const ofsBoxData *box );
@@ -44,6 +44,8 @@
  * The #ofaHub object is available through the #ofaIGetter interface.
  */
 
+#include "my/my-iprogress.h"
+
 #include "api/ofa-hub-def.h"
 #include "api/ofa-idbconnect-def.h"
 #include "api/ofa-idbexercice-meta-def.h"
@@ -123,6 +125,9 @@ gboolean       ofa_hub_is_writable_dossier  ( ofaHub *hub );
 
 void           ofa_hub_close_dossier        ( ofaHub *hub );
 
+void           ofa_hub_preload_collections  ( ofaHub *hub,
+													myIProgress *progress );
+
 ofaIImporter  *ofa_hub_get_willing_to_import( ofaHub *hub,
 													const gchar *uri,
 													GType type );
@@ -40,6 +40,8 @@
 
 #include <gtk/gtk.h>
 
+#include "my/my-stamp.h"
+
 #include "ofa-hub-def.h"
 #include "ofa-idbconnect-def.h"
 #include "ofa-idbdossier-meta-def.h"
@@ -60,6 +62,67 @@ typedef struct _ofaIDBConnect                    ofaIDBConnect;
 typedef struct _ofaIDBConnectInterface           ofaIDBConnectInterface;
 #endif
 
+/**
+ * ofeIDBParamType:
+ *
+ * The type of a parameter bound to a prepared statement.
+ */
+typedef enum {
+	OFA_IDBPARAM_NULL = 0,
+	OFA_IDBPARAM_STRING,
+	OFA_IDBPARAM_INTEGER,
+	OFA_IDBPARAM_AMOUNT,
+	OFA_IDBPARAM_DATE,
+	OFA_IDBPARAM_STAMP
+}
+	ofeIDBParamType;
+
+/**
+ * ofsIDBParam:
+ * @type: the #ofeIDBParamType type of the parameter.
+ * @string: the string value, when @type is OFA_IDBPARAM_STRING.
+ * @integer: the integer value, when @type is OFA_IDBPARAM_INTEGER.
+ * @amount: the amount value, when @type is OFA_IDBPARAM_AMOUNT.
+ * @digits: the count of decimal digits of the amount.
+ * @date: the date value, when @type is OFA_IDBPARAM_DATE.
+ * @stamp: the local timestamp value, when @type is OFA_IDBPARAM_STAMP.
+ *
+ * A parameter bound to a prepared statement, as passed to the DBMS
+ * provider. Only the field which corresponds to @type is meaningful.
+ */
+typedef struct {
+	ofeIDBParamType type;
+	gchar          *string;
+	gint64          integer;
+	gdouble         amount;
+	guint           digits;
+	GDate           date;
+	GDateTime      *stamp;
+}
+	ofsIDBParam;
+
+typedef struct _ofsIDBStatement                  ofsIDBStatement;
+
+/**
+ * ofeIDBAuditMode:
+ * @OFA_IDBAUDIT_SYNC: each audit record is written synchronously, on
+ *  the same connection, just after the audited query.
+ * @OFA_IDBAUDIT_COMMIT: audit records are queued and written by a
+ *  background thread on a dedicated connection; a transaction commit
+ *  waits for the queued records to be written (default).
+ * @OFA_IDBAUDIT_ASYNC: audit records are queued and written by a
+ *  background thread on a dedicated connection; a transaction commit
+ *  only requests the queue to be flushed.
+ *
+ * How the audit trail is written to the OFA_T_AUDIT table.
+ */
+typedef enum {
+	OFA_IDBAUDIT_SYNC = 1,
+	OFA_IDBAUDIT_COMMIT,
+	OFA_IDBAUDIT_ASYNC
+}
+	ofeIDBAuditMode;
+
 /**
  * ofaIDBConnectInterface:
  * @get_interface_version: [should]: returns the implemented version number.
@@ -78,6 +141,7 @@ typedef struct _ofaIDBConnectInterface           ofaIDBConnectInterface;
  * @transaction_start: [should]: start a transaction.
  * @transaction_cancel: [should]: cancel a transaction.
  * @transaction_commit: [should]: commit a transaction.
+ * @execute: [may]: executes a prepared statement.
  *
  * This defines the interface that an #ofaIDBConnect should implement.
  */
@@ -374,6 +438,62 @@ struct _ofaIDBConnectInterface {
 	 * Since: version 1
 	 */
 	gboolean    ( *transaction_commit )   ( const ofaIDBConnect *instance );
+
+	/**
+	 * execute:
+	 * @instance: an #ofaIDBConnect user connection on the DBMS server.
+	 * @query: the SQL statement, with '?' placeholders.
+	 * @params: the array of the bound parameters.
+	 * @count: the count of items in @params.
+	 * @result: [allow-none]: a GSList * which will hold the result set,
+	 *  with the same layout than those of #query_ex() method;
+	 *  %NULL for a modification statement.
+	 *
+	 * Execute a prepared statement on the DBMS.
+	 *
+	 * The implementation is expected to keep the prepared statement
+	 * for the @query text as long as the connection is opened, so that
+	 * subsequent executions do not have to re-parse it.
+	 *
+	 * If this method is not provided, the #ofaIDBConnect interface
+	 * falls back to #query() or #query_ex() after having substituted
+	 * the parameters in the @query.
+	 *
+	 * Returns: %TRUE if the statement successfully executed,
+	 * %FALSE else.
+	 *
+	 * Since: version 2
+	 */
+	gboolean    ( *execute )              ( const ofaIDBConnect *instance,
+												const gchar *query,
+												const ofsIDBParam *params,
+												guint count,
+												GSList **result );
+
+	/**
+	 * thread_init:
+	 * @instance: an #ofaIDBConnect user connection on the DBMS server.
+	 *
+	 * Initialize the DBMS client library for the calling thread.
+	 *
+	 * This is called at the start of each thread, other than the main
+	 * one, before it uses a connection.
+	 *
+	 * Since: version 2
+	 */
+	void        ( *thread_init )          ( const ofaIDBConnect *instance );
+
+	/**
+	 * thread_end:
+	 * @instance: an #ofaIDBConnect user connection on the DBMS server.
+	 *
+	 * Release the per-thread resources of the DBMS client library.
+	 *
+	 * This is called just before the thread exits.
+	 *
+	 * Since: version 2
+	 */
+	void        ( *thread_end )           ( const ofaIDBConnect *instance );
 };
 
 /*
@@ -418,6 +538,8 @@ gboolean            ofa_idbconnect_open_with_superuser      ( ofaIDBConnect *con
 
 gboolean            ofa_idbconnect_is_opened                ( const ofaIDBConnect *connect );
 
+ofaIDBConnect      *ofa_idbconnect_duplicate                ( const ofaIDBConnect *connect );
+
 GtkWidget          *ofa_idbconnect_get_display              ( ofaIDBConnect *connect,
 																	const gchar *style );
 
@@ -430,6 +552,17 @@ gboolean            ofa_idbconnect_query_ex                 ( const ofaIDBConnec
 																	GSList **result,
 																	gboolean display_error );
 
+void                ofa_idbconnect_query_async              ( const ofaIDBConnect *connect,
+																	const gchar *query,
+																	GCancellable *cancellable,
+																	GAsyncReadyCallback callback,
+																	gpointer user_data );
+
+gboolean            ofa_idbconnect_query_finish             ( const ofaIDBConnect *connect,
+																	GAsyncResult *result,
+																	GSList **rows,
+																	GError **error );
+
 gboolean            ofa_idbconnect_query_int                ( const ofaIDBConnect *connect,
 																	const gchar *query,
 																	gint *result,
@@ -445,12 +578,63 @@ gboolean            ofa_idbconnect_table_restore            ( const ofaIDBConnec
 																	const gchar *table_src,
 																	const gchar *table_dest );
 
+ofsIDBStatement    *ofa_idbconnect_prepare                  ( const ofaIDBConnect *connect,
+																	const gchar *query );
+
+void                ofa_idbconnect_bind_null                ( ofsIDBStatement *stmt,
+																	guint pos );
+
+void                ofa_idbconnect_bind_string              ( ofsIDBStatement *stmt,
+																	guint pos,
+																	const gchar *value );
+
+void                ofa_idbconnect_bind_int                 ( ofsIDBStatement *stmt,
+																	guint pos,
+																	gint64 value );
+
+void                ofa_idbconnect_bind_amount              ( ofsIDBStatement *stmt,
+																	guint pos,
+																	gdouble value,
+																	guint digits );
+
+void                ofa_idbconnect_bind_date                ( ofsIDBStatement *stmt,
+																	guint pos,
+																	const GDate *value );
+
+void                ofa_idbconnect_bind_stamp               ( ofsIDBStatement *stmt,
+																	guint pos,
+																	const myStampVal *value );
+
+gboolean            ofa_idbconnect_execute                  ( const ofaIDBConnect *connect,
+																	ofsIDBStatement *stmt,
+																	gboolean display_error );
+
+gboolean            ofa_idbconnect_execute_ex               ( const ofaIDBConnect *connect,
+																	ofsIDBStatement *stmt,
+																	GSList **result,
+																	gboolean display_error );
+
 #define             ofa_idbconnect_free_results( L )        g_debug( "ofa_idbconnect_free_results" ); \
 																	g_slist_foreach(( L ),( GFunc ) g_slist_free_full, g_free ); \
 																	g_slist_free( L )
 
 gchar              *ofa_idbconnect_get_last_error           ( const ofaIDBConnect *connect );
 
+void                ofa_idbconnect_thread_init              ( const ofaIDBConnect *connect );
+
+void                ofa_idbconnect_thread_end               ( const ofaIDBConnect *connect );
+
+ofeIDBAuditMode     ofa_idbconnect_get_audit_mode           ( const ofaIDBConnect *connect );
+
+void                ofa_idbconnect_set_audit_mode           ( const ofaIDBConnect *connect,
+																	ofeIDBAuditMode mode );
+
+gboolean            ofa_idbconnect_audit_flush              ( const ofaIDBConnect *connect,
+																	gchar **msgerr );
+
+gboolean            ofa_idbconnect_audit_close              ( const ofaIDBConnect *connect,
+																	gchar **msgerr );
+
 gboolean            ofa_idbconnect_backup_db                ( const ofaIDBConnect *connect,
 																	const gchar *comment,
 																	const gchar *uri,
@@ -489,6 +673,8 @@ gboolean            ofa_idbconnect_transaction_commit       ( const ofaIDBConnec
 																	gboolean display_error,
 																	gchar **msgerr );
 
+gboolean            ofa_idbconnect_transaction_is_started   ( const ofaIDBConnect *connect );
+
 G_END_DECLS
 
 #endif /* __OPENBOOK_API_OFA_IDBCONNECT_H__ */
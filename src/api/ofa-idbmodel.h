@@ -68,6 +68,7 @@
 #include "my/my-iwindow.h"
 
 #include "api/ofa-idbconnect-def.h"
+#include "api/ofa-idbexercice-meta-def.h"
 #include "api/ofa-igetter-def.h"
 #include "api/ofo-base-def.h"
 
@@ -90,6 +91,7 @@ typedef struct _ofaIDBModel                    ofaIDBModel;
  * @needs_update: [should]: returns whether the DB model needs an update.
  * @ddl_update: [should]: returns whether the DB model has been successfully updated.
  * @check_dbms_integrity: [should]: check for DBMS integrity.
+ * @get_version_table: [may]: return the name of the versions table.
  *
  * This defines the interface that an #ofaIDBModel may/should implement.
  */
@@ -188,6 +190,21 @@ typedef struct {
 	gulong        ( *check_dbms_integrity ) ( const ofaIDBModel *instance,
 													ofaIGetter *getter,
 													myIProgress *progress );
+
+	/**
+	 * get_version_table:
+	 * @instance: the #ofaIDBModel provider.
+	 *
+	 * Returns: the name of the table which records the successive
+	 * versions of the DB model, as a VER_NUMBER, VER_DATE pair.
+	 *
+	 * When implemented, the current version of the DB model is read
+	 * from this table in the same query than other DB models, instead
+	 * of calling get_current_version() method.
+	 *
+	 * Since: version 2
+	 */
+	const gchar * ( *get_version_table )    ( const ofaIDBModel *instance );
 }
 	ofaIDBModelInterface;
 
@@ -224,6 +241,8 @@ guint        ofa_idbmodel_get_last_version          ( const ofaIDBModel *instanc
 
 gchar       *ofa_idbmodel_get_canon_name            ( const ofaIDBModel *instance );
 
+void         ofa_idbmodel_reset_cache               ( const ofaIDBExerciceMeta *exercice_meta );
+
 gchar       *ofa_idbmodel_get_version               ( const ofaIDBModel *instance,
 															ofaIDBConnect *connect );
 
@@ -147,6 +147,20 @@ ofaIGetter *ofa_isignaler_get_getter                ( ofaISignaler *signaler );
 void        ofa_isignaler_disconnect_handlers       ( ofaISignaler *signaler,
 															GList **handlers );
 
+gulong      ofa_isignaler_connect_deferrable        ( ofaISignaler *signaler,
+															const gchar *signal,
+															GCallback callback,
+															void *user_data );
+
+gulong      ofa_isignaler_connect_reload            ( ofaISignaler *signaler,
+															GType type,
+															GCallback callback,
+															void *user_data );
+
+void        ofa_isignaler_begin_batch               ( ofaISignaler *signaler );
+
+void        ofa_isignaler_end_batch                 ( ofaISignaler *signaler );
+
 G_END_DECLS
 
 #endif /* __OPENBOOK_API_OFA_ISIGNALER_H__ */
@@ -40,6 +40,7 @@
 
 #include "my/my-date.h"
 
+#include "api/ofa-idbconnect.h"
 #include "api/ofa-igetter-def.h"
 #include "api/ofa-prefs-def.h"
 
@@ -160,6 +161,10 @@ void               ofa_prefs_assistant_set_user_settings         ( ofaIGetter *g
 																		gboolean confirm_on_escape,
 																		gboolean confirm_on_cancel );
 
+ofeIDBAuditMode    ofa_prefs_audit_get_mode                      ( ofaIGetter *getter );
+void               ofa_prefs_audit_set_user_settings             ( ofaIGetter *getter,
+																		ofeIDBAuditMode mode );
+
 gboolean           ofa_prefs_check_integrity_get_display_all     ( ofaIGetter *getter );
 void               ofa_prefs_check_integrity_set_user_settings   ( ofaIGetter *getter,
 																		gboolean display );
@@ -121,6 +121,35 @@ typedef struct {
 	 */
 	GList *            ( *get_dataset )         ( ofaRenderPage *page );
 
+	/**
+	 * get_dataset_async:
+	 * @page: this #ofaRenderPage instance.
+	 * @cancellable: a #GCancellable object.
+	 * @callback: the #GAsyncReadyCallback to be called.
+	 * @user_data: user data to be passed to @callback.
+	 *
+	 * Asynchronously loads the dataset for the current arguments.
+	 *
+	 * When this method is implemented, it is preferred to get_dataset(),
+	 * and get_dataset_finish() must also be implemented.
+	 */
+	void               ( *get_dataset_async )   ( ofaRenderPage *page,
+														GCancellable *cancellable,
+														GAsyncReadyCallback callback,
+														gpointer user_data );
+
+	/**
+	 * get_dataset_finish:
+	 * @page: this #ofaRenderPage instance.
+	 * @result: the #GAsyncResult passed to the callback.
+	 * @error: a placeholder for a #GError.
+	 *
+	 * Returns the dataset asynchronously loaded by get_dataset_async().
+	 */
+	GList *            ( *get_dataset_finish )  ( ofaRenderPage *page,
+														GAsyncResult *result,
+														GError **error );
+
 	/**
 	 * free_dataset:
 	 * @page: this #ofaRenderPage instance.
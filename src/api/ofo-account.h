@@ -94,6 +94,7 @@ ofoAccount       *ofo_account_new                       ( ofaIGetter *getter );
 
 gint              ofo_account_get_class                 ( const ofoAccount *account );
 const gchar      *ofo_account_get_number                ( const ofoAccount *account );
+const gchar      *ofo_account_get_number_key            ( const ofoAccount *account );
 const gchar      *ofo_account_get_cre_user              ( const ofoAccount *account );
 const myStampVal *ofo_account_get_cre_stamp             ( const ofoAccount *account );
 const gchar      *ofo_account_get_label                 ( const ofoAccount *account );
@@ -110,20 +110,46 @@ typedef struct {
  */
 #define OFO_BASE_UNSET_ID               -1
 
-GType       ofo_base_get_type        ( void ) G_GNUC_CONST;
+GType       ofo_base_get_type            ( void ) G_GNUC_CONST;
 
-GList      *ofo_base_init_fields_list( const ofsBoxDef *defs );
+GList      *ofo_base_init_fields_list    ( const ofsBoxDef *defs );
 
-GList      *ofo_base_load_dataset    ( const ofsBoxDef *defs,
+GList      *ofo_base_load_dataset        ( const ofsBoxDef *defs,
 											const gchar *from,
 											GType type,
 											ofaIGetter *getter );
 
-GList      *ofo_base_load_rows       ( const ofsBoxDef *defs,
+void        ofo_base_load_dataset_async  ( const ofsBoxDef *defs,
+											const gchar *from,
+											GType type,
+											ofaIGetter *getter,
+											GCancellable *cancellable,
+											GAsyncReadyCallback callback,
+											gpointer user_data );
+
+GList      *ofo_base_load_dataset_finish ( GAsyncResult *result,
+											GError **error );
+
+GList      *ofo_base_load_dataset_in_arena
+                                         ( const ofsBoxDef *defs,
+											const gchar *from,
+											GType type,
+											ofaIGetter *getter );
+
+void        ofo_base_load_dataset_in_arena_async
+                                         ( const ofsBoxDef *defs,
+											const gchar *from,
+											GType type,
+											ofaIGetter *getter,
+											GCancellable *cancellable,
+											GAsyncReadyCallback callback,
+											gpointer user_data );
+
+GList      *ofo_base_load_rows           ( const ofsBoxDef *defs,
 											const ofaIDBConnect *connect,
 											const gchar *from );
 
-ofaIGetter *ofo_base_get_getter      ( ofoBase *base );
+ofaIGetter *ofo_base_get_getter          ( ofoBase *base );
 
 G_END_DECLS
 
@@ -92,12 +92,15 @@ ofxCounter   ofo_counters_get_next_doc_id       ( ofaIGetter *getter );
 
 ofxCounter   ofo_counters_get_last_entry_id     ( ofaIGetter *getter );
 ofxCounter   ofo_counters_get_next_entry_id     ( ofaIGetter *getter );
+ofxCounter   ofo_counters_reserve_entry_ids     ( ofaIGetter *getter, guint count );
 
 ofxCounter   ofo_counters_get_last_ope_id       ( ofaIGetter *getter );
 ofxCounter   ofo_counters_get_next_ope_id       ( ofaIGetter *getter );
+ofxCounter   ofo_counters_reserve_ope_ids       ( ofaIGetter *getter, guint count );
 
 ofxCounter   ofo_counters_get_last_settlement_id( ofaIGetter *getter );
 ofxCounter   ofo_counters_get_next_settlement_id( ofaIGetter *getter );
+ofxCounter   ofo_counters_reserve_settlement_ids( ofaIGetter *getter, guint count );
 
 ofxCounter   ofo_counters_get_last_tiers_id     ( ofaIGetter *getter );
 ofxCounter   ofo_counters_get_next_tiers_id     ( ofaIGetter *getter );
@@ -34,6 +34,7 @@
  */
 
 #include "api/ofa-box.h"
+#include "api/ofa-idbconnect-def.h"
 #include "api/ofa-igetter-def.h"
 #include "api/ofo-base-def.h"
 #include "api/ofo-concil-def.h"
@@ -141,11 +142,31 @@ GList            *ofo_entry_get_dataset_for_print_by_account
 															const gchar *from_account, const gchar *to_account,
 															const GDate *from_date, const GDate *to_date );
 
+void              ofo_entry_get_dataset_for_print_by_account_async
+                                                       ( ofaIGetter *getter,
+															const gchar *from_account, const gchar *to_account,
+															const GDate *from_date, const GDate *to_date,
+															GCancellable *cancellable,
+															GAsyncReadyCallback callback,
+															gpointer user_data );
+
 GList            *ofo_entry_get_dataset_for_print_by_ledger
                                                        ( ofaIGetter *getter,
 															const GSList *mnemos,
 															const GDate *from_date, const GDate *to_date );
 
+void              ofo_entry_get_dataset_for_print_by_ledger_async
+                                                       ( ofaIGetter *getter,
+															const GSList *mnemos,
+															const GDate *from_date, const GDate *to_date,
+															GCancellable *cancellable,
+															GAsyncReadyCallback callback,
+															gpointer user_data );
+
+GList            *ofo_entry_get_dataset_for_print_finish
+                                                       ( GAsyncResult *result,
+															GError **error );
+
 GList            *ofo_entry_get_dataset_for_print_reconcil
                                                        ( ofaIGetter *getter,
                                                     		 const gchar *account, const GDate *date );
@@ -154,6 +175,8 @@ GList            *ofo_entry_get_dataset_for_exercice_by_status
                                                        ( ofaIGetter *getter, ofeEntryStatus status );
 
 GList            *ofo_entry_get_dataset                ( ofaIGetter *getter );
+void              ofo_entry_get_dataset_async          ( ofaIGetter *getter, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data );
+GList            *ofo_entry_get_dataset_finish         ( GAsyncResult *result, GError **error );
 ofxCounter        ofo_entry_get_count                  ( ofaIGetter *getter );
 ofoEntry         *ofo_entry_get_by_number              ( ofaIGetter *getter, ofxCounter number );
 GList            *ofo_entry_get_by_ope_numbers         ( ofaIGetter *getter, GList *ope_numbers );
@@ -249,6 +272,12 @@ GList            *ofo_entry_doc_get_orphans            ( ofaIGetter *getter );
 #define           ofo_entry_doc_free_orphans( L )      ( g_list_free( L ))
 
 gboolean          ofo_entry_insert                     ( ofoEntry *entry );
+gboolean          ofo_entry_insert_list                ( ofaIGetter *getter, GList *entries );
+void              ofo_entry_insert_list_notify         ( ofaIGetter *getter, GList *entries );
+
+gboolean          ofo_entry_future_to_current          ( ofaIGetter *getter );
+
+gboolean          ofo_entry_ledger_months_remove       ( const ofaIDBConnect *connect, const gchar *where );
 
 gboolean          ofo_entry_update                     ( ofoEntry *entry );
 gboolean          ofo_entry_update_settlement          ( ofoEntry *entry, ofxCounter number );
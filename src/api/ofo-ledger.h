@@ -79,6 +79,7 @@ ofoLedger        *ofo_ledger_get_by_mnemo               ( ofaIGetter *getter, co
 ofoLedger        *ofo_ledger_new                        ( ofaIGetter *getter );
 
 const gchar      *ofo_ledger_get_mnemo                  ( const ofoLedger *ledger );
+const gchar      *ofo_ledger_get_mnemo_key              ( const ofoLedger *ledger );
 const gchar      *ofo_ledger_get_cre_user               ( const ofoLedger *ledger );
 const myStampVal *ofo_ledger_get_cre_stamp              ( const ofoLedger *ledger );
 const gchar      *ofo_ledger_get_label                  ( const ofoLedger *ledger );
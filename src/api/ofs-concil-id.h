@@ -41,8 +41,8 @@ G_BEGIN_DECLS
  * ofsConcilId:
  */
 typedef struct {
-	gchar     *type;
-	ofxCounter other_id;
+	const gchar *type;					/* interned */
+	ofxCounter   other_id;
 }
 	ofsConcilId;
 
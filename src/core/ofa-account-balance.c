@@ -323,13 +323,13 @@ compute_accounts_balance( ofaAccountBalance *self )
 	ofeEntryStatus status;
 	ofeEntryPeriod period;
 	ofeEntryRule rule;
-	const gchar *acc_number;
-	gchar *prev_number;
+	const gchar *acc_number, *prev_number;
+	gchar *from_key, *to_key, *acc_key;
 	ofsAccountBalancePeriod *sabp;
 	ofoAccount *account;
 	gint cmp;
 	ofxAmount debit, credit;
-	gboolean is_begin, is_end;
+	gboolean is_begin, is_end, in_range;
 
 	priv = ofa_account_balance_get_instance_private( self );
 
@@ -350,15 +350,27 @@ compute_accounts_balance( ofaAccountBalance *self )
 	prev_number = NULL;
 	priv->accounts = NULL;
 	sabp = NULL;
+	in_range = FALSE;
+
+	/* the range bounds are compared as collation keys, and the key of
+	 * the entry account only needs to be computed once per account as
+	 * the entries are sorted;
+	 * entry accounts are interned strings, so that two entries share
+	 * the same account if and only if they share the same pointer */
+	from_key = my_strlen( priv->account_from ) ? my_collate_key( priv->account_from ) : NULL;
+	to_key = my_strlen( priv->account_to ) ? my_collate_key( priv->account_to ) : NULL;
 
 	for( it=sorted ; it ; it=it->next ){
 		entry = ( ofoEntry * ) it->data;
 		g_return_if_fail( entry && OFO_IS_ENTRY( entry ));
 		acc_number = ofo_entry_get_account( entry );
-		if( my_strlen( priv->account_from ) && my_collate( priv->account_from, acc_number ) > 0 ){
-			continue;
+		if( it == sorted || acc_number != ofo_entry_get_account( OFO_ENTRY( it->prev->data ))){
+			acc_key = my_collate_key( acc_number );
+			in_range = ( !from_key || g_strcmp0( from_key, acc_key ) <= 0 ) &&
+						( !to_key || g_strcmp0( to_key, acc_key ) >= 0 );
+			g_free( acc_key );
 		}
-		if( my_strlen( priv->account_to ) && my_collate( priv->account_to, acc_number ) < 0 ){
+		if( !in_range ){
 			continue;
 		}
 		status = ofo_entry_get_status( entry );
@@ -370,9 +382,8 @@ compute_accounts_balance( ofaAccountBalance *self )
 			continue;
 		}
 		/* on new account, initialize a new structure */
-		if( my_collate( acc_number, prev_number ) != 0 ){
-			g_free( prev_number );
-			prev_number = g_strdup( acc_number );
+		if( acc_number != prev_number ){
+			prev_number = acc_number;
 			account = ofo_account_get_by_number( priv->getter, acc_number );
 			g_return_if_fail( account && OFO_IS_ACCOUNT( account ) && !ofo_account_is_root( account ));
 			sabp = find_account( self, account );
@@ -422,7 +433,8 @@ compute_accounts_balance( ofaAccountBalance *self )
 		sabp->end_solde += credit - debit;
 	}
 
-	g_free( prev_number );
+	g_free( to_key );
+	g_free( from_key );
 	g_list_free( entries );
 }
 
@@ -459,10 +471,14 @@ complete_accounts_dataset( ofaAccountBalance *self )
 	ofaAccountBalancePrivate *priv;
 	GList *dataset, *it;
 	ofoAccount *account;
-	const gchar *acc_number;
+	const gchar *acc_key;
+	gchar *from_key, *to_key;
 
 	priv = ofa_account_balance_get_instance_private( self );
 
+	from_key = my_strlen( priv->account_from ) ? my_collate_key( priv->account_from ) : NULL;
+	to_key = my_strlen( priv->account_to ) ? my_collate_key( priv->account_to ) : NULL;
+
 	/* get only the detail accounts */
 	dataset = ofo_account_get_dataset( priv->getter );
 
@@ -470,11 +486,11 @@ complete_accounts_dataset( ofaAccountBalance *self )
 		account = ( ofoAccount * ) it->data;
 		g_return_if_fail( account && OFO_IS_ACCOUNT( account ));
 
-		acc_number = ofo_account_get_number( account );
-		if( my_strlen( priv->account_from ) && my_collate( priv->account_from, acc_number ) > 0 ){
+		acc_key = ofo_account_get_number_key( account );
+		if( from_key && g_strcmp0( from_key, acc_key ) > 0 ){
 			continue;
 		}
-		if( my_strlen( priv->account_to ) && my_collate( priv->account_to, acc_number ) < 0 ){
+		if( to_key && g_strcmp0( to_key, acc_key ) < 0 ){
 			continue;
 		}
 
@@ -482,6 +498,9 @@ complete_accounts_dataset( ofaAccountBalance *self )
 			find_account( self, account );
 		}
 	}
+
+	g_free( to_key );
+	g_free( from_key );
 }
 
 /*
@@ -28,6 +28,7 @@
 
 #include <gdk-pixbuf/gdk-pixbuf.h>
 #include <glib/gi18n.h>
+#include <string.h>
 
 #include "my/my-stamp.h"
 #include "my/my-utils.h"
@@ -55,9 +56,22 @@ typedef struct {
 	 */
 	GList      *signaler_handlers;
 	gboolean    dataset_is_loaded;
+	GHashTable *rows;					/* account number -> sAccountRow */
+	GSequence  *index;					/* sAccountRow's sorted by number */
 }
 	ofaAccountStorePrivate;
 
+/* a row of the store, indexed both by its account number and in the
+ * sorted sequence of the numbers
+ * NB: GtkTreeStore iters persist as long as the row exists
+ */
+typedef struct {
+	gchar         *number;
+	GtkTreeIter    iter;
+	GSequenceIter *seq_iter;
+}
+	sAccountRow;
+
 #define ACCOUNT_SETTLEABLE_STR            _( "S" )
 #define ACCOUNT_RECONCILIABLE_STR         _( "R" )
 #define ACCOUNT_FORWARDABLE_STR           _( "F" )
@@ -90,9 +104,10 @@ static void     tree_store_v_load_dataset( ofaTreeStore *store );
 static void     insert_row( ofaAccountStore *self, const ofoAccount *account );
 static void     set_row_by_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *iter );
 static gboolean find_parent_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *parent_iter );
-static gboolean find_row_by_number( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter, gboolean *bvalid );
-static gboolean find_row_by_number_rec( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter, GtkTreeIter *smaller, gint *last );
-static GList   *get_children_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *iter );
+static gboolean find_row_by_number( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter );
+static void     row_index( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter );
+static void     row_free( sAccountRow *row );
+static gint     row_cmp_by_number( const sAccountRow *a, const sAccountRow *b, void *empty );
 static void     realign_children( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *parent_iter );
 static GList   *remove_rows_by_number( ofaAccountStore *self, const gchar *number );
 static GList   *remove_rows_rec( ofaAccountStore *self, GtkTreeIter *iter, GList *list );
@@ -114,6 +129,7 @@ static void
 account_store_finalize( GObject *instance )
 {
 	static const gchar *thisfn = "ofa_account_store_finalize";
+	ofaAccountStorePrivate *priv;
 
 	g_debug( "%s: application=%p (%s)",
 			thisfn, ( void * ) instance, G_OBJECT_TYPE_NAME( instance ));
@@ -121,6 +137,11 @@ account_store_finalize( GObject *instance )
 	g_return_if_fail( instance && OFA_IS_ACCOUNT_STORE( instance ));
 
 	/* free data members here */
+	priv = ofa_account_store_get_instance_private( OFA_ACCOUNT_STORE( instance ));
+
+	/* rows have to be released before the sequence they are part of */
+	g_hash_table_unref( priv->rows );
+	g_sequence_free( priv->index );
 
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofa_account_store_parent_class )->finalize( instance );
@@ -167,6 +188,8 @@ ofa_account_store_init( ofaAccountStore *self )
 	priv->dispose_has_run = FALSE;
 	priv->signaler_handlers = NULL;
 	priv->dataset_is_loaded = FALSE;
+	priv->rows = g_hash_table_new_full( g_str_hash, g_str_equal, NULL, ( GDestroyNotify ) row_free );
+	priv->index = g_sequence_new( NULL );
 }
 
 static void
@@ -241,16 +264,19 @@ ofa_account_store_new( ofaIGetter *getter )
 static gint
 on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaAccountStore *self )
 {
-	gchar *anumber, *bnumber;
+	ofoAccount *a_obj, *b_obj;
 	gint cmp;
 
-	gtk_tree_model_get( tmodel, a, ACCOUNT_COL_NUMBER, &anumber, -1 );
-	gtk_tree_model_get( tmodel, b, ACCOUNT_COL_NUMBER, &bnumber, -1 );
+	gtk_tree_model_get( tmodel, a, ACCOUNT_COL_OBJECT, &a_obj, -1 );
+	gtk_tree_model_get( tmodel, b, ACCOUNT_COL_OBJECT, &b_obj, -1 );
 
-	cmp = my_collate( anumber, bnumber );
+	/* the object may not have been set yet on a just-inserted row */
+	cmp = g_strcmp0(
+			a_obj ? ofo_account_get_number_key( a_obj ) : NULL,
+			b_obj ? ofo_account_get_number_key( b_obj ) : NULL );
 
-	g_free( anumber );
-	g_free( bnumber );
+	g_clear_object( &a_obj );
+	g_clear_object( &b_obj );
 
 	return( cmp );
 }
@@ -311,6 +337,7 @@ insert_row( ofaAccountStore *self, const ofoAccount *account )
 			ACCOUNT_COL_OBJECT, account,
 			-1 );
 
+	row_index( self, ofo_account_get_number( account ), &iter );
 	set_row_by_iter( self, account, &iter );
 	realign_children( self, account, &iter );
 }
@@ -472,7 +499,7 @@ find_parent_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter
 	while( !found && ( len = my_strlen( candidate_number )) > 1 ){
 		candidate_number[len-1] = '\0';
 		//g_debug( "find_parent_iter: candidate_number='%s'", candidate_number );
-		found = find_row_by_number( self, candidate_number, parent_iter, NULL );
+		found = find_row_by_number( self, candidate_number, parent_iter );
 	}
 
 	g_free( candidate_number );
@@ -484,105 +511,67 @@ find_parent_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter
  * find_row_by_number:
  * @self: this #ofaAccountStore
  * @number: [in]: the account number we are searching for.
- * @iter: [out]: the last iter equal or immediately greater than the
- *  searched value.
- * @bvalid: [allow-none][out]: set to TRUE if the returned iter is
- *  valid.
- *
- * Rows are sorted by account number
- * We exit the search as soon as we get a number greater than the
- * searched one, or the end of the tree.
+ * @iter: [out]: the found iter.
  *
  * Returns TRUE if we have found an exact match, and @iter addresses
  * this exact match.
- *
- * Returns FALSE if we do not have found a match:
- * - @iter addresses
- * the first number greater than the searched value, or lesser if at
- * the end of the list, or nothing at all if the self is empty (and
- * @bvalid will be %FALSE if this later case).
  */
 static gboolean
-find_row_by_number( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter, gboolean *bvalid )
+find_row_by_number( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter )
 {
-	gint last_cmp;
-	gboolean found;
-	GtkTreeIter smaller;
+	ofaAccountStorePrivate *priv;
+	sAccountRow *row;
 
-	if( bvalid ){
-		*bvalid = FALSE;
-	}
+	priv = ofa_account_store_get_instance_private( self );
 
-	if( gtk_tree_model_get_iter_first( GTK_TREE_MODEL( self ), iter )){
-		if( bvalid ){
-			*bvalid = TRUE;
-		}
-		smaller = *iter;
-		found = find_row_by_number_rec( self, number, iter, &smaller, &last_cmp );
-		return( found );
+	row = g_hash_table_lookup( priv->rows, number );
+	if( row ){
+		*iter = row->iter;
 	}
 
-	return( FALSE );
+	return( row != NULL );
 }
 
 /*
- * enter here with a valid @iter (the first of the tree)
- * start by compare this @iter with the searched value
- * returns TRUE (and exit the recursion) if the @iter is equal to
- *   the searched value
- * returns FALSE (and exit the recursion) if the @iter is greater than
- *   the searched value
- * else if have children
- *   get the first child and recurse
- * else get next iter
- *
- * when exiting this function, iter is set to the last number which is
- * less or equal to the searched value
+ * Index the newly inserted @iter row.
  */
-static gboolean
-find_row_by_number_rec( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter, GtkTreeIter *smaller, gint *last_cmp )
+static void
+row_index( ofaAccountStore *self, const gchar *number, GtkTreeIter *iter )
 {
-	gchar *cmp_number;
-	gint searched_class, cmp_class;
-	GtkTreeIter cmp_iter, child_iter, last_iter;
+	ofaAccountStorePrivate *priv;
+	sAccountRow *row;
 
-	cmp_iter = *iter;
-	searched_class = ofo_account_get_class_from_number( number );
+	priv = ofa_account_store_get_instance_private( self );
 
-	while( TRUE ){
-		gtk_tree_model_get( GTK_TREE_MODEL( self ), &cmp_iter, ACCOUNT_COL_NUMBER, &cmp_number, -1 );
-		*last_cmp = g_utf8_collate( cmp_number, number );
-		cmp_class = ofo_account_get_class_from_number( cmp_number );
-		g_free( cmp_number );
-		if( *last_cmp == 0 ){
-			*iter = cmp_iter;
-			return( TRUE );
-		}
-		if( *last_cmp > 0 ){
-			*iter = cmp_class > searched_class ? *smaller : cmp_iter;
-			return( FALSE );
-		}
-		*smaller = cmp_iter;
-		if( gtk_tree_model_iter_children( GTK_TREE_MODEL( self ), &child_iter, &cmp_iter )){
-			find_row_by_number_rec( self, number, &child_iter, smaller, last_cmp );
-			if( *last_cmp == 0 ){
-				*iter = child_iter;
-				return( TRUE );
-			}
-			if( *last_cmp > 0 ){
-				*iter = *smaller;
-				return( FALSE );
-			}
-			*smaller = child_iter;
-		}
-		last_iter = cmp_iter;
-		if( !gtk_tree_model_iter_next( GTK_TREE_MODEL( self ), &cmp_iter )){
-			break;
-		}
-	}
+	row = g_new0( sAccountRow, 1 );
+	row->number = g_strdup( number );
+	row->iter = *iter;
+	row->seq_iter = g_sequence_insert_sorted(
+			priv->index, row, ( GCompareDataFunc ) row_cmp_by_number, NULL );
 
-	*iter = last_iter;
-	return( FALSE );
+	g_hash_table_replace( priv->rows, row->number, row );
+}
+
+/*
+ * Called when the row is removed from the hash table.
+ */
+static void
+row_free( sAccountRow *row )
+{
+	g_sequence_remove( row->seq_iter );
+	g_free( row->number );
+	g_free( row );
+}
+
+/*
+ * Accounts are indexed by byte order: this guarantees that all the
+ * numbers which start with a given prefix are contiguous, just after
+ * the prefix itself.
+ */
+static gint
+row_cmp_by_number( const sAccountRow *a, const sAccountRow *b, void *empty )
+{
+	return( strcmp( a->number, b->number ));
 }
 
 /*
@@ -591,88 +580,62 @@ find_row_by_number_rec( ofaAccountStore *self, const gchar *number, GtkTreeIter
  * When entering here, @parent_iter should not have yet any child iter
  * (because it is newly inserted)
  *
- * This function relies on the fact that the self is sorted.
- * Starting from the newly inserted account (@parent_iter), we
- * successively iterate on children while these are actual child
- * of the account.
+ * The children of the account are the contiguous numbers which follow
+ * it in the index. Each of them which is not itself the child of a
+ * previous one is the top of a subtree which is removed from its
+ * current place, and then reinserted under @account.
  */
 static void
 realign_children( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *parent_iter )
 {
 	static const gchar *thisfn = "ofa_account_store_realign_children";
-	GList *children, *it;
+	ofaAccountStorePrivate *priv;
+	GList *tops, *children, *it;
+	GSequenceIter *seq_iter;
+	sAccountRow *row;
+	const gchar *number, *last_top;
 	GtkTreeIter iter;
 
+	priv = ofa_account_store_get_instance_private( self );
+
 	if( gtk_tree_model_iter_has_child( GTK_TREE_MODEL( self ), parent_iter )){
 		g_warning( "%s: newly inserted row, but already has one child", thisfn );
 
 	} else {
-		children = NULL;
-		iter = *parent_iter;
-		if( gtk_tree_model_iter_next( GTK_TREE_MODEL( self ), &iter )){
-			children = get_children_iter( self, account, &iter );
-			for( it=children ; it ; it=it->next ){
-				//g_debug( "realign_children: re-inserting %s", ofo_account_get_number( OFO_ACCOUNT( it->data )));
-				insert_row( self, OFO_ACCOUNT( it->data ));
-			}
-			g_list_free_full( children, ( GDestroyNotify ) g_object_unref );
-		}
-	}
-}
+		number = ofo_account_get_number( account );
+		row = g_hash_table_lookup( priv->rows, number );
+		g_return_if_fail( row != NULL );
 
-/*
- * get_children_iter:
- * copy into 'children' GList all children accounts, along with their
- * row reference - it will so be easy to remove them from the model,
- * then reinsert these same accounts
- */
-static GList *
-get_children_iter( ofaAccountStore *self, const ofoAccount *account, GtkTreeIter *iter )
-{
-	GList *children;
-	ofoAccount *candidate;
-	gboolean is_child, has_next;
-	GtkTreePath *path;
-	GtkTreeRowReference *ref;
-	GtkTreeIter next_iter;
+		tops = NULL;
+		last_top = NULL;
+		seq_iter = g_sequence_iter_next( row->seq_iter );
 
-	children = NULL;
-
-	while( TRUE ){
-		gtk_tree_model_get( GTK_TREE_MODEL( self ), iter, ACCOUNT_COL_OBJECT, &candidate, -1 );
-		g_object_unref( candidate );
-
-		is_child = ofo_account_is_child_of( account, ofo_account_get_number( candidate ));
-		if( 0 ){
-			g_debug( "get_children_iter: account=%s, candidate=%s, is_child=%s",
-					ofo_account_get_number( account ),
-					ofo_account_get_number( candidate ),
-					is_child ? "True":"False" );
-		}
-		if( is_child ){
-			next_iter = *iter;
-			has_next = gtk_tree_model_iter_next( GTK_TREE_MODEL( self ), &next_iter );
-			if( has_next ){
-				path = gtk_tree_model_get_path( GTK_TREE_MODEL( self ), &next_iter );
-				ref = gtk_tree_row_reference_new( GTK_TREE_MODEL( self ), path );
-				gtk_tree_path_free( path );
+		while( !g_sequence_iter_is_end( seq_iter )){
+			row = g_sequence_get( seq_iter );
+			if( !g_str_has_prefix( row->number, number )){
+				break;
+			}
+			if( !last_top || !g_str_has_prefix( row->number, last_top )){
+				last_top = row->number;
+				tops = g_list_prepend( tops, g_strdup( last_top ));
 			}
-			children = remove_rows_rec( self, iter, children );
-			if( has_next ){
-				path = gtk_tree_row_reference_get_path( ref );
-				gtk_tree_model_get_iter( GTK_TREE_MODEL( self ), iter, path );
-				gtk_tree_row_reference_free( ref );
+			seq_iter = g_sequence_iter_next( seq_iter );
+		}
 
-			} else {
-				break;
+		children = NULL;
+		for( it=tops ; it ; it=it->next ){
+			if( find_row_by_number( self, ( const gchar * ) it->data, &iter )){
+				children = remove_rows_rec( self, &iter, children );
 			}
+		}
+		g_list_free_full( tops, ( GDestroyNotify ) g_free );
 
-		} else {
-			break;
+		for( it=children ; it ; it=it->next ){
+			//g_debug( "realign_children: re-inserting %s", ofo_account_get_number( OFO_ACCOUNT( it->data )));
+			insert_row( self, OFO_ACCOUNT( it->data ));
 		}
+		g_list_free_full( children, ( GDestroyNotify ) g_object_unref );
 	}
-
-	return( children );
 }
 
 /*
@@ -686,20 +649,15 @@ remove_rows_by_number( ofaAccountStore *self, const gchar *number )
 	static const gchar *thisfn = "ofa_account_store_remove_rows_by_number";
 	GList *list;
 	GtkTreeIter iter;
-	gboolean is_valid;
 
 	g_debug( "%s: number=%s", thisfn, number );
 
 	/* warning is admitted here because this function is expected to be
 	 * called only on existing accounts */
-	if( !find_row_by_number( self, number, &iter, &is_valid )){
+	if( !find_row_by_number( self, number, &iter )){
 		g_warning( "%s: '%s': account not found", thisfn, number );
 		return( NULL );
 	}
-	if( !is_valid ){
-		g_warning( "%s: '%s': account was found, but returned GtkTreeIter is not valid", thisfn, number );
-		return( NULL );
-	}
 
 	list = remove_rows_rec( self, &iter, NULL );
 
@@ -716,8 +674,12 @@ remove_rows_by_number( ofaAccountStore *self, const gchar *number )
 static GList *
 remove_rows_rec( ofaAccountStore *self, GtkTreeIter *iter, GList *list )
 {
+	ofaAccountStorePrivate *priv;
 	GtkTreeIter child_iter;
 	ofoAccount *account;
+	gchar *number;
+
+	priv = ofa_account_store_get_instance_private( self );
 
 	if( 0 ){
 		g_debug( "remove_rows_rec: iter=%p, list=%p (count=%d)",
@@ -728,11 +690,16 @@ remove_rows_rec( ofaAccountStore *self, GtkTreeIter *iter, GList *list )
 		list = remove_rows_rec( self, &child_iter, list );
 	}
 
-	gtk_tree_model_get( GTK_TREE_MODEL( self ), iter, ACCOUNT_COL_OBJECT, &account, -1 );
+	/* the row is unindexed by its stored number, as the account may
+	 * have been just renumbered */
+	gtk_tree_model_get( GTK_TREE_MODEL( self ), iter,
+			ACCOUNT_COL_NUMBER, &number, ACCOUNT_COL_OBJECT, &account, -1 );
 	g_return_val_if_fail( account && OFO_IS_ACCOUNT( account ), NULL );
 	list = g_list_insert_sorted( list, account, ( GCompareFunc ) cmp_account_by_number );
 
 	//g_debug( "remove_rows_rec: removing %s", ofo_account_get_number( account ));
+	g_hash_table_remove( priv->rows, number );
+	g_free( number );
 	gtk_tree_store_remove( GTK_TREE_STORE( self ), iter );
 
 	return( list );
@@ -767,7 +734,7 @@ set_account_new_id( ofaAccountStore *self, ofoAccount *account, const gchar *pre
 		}
 		g_list_free_full( list, ( GDestroyNotify ) g_object_unref );
 
-	} else if( find_row_by_number( self, number, &iter, NULL )){
+	} else if( find_row_by_number( self, number, &iter )){
 		set_row_by_iter( self, account, &iter);
 	}
 }
@@ -831,16 +798,16 @@ signaler_connect_to_signaling_system( ofaAccountStore *self )
 
 	signaler = ofa_igetter_get_signaler( priv->getter );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_COLLECTION_RELOAD, G_CALLBACK( signaler_on_reload_collection ), self );
+	handler = ofa_isignaler_connect_reload( signaler, OFO_TYPE_ACCOUNT, G_CALLBACK( signaler_on_reload_collection ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 }
 
@@ -945,6 +912,7 @@ signaler_on_reload_collection( ofaISignaler *signaler, GType type, ofaAccountSto
 	priv = ofa_account_store_get_instance_private( self );
 
 	if( type == OFO_TYPE_ACCOUNT ){
+		g_hash_table_remove_all( priv->rows );
 		gtk_tree_store_clear( GTK_TREE_STORE( self ));
 		priv->dataset_is_loaded = FALSE;
 		tree_store_v_load_dataset( OFA_TREE_STORE( self ));
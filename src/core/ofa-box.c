@@ -45,38 +45,93 @@
 struct _ofsBoxData {
 	const ofsBoxDef *def;
 	gboolean         is_null;
+	gboolean         in_arena;
 	union {
 		ofxAmount   amount;
 		ofxCounter  counter;
 		gint        integer;
 		GDate       date;
 		gchar      *string;
-		myStampVal *timestamp;
+		myStampVal  timestamp;
 	};
 };
 
-static void   box_dump_def( const ofsBoxDef *def );
-static gchar *get_csv_name( const ofsBoxDef *def );
-static gchar *compute_csv_name( const gchar *dbms_name );
-static gchar *csv_get_field_ex( const ofsBoxData *box_data, ofaStreamFormat *format, ofoCurrency *currency, CSVExportFunc cb, void *user_data );
-static void   set_decimal_point( gchar *str, gchar decimal_sep );
+/**
+ * ofaBoxArena:
+ *
+ * A block allocator for the elementary data of a whole dataset, and
+ * the #GList nodes which chain them.
+ */
+struct _ofaBoxArena {
+	gint    ref_count;
+	GSList *blocks;
+	gchar  *next;
+	gsize   left;
+};
+
+#define ARENA_BLOCK_SIZE                65536
+#define ARENA_ALIGN(S)                  (((S)+7) & ~(( gsize ) 7 ))
+
+static gpointer arena_alloc0( ofaBoxArena *arena, gsize size );
+static gchar   *string_dup( const ofsBoxDef *def, const gchar *str );
+static void     string_release( ofsBoxData *box );
+static void     box_dump_def( const ofsBoxDef *def );
+static gchar   *get_csv_name( const ofsBoxDef *def );
+static gchar   *compute_csv_name( const gchar *dbms_name );
+static gchar   *csv_get_field_ex( const ofsBoxData *box_data, ofaStreamFormat *format, ofoCurrency *currency, CSVExportFunc cb, void *user_data );
+static void     set_decimal_point( gchar *str, gchar decimal_sep );
 
 /*
  * box_new:
  * @def: the field definition.
  */
 static ofsBoxData *
-box_new( const ofsBoxDef *def )
+box_new( const ofsBoxDef *def, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = g_new0( ofsBoxData, 1 );
+	if( arena ){
+		box = arena_alloc0( arena, sizeof( ofsBoxData ));
+		box->in_arena = TRUE;
+	} else {
+		box = g_new0( ofsBoxData, 1 );
+	}
 	box->def = def;
 	box->is_null = TRUE;
 
 	return( box );
 }
 
+/*
+ * arena_alloc0:
+ * @arena: the #ofaBoxArena.
+ * @size: the requested size.
+ *
+ * Returns: a zeroed memory area of at least @size bytes, which is only
+ * released with the @arena itself.
+ */
+static gpointer
+arena_alloc0( ofaBoxArena *arena, gsize size )
+{
+	gpointer ptr;
+	gsize block_size;
+
+	size = ARENA_ALIGN( size );
+
+	if( size > arena->left ){
+		block_size = MAX( size, ARENA_BLOCK_SIZE );
+		arena->next = g_malloc0( block_size );
+		arena->left = block_size;
+		arena->blocks = g_slist_prepend( arena->blocks, arena->next );
+	}
+
+	ptr = arena->next;
+	arena->next += size;
+	arena->left -= size;
+
+	return( ptr );
+}
+
 /*
  * OFA_TYPE_AMOUNT
  * ofxAmount
@@ -99,11 +154,11 @@ amount_set( ofsBoxData *box, gconstpointer value )
 }
 
 static ofsBoxData *
-amount_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+amount_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_AMOUNT, NULL );
 
 	if( my_strlen( str )){
@@ -152,11 +207,11 @@ counter_set( ofsBoxData *box, ofxCounter value )
 }
 
 static ofsBoxData *
-counter_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+counter_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_COUNTER, NULL );
 
 	if( my_strlen( str )){
@@ -204,11 +259,11 @@ int_set( ofsBoxData *box, gint value )
 }
 
 static ofsBoxData *
-int_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+int_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_INTEGER, NULL );
 
 	if( my_strlen( str )){
@@ -261,11 +316,11 @@ date_set( ofsBoxData *box, const GDate *value )
 }
 
 static ofsBoxData *
-date_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+date_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_DATE, NULL );
 	my_date_clear( &box->date );
 
@@ -310,7 +365,7 @@ string_set( ofsBoxData *box, const gchar *value )
 {
 	g_return_if_fail( box->def->type == OFA_TYPE_STRING );
 
-	g_free( box->string );
+	string_release( box );
 	/* debug */
 	if( 0 ){
 		g_debug( "string_set: value=%s, len=%ld", value, my_strlen( value ));
@@ -318,7 +373,7 @@ string_set( ofsBoxData *box, const gchar *value )
 
 	if( my_strlen( value )){
 		box->is_null = FALSE;
-		box->string = g_strdup( value );
+		box->string = string_dup( box->def, value );
 
 	} else {
 		box->is_null = TRUE;
@@ -327,16 +382,16 @@ string_set( ofsBoxData *box, const gchar *value )
 }
 
 static ofsBoxData *
-string_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+string_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_STRING, NULL );
 
 	if( my_strlen( str )){
 		box->is_null = FALSE;
-		box->string = g_strdup( str );
+		box->string = string_dup( box->def, str );
 	}
 
 	return( box );
@@ -375,10 +430,31 @@ string_free( ofsBoxData *box )
 	g_return_if_fail( box->def->type == OFA_TYPE_STRING );
 
 	/*g_debug( "ofa_box_string_free: box=%p", ( void * ) box );*/
-	g_free( box->string );
+	string_release( box );
 	g_free( box );
 }
 
+/*
+ * the interned strings are shared through the pool, and only released
+ * there
+ */
+static gchar *
+string_dup( const ofsBoxDef *def, const gchar *str )
+{
+	return( def->interned ? ( gchar * ) my_utils_intern_ref( str ) : g_strdup( str ));
+}
+
+static void
+string_release( ofsBoxData *box )
+{
+	if( box->def->interned ){
+		my_utils_intern_unref( box->string );
+	} else {
+		g_free( box->string );
+	}
+	box->string = NULL;
+}
+
 /*
  * OFA_TYPE_TIMESTAMP
  */
@@ -388,7 +464,7 @@ timestamp_get( const ofsBoxData *box )
 	g_return_val_if_fail( box->def->type == OFA_TYPE_TIMESTAMP, NULL );
 
 	if( !box->is_null ){
-		return(( const myStampVal * ) box->timestamp );
+		return(( const myStampVal * ) &box->timestamp );
 	}
 
 	return( NULL );
@@ -401,25 +477,25 @@ timestamp_set( ofsBoxData *box, const myStampVal *value )
 
 	if( value ){
 		box->is_null = FALSE;
-		box->timestamp = my_stamp_new_from_stamp( value );
+		my_stamp_set_from_stamp( &box->timestamp, value );
 
 	} else {
 		box->is_null = TRUE;
-		box->timestamp = NULL;
+		my_stamp_set_from_stamp( &box->timestamp, NULL );
 	}
 }
 
 static ofsBoxData *
-timestamp_new_from_dbms( const ofsBoxDef *def, const gchar *str )
+timestamp_new_from_dbms( const ofsBoxDef *def, const gchar *str, ofaBoxArena *arena )
 {
 	ofsBoxData *box;
 
-	box = box_new( def );
+	box = box_new( def, arena );
 	g_return_val_if_fail( box->def->type == OFA_TYPE_TIMESTAMP, NULL );
 
 	if( my_strlen( str )){
 		box->is_null = FALSE;
-		box->timestamp = my_stamp_new_from_sql( str );
+		my_stamp_set_from_sql( &box->timestamp, str );
 	}
 
 	return( box );
@@ -435,7 +511,7 @@ timestamp_to_string( const ofsBoxData *box, ofaStreamFormat *format )
 	if( box->is_null ){
 		str = g_strdup( "" );
 	} else {
-		str = my_stamp_to_str( box->timestamp, MY_STAMP_YYMDHMS );
+		str = my_stamp_to_str( &box->timestamp, MY_STAMP_YYMDHMS );
 		if( !str ){
 			str = g_strdup( "" );
 		}
@@ -444,18 +520,9 @@ timestamp_to_string( const ofsBoxData *box, ofaStreamFormat *format )
 	return( str );
 }
 
-static void
-timestamp_free( ofsBoxData *box )
-{
-	g_return_if_fail( box->def->type == OFA_TYPE_TIMESTAMP );
-
-	my_stamp_free( box->timestamp );
-	g_free( box );
-}
-
 typedef gconstpointer ( *GetFn )       ( gconstpointer box );
 typedef void          ( *SetFn )       ( gpointer box, gconstpointer value );
-typedef gpointer      ( *FromDBMSFn )  ( const ofsBoxDef *def, const gchar *source );
+typedef gpointer      ( *FromDBMSFn )  ( const ofsBoxDef *def, const gchar *source, ofaBoxArena *arena );
 typedef gchar       * ( *ToDBMSFn )    ( gconstpointer box );
 typedef gpointer      ( *FromStringFn )( const ofsBoxDef *def, const gchar *source );
 typedef gchar       * ( *ToStringFn )  ( gconstpointer box, ofaStreamFormat *format );
@@ -521,7 +588,7 @@ static const sBoxHelpers st_box_helpers[] = {
 				( ToDBMSFn )     NULL,
 				( FromStringFn ) NULL,
 				( ToStringFn )   timestamp_to_string,
-				( FreeFn )       timestamp_free },
+				( FreeFn )       g_free },
 		{ 0 }
 };
 
@@ -587,7 +654,7 @@ ofa_box_init_fields_list( const ofsBoxDef *defs )
 	if( defs ){
 		idef = defs;
 		while( idef->id ){
-			fields_list = g_list_prepend( fields_list, box_new( idef ));
+			fields_list = g_list_prepend( fields_list, box_new( idef, NULL ));
 			idef++;
 		}
 	}
@@ -667,28 +734,70 @@ ofa_box_dbms_get_columns_list( const ofsBoxDef *defs )
 GList *
 ofa_box_dbms_parse_result( const ofsBoxDef *defs, GSList *row )
 {
-	GList *fields_list;
+	return( ofa_box_dbms_parse_result_ex( defs, row, NULL ));
+}
+
+/**
+ * ofa_box_dbms_parse_result_ex:
+ * @defs: the definition of ofaBox elementary data of the object
+ * @row: a row of the DBMS result to be parsed.
+ * @arena: [allow-none]: a #ofaBoxArena.
+ *
+ * Same as ofa_box_dbms_parse_result(), but the elementary data and the
+ * nodes of the returned list are allocated from the @arena when it is
+ * set.
+ *
+ * An arena-allocated list must not be modified (only the values of its
+ * elementary data may be), and the @arena must be kept alive until it
+ * has been released with ofa_box_free_fields_list().
+ */
+GList *
+ofa_box_dbms_parse_result_ex( const ofsBoxDef *defs, GSList *row, ofaBoxArena *arena )
+{
+	GList *fields_list, *nodes;
 	GSList *icol;
 	const ofsBoxDef *idef;
 	const sBoxHelpers *ihelper;
 	gboolean first;
+	ofsBoxData *box;
+	guint count, i;
 
 	fields_list = NULL;
+	nodes = NULL;
 	first = TRUE;
 
+	if( row && defs && arena ){
+		for( count=0, idef=defs ; idef->id ; ++count, ++idef )
+			;
+		/* the list nodes are allocated as a single array */
+		nodes = count ? arena_alloc0( arena, count * sizeof( GList )) : NULL;
+	}
+
 	if( row && defs ){
 		idef = defs;
+		i = 0;
 		while( idef->id ){
 			ihelper = box_get_helper_for_type( idef->type );
 			g_return_val_if_fail( ihelper, NULL );
 			icol = ( GSList * )( first ? row->data : icol->next );
-			fields_list = g_list_prepend( fields_list, ihelper->from_dbms_fn( idef, icol->data ));
+			box = ihelper->from_dbms_fn( idef, icol->data, arena );
+			if( nodes ){
+				nodes[i].data = box;
+				nodes[i].prev = i ? &nodes[i-1] : NULL;
+				nodes[i].next = NULL;
+				if( i ){
+					nodes[i-1].next = &nodes[i];
+				}
+			} else {
+				fields_list = g_list_prepend( fields_list, box );
+			}
 			idef++;
+			i++;
 			first = FALSE;
 		}
 	}
 
-	return( g_list_reverse( fields_list ));
+	return( nodes ? nodes : g_list_reverse( fields_list ));
 }
 
 /**
@@ -1049,7 +1158,13 @@ void
 ofa_box_free_fields_list( GList *fields_list )
 {
 	if( fields_list ){
-		g_list_free_full( fields_list, ( GDestroyNotify ) box_free_data );
+		/* an arena-allocated list only releases the values which have
+		 * been allocated outside of the arena */
+		if((( ofsBoxData * ) fields_list->data )->in_arena ){
+			g_list_foreach( fields_list, ( GFunc ) box_free_data, NULL );
+		} else {
+			g_list_free_full( fields_list, ( GDestroyNotify ) box_free_data );
+		}
 	}
 }
 
@@ -1062,12 +1177,70 @@ box_free_data( ofsBoxData *box )
 	def = (( ofsBoxData * ) box )->def;
 	g_return_if_fail( def );
 
+	if( box->in_arena ){
+		if( def->type == OFA_TYPE_STRING ){
+			string_release( box );
+		}
+		return;
+	}
+
 	ihelper = box_get_helper_for_type( def->type );
 	g_return_if_fail( ihelper );
 
 	ihelper->free_fn( box );
 }
 
+/**
+ * ofa_box_arena_new:
+ *
+ * Returns: a new #ofaBoxArena, with a reference count of one.
+ *
+ * An arena lets a whole dataset be allocated in large blocks, and
+ * released at once when its last reference is dropped.
+ */
+ofaBoxArena *
+ofa_box_arena_new( void )
+{
+	ofaBoxArena *arena;
+
+	arena = g_new0( ofaBoxArena, 1 );
+	arena->ref_count = 1;
+
+	return( arena );
+}
+
+/**
+ * ofa_box_arena_ref:
+ * @arena: this #ofaBoxArena.
+ *
+ * Returns: the @arena with a new reference.
+ */
+ofaBoxArena *
+ofa_box_arena_ref( ofaBoxArena *arena )
+{
+	g_return_val_if_fail( arena, NULL );
+
+	g_atomic_int_inc( &arena->ref_count );
+
+	return( arena );
+}
+
+/**
+ * ofa_box_arena_unref:
+ * @arena: [allow-none]: this #ofaBoxArena.
+ *
+ * Releases a reference on the @arena, and frees all its blocks when
+ * this was the last one.
+ */
+void
+ofa_box_arena_unref( ofaBoxArena *arena )
+{
+	if( arena && g_atomic_int_dec_and_test( &arena->ref_count )){
+		g_slist_free_full( arena->blocks, ( GDestroyNotify ) g_free );
+		g_free( arena );
+	}
+}
+
 /**
  * ofa_box_data_get_def:
  * @box: the #ofaBox data as an opaque structure.
@@ -48,15 +48,18 @@
 /* private instance data
  */
 typedef struct {
-	gboolean    dispose_has_run;
+	gboolean      dispose_has_run;
 
 	/* initialization
 	 */
-	ofaIGetter *getter;
+	ofaIGetter   *getter;
 
 	/* runtime
 	 */
-	GList      *signaler_handlers;
+	GList        *signaler_handlers;
+	GCancellable *cancellable;
+	gboolean      loading;
+	gboolean      inserted_while_loading;
 }
 	ofaEntryStorePrivate;
 
@@ -92,6 +95,7 @@ enum {
 static guint st_signals[ N_SIGNALS ]    = { 0 };
 
 static void     load_dataset( ofaEntryStore *store );
+static void     load_dataset_on_ready( GObject *source, GAsyncResult *result, ofaEntryStore *self );
 static gint     on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaEntryStore *self );
 static void     insert_row( ofaEntryStore *self, const ofoEntry *entry );
 static void     set_row_by_iter( ofaEntryStore *self, const ofoEntry *entry, GtkTreeIter *iter );
@@ -147,6 +151,10 @@ entry_store_dispose( GObject *instance )
 		ofa_isignaler_disconnect_handlers( signaler, &priv->signaler_handlers );
 
 		/* unref object members here */
+		if( priv->cancellable ){
+			g_cancellable_cancel( priv->cancellable );
+			g_clear_object( &priv->cancellable );
+		}
 	}
 
 	/* chain up to the parent class */
@@ -273,22 +281,72 @@ on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaEntrySto
 
 /*
  * Loads the dataset.
+ *
+ * The entries are asynchronously loaded, so that the user interface
+ * is not blocked; the store sends a 'ofa-changed' signal when the
+ * rows have been inserted.
  */
 static void
 load_dataset( ofaEntryStore *store )
 {
 	ofaEntryStorePrivate *priv;
+
+	priv = ofa_entry_store_get_instance_private( store );
+
+	priv->cancellable = g_cancellable_new();
+	priv->loading = TRUE;
+	priv->inserted_while_loading = FALSE;
+
+	ofo_entry_get_dataset_async(
+			priv->getter, priv->cancellable,
+			( GAsyncReadyCallback ) load_dataset_on_ready, g_object_ref( store ));
+}
+
+static void
+load_dataset_on_ready( GObject *source, GAsyncResult *result, ofaEntryStore *self )
+{
+	static const gchar *thisfn = "ofa_entry_store_load_dataset_on_ready";
+	ofaEntryStorePrivate *priv;
 	GList *dataset, *it;
 	ofoEntry *entry;
+	GError *error;
+	GtkTreeIter iter;
 
-	priv = ofa_entry_store_get_instance_private( store );
+	priv = ofa_entry_store_get_instance_private( self );
+
+	error = NULL;
+	dataset = ofo_entry_get_dataset_finish( result, &error );
+
+	if( error ){
+		if( !g_error_matches( error, G_IO_ERROR, G_IO_ERROR_CANCELLED )){
+			g_warning( "%s: %s", thisfn, error->message );
+			/* the load is over: later inserted entries are not
+			 * to be checked against a dataset which will never come */
+			if( !priv->dispose_has_run ){
+				priv->loading = FALSE;
+				g_clear_object( &priv->cancellable );
+			}
+		}
+		g_error_free( error );
 
-	dataset = ofo_entry_get_dataset( priv->getter );
+	} else if( !priv->dispose_has_run ){
+		priv->loading = FALSE;
 
-	for( it=dataset ; it ; it=it->next ){
-		entry = OFO_ENTRY( it->data );
-		insert_row( store, entry );
+		for( it=dataset ; it ; it=it->next ){
+			entry = OFO_ENTRY( it->data );
+			/* do not insert twice an entry which has been created
+			 * while the dataset was loading */
+			if( !priv->inserted_while_loading ||
+					!find_row_by_number( self, ofo_entry_get_number( entry ), &iter )){
+				insert_row( self, entry );
+			}
+		}
+
+		g_clear_object( &priv->cancellable );
+		g_signal_emit_by_name( self, "ofa-changed" );
 	}
+
+	g_object_unref( self );
 }
 
 static void
@@ -629,16 +687,16 @@ signaler_connect_to_signaling_system( ofaEntryStore *self )
 
 	signaler = ofa_igetter_get_signaler( priv->getter );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_COLLECTION_RELOAD, G_CALLBACK( signaler_on_reload_collection ), self );
+	handler = ofa_isignaler_connect_reload( signaler, OFO_TYPE_ENTRY, G_CALLBACK( signaler_on_reload_collection ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 }
 
@@ -649,6 +707,7 @@ static void
 signaler_on_new_base( ofaISignaler *signaler, ofoBase *object, ofaEntryStore *self )
 {
 	static const gchar *thisfn = "ofa_entry_store_signaler_on_new_base";
+	ofaEntryStorePrivate *priv;
 
 	g_debug( "%s: signaler=%p, object=%p (%s), self=%p",
 			thisfn,
@@ -656,8 +715,11 @@ signaler_on_new_base( ofaISignaler *signaler, ofoBase *object, ofaEntryStore *se
 			( void * ) object, G_OBJECT_TYPE_NAME( object ),
 			( void * ) self );
 
+	priv = ofa_entry_store_get_instance_private( self );
+
 	if( OFO_IS_ENTRY( object )){
 		insert_row( self, OFO_ENTRY( object ));
+		priv->inserted_while_loading |= priv->loading;
 	}
 
 	g_signal_emit_by_name( self, "ofa-changed" );
@@ -737,15 +799,31 @@ signaler_on_deleted_base( ofaISignaler *signaler, ofoBase *object, ofaEntryStore
 
 /*
  * SIGNALER_COLLECTION_RELOAD signal handler
+ *
+ * This is sent instead of the individual signals when a batch has
+ * updated too many entries: the store is cleared and reloaded, a load
+ * in progress being cancelled first. The 'ofa-changed' signal will be
+ * sent when the new dataset has been inserted.
  */
 static void
 signaler_on_reload_collection( ofaISignaler *signaler, GType type, ofaEntryStore *self )
 {
 	static const gchar *thisfn = "ofa_entry_store_signaler_on_reload_collection";
+	ofaEntryStorePrivate *priv;
 
 	g_debug( "%s: signaler=%p, type=%lu, self=%p",
 			thisfn,
 			( void * ) signaler, type, ( void * ) self );
 
+	priv = ofa_entry_store_get_instance_private( self );
+
+	if( priv->cancellable ){
+		g_cancellable_cancel( priv->cancellable );
+		g_clear_object( &priv->cancellable );
+	}
+
+	gtk_list_store_clear( GTK_LIST_STORE( self ));
+	load_dataset( self );
+
 	g_signal_emit_by_name( self, "ofa-changed" );
 }
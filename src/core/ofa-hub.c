@@ -26,7 +26,9 @@
 #include <config.h>
 #endif
 
+#include "my/my-icollectionable.h"
 #include "my/my-icollector.h"
+#include "my/my-iprogress.h"
 #include "my/my-isettings.h"
 #include "my/my-scope-mapper.h"
 #include "my/my-settings.h"
@@ -97,12 +99,61 @@ typedef struct {
 	ofoDossier            *dossier;
 	gboolean               read_only;
 	ofoCounters           *counters;
+
+	/* collections preloading
+	 */
+	GCancellable          *preload_cancellable;
 }
 	ofaHubPrivate;
 
+/* Collections preloading
+ *
+ * The collections are loaded by at most PRELOAD_MAX_THREADS worker
+ * threads, each one with its own dedicated connection. While a worker
+ * runs a loader, ofa_hub_get_connect() returns the connection of the
+ * worker (see st_thread_connect), so that the standard
+ * myICollectionable::load_collection() methods can be used as is.
+ *
+ * The loaded datasets are published to the collector from the main
+ * thread. A collection which has been loaded on demand in the meanwhile
+ * is left unchanged, the preloaded dataset being just released.
+ */
+#define PRELOAD_MAX_THREADS    4
+
+typedef struct {
+	ofaHub                *hub;
+	GCancellable          *cancellable;
+	myIProgress           *progress;
+	GAsyncQueue           *types;
+	guint                  total;
+	guint                  done;
+	guint                  running;
+}
+	sPreload;
+
+typedef struct {
+	sPreload              *preload;
+	GThread               *thread;
+	ofaIDBConnect         *connect;
+}
+	sPreloadWorker;
+
+typedef struct {
+	sPreload              *preload;
+	GType                  type;
+	GList                 *dataset;
+}
+	sPreloadDone;
+
+static GPrivate st_thread_connect = G_PRIVATE_INIT( NULL );
+
 static void                   hub_register_types( ofaHub *self );
 static void                   hub_setup_settings( ofaHub *self );
 static void                   on_properties_dossier_changed( ofaISignaler *signaler, void *empty );
+static gpointer               preload_thread( sPreloadWorker *worker );
+static gboolean               preload_on_loaded( sPreloadDone *done );
+static gboolean               preload_on_worker_end( sPreloadWorker *worker );
+static void                   preload_free( sPreload *preload );
 static void                   icollector_iface_init( myICollectorInterface *iface );
 static guint                  icollector_get_interface_version( void );
 static void                   igetter_iface_init( ofaIGetterInterface *iface );
@@ -487,6 +538,7 @@ ofa_hub_open_dossier( ofaHub *hub, GtkWindow *parent,
 	g_return_val_if_fail( priv->dossier == NULL, FALSE );
 
 	priv->connect = g_object_ref(( gpointer ) connect );
+	ofa_idbconnect_set_audit_mode( connect, ofa_prefs_audit_get_mode( OFA_IGETTER( hub )));
 	ok = FALSE;
 
 	if( ofa_idbmodel_update( OFA_IGETTER( hub ), parent )){
@@ -531,6 +583,9 @@ on_properties_dossier_changed( ofaISignaler *signaler, void *empty )
  *
  * Returns: the #ofaIDBConnect connection object.
  *
+ * When called from a collections preloading worker thread, returns the
+ * dedicated connection of this worker.
+ *
  * The returned reference is owned by the @hub object, and should
  * not be released by the caller.
  */
@@ -538,6 +593,7 @@ ofaIDBConnect *
 ofa_hub_get_connect( ofaHub *hub )
 {
 	ofaHubPrivate *priv;
+	ofaIDBConnect *connect;
 
 	g_return_val_if_fail( hub && OFA_IS_HUB( hub ), NULL );
 
@@ -545,7 +601,9 @@ ofa_hub_get_connect( ofaHub *hub )
 
 	g_return_val_if_fail( !priv->dispose_has_run, NULL );
 
-	return( priv->connect );
+	connect = g_private_get( &st_thread_connect );
+
+	return( connect ? connect : priv->connect );
 }
 
 /*
@@ -681,6 +739,7 @@ ofa_hub_close_dossier( ofaHub *hub )
 {
 	static const gchar *thisfn = "ofa_hub_close_dossier";
 	ofaHubPrivate *priv;
+	gchar *msgerr;
 
 	g_debug( "%s: hub=%p", thisfn, ( void * ) hub );
 
@@ -696,6 +755,21 @@ ofa_hub_close_dossier( ofaHub *hub )
 		 *  at this time all datas are alive and valid */
 		g_signal_emit_by_name( OFA_ISIGNALER( hub ), SIGNALER_DOSSIER_CLOSED );
 
+		/* the preloaded collections will not be published */
+		if( priv->preload_cancellable ){
+			g_cancellable_cancel( priv->preload_cancellable );
+			g_clear_object( &priv->preload_cancellable );
+		}
+
+		/* last chance to write the audit trail */
+		if( priv->connect ){
+			msgerr = NULL;
+			if( !ofa_idbconnect_audit_close( priv->connect, &msgerr )){
+				my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, msgerr );
+				g_free( msgerr );
+			}
+		}
+
 		g_clear_object( &priv->connect );
 		g_clear_object( &priv->counters );
 		g_clear_object( &priv->dossier );
@@ -704,6 +778,209 @@ ofa_hub_close_dossier( ofaHub *hub )
 	}
 }
 
+/**
+ * ofa_hub_preload_collections:
+ * @hub: this #ofaHub instance.
+ * @progress: [allow-none]: a #myIProgress instance.
+ *
+ * Loads in the background all the collections which are not loaded yet,
+ * so that the first access to them is immediate.
+ *
+ * The collections are those of the #myICollectionable types which are
+ * registered by the core library and by the plugins. They are loaded
+ * concurrently by worker threads on dedicated connections, and are
+ * published to the collector from the main thread.
+ *
+ * The @progress instance, if set, is advertised with the @hub as the
+ * worker: #my_iprogress_start_work() when the preloading starts,
+ * #my_iprogress_pulse() each time a collection is published, and
+ * #my_iprogress_set_ok() when all the workers have ended.
+ *
+ * Closing the dossier cancels the preloading: the collections which
+ * have not been published yet are just released.
+ */
+void
+ofa_hub_preload_collections( ofaHub *hub, myIProgress *progress )
+{
+	static const gchar *thisfn = "ofa_hub_preload_collections";
+	ofaHubPrivate *priv;
+	myICollector *collector;
+	sPreload *preload;
+	sPreloadWorker *worker;
+	GList *objects, *it;
+	GType type;
+	guint i, count;
+
+	g_debug( "%s: hub=%p, progress=%p", thisfn, ( void * ) hub, ( void * ) progress );
+
+	g_return_if_fail( hub && OFA_IS_HUB( hub ));
+	g_return_if_fail( !progress || MY_IS_IPROGRESS( progress ));
+
+	priv = ofa_hub_get_instance_private( hub );
+
+	g_return_if_fail( !priv->dispose_has_run );
+	g_return_if_fail( priv->connect && priv->dossier );
+
+	preload = g_new0( sPreload, 1 );
+	preload->hub = g_object_ref( hub );
+	preload->progress = progress ? g_object_ref( progress ) : NULL;
+	preload->types = g_async_queue_new();
+
+	collector = ofa_igetter_get_collector( OFA_IGETTER( hub ));
+	objects = ofa_igetter_get_for_type( OFA_IGETTER( hub ), MY_TYPE_ICOLLECTIONABLE );
+
+	for( it=objects ; it ; it=it->next ){
+		type = G_OBJECT_TYPE( it->data );
+		if( !my_icollector_collection_get( collector, type, NULL )){
+			g_async_queue_push( preload->types, GSIZE_TO_POINTER( type ));
+			preload->total += 1;
+		}
+	}
+
+	g_list_free( objects );
+
+	if( preload->total == 0 ){
+		preload_free( preload );
+		return;
+	}
+
+	if( !priv->preload_cancellable ){
+		priv->preload_cancellable = g_cancellable_new();
+	}
+	preload->cancellable = g_object_ref( priv->preload_cancellable );
+
+	if( preload->progress ){
+		my_iprogress_start_work( preload->progress, preload->hub, NULL );
+		my_iprogress_pulse( preload->progress, preload->hub, 0, preload->total );
+	}
+
+	count = MIN( preload->total, PRELOAD_MAX_THREADS );
+
+	for( i=0 ; i<count ; ++i ){
+		worker = g_new0( sPreloadWorker, 1 );
+		worker->preload = preload;
+		worker->connect = ofa_idbconnect_duplicate( priv->connect );
+		if( !worker->connect ){
+			g_free( worker );
+			break;
+		}
+		preload->running += 1;
+		worker->thread = g_thread_new( "ofaHubPreload", ( GThreadFunc ) preload_thread, worker );
+	}
+
+	g_debug( "%s: collections=%u, workers=%u", thisfn, preload->total, preload->running );
+
+	/* not even one dedicated connection: just let the collections be
+	 * loaded on demand */
+	if( preload->running == 0 ){
+		if( preload->progress ){
+			my_iprogress_set_ok( preload->progress, preload->hub, NULL, preload->total );
+		}
+		preload_free( preload );
+	}
+}
+
+/*
+ * Worker thread: load collections until the queue is empty
+ */
+static gpointer
+preload_thread( sPreloadWorker *worker )
+{
+	sPreload *preload;
+	sPreloadDone *done;
+	gpointer ptype;
+
+	preload = worker->preload;
+	ofa_idbconnect_thread_init( worker->connect );
+	g_private_set( &st_thread_connect, worker->connect );
+
+	while( !g_cancellable_is_cancelled( preload->cancellable ) &&
+			( ptype = g_async_queue_try_pop( preload->types )) != NULL ){
+
+		done = g_new0( sPreloadDone, 1 );
+		done->preload = preload;
+		done->type = GPOINTER_TO_SIZE( ptype );
+		done->dataset = my_icollectionable_load_collection( done->type, OFA_IGETTER( preload->hub ));
+
+		g_idle_add(( GSourceFunc ) preload_on_loaded, done );
+	}
+
+	g_private_set( &st_thread_connect, NULL );
+	ofa_idbconnect_thread_end( worker->connect );
+	g_idle_add(( GSourceFunc ) preload_on_worker_end, worker );
+
+	return( NULL );
+}
+
+/*
+ * Main thread: publish a loaded collection
+ */
+static gboolean
+preload_on_loaded( sPreloadDone *done )
+{
+	static const gchar *thisfn = "ofa_hub_preload_on_loaded";
+	sPreload *preload;
+
+	preload = done->preload;
+	preload->done += 1;
+
+	g_debug( "%s: type=%s, count=%u",
+			thisfn, g_type_name( done->type ), g_list_length( done->dataset ));
+
+	if( g_cancellable_is_cancelled( preload->cancellable )){
+		g_list_free_full( done->dataset, ( GDestroyNotify ) g_object_unref );
+
+	} else {
+		my_icollector_collection_set(
+				ofa_igetter_get_collector( OFA_IGETTER( preload->hub )), done->type, done->dataset );
+		if( preload->progress ){
+			my_iprogress_pulse( preload->progress, preload->hub, preload->done, preload->total );
+		}
+	}
+
+	g_free( done );
+
+	return( G_SOURCE_REMOVE );
+}
+
+/*
+ * Main thread: a worker has ended
+ * the idle sources being dispatched in order, all the collections
+ * loaded by this worker have already been published
+ */
+static gboolean
+preload_on_worker_end( sPreloadWorker *worker )
+{
+	sPreload *preload;
+
+	preload = worker->preload;
+
+	g_thread_join( worker->thread );
+	g_object_unref( worker->connect );
+	g_free( worker );
+
+	preload->running -= 1;
+
+	if( preload->running == 0 ){
+		if( preload->progress ){
+			my_iprogress_set_ok( preload->progress, preload->hub, NULL, preload->total-preload->done );
+		}
+		preload_free( preload );
+	}
+
+	return( G_SOURCE_REMOVE );
+}
+
+static void
+preload_free( sPreload *preload )
+{
+	g_clear_object( &preload->cancellable );
+	g_clear_object( &preload->progress );
+	g_async_queue_unref( preload->types );
+	g_object_unref( preload->hub );
+	g_free( preload );
+}
+
 /**
  * ofa_hub_get_willing_to_import:
  * @hub: this #ofaHub instance.
@@ -30,7 +30,10 @@
 #include <archive.h>
 #include <archive_entry.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "my/my-date.h"
+#include "my/my-double.h"
 #include "my/my-stamp.h"
 #include "my/my-utils.h"
 
@@ -44,6 +47,51 @@
 #include "api/ofa-idbprovider.h"
 #include "api/ofa-igetter.h"
 
+/* the audit trail writer
+ * audit records are queued by the main thread, and written by a
+ * background thread on its own dedicated connection
+ * all the fields, but @thread and @connect, are protected by @mutex
+ */
+typedef struct {
+	GMutex              mutex;
+	GCond               cond;				/* wakes up the writer */
+	GCond               flushed;			/* wakes up the flush waiters */
+	GThread            *thread;
+	ofaIDBConnect      *connect;
+	GQueue              queue;				/* sAuditRecord's to be written */
+	gsize               queue_size;
+	gint64              queue_time;			/* monotonic time of the first queued record */
+	guint64             pushed;				/* count of queued records */
+	guint64             written;			/* count of written records */
+	guint               failures;			/* count of failed flushes */
+	gchar              *error;				/* last flush error */
+	gboolean            flush_requested;
+	gboolean            stop_requested;
+}
+	sAudit;
+
+/* an audit record
+ * the text of a prepared statement is only built and quoted when the
+ * record is written by the audit writer thread
+ */
+typedef struct {
+	gchar              *stamp;
+	gchar              *quoted;
+	ofsIDBStatement    *stmt;
+	gsize               size;
+}
+	sAuditRecord;
+
+/* the worker thread which runs the asynchronous queries
+ * @queue is a queue of GTask's, each task data being the query
+ */
+typedef struct {
+	GThread            *thread;
+	GAsyncQueue        *queue;
+	ofaIDBConnect      *connect;
+}
+	sWorker;
+
 /* some data attached to each IDBConnect instance
  * we store here the data provided by the application
  * which do not depend of a specific implementation
@@ -62,9 +110,38 @@ typedef struct {
 	 */
 	gchar              *account;
 	gchar              *password;
+
+	/* prepared statements, indexed by their query text
+	 */
+	GHashTable         *statements;
+
+	/* audit trail
+	 * while a transaction is opened, the audit records are kept in
+	 * @audit_pending until the transaction is either committed or
+	 * cancelled
+	 */
+	ofeIDBAuditMode     audit_mode;
+	sAudit             *audit;
+	gboolean            audit_disabled;
+	gboolean            audit_in_transaction;
+	GQueue              audit_pending;
+
+	/* asynchronous queries
+	 */
+	sWorker            *worker;
+	gboolean            worker_disabled;
 }
 	sIDBConnect;
 
+/* a prepared statement
+ * the statement is owned by the connection, and is kept in the cache
+ * of the connection as long as the connection itself lives
+ */
+struct _ofsIDBStatement {
+	gchar              *query;
+	GArray             *params;
+};
+
 enum {
 	CONNECT_WITH_ACCOUNT = 1,
 	CONNECT_WITH_SU
@@ -93,9 +170,18 @@ typedef struct {
 }
 	sRestore;
 
-#define IDBCONNECT_LAST_VERSION            1
+#define IDBCONNECT_LAST_VERSION            2
 #define IDBCONNECT_DATA                   "idbconnect-data"
 
+/* the audit queue is flushed as soon as it holds AUDIT_MAX_COUNT
+ * records or AUDIT_MAX_SIZE bytes, or when its oldest record has been
+ * waiting for AUDIT_MAX_DELAY microseconds; these are also the limits
+ * of a single multi-row INSERT
+ */
+#define AUDIT_MAX_COUNT                   100
+#define AUDIT_MAX_SIZE                    ( 512*1024 )
+#define AUDIT_MAX_DELAY                   ( 500*G_TIME_SPAN_MILLISECOND )
+
 static guint st_initializations         = 0;	/* interface initialization count */
 
 static GType           register_type( void );
@@ -103,8 +189,40 @@ static void            interface_base_init( ofaIDBConnectInterface *klass );
 static void            interface_base_finalize( ofaIDBConnectInterface *klass );
 static gboolean        idbconnect_query( const ofaIDBConnect *connect, const gchar *query, gboolean display_error );
 static void            audit_query( const ofaIDBConnect *connect, const gchar *query );
+static void            audit_statement( const ofaIDBConnect *connect, ofsIDBStatement *stmt );
+static void            audit_enqueue( sIDBConnect *sdata, sAuditRecord *record );
+static void            audit_query_sync( const ofaIDBConnect *connect, const gchar *query );
 static gchar          *quote_query( const gchar *query );
+static sAuditRecord   *audit_record_new( const gchar *query );
+static sAuditRecord   *audit_record_new_statement( ofsIDBStatement *stmt );
+static const gchar    *audit_record_get_quoted( sAuditRecord *record );
+static void            audit_record_free( sAuditRecord *record );
+static gboolean        audit_start( const ofaIDBConnect *connect, sIDBConnect *sdata );
+static void            audit_push( sAudit *audit, GQueue *records );
+static gboolean        audit_flush( sAudit *audit, gboolean wait, gchar **msgerr );
+static gboolean        audit_stop( const ofaIDBConnect *connect, sIDBConnect *sdata, gchar **msgerr );
+static gpointer        audit_thread( sAudit *audit );
+static gboolean        audit_is_due( sAudit *audit );
+static gsize           audit_batch( GQueue *queue, GQueue *batch );
+static gboolean        audit_write( const ofaIDBConnect *connect, GQueue *batch, gchar **msgerr );
+static void            audit_commit( const ofaIDBConnect *connect, gboolean display_error, gchar **msgerr );
+static void            audit_rollback( const ofaIDBConnect *connect );
 static void            error_query( const ofaIDBConnect *connect, const gchar *query );
+static void            free_results( GSList *result );
+static gboolean        worker_start( const ofaIDBConnect *connect, sIDBConnect *sdata );
+static void            worker_stop( sIDBConnect *sdata );
+static gpointer        worker_thread( sWorker *worker );
+static ofaIDBConnect  *new_dedicated_connect( sIDBConnect *sdata );
+static ofsIDBStatement *statement_new( const gchar *query );
+static ofsIDBStatement *statement_copy( const ofsIDBStatement *stmt );
+static void            statement_free( ofsIDBStatement *stmt );
+static void            statement_reset( ofsIDBStatement *stmt );
+static ofsIDBParam    *statement_get_param( ofsIDBStatement *stmt, guint pos );
+static void            param_clear( ofsIDBParam *param );
+static gboolean        statement_execute( const ofaIDBConnect *connect, ofsIDBStatement *stmt, GSList **result, gboolean display_error );
+static gchar          *statement_to_sql( ofsIDBStatement *stmt );
+static gchar          *param_to_sql( const ofsIDBParam *param );
+static gchar          *param_quote_string( const gchar *str );
 static gboolean        backup_create_archive( const ofaIDBConnect *self, GFile *file, sBackup *sope );
 static struct archive *backup_new_archive( const gchar *filename );
 static gboolean        backup_write_headers( const ofaIDBConnect *self, const gchar *comment, sBackup *sope );
@@ -386,12 +504,23 @@ ofa_idbconnect_set_exercice_meta( ofaIDBConnect *connect, ofaIDBExerciceMeta *ex
 {
 	static const gchar *thisfn = "ofa_idbconnect_set_exercice_meta";
 	sIDBConnect *sdata;
+	gchar *msgerr;
 
 	g_return_if_fail( connect && OFA_IS_IDBCONNECT( connect ));
 	g_return_if_fail( !exercice_meta || OFA_IS_IDBEXERCICE_META( exercice_meta ));
 
 	sdata = get_instance_data( connect );
 
+	/* the audit writer and the worker are attached to the previous period */
+	msgerr = NULL;
+	if( !audit_stop( connect, sdata, &msgerr )){
+		my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, msgerr );
+		g_free( msgerr );
+	}
+	sdata->audit_disabled = FALSE;
+	worker_stop( sdata );
+	sdata->worker_disabled = FALSE;
+
 	g_clear_object( &sdata->exercice_meta );
 	if( exercice_meta ){
 		sdata->exercice_meta = g_object_ref(( gpointer ) exercice_meta );
@@ -496,6 +625,36 @@ ofa_idbconnect_is_opened( const ofaIDBConnect *connect )
 	return( FALSE );
 }
 
+/**
+ * ofa_idbconnect_duplicate:
+ * @connect: this #ofaIDBConnect instance.
+ *
+ * Opens a new connection on the same dossier and period, with the same
+ * account than @connect.
+ *
+ * Such a connection may be used from another thread than the main one,
+ * e.g. to run several read-only queries concurrently.
+ *
+ * Returns: a new opened #ofaIDBConnect, which should be g_object_unref()
+ * by the caller, or %NULL if the connection cannot be opened.
+ */
+ofaIDBConnect *
+ofa_idbconnect_duplicate( const ofaIDBConnect *connect )
+{
+	static const gchar *thisfn = "ofa_idbconnect_duplicate";
+	sIDBConnect *sdata;
+	ofaIDBConnect *dup;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), NULL );
+
+	sdata = get_instance_data( connect );
+	dup = new_dedicated_connect( sdata );
+
+	g_debug( "%s: connect=%p, dup=%p", thisfn, ( void * ) connect, ( void * ) dup );
+
+	return( dup );
+}
+
 /**
  * ofa_idbconnect_get_display:
  * @connect: this #ofaIDBConnect instance.
@@ -619,213 +778,1519 @@ ofa_idbconnect_query_ex( const ofaIDBConnect *connect, const gchar *query, GSLis
 	g_return_val_if_fail( my_strlen( query ), FALSE );
 	g_return_val_if_fail( result, FALSE );
 
-	ok = FALSE;
+	ok = FALSE;
+
+	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->query_ex ){
+		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->query_ex( connect, query, result );
+		if( !ok && display_error ){
+			error_query( connect, query );
+		}
+
+	} else {
+		str = g_strdup_printf(
+					_( "ofaIDBConnect's %s implementation does not provide 'query_ex()' method" ),
+					G_OBJECT_TYPE_NAME( connect ));
+
+		if( display_error ){
+			my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, str );
+		} else {
+			g_info( "%s: %s", thisfn, str );
+		}
+
+		g_free( str );
+	}
+
+	return( ok );
+}
+
+/**
+ * ofa_idbconnect_query_async:
+ * @connect: this #ofaIDBConnect instance.
+ * @query: the select query to be executed.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the result is
+ *  available.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously execute a select @query.
+ *
+ * The query is run by the worker thread of the @connect, on its own
+ * dedicated connection, so that the caller is not blocked while the
+ * DBMS server works. The @callback is then called from the thread
+ * default main context of the caller, and should call
+ * #ofa_idbconnect_query_finish() to get the result set.
+ *
+ * The queries are run in the order of their submission. A cancelled
+ * query is not run if it has not started yet; else, its result is
+ * just discarded.
+ */
+void
+ofa_idbconnect_query_async( const ofaIDBConnect *connect, const gchar *query,
+								GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	static const gchar *thisfn = "ofa_idbconnect_query_async";
+	sIDBConnect *sdata;
+	GTask *task;
+	GSList *result;
+	gchar *msgerr;
+
+	g_debug( "%s: connect=%p, query='%s', cancellable=%p",
+			thisfn, ( void * ) connect, query, ( void * ) cancellable );
+
+	g_return_if_fail( connect && OFA_IS_IDBCONNECT( connect ));
+	g_return_if_fail( my_strlen( query ));
+
+	task = g_task_new(( gpointer ) connect, cancellable, callback, user_data );
+	g_task_set_task_data( task, g_strdup( query ), ( GDestroyNotify ) g_free );
+
+	sdata = get_instance_data( connect );
+
+	if( worker_start( connect, sdata )){
+		g_async_queue_push( sdata->worker->queue, task );
+
+	} else {
+		/* no dedicated connection: run the query synchronously
+		 * the callback is nonetheless called from the main loop */
+		if( !g_task_return_error_if_cancelled( task )){
+			result = NULL;
+			if( ofa_idbconnect_query_ex( connect, query, &result, FALSE )){
+				g_task_return_pointer( task, result, ( GDestroyNotify ) free_results );
+			} else {
+				msgerr = ofa_idbconnect_get_last_error( connect );
+				g_task_return_new_error( task, G_IO_ERROR, G_IO_ERROR_FAILED, "%s", msgerr ? msgerr : query );
+				g_free( msgerr );
+			}
+		}
+		g_object_unref( task );
+	}
+}
+
+/**
+ * ofa_idbconnect_query_finish:
+ * @connect: this #ofaIDBConnect instance.
+ * @result: the #GAsyncResult passed to the callback.
+ * @rows: [out]: the result set as a GSList of ordered rows.
+ * @error: [allow-none]: a placeholder for a #GError.
+ *
+ * Finishes an asynchronous query started with
+ * #ofa_idbconnect_query_async().
+ *
+ * The result set has the same layout than those of
+ * #ofa_idbconnect_query_ex(), and should be freed with
+ * #ofa_idbconnect_free_results().
+ *
+ * Returns: %TRUE if the query has been successfully executed,
+ * %FALSE if it has failed or has been cancelled.
+ */
+gboolean
+ofa_idbconnect_query_finish( const ofaIDBConnect *connect, GAsyncResult *result, GSList **rows, GError **error )
+{
+	GError *local_error;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( g_task_is_valid( result, ( gpointer ) connect ), FALSE );
+	g_return_val_if_fail( rows, FALSE );
+
+	local_error = NULL;
+	*rows = g_task_propagate_pointer( G_TASK( result ), &local_error );
+
+	if( local_error ){
+		g_propagate_error( error, local_error );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+static void
+free_results( GSList *result )
+{
+	ofa_idbconnect_free_results( result );
+}
+
+/*
+ * Start the worker thread on its dedicated connection, if not already
+ * done.
+ *
+ * Returns: %TRUE if the worker is available, %FALSE if the queries
+ * have to be run synchronously.
+ */
+static gboolean
+worker_start( const ofaIDBConnect *connect, sIDBConnect *sdata )
+{
+	static const gchar *thisfn = "ofa_idbconnect_worker_start";
+	ofaIDBConnect *dedicated;
+	sWorker *worker;
+
+	if( sdata->worker ){
+		return( TRUE );
+	}
+	if( sdata->worker_disabled ){
+		return( FALSE );
+	}
+
+	dedicated = new_dedicated_connect( sdata );
+
+	if( !dedicated ){
+		g_info( "%s: connect=%p: unable to open the worker connection, falling back to synchronous queries",
+				thisfn, ( void * ) connect );
+		sdata->worker_disabled = TRUE;
+		return( FALSE );
+	}
+
+	worker = g_new0( sWorker, 1 );
+	worker->connect = dedicated;
+	worker->queue = g_async_queue_new();
+	worker->thread = g_thread_new( "ofa-worker", ( GThreadFunc ) worker_thread, worker );
+
+	sdata->worker = worker;
+
+	g_debug( "%s: connect=%p, worker=%p, dedicated=%p",
+			thisfn, ( void * ) connect, ( void * ) worker, ( void * ) dedicated );
+
+	return( TRUE );
+}
+
+/*
+ * Stop the worker thread after it has run all the already queued
+ * queries, and close its connection.
+ */
+static void
+worker_stop( sIDBConnect *sdata )
+{
+	sWorker *worker;
+
+	worker = sdata->worker;
+
+	if( !worker ){
+		return;
+	}
+
+	/* the worker itself is used as the end-of-queue sentinel */
+	g_async_queue_push( worker->queue, worker );
+	g_thread_join( worker->thread );
+
+	g_async_queue_unref( worker->queue );
+	g_clear_object( &worker->connect );
+	g_free( worker );
+
+	sdata->worker = NULL;
+}
+
+/*
+ * The worker thread.
+ *
+ * Run the queued queries on the dedicated connection, returning each
+ * result set (or error) to its #GTask.
+ */
+static gpointer
+worker_thread( sWorker *worker )
+{
+	GTask *task;
+	const gchar *query;
+	GSList *result;
+	gchar *msgerr;
+
+	ofa_idbconnect_thread_init( worker->connect );
+
+	while(( task = g_async_queue_pop( worker->queue )) != ( gpointer ) worker ){
+
+		if( !g_task_return_error_if_cancelled( task )){
+			query = ( const gchar * ) g_task_get_task_data( task );
+			result = NULL;
+
+			if( ofa_idbconnect_query_ex( worker->connect, query, &result, FALSE )){
+				g_task_return_pointer( task, result, ( GDestroyNotify ) free_results );
+
+			} else {
+				msgerr = ofa_idbconnect_get_last_error( worker->connect );
+				g_task_return_new_error( task, G_IO_ERROR, G_IO_ERROR_FAILED, "%s", msgerr ? msgerr : query );
+				g_free( msgerr );
+			}
+		}
+
+		g_object_unref( task );
+	}
+
+	ofa_idbconnect_thread_end( worker->connect );
+
+	return( NULL );
+}
+
+/*
+ * Open a new connection on the same dossier and period, with the same
+ * account than this one.
+ *
+ * Returns: the new opened connection, or %NULL.
+ */
+static ofaIDBConnect *
+new_dedicated_connect( sIDBConnect *sdata )
+{
+	ofaIDBConnect *dedicated;
+
+	if( !sdata->dossier_meta || !sdata->exercice_meta || !my_strlen( sdata->account )){
+		return( NULL );
+	}
+
+	dedicated = ofa_idbdossier_meta_new_connect( sdata->dossier_meta, sdata->exercice_meta );
+
+	if( dedicated && !ofa_idbconnect_open_with_account( dedicated, sdata->account, sdata->password )){
+		g_clear_object( &dedicated );
+	}
+
+	return( dedicated );
+}
+
+/**
+ * ofa_idbconnect_query_int:
+ * @connect: this #ofaIDBConnect instance.
+ * @query: the query to be executed
+ * @result: [out]: the returned integer value
+ * @display_error: whether the error should be published in a dialog box
+ *
+ * A simple query for getting a single int.
+ *
+ * Returns: %TRUE if the sentence has been successfully executed,
+ * %FALSE else.
+ */
+gboolean
+ofa_idbconnect_query_int( const ofaIDBConnect *connect, const gchar *query, gint *result, gboolean display_error )
+{
+	gboolean ok;
+	GSList *reslist, *icol;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( my_strlen( query ), FALSE );
+	g_return_val_if_fail( result, FALSE );
+
+	*result = 0;
+	ok = ofa_idbconnect_query_ex( connect, query, &reslist, display_error );
+
+	if( ok ){
+		icol = ( GSList * ) reslist->data;
+		if( icol && icol->data ){
+			*result = atoi(( gchar * ) icol->data );
+		}
+		ofa_idbconnect_free_results( reslist );
+	}
+
+	return( ok );
+}
+
+/**
+ * ofa_idbconnect_has_table:
+ * @connect: this #ofaIDBConnect instance.
+ * @table: the name of the searched table.
+ *
+ * Returns: %TRUE if the specified @table exists, %FALSE else.
+ */
+gboolean
+ofa_idbconnect_has_table( const ofaIDBConnect *connect, const gchar *table )
+{
+	gboolean ok, found;
+	gchar *query;
+	GSList *result, *icol;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+
+	query = g_strdup_printf( "SHOW TABLES LIKE '%s'", table );
+	result = NULL;
+	found = FALSE;
+
+	ok = ofa_idbconnect_query_ex( connect, query, &result, FALSE );
+	if( ok ){
+		if( result ){
+			icol = ( GSList * ) result->data;
+			if( icol && icol->data ){
+				found = TRUE;
+			}
+			ofa_idbconnect_free_results( result );
+		}
+	}
+	g_free( query );
+
+	return( found );
+}
+
+/**
+ * ofa_idbconnect_table_backup:
+ * @connect: this #ofaIDBConnect instance.
+ * @table: the name of the table to be saved.
+ *
+ * Backup the @table table.
+ *
+ * Returns: the name of the backup table, as a newly allocated string
+ * which should be g_free() by the caller.
+ */
+gchar *
+ofa_idbconnect_table_backup( const ofaIDBConnect *connect, const gchar *table )
+{
+	gchar *output, *query;
+	gboolean ok;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), NULL );
+	g_return_val_if_fail( my_strlen( table ), NULL );
+
+	output = g_strdup_printf( "BACKUP_%s", table );
+	ok = TRUE;
+
+	if( ok ){
+		query = g_strdup_printf( "DROP TABLE IF EXISTS %s", output );
+		ok = ofa_idbconnect_query( connect, query, FALSE );
+		g_free( query );
+	}
+	if( ok ){
+		query = g_strdup_printf( "CREATE TABLE %s SELECT * FROM %s ", output, table );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
+	}
+	if( !ok ){
+		g_free( output );
+		output = NULL;
+	}
+
+	return( output );
+}
+
+/**
+ * ofa_idbconnect_table_restore:
+ * @connect: this #ofaIDBConnect instance.
+ * @table_src: the source of the restoration.
+ * @table_dest: the target of the restoration.
+ *
+ * Restore @table_src to @table_dest.
+ *
+ * Returns: %TRUE if successful.
+ */
+gboolean
+ofa_idbconnect_table_restore( const ofaIDBConnect *connect, const gchar *table_src, const gchar *table_dest )
+{
+	gboolean ok;
+	gchar *query;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( my_strlen( table_src ), FALSE );
+	g_return_val_if_fail( my_strlen( table_dest ), FALSE );
+
+	ok = TRUE;
+
+	if( ok ){
+		query = g_strdup_printf( "DROP TABLE IF EXISTS %s", table_dest );
+		ok = ofa_idbconnect_query( connect, query, FALSE );
+		g_free( query );
+	}
+	if( ok ){
+		query = g_strdup_printf( "CREATE TABLE %s SELECT * FROM %s ", table_dest, table_src );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
+	}
+
+	return( ok );
+}
+
+/**
+ * ofa_idbconnect_prepare:
+ * @connect: this #ofaIDBConnect instance.
+ * @query: the SQL statement, with a '?' placeholder for each parameter.
+ *
+ * Returns: a prepared statement for the @query text.
+ *
+ * The returned statement is owned by the @connect connection, which
+ * keeps it cached for the subsequent calls with the same @query text.
+ * It should not be released by the caller.
+ *
+ * All the parameters previously bound to the statement are cleared.
+ */
+ofsIDBStatement *
+ofa_idbconnect_prepare( const ofaIDBConnect *connect, const gchar *query )
+{
+	sIDBConnect *sdata;
+	ofsIDBStatement *stmt;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), NULL );
+	g_return_val_if_fail( my_strlen( query ), NULL );
+
+	sdata = get_instance_data( connect );
+
+	if( !sdata->statements ){
+		sdata->statements = g_hash_table_new_full(
+				g_str_hash, g_str_equal, NULL, ( GDestroyNotify ) statement_free );
+	}
+
+	stmt = ( ofsIDBStatement * ) g_hash_table_lookup( sdata->statements, query );
+
+	if( stmt ){
+		statement_reset( stmt );
+	} else {
+		stmt = statement_new( query );
+		g_hash_table_insert( sdata->statements, stmt->query, stmt );
+	}
+
+	return( stmt );
+}
+
+/**
+ * ofa_idbconnect_bind_null:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ *
+ * Binds a SQL NULL value at @pos position.
+ */
+void
+ofa_idbconnect_bind_null( ofsIDBStatement *stmt, guint pos )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+	param->type = OFA_IDBPARAM_NULL;
+}
+
+/**
+ * ofa_idbconnect_bind_string:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ * @value: [allow-none]: the string value.
+ *
+ * Binds the @value string at @pos position.
+ *
+ * A %NULL or empty @value is bound as a SQL NULL value.
+ */
+void
+ofa_idbconnect_bind_string( ofsIDBStatement *stmt, guint pos, const gchar *value )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+
+	if( my_strlen( value )){
+		param->type = OFA_IDBPARAM_STRING;
+		param->string = g_strdup( value );
+	} else {
+		param->type = OFA_IDBPARAM_NULL;
+	}
+}
+
+/**
+ * ofa_idbconnect_bind_int:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ * @value: the integer value.
+ *
+ * Binds the @value integer at @pos position.
+ */
+void
+ofa_idbconnect_bind_int( ofsIDBStatement *stmt, guint pos, gint64 value )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+	param->type = OFA_IDBPARAM_INTEGER;
+	param->integer = value;
+}
+
+/**
+ * ofa_idbconnect_bind_amount:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ * @value: the amount value.
+ * @digits: the count of decimal digits to be kept.
+ *
+ * Binds the @value amount at @pos position, rounded to @digits
+ * decimal digits.
+ */
+void
+ofa_idbconnect_bind_amount( ofsIDBStatement *stmt, guint pos, gdouble value, guint digits )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+	param->type = OFA_IDBPARAM_AMOUNT;
+	param->amount = my_double_round_to_decimals( value, digits );
+	param->digits = digits;
+}
+
+/**
+ * ofa_idbconnect_bind_date:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ * @value: [allow-none]: the date value.
+ *
+ * Binds the @value date at @pos position.
+ *
+ * A %NULL or invalid @value is bound as a SQL NULL value.
+ */
+void
+ofa_idbconnect_bind_date( ofsIDBStatement *stmt, guint pos, const GDate *value )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+
+	if( my_date_is_valid( value )){
+		param->type = OFA_IDBPARAM_DATE;
+		my_date_set_from_date( &param->date, value );
+	} else {
+		param->type = OFA_IDBPARAM_NULL;
+	}
+}
+
+/**
+ * ofa_idbconnect_bind_stamp:
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @pos: the zero-based index of the placeholder.
+ * @value: [allow-none]: the timestamp value.
+ *
+ * Binds the @value timestamp at @pos position.
+ *
+ * A %NULL @value is bound as a SQL NULL value.
+ */
+void
+ofa_idbconnect_bind_stamp( ofsIDBStatement *stmt, guint pos, const myStampVal *value )
+{
+	ofsIDBParam *param;
+
+	g_return_if_fail( stmt );
+
+	param = statement_get_param( stmt, pos );
+
+	if( value ){
+		param->type = OFA_IDBPARAM_STAMP;
+		param->stamp = g_date_time_new_from_unix_local( my_stamp_get_seconds( value ));
+	} else {
+		param->type = OFA_IDBPARAM_NULL;
+	}
+}
+
+/**
+ * ofa_idbconnect_execute:
+ * @connect: this #ofaIDBConnect instance.
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @display_error: whether the error should be published in a dialog box.
+ *
+ * Execute a modification prepared statement.
+ *
+ * The statement is audited as if it had been executed through
+ * #ofa_idbconnect_query(). Its text is only built when the audit
+ * record is written, unless the audit trail is synchronous.
+ *
+ * Returns: %TRUE if the statement has been successfully executed,
+ * %FALSE else.
+ */
+gboolean
+ofa_idbconnect_execute( const ofaIDBConnect *connect, ofsIDBStatement *stmt, gboolean display_error )
+{
+	gboolean ok;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( stmt, FALSE );
+
+	ok = statement_execute( connect, stmt, NULL, display_error );
+	if( ok ){
+		audit_statement( connect, stmt );
+	}
+
+	return( ok );
+}
+
+/**
+ * ofa_idbconnect_execute_ex:
+ * @connect: this #ofaIDBConnect instance.
+ * @stmt: a #ofsIDBStatement prepared statement.
+ * @result: [out]: the result set as a GSList of ordered rows.
+ * @display_error: whether the error should be published in a dialog box.
+ *
+ * Execute a select prepared statement.
+ *
+ * The result set has the same layout than those of
+ * #ofa_idbconnect_query_ex(), and should be freed with
+ * #ofa_idbconnect_free_results().
+ *
+ * Returns: %TRUE if the statement has been successfully executed,
+ * %FALSE else.
+ */
+gboolean
+ofa_idbconnect_execute_ex( const ofaIDBConnect *connect, ofsIDBStatement *stmt, GSList **result, gboolean display_error )
+{
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( stmt, FALSE );
+	g_return_val_if_fail( result, FALSE );
+
+	return( statement_execute( connect, stmt, result, display_error ));
+}
+
+static ofsIDBStatement *
+statement_new( const gchar *query )
+{
+	ofsIDBStatement *stmt;
+
+	stmt = g_new0( ofsIDBStatement, 1 );
+	stmt->query = g_strdup( query );
+	stmt->params = g_array_new( FALSE, TRUE, sizeof( ofsIDBParam ));
+
+	return( stmt );
+}
+
+/*
+ * Returns: a deep copy of @stmt, which may be used from another thread.
+ */
+static ofsIDBStatement *
+statement_copy( const ofsIDBStatement *stmt )
+{
+	ofsIDBStatement *copy;
+	ofsIDBParam *param;
+	guint i;
+
+	copy = statement_new( stmt->query );
+	g_array_append_vals( copy->params, stmt->params->data, stmt->params->len );
+
+	for( i=0 ; i<copy->params->len ; ++i ){
+		param = &g_array_index( copy->params, ofsIDBParam, i );
+		param->string = g_strdup( param->string );
+		if( param->stamp ){
+			g_date_time_ref( param->stamp );
+		}
+	}
+
+	return( copy );
+}
+
+static void
+statement_free( ofsIDBStatement *stmt )
+{
+	statement_reset( stmt );
+	g_array_free( stmt->params, TRUE );
+	g_free( stmt->query );
+	g_free( stmt );
+}
+
+static void
+statement_reset( ofsIDBStatement *stmt )
+{
+	guint i;
+
+	for( i=0 ; i<stmt->params->len ; ++i ){
+		param_clear( &g_array_index( stmt->params, ofsIDBParam, i ));
+	}
+	g_array_set_size( stmt->params, 0 );
+}
+
+/*
+ * returns the parameter at @pos position, after having cleared it
+ */
+static ofsIDBParam *
+statement_get_param( ofsIDBStatement *stmt, guint pos )
+{
+	ofsIDBParam *param;
+
+	if( pos >= stmt->params->len ){
+		g_array_set_size( stmt->params, pos+1 );
+	}
+
+	param = &g_array_index( stmt->params, ofsIDBParam, pos );
+	param_clear( param );
+
+	return( param );
+}
+
+static void
+param_clear( ofsIDBParam *param )
+{
+	g_free( param->string );
+	if( param->stamp ){
+		g_date_time_unref( param->stamp );
+	}
+	memset( param, '\0', sizeof( ofsIDBParam ));
+}
+
+/*
+ * Execute a prepared statement, falling back to a plain text query if
+ * the DBMS provider does not know how to do that.
+ * May display an error message
+ */
+static gboolean
+statement_execute( const ofaIDBConnect *connect, ofsIDBStatement *stmt, GSList **result, gboolean display_error )
+{
+	static const gchar *thisfn = "ofa_idbconnect_execute";
+	gboolean ok;
+	gchar *query;
+
+	if( result ){
+		*result = NULL;
+	}
+
+	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->execute ){
+		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->execute(
+					connect, stmt->query, ( const ofsIDBParam * ) stmt->params->data, stmt->params->len, result );
+		if( !ok ){
+			query = statement_to_sql( stmt );
+			g_debug( "%s: connect=%p, query='%s'", thisfn, ( void * ) connect, query );
+			if( display_error ){
+				error_query( connect, query );
+			}
+			g_free( query );
+		}
+
+	} else {
+		query = statement_to_sql( stmt );
+		if( result ){
+			ok = ofa_idbconnect_query_ex( connect, query, result, display_error );
+		} else {
+			ok = idbconnect_query( connect, query, display_error );
+		}
+		g_free( query );
+	}
+
+	return( ok );
+}
+
+/*
+ * Returns: the text of the statement, where the placeholders have been
+ * replaced with the bound parameters, as a newly allocated string which
+ * should be g_free() by the caller.
+ *
+ * Placeholders inside of quoted strings are left unchanged.
+ *
+ * This does not use any shared data, so that it may be called from the
+ * audit writer thread.
+ */
+static gchar *
+statement_to_sql( ofsIDBStatement *stmt )
+{
+	GString *sql;
+	const gchar *p;
+	gboolean quoted;
+	guint pos;
+	gchar *str;
+
+	sql = g_string_sized_new( strlen( stmt->query )+16*stmt->params->len );
+	quoted = FALSE;
+	pos = 0;
+
+	for( p=stmt->query ; *p ; ++p ){
+		if( *p == '\\' && quoted && p[1] ){
+			sql = g_string_append_c( sql, *p );
+			p += 1;
+		} else if( *p == '\'' ){
+			quoted = !quoted;
+		} else if( *p == '?' && !quoted ){
+			str = pos < stmt->params->len ?
+					param_to_sql( &g_array_index( stmt->params, ofsIDBParam, pos )) : g_strdup( "NULL" );
+			sql = g_string_append( sql, str );
+			g_free( str );
+			pos += 1;
+			continue;
+		}
+		sql = g_string_append_c( sql, *p );
+	}
+
+	return( g_string_free( sql, FALSE ));
+}
+
+static gchar *
+param_to_sql( const ofsIDBParam *param )
+{
+	gchar *str, *quoted;
+
+	switch( param->type ){
+		case OFA_IDBPARAM_STRING:
+			str = param_quote_string( param->string );
+			break;
+
+		case OFA_IDBPARAM_INTEGER:
+			str = g_strdup_printf( "%" G_GINT64_FORMAT, param->integer );
+			break;
+
+		case OFA_IDBPARAM_AMOUNT:
+			str = my_double_to_sql_ex( param->amount, param->digits );
+			break;
+
+		case OFA_IDBPARAM_DATE:
+			quoted = my_date_to_str( &param->date, MY_DATE_SQL );
+			str = g_strdup_printf( "'%s'", quoted );
+			g_free( quoted );
+			break;
+
+		case OFA_IDBPARAM_STAMP:
+			str = g_date_time_format( param->stamp, "'%Y-%m-%d %H:%M:%S'" );
+			break;
+
+		default:
+			str = g_strdup( "NULL" );
+			break;
+	}
+
+	return( str );
+}
+
+/*
+ * Returns: the string between single quotes, the backslashes being
+ * doubled and the quotes being backslashed, as my_utils_quote_sql()
+ * does, but in a single pass and without shared data.
+ */
+static gchar *
+param_quote_string( const gchar *str )
+{
+	GString *quoted;
+	const gchar *p;
+
+	quoted = g_string_sized_new( my_strlen( str )+8 );
+	g_string_append_c( quoted, '\'' );
+
+	for( p=str ; p && *p ; ++p ){
+		if( *p == '\\' || *p == '\'' ){
+			g_string_append_c( quoted, '\\' );
+		}
+		g_string_append_c( quoted, *p );
+	}
+
+	g_string_append_c( quoted, '\'' );
+
+	return( g_string_free( quoted, FALSE ));
+}
+
+/*
+ * Audit a successfully executed query.
+ *
+ * Unless the connection is configured for a synchronous audit trail,
+ * the audit record is only queued here, and will be written later by
+ * the audit writer thread. Records which are emitted inside of a
+ * transaction are only queued on commit.
+ */
+static void
+audit_query( const ofaIDBConnect *connect, const gchar *query )
+{
+	sIDBConnect *sdata;
+
+	sdata = get_instance_data( connect );
+
+	if( sdata->audit_mode != OFA_IDBAUDIT_SYNC && audit_start( connect, sdata )){
+		audit_enqueue( sdata, audit_record_new( query ));
+	} else {
+		audit_query_sync( connect, query );
+	}
+}
+
+/*
+ * Audit a successfully executed prepared statement.
+ *
+ * The queued record keeps a copy of the statement and of its bound
+ * parameters: the SQL text is built by the audit writer thread.
+ */
+static void
+audit_statement( const ofaIDBConnect *connect, ofsIDBStatement *stmt )
+{
+	sIDBConnect *sdata;
+	gchar *query;
+
+	sdata = get_instance_data( connect );
+
+	if( sdata->audit_mode != OFA_IDBAUDIT_SYNC && audit_start( connect, sdata )){
+		audit_enqueue( sdata, audit_record_new_statement( stmt ));
+	} else {
+		query = statement_to_sql( stmt );
+		audit_query_sync( connect, query );
+		g_free( query );
+	}
+}
+
+/*
+ * Records which are emitted inside of a transaction are kept until
+ * the transaction is committed.
+ */
+static void
+audit_enqueue( sIDBConnect *sdata, sAuditRecord *record )
+{
+	GQueue records = G_QUEUE_INIT;
+
+	if( sdata->audit_in_transaction ){
+		g_queue_push_tail( &sdata->audit_pending, record );
+	} else {
+		g_queue_push_tail( &records, record );
+		audit_push( sdata->audit, &records );
+	}
+}
+
+static void
+audit_query_sync( const ofaIDBConnect *connect, const gchar *query )
+{
+	gchar *quoted;
+	gchar *audit;
+
+	quoted = quote_query( query );
+	audit = g_strdup_printf( "INSERT INTO OFA_T_AUDIT (AUD_QUERY) VALUES ('%s')", quoted );
+
+	idbconnect_query( connect, audit, FALSE );
+
+	g_free( quoted );
+	g_free( audit );
+}
+
+/*
+ * Remove the backslashes and quote the single quotes of the query, so
+ * that it can be itself inserted as a SQL string.
+ *
+ * This is a single pass on the string, and does not use any shared
+ * data, so that it may be called from any thread.
+ */
+static gchar *
+quote_query( const gchar *query )
+{
+	GString *quoted;
+	const gchar *p;
+
+	quoted = g_string_sized_new( strlen( query )+16 );
+
+	for( p=query ; *p ; ++p ){
+		if( *p == '\\' ){
+			continue;
+		}
+		if( *p == '\'' ){
+			g_string_append_c( quoted, '\\' );
+		}
+		g_string_append_c( quoted, *p );
+	}
+
+	return( g_string_free( quoted, FALSE ));
+}
+
+static sAuditRecord *
+audit_record_new( const gchar *query )
+{
+	sAuditRecord *record;
+	myStampVal *stamp;
+
+	record = g_new0( sAuditRecord, 1 );
+
+	stamp = my_stamp_new_now();
+	record->stamp = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
+	my_stamp_free( stamp );
+
+	record->quoted = quote_query( query );
+	record->size = strlen( record->quoted )+strlen( record->stamp )+8;
+
+	return( record );
+}
+
+/*
+ * The size of the record is only estimated, as the text of the
+ * statement is not built yet.
+ */
+static sAuditRecord *
+audit_record_new_statement( ofsIDBStatement *stmt )
+{
+	sAuditRecord *record;
+	myStampVal *stamp;
+
+	record = g_new0( sAuditRecord, 1 );
+
+	stamp = my_stamp_new_now();
+	record->stamp = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
+	my_stamp_free( stamp );
+
+	record->stmt = statement_copy( stmt );
+	record->size = strlen( stmt->query )+16*stmt->params->len+strlen( record->stamp )+8;
+
+	return( record );
+}
+
+/*
+ * Returns: the quoted text of the record, building it from the
+ * statement the first time.
+ */
+static const gchar *
+audit_record_get_quoted( sAuditRecord *record )
+{
+	gchar *query;
+
+	if( !record->quoted && record->stmt ){
+		query = statement_to_sql( record->stmt );
+		record->quoted = quote_query( query );
+		g_free( query );
+	}
+
+	return( record->quoted );
+}
+
+static void
+audit_record_free( sAuditRecord *record )
+{
+	g_free( record->stamp );
+	g_free( record->quoted );
+	if( record->stmt ){
+		statement_free( record->stmt );
+	}
+	g_free( record );
+}
+
+/*
+ * Start the audit writer thread on its dedicated connection, if not
+ * already done.
+ *
+ * Returns: %TRUE if the writer is available, %FALSE if the audit trail
+ * has to be written synchronously (e.g. for a server-level connection).
+ */
+static gboolean
+audit_start( const ofaIDBConnect *connect, sIDBConnect *sdata )
+{
+	static const gchar *thisfn = "ofa_idbconnect_audit_start";
+	ofaIDBConnect *writer;
+	sAudit *audit;
+
+	if( sdata->audit ){
+		return( TRUE );
+	}
+	if( sdata->audit_disabled ){
+		return( FALSE );
+	}
+
+	writer = new_dedicated_connect( sdata );
+
+	if( !writer ){
+		g_info( "%s: connect=%p: unable to open the audit connection, falling back to synchronous audit",
+				thisfn, ( void * ) connect );
+		sdata->audit_disabled = TRUE;
+		return( FALSE );
+	}
+
+	audit = g_new0( sAudit, 1 );
+	g_mutex_init( &audit->mutex );
+	g_cond_init( &audit->cond );
+	g_cond_init( &audit->flushed );
+	g_queue_init( &audit->queue );
+	audit->connect = writer;
+	audit->thread = g_thread_new( "ofa-audit", ( GThreadFunc ) audit_thread, audit );
+
+	sdata->audit = audit;
+
+	g_debug( "%s: connect=%p, audit=%p, writer=%p",
+			thisfn, ( void * ) connect, ( void * ) audit, ( void * ) writer );
+
+	return( TRUE );
+}
+
+/*
+ * Move the @records to the audit queue.
+ */
+static void
+audit_push( sAudit *audit, GQueue *records )
+{
+	sAuditRecord *record;
+
+	if( g_queue_is_empty( records )){
+		return;
+	}
+
+	g_mutex_lock( &audit->mutex );
+
+	if( g_queue_is_empty( &audit->queue )){
+		audit->queue_time = g_get_monotonic_time();
+	}
+	while(( record = g_queue_pop_head( records )) != NULL ){
+		g_queue_push_tail( &audit->queue, record );
+		audit->queue_size += record->size;
+		audit->pushed += 1;
+	}
+
+	g_cond_signal( &audit->cond );
+	g_mutex_unlock( &audit->mutex );
+}
+
+/*
+ * Request the writer to flush the audit queue.
+ * If @wait is %TRUE, then wait for all the currently queued records
+ * to have been written, or for the flush to have failed.
+ *
+ * Returns: %TRUE if the queue has been successfully flushed (or if we
+ * do not wait for it).
+ */
+static gboolean
+audit_flush( sAudit *audit, gboolean wait, gchar **msgerr )
+{
+	guint64 target;
+	guint failures;
+	gboolean ok;
+
+	ok = TRUE;
+
+	g_mutex_lock( &audit->mutex );
+
+	target = audit->pushed;
+	failures = audit->failures;
+	audit->flush_requested = TRUE;
+	g_cond_signal( &audit->cond );
+
+	if( wait ){
+		while( audit->written < target && audit->failures == failures && audit->thread ){
+			g_cond_wait( &audit->flushed, &audit->mutex );
+		}
+		ok = ( audit->written >= target );
+		if( !ok && msgerr ){
+			*msgerr = g_strdup_printf(
+					_( "Unable to write the audit trail: %s" ),
+					audit->error ? audit->error : _( "writer is not running" ));
+		}
+	}
+
+	g_mutex_unlock( &audit->mutex );
+
+	return( ok );
+}
+
+/*
+ * Flush the audit queue, stop the writer thread and close its
+ * connection.
+ *
+ * The records the writer has not been able to write are written on
+ * the @connect main connection, when it is available (it is %NULL when
+ * the instance is being finalized).
+ *
+ * Returns: %TRUE if all the audit records have been written, %FALSE
+ * else, @msgerr being then set.
+ */
+static gboolean
+audit_stop( const ofaIDBConnect *connect, sIDBConnect *sdata, gchar **msgerr )
+{
+	static const gchar *thisfn = "ofa_idbconnect_audit_stop";
+	sAudit *audit;
+	GThread *thread;
+	GQueue batch = G_QUEUE_INIT;
+	sAuditRecord *record;
+	gboolean ok;
+	gchar *error;
+
+	audit = sdata->audit;
+
+	if( !audit ){
+		return( TRUE );
+	}
+
+	g_mutex_lock( &audit->mutex );
+	audit->stop_requested = TRUE;
+	g_cond_signal( &audit->cond );
+	thread = audit->thread;
+	g_mutex_unlock( &audit->mutex );
+
+	g_thread_join( thread );
+
+	g_mutex_lock( &audit->mutex );
+	audit->thread = NULL;
+	g_cond_broadcast( &audit->flushed );
+	g_mutex_unlock( &audit->mutex );
+
+	ok = TRUE;
+	error = NULL;
+
+	while( connect && !g_queue_is_empty( &audit->queue )){
+		audit_batch( &audit->queue, &batch );
+		ok = audit_write( connect, &batch, &error );
+		if( !ok ){
+			while(( record = g_queue_pop_tail( &batch )) != NULL ){
+				g_queue_push_head( &audit->queue, record );
+			}
+			break;
+		}
+		while(( record = g_queue_pop_head( &batch )) != NULL ){
+			audit_record_free( record );
+		}
+	}
+
+	if( !g_queue_is_empty( &audit->queue )){
+		ok = FALSE;
+		if( !error ){
+			error = g_strdup( audit->error );
+		}
+		g_warning( "%s: %u audit record(s) have not been written: %s",
+				thisfn, g_queue_get_length( &audit->queue ), error );
+		if( msgerr ){
+			*msgerr = g_strdup_printf(
+					_( "%u audit record(s) have not been written: %s" ),
+					g_queue_get_length( &audit->queue ), error ? error : _( "writer is not running" ));
+		}
+	}
+
+	while(( record = g_queue_pop_head( &audit->queue )) != NULL ){
+		audit_record_free( record );
+	}
+	g_free( error );
+	g_clear_object( &audit->connect );
+	g_free( audit->error );
+	g_cond_clear( &audit->flushed );
+	g_cond_clear( &audit->cond );
+	g_mutex_clear( &audit->mutex );
+	g_free( audit );
+
+	sdata->audit = NULL;
+
+	return( ok );
+}
+
+/*
+ * The audit writer thread.
+ *
+ * Wait for the queue to be due, then write it by batches.
+ * A failed batch is put back at the head of the queue, and retried
+ * later; the writer only exits with an empty queue, or when a flush
+ * fails while it is requested to stop.
+ */
+static gpointer
+audit_thread( sAudit *audit )
+{
+	static const gchar *thisfn = "ofa_idbconnect_audit_thread";
+	GQueue batch = G_QUEUE_INIT;
+	sAuditRecord *record;
+	gsize batch_size;
+	gboolean ok;
+	gchar *msgerr;
+
+	ofa_idbconnect_thread_init( audit->connect );
+
+	g_mutex_lock( &audit->mutex );
+
+	while( TRUE ){
+		while( g_queue_is_empty( &audit->queue ) && !audit->stop_requested ){
+			audit->flush_requested = FALSE;
+			g_cond_wait( &audit->cond, &audit->mutex );
+		}
+		if( g_queue_is_empty( &audit->queue )){
+			break;
+		}
+		while( !audit_is_due( audit )){
+			if( !g_cond_wait_until( &audit->cond, &audit->mutex, audit->queue_time+AUDIT_MAX_DELAY )){
+				break;
+			}
+		}
+
+		batch_size = audit_batch( &audit->queue, &batch );
+		audit->queue_size -= batch_size;
+
+		g_mutex_unlock( &audit->mutex );
+		msgerr = NULL;
+		ok = audit_write( audit->connect, &batch, &msgerr );
+		g_mutex_lock( &audit->mutex );
+
+		if( ok ){
+			audit->written += g_queue_get_length( &batch );
+			while(( record = g_queue_pop_head( &batch )) != NULL ){
+				audit_record_free( record );
+			}
+			if( audit->error ){
+				g_info( "%s: audit trail is written again", thisfn );
+				g_free( audit->error );
+				audit->error = NULL;
+			}
+			audit->queue_time = g_get_monotonic_time();
+
+		} else {
+			while(( record = g_queue_pop_tail( &batch )) != NULL ){
+				g_queue_push_head( &audit->queue, record );
+			}
+			audit->queue_size += batch_size;
+			audit->queue_time = g_get_monotonic_time();
+			audit->failures += 1;
+			audit->flush_requested = FALSE;
+			if( !audit->error ){
+				g_warning( "%s: unable to write the audit trail: %s", thisfn, msgerr );
+			}
+			g_free( audit->error );
+			audit->error = msgerr;
+			msgerr = NULL;
+		}
+
+		g_cond_broadcast( &audit->flushed );
 
-	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->query_ex ){
-		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->query_ex( connect, query, result );
-		if( !ok && display_error ){
-			error_query( connect, query );
+		if( !ok && audit->stop_requested ){
+			break;
 		}
+	}
 
-	} else {
-		str = g_strdup_printf(
-					_( "ofaIDBConnect's %s implementation does not provide 'query_ex()' method" ),
-					G_OBJECT_TYPE_NAME( connect ));
+	g_mutex_unlock( &audit->mutex );
 
-		if( display_error ){
-			my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, str );
-		} else {
-			g_info( "%s: %s", thisfn, str );
-		}
+	ofa_idbconnect_thread_end( audit->connect );
 
-		g_free( str );
-	}
+	return( NULL );
+}
 
-	return( ok );
+/*
+ * Whether the audit queue should be written now.
+ * Must be called with the mutex held.
+ */
+static gboolean
+audit_is_due( sAudit *audit )
+{
+	return( audit->stop_requested ||
+			audit->flush_requested ||
+			g_queue_get_length( &audit->queue ) >= AUDIT_MAX_COUNT ||
+			audit->queue_size >= AUDIT_MAX_SIZE ||
+			g_get_monotonic_time() >= audit->queue_time+AUDIT_MAX_DELAY );
 }
 
-/**
- * ofa_idbconnect_query_int:
- * @connect: this #ofaIDBConnect instance.
- * @query: the query to be executed
- * @result: [out]: the returned integer value
- * @display_error: whether the error should be published in a dialog box
- *
- * A simple query for getting a single int.
+/*
+ * Move to @batch the records at the head of @queue which fit in a
+ * single multi-row INSERT.
  *
- * Returns: %TRUE if the sentence has been successfully executed,
- * %FALSE else.
+ * Returns: the size of the @batch.
  */
-gboolean
-ofa_idbconnect_query_int( const ofaIDBConnect *connect, const gchar *query, gint *result, gboolean display_error )
+static gsize
+audit_batch( GQueue *queue, GQueue *batch )
+{
+	sAuditRecord *record;
+	gsize batch_size;
+
+	batch_size = 0;
+
+	while( g_queue_get_length( batch ) < AUDIT_MAX_COUNT &&
+			( record = g_queue_peek_head( queue )) != NULL &&
+			( g_queue_is_empty( batch ) || batch_size+record->size <= AUDIT_MAX_SIZE )){
+		g_queue_push_tail( batch, g_queue_pop_head( queue ));
+		batch_size += record->size;
+	}
+
+	return( batch_size );
+}
+
+/*
+ * Write the @batch of audit records as a single multi-row INSERT.
+ * This is run from the writer thread, and so must not display any
+ * error dialog.
+ */
+static gboolean
+audit_write( const ofaIDBConnect *connect, GQueue *batch, gchar **msgerr )
 {
+	GString *query;
+	GList *it;
+	sAuditRecord *record;
 	gboolean ok;
-	GSList *reslist, *icol;
 
-	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
-	g_return_val_if_fail( my_strlen( query ), FALSE );
-	g_return_val_if_fail( result, FALSE );
+	query = g_string_new( "INSERT INTO OFA_T_AUDIT (AUD_STAMP,AUD_QUERY) VALUES " );
 
-	*result = 0;
-	ok = ofa_idbconnect_query_ex( connect, query, &reslist, display_error );
+	for( it=batch->head ; it ; it=it->next ){
+		record = ( sAuditRecord * ) it->data;
+		g_string_append_printf( query, "%s('%s','%s')",
+				it == batch->head ? "" : ",", record->stamp, audit_record_get_quoted( record ));
+	}
 
-	if( ok ){
-		icol = ( GSList * ) reslist->data;
-		if( icol && icol->data ){
-			*result = atoi(( gchar * ) icol->data );
-		}
-		ofa_idbconnect_free_results( reslist );
+	ok = idbconnect_query( connect, query->str, FALSE );
+	if( !ok ){
+		*msgerr = ofa_idbconnect_get_last_error( connect );
 	}
 
+	g_string_free( query, TRUE );
+
 	return( ok );
 }
 
 /**
- * ofa_idbconnect_has_table:
+ * ofa_idbconnect_get_audit_mode:
  * @connect: this #ofaIDBConnect instance.
- * @table: the name of the searched table.
  *
- * Returns: %TRUE if the specified @table exists, %FALSE else.
+ * Returns: how the audit trail is written for this @connect.
  */
-gboolean
-ofa_idbconnect_has_table( const ofaIDBConnect *connect, const gchar *table )
+ofeIDBAuditMode
+ofa_idbconnect_get_audit_mode( const ofaIDBConnect *connect )
 {
-	gboolean ok, found;
-	gchar *query;
-	GSList *result, *icol;
-
-	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	sIDBConnect *sdata;
 
-	query = g_strdup_printf( "SHOW TABLES LIKE '%s'", table );
-	result = NULL;
-	found = FALSE;
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), OFA_IDBAUDIT_SYNC );
 
-	ok = ofa_idbconnect_query_ex( connect, query, &result, FALSE );
-	if( ok ){
-		if( result ){
-			icol = ( GSList * ) result->data;
-			if( icol && icol->data ){
-				found = TRUE;
-			}
-			ofa_idbconnect_free_results( result );
-		}
-	}
-	g_free( query );
+	sdata = get_instance_data( connect );
 
-	return( found );
+	return( sdata->audit_mode );
 }
 
 /**
- * ofa_idbconnect_table_backup:
+ * ofa_idbconnect_set_audit_mode:
  * @connect: this #ofaIDBConnect instance.
- * @table: the name of the table to be saved.
+ * @mode: the #ofeIDBAuditMode to be set.
  *
- * Backup the @table table.
+ * Set how the audit trail is written for this @connect.
  *
- * Returns: the name of the backup table, as a newly allocated string
- * which should be g_free() by the caller.
+ * Switching to %OFA_IDBAUDIT_SYNC mode first flushes the queued
+ * records, and then stops the writer thread.
  */
-gchar *
-ofa_idbconnect_table_backup( const ofaIDBConnect *connect, const gchar *table )
+void
+ofa_idbconnect_set_audit_mode( const ofaIDBConnect *connect, ofeIDBAuditMode mode )
 {
-	gchar *output, *query;
-	gboolean ok;
+	static const gchar *thisfn = "ofa_idbconnect_set_audit_mode";
+	sIDBConnect *sdata;
+	gchar *msgerr;
 
-	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), NULL );
-	g_return_val_if_fail( my_strlen( table ), NULL );
+	g_debug( "%s: connect=%p, mode=%u", thisfn, ( void * ) connect, mode );
 
-	output = g_strdup_printf( "BACKUP_%s", table );
-	ok = TRUE;
+	g_return_if_fail( connect && OFA_IS_IDBCONNECT( connect ));
+	g_return_if_fail( mode >= OFA_IDBAUDIT_SYNC && mode <= OFA_IDBAUDIT_ASYNC );
 
-	if( ok ){
-		query = g_strdup_printf( "DROP TABLE IF EXISTS %s", output );
-		ok = ofa_idbconnect_query( connect, query, FALSE );
-		g_free( query );
-	}
-	if( ok ){
-		query = g_strdup_printf( "CREATE TABLE %s SELECT * FROM %s ", output, table );
-		ok = ofa_idbconnect_query( connect, query, TRUE );
-		g_free( query );
-	}
-	if( !ok ){
-		g_free( output );
-		output = NULL;
+	sdata = get_instance_data( connect );
+
+	if( mode == OFA_IDBAUDIT_SYNC && !sdata->audit_in_transaction ){
+		msgerr = NULL;
+		if( !audit_stop( connect, sdata, &msgerr )){
+			my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, msgerr );
+			g_free( msgerr );
+		}
 	}
 
-	return( output );
+	sdata->audit_mode = mode;
 }
 
 /**
- * ofa_idbconnect_table_restore:
+ * ofa_idbconnect_audit_flush:
  * @connect: this #ofaIDBConnect instance.
- * @table_src: the source of the restoration.
- * @table_dest: the target of the restoration.
+ * @msgerr: [out][allow-none]: a placeholder for an error message.
  *
- * Restore @table_src to @table_dest.
+ * Wait for all the queued audit records to be written.
  *
- * Returns: %TRUE if successful.
+ * Returns: %TRUE if the audit trail is up to date, %FALSE if it could
+ * not be written.
  */
 gboolean
-ofa_idbconnect_table_restore( const ofaIDBConnect *connect, const gchar *table_src, const gchar *table_dest )
+ofa_idbconnect_audit_flush( const ofaIDBConnect *connect, gchar **msgerr )
 {
-	gboolean ok;
-	gchar *query;
+	sIDBConnect *sdata;
 
 	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
-	g_return_val_if_fail( my_strlen( table_src ), FALSE );
-	g_return_val_if_fail( my_strlen( table_dest ), FALSE );
-
-	ok = TRUE;
-
-	if( ok ){
-		query = g_strdup_printf( "DROP TABLE IF EXISTS %s", table_dest );
-		ok = ofa_idbconnect_query( connect, query, FALSE );
-		g_free( query );
-	}
-	if( ok ){
-		query = g_strdup_printf( "CREATE TABLE %s SELECT * FROM %s ", table_dest, table_src );
-		ok = ofa_idbconnect_query( connect, query, TRUE );
-		g_free( query );
-	}
-
-	return( ok );
-}
-
-static void
-audit_query( const ofaIDBConnect *connect, const gchar *query )
-{
-	gchar *quoted;
-	gchar *audit;
-
-	quoted = quote_query( query );
-	audit = g_strdup_printf( "INSERT INTO OFA_T_AUDIT (AUD_QUERY) VALUES ('%s')", quoted );
 
-	idbconnect_query( connect, audit, FALSE );
+	sdata = get_instance_data( connect );
 
-	g_free( quoted );
-	g_free( audit );
+	return( sdata->audit ? audit_flush( sdata->audit, TRUE, msgerr ) : TRUE );
 }
 
-static gchar *
-quote_query( const gchar *query )
+/**
+ * ofa_idbconnect_audit_close:
+ * @connect: this #ofaIDBConnect instance.
+ * @msgerr: [out][allow-none]: a placeholder for an error message.
+ *
+ * Write all the queued audit records, and stop the audit writer.
+ *
+ * This is expected to be called when closing the dossier, while the
+ * @connect connection is still alive, so that the records the writer
+ * has not been able to write may still be written, or at least be
+ * reported to the user.
+ *
+ * A later audited query will restart the writer.
+ *
+ * Returns: %TRUE if the audit trail is up to date, %FALSE if some
+ * records have been lost.
+ */
+gboolean
+ofa_idbconnect_audit_close( const ofaIDBConnect *connect, gchar **msgerr )
 {
-	gchar *quoted;
-	GRegex *regex;
-	gchar *new_str;
-
-	new_str = g_strdup( query );
+	sIDBConnect *sdata;
 
-	regex = g_regex_new( "\\\\", 0, 0, NULL );
-	if( regex ){
-		g_free( new_str );
-		new_str = g_regex_replace_literal( regex, query, -1, 0, "", 0, NULL );
-		g_regex_unref( regex );
-	}
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
 
-	quoted = my_utils_quote_single( new_str );
-	g_free( new_str );
+	sdata = get_instance_data( connect );
 
-	return( quoted );
+	return( audit_stop( connect, sdata, msgerr ));
 }
 
 static void
@@ -876,6 +2341,44 @@ ofa_idbconnect_get_last_error( const ofaIDBConnect *connect )
 	return( NULL );
 }
 
+/**
+ * ofa_idbconnect_thread_init:
+ * @connect: this #ofaIDBConnect instance.
+ *
+ * Must be called by a thread, other than the main one, before it uses
+ * @connect, so that the DBMS client library may set up its per-thread
+ * data.
+ *
+ * Each call must be balanced by a call to ofa_idbconnect_thread_end()
+ * before the thread exits.
+ */
+void
+ofa_idbconnect_thread_init( const ofaIDBConnect *connect )
+{
+	g_return_if_fail( connect && OFA_IS_IDBCONNECT( connect ));
+
+	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->thread_init ){
+		OFA_IDBCONNECT_GET_INTERFACE( connect )->thread_init( connect );
+	}
+}
+
+/**
+ * ofa_idbconnect_thread_end:
+ * @connect: this #ofaIDBConnect instance.
+ *
+ * Must be called by a thread which has called
+ * ofa_idbconnect_thread_init(), just before exiting.
+ */
+void
+ofa_idbconnect_thread_end( const ofaIDBConnect *connect )
+{
+	g_return_if_fail( connect && OFA_IS_IDBCONNECT( connect ));
+
+	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->thread_end ){
+		OFA_IDBCONNECT_GET_INTERFACE( connect )->thread_end( connect );
+	}
+}
+
 /**
  * ofa_idbconnect_backup_db:
  * @connect: a #ofaIDBConnect instance which handles a user
@@ -1164,6 +2667,7 @@ ofa_idbconnect_restore_db( const ofaIDBConnect *connect,
 						connect, target_period, uri, format, ( ofaMsgCb ) restore_msg_cb, ( ofaDataCb ) restore_data_cb, sope );
 
 		if( ok ){
+			ofa_idbmodel_reset_cache( target_period );
 			target_connect = ofa_idbdossier_meta_new_connect( sdata->dossier_meta, target_period );
 			if( ofa_idbconnect_open_with_account( target_connect, sdata->account, sdata->password )){
 				set_admin_credentials( target_connect, adm_account, adm_password, NULL );
@@ -1464,6 +2968,7 @@ ofa_idbconnect_transaction_start( const ofaIDBConnect *connect, gboolean display
 {
 	static const gchar *thisfn = "ofa_idbconnect_transaction_start";
 	gboolean ok;
+	sIDBConnect *sdata;
 
 	g_debug( "%s: connect=%p, display_error=%s, msgerr=%p",
 			thisfn, ( void * ) connect, display_error ? "True":"False", ( void * ) msgerr );
@@ -1472,6 +2977,10 @@ ofa_idbconnect_transaction_start( const ofaIDBConnect *connect, gboolean display
 
 	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_start ){
 		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_start( connect );
+		if( ok ){
+			sdata = get_instance_data( connect );
+			sdata->audit_in_transaction = TRUE;
+		}
 
 	} else {
 		g_info( "%s: ofaIDBConnect's %s implementation does not provide 'transaction_start()' method",
@@ -1507,6 +3016,7 @@ ofa_idbconnect_transaction_cancel( const ofaIDBConnect *connect, gboolean displa
 
 	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_cancel ){
 		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_cancel( connect );
+		audit_rollback( connect );
 
 	} else {
 		g_info( "%s: ofaIDBConnect's %s implementation does not provide 'transaction_cancel()' method",
@@ -1542,6 +3052,11 @@ ofa_idbconnect_transaction_commit( const ofaIDBConnect *connect, gboolean displa
 
 	if( OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_commit ){
 		ok = OFA_IDBCONNECT_GET_INTERFACE( connect )->transaction_commit( connect );
+		if( ok ){
+			audit_commit( connect, display_error, msgerr );
+		} else {
+			audit_rollback( connect );
+		}
 
 	} else {
 		g_info( "%s: ofaIDBConnect's %s implementation does not provide 'transaction_commit()' method",
@@ -1552,6 +3067,83 @@ ofa_idbconnect_transaction_commit( const ofaIDBConnect *connect, gboolean displa
 	return( ok );
 }
 
+/**
+ * ofa_idbconnect_transaction_is_started:
+ * @connect: an #ofaIDBConnect object which handles a user
+ *  connection on the DBMS.
+ *
+ * As transactions do not nest, this lets a function which updates
+ * several tables only start its own transaction when its caller has
+ * not already started one.
+ *
+ * Returns: %TRUE if a transaction has been started on @connect, and
+ * has not yet been committed nor cancelled.
+ */
+gboolean
+ofa_idbconnect_transaction_is_started( const ofaIDBConnect *connect )
+{
+	sIDBConnect *sdata;
+
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+
+	sdata = get_instance_data( connect );
+
+	return( sdata->audit_in_transaction );
+}
+
+/*
+ * On transaction commit, queue the audit records of the transaction
+ * and flush them, maybe waiting for them to be written depending of
+ * the audit mode.
+ *
+ * The transaction itself is already committed: an audit failure does
+ * not change that, but is reported to the caller.
+ */
+static void
+audit_commit( const ofaIDBConnect *connect, gboolean display_error, gchar **msgerr )
+{
+	static const gchar *thisfn = "ofa_idbconnect_audit_commit";
+	sIDBConnect *sdata;
+	gchar *str;
+
+	sdata = get_instance_data( connect );
+	sdata->audit_in_transaction = FALSE;
+
+	if( sdata->audit ){
+		audit_push( sdata->audit, &sdata->audit_pending );
+
+		str = NULL;
+		if( !audit_flush( sdata->audit, sdata->audit_mode == OFA_IDBAUDIT_COMMIT, &str )){
+			g_warning( "%s: %s", thisfn, str );
+			if( display_error ){
+				my_utils_msg_dialog( NULL, GTK_MESSAGE_WARNING, str );
+			} else if( msgerr ){
+				*msgerr = g_strdup( str );
+			}
+		}
+		g_free( str );
+	}
+}
+
+/*
+ * On transaction cancel, or when the commit fails, the audit records
+ * of the transaction are rolled back with it, as they would have been
+ * in the synchronous mode; next queries are no more in a transaction.
+ */
+static void
+audit_rollback( const ofaIDBConnect *connect )
+{
+	sIDBConnect *sdata;
+	sAuditRecord *record;
+
+	sdata = get_instance_data( connect );
+	sdata->audit_in_transaction = FALSE;
+
+	while(( record = g_queue_pop_head( &sdata->audit_pending )) != NULL ){
+		audit_record_free( record );
+	}
+}
+
 static sIDBConnect *
 get_instance_data( const ofaIDBConnect *connect )
 {
@@ -1561,6 +3153,7 @@ get_instance_data( const ofaIDBConnect *connect )
 
 	if( !sdata ){
 		sdata = g_new0( sIDBConnect, 1 );
+		sdata->audit_mode = OFA_IDBAUDIT_COMMIT;
 		g_object_set_data( G_OBJECT( connect ), IDBCONNECT_DATA, sdata );
 		g_object_weak_ref( G_OBJECT( connect ), ( GWeakNotify ) on_instance_finalized, sdata );
 	}
@@ -1572,6 +3165,7 @@ static void
 on_instance_finalized( sIDBConnect *sdata, GObject *finalized_connect )
 {
 	static const gchar *thisfn = "ofa_idbconnect_on_instance_finalized";
+	sAuditRecord *record;
 
 	g_debug( "%s: sdata=%p, finalized_connect=%p",
 			thisfn, ( void * ) sdata, ( void * ) finalized_connect );
@@ -1580,5 +3174,13 @@ on_instance_finalized( sIDBConnect *sdata, GObject *finalized_connect )
 	g_clear_object( &sdata->exercice_meta );
 	g_free( sdata->account );
 	g_free( sdata->password );
+	if( sdata->statements ){
+		g_hash_table_destroy( sdata->statements );
+	}
+	worker_stop( sdata );
+	audit_stop( NULL, sdata, NULL );
+	while(( record = g_queue_pop_head( &sdata->audit_pending )) != NULL ){
+		audit_record_free( record );
+	}
 	g_free( sdata );
 }
@@ -33,14 +33,18 @@
 #include "my/my-idialog.h"
 #include "my/my-iident.h"
 #include "my/my-iprogress.h"
+#include "my/my-isettings.h"
 #include "my/my-iwindow.h"
 #include "my/my-progress-bar.h"
+#include "my/my-stamp.h"
 #include "my/my-style.h"
 #include "my/my-utils.h"
 
 #include "api/ofa-extender-collection.h"
 #include "api/ofa-hub.h"
 #include "api/ofa-idbconnect.h"
+#include "api/ofa-idbdossier-meta.h"
+#include "api/ofa-idbexercice-meta.h"
 #include "api/ofa-idbmodel.h"
 #include "api/ofa-igetter.h"
 #include "api/ofo-account.h"
@@ -52,7 +56,18 @@
 #include "api/ofo-ope-template.h"
 #include "api/ofo-rate.h"
 
-#define IDBMODEL_LAST_VERSION             1
+#define IDBMODEL_LAST_VERSION             2
+
+/* the checked versions of the DB models are cached in the dossier
+ * settings, as a '<signature>;<stamp>;<marker>;' string, where:
+ * - the signature is the list of '<canon_name>:<last_version>' DB
+ *   models which have been found up to date;
+ * - the marker is the list of '<index>:<max_number>:<max_date>' read
+ *   from the versions tables of the database, so that a database
+ *   which has been changed outside of this application is checked
+ *   again
+ */
+#define IDBMODEL_CACHE_KEY_PREFIX         "DBModel-"
 
 /* default imported datas
  *
@@ -163,6 +178,13 @@ static GType    register_type( void );
 static void     interface_base_init( ofaIDBModelInterface *klass );
 static void     interface_base_finalize( ofaIDBModelInterface *klass );
 static gboolean idbmodel_get_needs_update( const ofaIDBModel *instance, const ofaIDBConnect *connect );
+static const gchar *idbmodel_get_version_table( const ofaIDBModel *instance );
+static gboolean idbmodel_get_needs_update_list( GList *plugins_list, const ofaIDBConnect *connect );
+static gchar   *idbmodel_cache_get_signature( GList *plugins_list, const ofaIDBConnect *connect );
+static gchar   *idbmodel_cache_get_key( const ofaIDBExerciceMeta *exercice_meta, myISettings **settings, const gchar **group );
+static gchar   *idbmodel_cache_get_marker( GList *plugins_list, const ofaIDBConnect *connect );
+static gboolean idbmodel_cache_is_valid( const ofaIDBConnect *connect, const gchar *signature, const gchar *marker );
+static void     idbmodel_cache_write( const ofaIDBConnect *connect, const gchar *signature, const gchar *marker );
 static gboolean idbmodel_ddl_update( ofaIDBModel *instance, ofaIGetter *getter, myIProgress *dialog );
 
 /* dialog management */
@@ -341,6 +363,7 @@ ofa_idbmodel_update( ofaIGetter *getter, GtkWindow *parent )
 	ofaDBModelWindowPrivate *priv;
 	const ofaIDBConnect *connect;
 	ofaHub *hub;
+	gchar *signature, *marker;
 
 	g_debug( "%s: getter=%p, parent=%p", thisfn, ( void * ) getter, ( void * ) parent );
 
@@ -361,8 +384,14 @@ ofa_idbmodel_update( ofaIGetter *getter, GtkWindow *parent )
 	plugins_list = ofa_extender_collection_get_for_type( extenders, OFA_TYPE_IDBMODEL );
 	g_debug( "%s: IDBModel plugins count=%u", thisfn, g_list_length( plugins_list ));
 
-	for( it=plugins_list ; it && !need_update ; it=it->next ){
-		need_update = idbmodel_get_needs_update( OFA_IDBMODEL( it->data ), connect );
+	signature = idbmodel_cache_get_signature( plugins_list, connect );
+	marker = idbmodel_cache_get_marker( plugins_list, connect );
+
+	if( idbmodel_cache_is_valid( connect, signature, marker )){
+		g_debug( "%s: cached DB model versions are up to date, skipping the check", thisfn );
+
+	} else {
+		need_update = idbmodel_get_needs_update_list( plugins_list, connect );
 	}
 
 	if( need_update ){
@@ -381,6 +410,17 @@ ofa_idbmodel_update( ofaIGetter *getter, GtkWindow *parent )
 		}
 	}
 
+	if( ok ){
+		/* the versions tables have been updated */
+		if( need_update ){
+			g_free( marker );
+			marker = idbmodel_cache_get_marker( plugins_list, connect );
+		}
+		idbmodel_cache_write( connect, signature, marker );
+	}
+
+	g_free( marker );
+	g_free( signature );
 	g_list_free( plugins_list );
 
 	return( ok );
@@ -531,6 +571,278 @@ idbmodel_get_needs_update( const ofaIDBModel *instance, const ofaIDBConnect *con
 	return( cur_version < last_version );
 }
 
+/*
+ * get_version_table() method has been introduced in version 2 of the
+ * interface: do not call it on older implementations.
+ *
+ * Returns: the name of the versions table of the DB model, or %NULL.
+ */
+static const gchar *
+idbmodel_get_version_table( const ofaIDBModel *instance )
+{
+	if( ofa_idbmodel_get_interface_version( G_OBJECT_TYPE( instance )) >= 2 &&
+			OFA_IDBMODEL_GET_INTERFACE( instance )->get_version_table ){
+		return( OFA_IDBMODEL_GET_INTERFACE( instance )->get_version_table( instance ));
+	}
+
+	return( NULL );
+}
+
+/*
+ * Check all the DB models at once.
+ *
+ * The current versions of the DB models which publish their versions
+ * table are read with a single UNION query; other DB models (or all
+ * DB models if this query fails, e.g. because a versions table does
+ * not exist yet) are individually probed.
+ *
+ * Returns: %TRUE if at least one DB model needs an update.
+ */
+static gboolean
+idbmodel_get_needs_update_list( GList *plugins_list, const ofaIDBConnect *connect )
+{
+	static const gchar *thisfn = "ofa_idbmodel_get_needs_update_list";
+	GList *it;
+	GSList *result, *irow, *icol;
+	GString *query;
+	ofaIDBModel *instance;
+	const gchar *table;
+	gboolean *checked, need_update;
+	guint count, i, cur_version;
+
+	need_update = FALSE;
+	count = g_list_length( plugins_list );
+	checked = g_new0( gboolean, count );
+	query = g_string_new( "" );
+
+	for( it=plugins_list, i=0 ; it ; it=it->next, ++i ){
+		instance = OFA_IDBMODEL( it->data );
+		if( !OFA_IDBMODEL_GET_INTERFACE( instance )->needs_update ){
+			table = idbmodel_get_version_table( instance );
+			if( my_strlen( table )){
+				g_string_append_printf( query,
+						"%sSELECT %u,MAX(VER_NUMBER) FROM %s WHERE VER_DATE > 0",
+						query->len ? " UNION ALL " : "", i, table );
+			}
+		}
+	}
+
+	if( query->len && ofa_idbconnect_query_ex( connect, query->str, &result, FALSE )){
+		for( irow=result ; irow ; irow=irow->next ){
+			icol = ( GSList * ) irow->data;
+			i = atoi(( const gchar * ) icol->data );
+			icol = icol->next;
+			cur_version = icol->data ? abs( atoi(( const gchar * ) icol->data )) : 0;
+			instance = OFA_IDBMODEL( g_list_nth_data( plugins_list, i ));
+			if( instance && i < count ){
+				checked[i] = TRUE;
+				if( cur_version < ofa_idbmodel_get_last_version( instance, connect )){
+					g_debug( "%s: %s needs an update (current=%u)",
+							thisfn, G_OBJECT_TYPE_NAME( instance ), cur_version );
+					need_update = TRUE;
+				}
+			}
+		}
+		ofa_idbconnect_free_results( result );
+	}
+
+	for( it=plugins_list, i=0 ; it && !need_update ; it=it->next, ++i ){
+		if( !checked[i] ){
+			need_update = idbmodel_get_needs_update( OFA_IDBMODEL( it->data ), connect );
+		}
+	}
+
+	g_string_free( query, TRUE );
+	g_free( checked );
+
+	return( need_update );
+}
+
+/*
+ * The signature identifies the DB models as this application knows
+ * them: it changes as soon as a plugin is added, removed or brings a
+ * new version of its DB model.
+ */
+static gchar *
+idbmodel_cache_get_signature( GList *plugins_list, const ofaIDBConnect *connect )
+{
+	GList *it;
+	GString *signature;
+	gchar *canon;
+
+	signature = g_string_new( "" );
+
+	for( it=plugins_list ; it ; it=it->next ){
+		canon = ofa_idbmodel_get_canon_name( OFA_IDBMODEL( it->data ));
+		g_string_append_printf( signature, "%s%s:%u",
+				signature->len ? "," : "",
+				canon ? canon : G_OBJECT_TYPE_NAME( it->data ),
+				ofa_idbmodel_get_last_version( OFA_IDBMODEL( it->data ), connect ));
+		g_free( canon );
+	}
+
+	return( g_string_free( signature, FALSE ));
+}
+
+/*
+ * The marker identifies the state of the versions tables of the
+ * database: it is read with a single UNION query, and changes as soon
+ * as a DB model version is added or replayed, whoever does it.
+ *
+ * Returns: the marker as a newly allocated string which should be
+ * g_free() by the caller, or %NULL if it cannot be read.
+ */
+static gchar *
+idbmodel_cache_get_marker( GList *plugins_list, const ofaIDBConnect *connect )
+{
+	GList *it;
+	GSList *result, *irow, *icol;
+	GString *query, *marker;
+	ofaIDBModel *instance;
+	const gchar *table;
+	guint i;
+
+	query = g_string_new( "" );
+
+	for( it=plugins_list, i=0 ; it ; it=it->next, ++i ){
+		instance = OFA_IDBMODEL( it->data );
+		table = idbmodel_get_version_table( instance );
+		if( my_strlen( table )){
+			g_string_append_printf( query,
+					"%sSELECT %u,MAX(VER_NUMBER),MAX(VER_DATE) FROM %s",
+					query->len ? " UNION ALL " : "", i, table );
+		}
+	}
+
+	marker = NULL;
+
+	if( query->len && ofa_idbconnect_query_ex( connect, query->str, &result, FALSE )){
+		marker = g_string_new( "" );
+		for( irow=result ; irow ; irow=irow->next ){
+			g_string_append( marker, marker->len ? "," : "" );
+			for( icol=( GSList * ) irow->data ; icol ; icol=icol->next ){
+				g_string_append_printf( marker, "%s%s",
+						icol == irow->data ? "" : ":", icol->data ? ( const gchar * ) icol->data : "" );
+			}
+		}
+		ofa_idbconnect_free_results( result );
+	}
+
+	g_string_free( query, TRUE );
+
+	return( marker ? g_string_free( marker, FALSE ) : NULL );
+}
+
+/*
+ * Returns: the settings key of the cache for this exercice, as a newly
+ * allocated string which should be g_free() by the caller.
+ */
+static gchar *
+idbmodel_cache_get_key( const ofaIDBExerciceMeta *exercice_meta, myISettings **settings, const gchar **group )
+{
+	ofaIDBDossierMeta *dossier_meta;
+	const gchar *settings_id;
+
+	dossier_meta = ofa_idbexercice_meta_get_dossier_meta( exercice_meta );
+	settings_id = ofa_idbexercice_meta_get_settings_id( exercice_meta );
+
+	if( !dossier_meta || !my_strlen( settings_id )){
+		return( NULL );
+	}
+
+	*settings = ofa_idbdossier_meta_get_settings_iface( dossier_meta );
+	*group = ofa_idbdossier_meta_get_settings_group( dossier_meta );
+
+	return( g_strdup_printf( "%s%s", IDBMODEL_CACHE_KEY_PREFIX, settings_id ));
+}
+
+/*
+ * The cache is valid if it has been written for the same DB models
+ * and for the same state of the versions tables; the full check is
+ * run else, or when the marker cannot be read.
+ */
+static gboolean
+idbmodel_cache_is_valid( const ofaIDBConnect *connect, const gchar *signature, const gchar *marker )
+{
+	ofaIDBExerciceMeta *exercice_meta;
+	myISettings *settings;
+	const gchar *group;
+	gchar *key;
+	GList *strlist, *it;
+	gboolean valid;
+
+	valid = FALSE;
+	exercice_meta = ofa_idbconnect_get_exercice_meta( connect );
+	key = ( exercice_meta && marker ) ? idbmodel_cache_get_key( exercice_meta, &settings, &group ) : NULL;
+
+	if( key ){
+		strlist = my_isettings_get_string_list( settings, group, key );
+		it = strlist ? strlist->next : NULL;
+		it = it ? it->next : NULL;
+		valid = strlist && it &&
+				g_strcmp0(( const gchar * ) strlist->data, signature ) == 0 &&
+				g_strcmp0(( const gchar * ) it->data, marker ) == 0;
+		my_isettings_free_string_list( settings, strlist );
+		g_free( key );
+	}
+
+	return( valid );
+}
+
+static void
+idbmodel_cache_write( const ofaIDBConnect *connect, const gchar *signature, const gchar *marker )
+{
+	ofaIDBExerciceMeta *exercice_meta;
+	myISettings *settings;
+	const gchar *group;
+	gchar *key, *sstamp, *str;
+	myStampVal *stamp;
+
+	exercice_meta = ofa_idbconnect_get_exercice_meta( connect );
+	key = ( exercice_meta && marker ) ? idbmodel_cache_get_key( exercice_meta, &settings, &group ) : NULL;
+
+	if( key ){
+		stamp = my_stamp_new_now();
+		sstamp = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
+		str = g_strdup_printf( "%s;%s;%s;", signature, sstamp, marker );
+
+		my_isettings_set_string( settings, group, key, str );
+
+		g_free( str );
+		g_free( sstamp );
+		my_stamp_free( stamp );
+		g_free( key );
+	}
+}
+
+/**
+ * ofa_idbmodel_reset_cache:
+ * @exercice_meta: the #ofaIDBExerciceMeta object which describes the
+ *  exercice.
+ *
+ * Forgets the DB model versions which have been found up to date for
+ * this exercice, so that they will be checked again on next opening.
+ *
+ * This must be called each time the content of the database is
+ * replaced, e.g. on restore.
+ */
+void
+ofa_idbmodel_reset_cache( const ofaIDBExerciceMeta *exercice_meta )
+{
+	myISettings *settings;
+	const gchar *group;
+	gchar *key;
+
+	g_return_if_fail( exercice_meta && OFA_IS_IDBEXERCICE_META( exercice_meta ));
+
+	key = idbmodel_cache_get_key( exercice_meta, &settings, &group );
+
+	if( key ){
+		my_isettings_remove_key( settings, group, key );
+		g_free( key );
+	}
+}
+
 static gboolean
 idbmodel_ddl_update( ofaIDBModel *instance, ofaIGetter *getter, myIProgress *window )
 {
@@ -36,6 +36,7 @@
 #include "api/ofa-igetter.h"
 #include "api/ofa-iimportable.h"
 #include "api/ofa-iimporter.h"
+#include "api/ofa-isignaler.h"
 
 #define IIMPORTER_LAST_VERSION            1
 
@@ -422,6 +423,7 @@ ofa_iimporter_import( ofaIImporter *instance, ofsImporterParms *parms )
 	guint error_count, headers_count;
 	gint count;
 	gchar *msgerr;
+	ofaISignaler *signaler;
 
 	g_return_val_if_fail( instance && OFA_IS_IIMPORTER( instance ), 1 );
 
@@ -459,7 +461,10 @@ ofa_iimporter_import( ofaIImporter *instance, ofsImporterParms *parms )
 		count = parms->lines_count - headers_count;
 
 		if( count > 0 ){
+			signaler = ofa_igetter_get_signaler( parms->getter );
+			ofa_isignaler_begin_batch( signaler );
 			error_count = ofa_iimportable_import( parms->type, instance, parms, g_slist_nth( lines, headers_count ));
+			ofa_isignaler_end_batch( signaler );
 
 		} else if( count < 0 ){
 			error_count += 1;
@@ -35,13 +35,51 @@
 #define ISIGNALER_DATA                     "ofa-isignaler-data"
 #define ISIGNALER_LAST_VERSION              1
 
+/* when more than this count of objects of a same type have been
+ * notified during a batch, the handlers which know how to reload this
+ * type are asked to do so instead of handling each notification
+ */
+#define ISIGNALER_BATCH_RELOAD_COUNT      200
+
 /* a structure attached to the #ofaISignaler instance
  */
 typedef struct {
 	ofaIGetter *getter;
+
+	/* batched notifications
+	 */
+	guint       batch_depth;
+	GHashTable *deferrables;			/* handler id -> sDeferrable */
+	GList      *pending;				/* sPending, last notified first */
+	GHashTable *pending_objects;		/* object -> its NEW or UPDATED sPending */
 }
 	sData;
 
+/* a handler connected through ofa_isignaler_connect_deferrable() or
+ * ofa_isignaler_connect_reload()
+ */
+typedef struct {
+	gulong      handler_id;
+	guint       signal;
+	GCallback   callback;
+	void       *user_data;
+	GType       reload_type;
+}
+	sDeferrable;
+
+/* a notification which has been emitted during a batch
+ */
+typedef struct {
+	guint       signal;
+	GObject    *object;
+	gchar      *prev_id;
+}
+	sPending;
+
+typedef void ( *BaseFn )     ( ofaISignaler *signaler, GObject *object, void *user_data );
+typedef void ( *UpdatedFn )  ( ofaISignaler *signaler, GObject *object, const gchar *prev_id, void *user_data );
+typedef void ( *ReloadFn )   ( ofaISignaler *signaler, GType type, void *user_data );
+
 /* signals defined here
  */
 enum {
@@ -79,6 +117,16 @@ static GType    register_type( void );
 static void     interface_base_init( ofaISignalerInterface *klass );
 static void     interface_base_finalize( ofaISignalerInterface *klass );
 static gboolean on_deletable_default_handler( ofaISignaler *signaler, GObject *object );
+static void     on_base_new_class_handler( ofaISignaler *signaler, GObject *object );
+static void     on_base_updated_class_handler( ofaISignaler *signaler, GObject *object, const gchar *prev_id );
+static void     on_base_deleted_class_handler( ofaISignaler *signaler, GObject *object );
+static void     on_collection_reload_class_handler( ofaISignaler *signaler, GType type );
+static void     batch_add_pending( sData *sdata, guint signal, GObject *object, const gchar *prev_id );
+static void     batch_deliver( ofaISignaler *signaler, sData *sdata );
+static gboolean batch_is_reloaded( GList *reloaded, void *user_data, GType type );
+static void     batch_set_blocked( ofaISignaler *signaler, sData *sdata, gboolean blocked );
+static gulong   deferrable_connect( ofaISignaler *signaler, const gchar *signal, GCallback callback, void *user_data, GType reload_type );
+static void     pending_free( sPending *pending );
 static sData   *get_instance_data( const ofaISignaler *self );
 static void     on_instance_finalized( sData *sdata, GObject *finalized_object );
 
@@ -157,7 +205,7 @@ interface_base_init( ofaISignalerInterface *klass )
 					SIGNALER_BASE_NEW,
 					OFA_TYPE_ISIGNALER,
 					G_SIGNAL_RUN_LAST,
-					NULL,
+					G_CALLBACK( on_base_new_class_handler ),
 					NULL,								/* accumulator */
 					NULL,								/* accumulator data */
 					NULL,
@@ -184,7 +232,7 @@ interface_base_init( ofaISignalerInterface *klass )
 					SIGNALER_BASE_UPDATED,
 					OFA_TYPE_ISIGNALER,
 					G_SIGNAL_RUN_LAST,
-					NULL,
+					G_CALLBACK( on_base_updated_class_handler ),
 					NULL,								/* accumulator */
 					NULL,								/* accumulator data */
 					NULL,
@@ -239,7 +287,7 @@ interface_base_init( ofaISignalerInterface *klass )
 					SIGNALER_BASE_DELETED,
 					OFA_TYPE_ISIGNALER,
 					G_SIGNAL_RUN_LAST,
-					NULL,
+					G_CALLBACK( on_base_deleted_class_handler ),
 					NULL,								/* accumulator */
 					NULL,								/* accumulator data */
 					NULL,
@@ -267,7 +315,7 @@ interface_base_init( ofaISignalerInterface *klass )
 					SIGNALER_COLLECTION_RELOAD,
 					OFA_TYPE_ISIGNALER,
 					G_SIGNAL_RUN_LAST,
-					NULL,
+					G_CALLBACK( on_collection_reload_class_handler ),
 					NULL,								/* accumulator */
 					NULL,								/* accumulator data */
 					NULL,
@@ -833,12 +881,18 @@ ofa_isignaler_disconnect_handlers( ofaISignaler *signaler, GList **handlers )
 {
 	static const gchar *thisfn = "ofa_isignaler_disconnect_handlers";
 	GList *it;
+	sData *sdata;
 
 	g_debug( "%s: signaler=%p, handlers=%p (count=%d)",
 			thisfn, ( void * ) signaler, ( void * ) handlers, g_list_length( *handlers ));
 
+	sdata = get_instance_data( signaler );
+
 	for( it=( *handlers ) ; it ; it=it->next ){
 		g_signal_handler_disconnect( signaler, ( gulong ) it->data );
+		if( sdata->deferrables ){
+			g_hash_table_remove( sdata->deferrables, it->data );
+		}
 	}
 
 	if( *handlers ){
@@ -847,6 +901,390 @@ ofa_isignaler_disconnect_handlers( ofaISignaler *signaler, GList **handlers )
 	}
 }
 
+/**
+ * ofa_isignaler_connect_deferrable:
+ * @signaler: this #ofaISignaler instance.
+ * @signal: the name of the signal, which must be one of
+ *  %SIGNALER_BASE_NEW, %SIGNALER_BASE_UPDATED or %SIGNALER_BASE_DELETED.
+ * @callback: the handler.
+ * @user_data: the user data to be passed to the @callback; this is
+ *  most often the connecting store.
+ *
+ * Connects @callback to the @signal.
+ *
+ * Outside of a batch, the @callback is called as for any other handler.
+ * During a batch, it is only called when the batch ends, with the
+ * deduplicated notifications (see ofa_isignaler_begin_batch()).
+ *
+ * Only handlers which do not need to be synchronous should be connected
+ * this way: typically the stores and the views. The handlers which keep
+ * the data consistent must still be connected with g_signal_connect().
+ *
+ * The returned identifier should be disconnected with
+ * ofa_isignaler_disconnect_handlers().
+ *
+ * Returns: the handler identifier.
+ */
+gulong
+ofa_isignaler_connect_deferrable( ofaISignaler *signaler, const gchar *signal, GCallback callback, void *user_data )
+{
+	g_return_val_if_fail( signaler && OFA_IS_ISIGNALER( signaler ), 0 );
+	g_return_val_if_fail(
+			!g_strcmp0( signal, SIGNALER_BASE_NEW ) ||
+			!g_strcmp0( signal, SIGNALER_BASE_UPDATED ) ||
+			!g_strcmp0( signal, SIGNALER_BASE_DELETED ), 0 );
+
+	return( deferrable_connect( signaler, signal, callback, user_data, G_TYPE_INVALID ));
+}
+
+/**
+ * ofa_isignaler_connect_reload:
+ * @signaler: this #ofaISignaler instance.
+ * @type: the type of the collection which is reloaded by @callback.
+ * @callback: the %SIGNALER_COLLECTION_RELOAD handler.
+ * @user_data: the user data to be passed to the @callback.
+ *
+ * Connects @callback to the %SIGNALER_COLLECTION_RELOAD signal.
+ *
+ * When a batch ends with a large count of notifications on objects of
+ * @type, the @callback is called once for this @type, and the deferrable
+ * handlers with the same @user_data do not receive these notifications.
+ *
+ * The returned identifier should be disconnected with
+ * ofa_isignaler_disconnect_handlers().
+ *
+ * Returns: the handler identifier.
+ */
+gulong
+ofa_isignaler_connect_reload( ofaISignaler *signaler, GType type, GCallback callback, void *user_data )
+{
+	g_return_val_if_fail( signaler && OFA_IS_ISIGNALER( signaler ), 0 );
+	g_return_val_if_fail( type != G_TYPE_INVALID, 0 );
+
+	return( deferrable_connect( signaler, SIGNALER_COLLECTION_RELOAD, callback, user_data, type ));
+}
+
+static gulong
+deferrable_connect( ofaISignaler *signaler, const gchar *signal, GCallback callback, void *user_data, GType reload_type )
+{
+	sData *sdata;
+	sDeferrable *deferrable;
+
+	sdata = get_instance_data( signaler );
+
+	if( !sdata->deferrables ){
+		sdata->deferrables = g_hash_table_new_full( g_direct_hash, g_direct_equal, NULL, g_free );
+	}
+
+	deferrable = g_new0( sDeferrable, 1 );
+	deferrable->handler_id = g_signal_connect( signaler, signal, callback, user_data );
+	deferrable->signal = g_signal_lookup( signal, OFA_TYPE_ISIGNALER );
+	deferrable->callback = callback;
+	deferrable->user_data = user_data;
+	deferrable->reload_type = reload_type;
+
+	g_hash_table_insert( sdata->deferrables, ( gpointer ) deferrable->handler_id, deferrable );
+
+	if( sdata->batch_depth > 0 && reload_type == G_TYPE_INVALID ){
+		g_signal_handler_block( signaler, deferrable->handler_id );
+	}
+
+	return( deferrable->handler_id );
+}
+
+/**
+ * ofa_isignaler_begin_batch:
+ * @signaler: this #ofaISignaler instance.
+ *
+ * Starts a batch of notifications.
+ *
+ * Until the matching ofa_isignaler_end_batch(), the %SIGNALER_BASE_NEW,
+ * %SIGNALER_BASE_UPDATED and %SIGNALER_BASE_DELETED signals are still
+ * synchronously sent to the handlers connected with g_signal_connect(),
+ * but the handlers connected with ofa_isignaler_connect_deferrable()
+ * only receive them when the batch ends:
+ * - the successive updates of a same object are delivered once;
+ * - the notifications on the objects of a type whose collection has
+ *   been reloaded during the batch are dropped.
+ *
+ * Batches may be nested: only the outermost one delivers the
+ * notifications.
+ */
+void
+ofa_isignaler_begin_batch( ofaISignaler *signaler )
+{
+	sData *sdata;
+
+	g_return_if_fail( signaler && OFA_IS_ISIGNALER( signaler ));
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth == 0 ){
+		if( !sdata->pending_objects ){
+			sdata->pending_objects = g_hash_table_new( g_direct_hash, g_direct_equal );
+		}
+		batch_set_blocked( signaler, sdata, TRUE );
+	}
+
+	sdata->batch_depth += 1;
+}
+
+/**
+ * ofa_isignaler_end_batch:
+ * @signaler: this #ofaISignaler instance.
+ *
+ * Ends a batch of notifications started with ofa_isignaler_begin_batch().
+ *
+ * When ending the outermost batch, the deferrable handlers receive the
+ * notifications emitted during the batch.
+ * For each type of which more than ISIGNALER_BATCH_RELOAD_COUNT objects
+ * have been notified, the handlers connected with
+ * ofa_isignaler_connect_reload() for this type are called once instead.
+ */
+void
+ofa_isignaler_end_batch( ofaISignaler *signaler )
+{
+	static const gchar *thisfn = "ofa_isignaler_end_batch";
+	sData *sdata;
+
+	g_return_if_fail( signaler && OFA_IS_ISIGNALER( signaler ));
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth == 0 ){
+		g_warning( "%s: no batch has been started", thisfn );
+		return;
+	}
+
+	sdata->batch_depth -= 1;
+
+	if( sdata->batch_depth == 0 ){
+		batch_set_blocked( signaler, sdata, FALSE );
+		batch_deliver( signaler, sdata );
+	}
+}
+
+/*
+ * The class handlers are run after all connected (and not blocked)
+ * handlers: they record the notifications emitted during a batch.
+ */
+static void
+on_base_new_class_handler( ofaISignaler *signaler, GObject *object )
+{
+	sData *sdata;
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth > 0 ){
+		batch_add_pending( sdata, ( guint ) st_signals[ BASE_NEW ], object, NULL );
+	}
+}
+
+static void
+on_base_updated_class_handler( ofaISignaler *signaler, GObject *object, const gchar *prev_id )
+{
+	sData *sdata;
+	sPending *pending;
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth > 0 ){
+		pending = g_hash_table_lookup( sdata->pending_objects, object );
+
+		/* the object is already to be inserted or updated with its
+		 * final properties; only keep the identifier by which the
+		 * handlers know it */
+		if( pending ){
+			if( pending->signal == ( guint ) st_signals[ BASE_UPDATED ] && !pending->prev_id && prev_id ){
+				pending->prev_id = g_strdup( prev_id );
+			}
+		} else {
+			batch_add_pending( sdata, ( guint ) st_signals[ BASE_UPDATED ], object, prev_id );
+		}
+	}
+}
+
+static void
+on_base_deleted_class_handler( ofaISignaler *signaler, GObject *object )
+{
+	sData *sdata;
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth > 0 ){
+		g_hash_table_remove( sdata->pending_objects, object );
+		batch_add_pending( sdata, ( guint ) st_signals[ BASE_DELETED ], object, NULL );
+	}
+}
+
+/*
+ * The handlers have just reloaded the collection: the pending
+ * notifications on this type become useless.
+ */
+static void
+on_collection_reload_class_handler( ofaISignaler *signaler, GType type )
+{
+	sData *sdata;
+	GList *it, *next;
+	sPending *pending;
+
+	sdata = get_instance_data( signaler );
+
+	if( sdata->batch_depth > 0 ){
+		for( it=sdata->pending ; it ; it=next ){
+			next = it->next;
+			pending = ( sPending * ) it->data;
+			if( G_OBJECT_TYPE( pending->object ) == type ){
+				g_hash_table_remove( sdata->pending_objects, pending->object );
+				sdata->pending = g_list_delete_link( sdata->pending, it );
+				pending_free( pending );
+			}
+		}
+	}
+}
+
+static void
+batch_add_pending( sData *sdata, guint signal, GObject *object, const gchar *prev_id )
+{
+	sPending *pending;
+
+	pending = g_new0( sPending, 1 );
+	pending->signal = signal;
+	pending->object = g_object_ref( object );
+	pending->prev_id = g_strdup( prev_id );
+
+	sdata->pending = g_list_prepend( sdata->pending, pending );
+
+	if( signal != ( guint ) st_signals[ BASE_DELETED ] ){
+		g_hash_table_insert( sdata->pending_objects, object, pending );
+	}
+}
+
+/*
+ * Deliver the pending notifications to the deferrable handlers.
+ *
+ * The handlers are taken from their identifiers at each call, as a
+ * handler may disconnect others (or itself) while being called.
+ */
+static void
+batch_deliver( ofaISignaler *signaler, sData *sdata )
+{
+	static const gchar *thisfn = "ofa_isignaler_batch_deliver";
+	GList *pendings, *handlers, *reloaded, *it, *ith;
+	GHashTable *counts;
+	sPending *pending;
+	sDeferrable *deferrable, *reload;
+	GType type;
+	guint count;
+
+	pendings = g_list_reverse( sdata->pending );
+	sdata->pending = NULL;
+	g_hash_table_remove_all( sdata->pending_objects );
+
+	g_debug( "%s: signaler=%p, notifications=%u",
+			thisfn, ( void * ) signaler, g_list_length( pendings ));
+
+	if( !pendings || !sdata->deferrables ){
+		g_list_free_full( pendings, ( GDestroyNotify ) pending_free );
+		return;
+	}
+
+	/* count the notified objects per type */
+	counts = g_hash_table_new( g_direct_hash, g_direct_equal );
+	for( it=pendings ; it ; it=it->next ){
+		type = G_OBJECT_TYPE((( sPending * ) it->data )->object );
+		count = GPOINTER_TO_UINT( g_hash_table_lookup( counts, ( gpointer ) type ));
+		g_hash_table_insert( counts, ( gpointer ) type, GUINT_TO_POINTER( count+1 ));
+	}
+
+	/* ask for a reload of the large types
+	 * reloaded keeps a copy of the reload handlers which have been called */
+	reloaded = NULL;
+	handlers = g_hash_table_get_keys( sdata->deferrables );
+
+	for( ith=handlers ; ith ; ith=ith->next ){
+		deferrable = g_hash_table_lookup( sdata->deferrables, ith->data );
+		if( deferrable && deferrable->reload_type != G_TYPE_INVALID &&
+				GPOINTER_TO_UINT( g_hash_table_lookup( counts, ( gpointer ) deferrable->reload_type )) > ISIGNALER_BATCH_RELOAD_COUNT ){
+			reload = g_new0( sDeferrable, 1 );
+			*reload = *deferrable;
+			reloaded = g_list_prepend( reloaded, reload );
+			(( ReloadFn ) reload->callback )( signaler, reload->reload_type, reload->user_data );
+		}
+	}
+
+	/* deliver the other notifications */
+	for( it=pendings ; it ; it=it->next ){
+		pending = ( sPending * ) it->data;
+		type = G_OBJECT_TYPE( pending->object );
+
+		for( ith=handlers ; ith ; ith=ith->next ){
+			deferrable = g_hash_table_lookup( sdata->deferrables, ith->data );
+			if( !deferrable || deferrable->signal != pending->signal ||
+					batch_is_reloaded( reloaded, deferrable->user_data, type )){
+				continue;
+			}
+			if( pending->signal == ( guint ) st_signals[ BASE_UPDATED ] ){
+				(( UpdatedFn ) deferrable->callback )( signaler, pending->object, pending->prev_id, deferrable->user_data );
+			} else {
+				(( BaseFn ) deferrable->callback )( signaler, pending->object, deferrable->user_data );
+			}
+		}
+	}
+
+	g_list_free( handlers );
+	g_list_free_full( reloaded, ( GDestroyNotify ) g_free );
+	g_hash_table_unref( counts );
+	g_list_free_full( pendings, ( GDestroyNotify ) pending_free );
+}
+
+static gboolean
+batch_is_reloaded( GList *reloaded, void *user_data, GType type )
+{
+	GList *it;
+	sDeferrable *reload;
+
+	for( it=reloaded ; it ; it=it->next ){
+		reload = ( sDeferrable * ) it->data;
+		if( reload->user_data == user_data && reload->reload_type == type ){
+			return( TRUE );
+		}
+	}
+
+	return( FALSE );
+}
+
+/*
+ * Block (resp. unblock) the deferrable base handlers.
+ */
+static void
+batch_set_blocked( ofaISignaler *signaler, sData *sdata, gboolean blocked )
+{
+	GHashTableIter iter;
+	sDeferrable *deferrable;
+
+	if( sdata->deferrables ){
+		g_hash_table_iter_init( &iter, sdata->deferrables );
+		while( g_hash_table_iter_next( &iter, NULL, ( gpointer * ) &deferrable )){
+			if( deferrable->reload_type == G_TYPE_INVALID ){
+				if( blocked ){
+					g_signal_handler_block( signaler, deferrable->handler_id );
+				} else {
+					g_signal_handler_unblock( signaler, deferrable->handler_id );
+				}
+			}
+		}
+	}
+}
+
+static void
+pending_free( sPending *pending )
+{
+	g_object_unref( pending->object );
+	g_free( pending->prev_id );
+	g_free( pending );
+}
+
 static sData *
 get_instance_data( const ofaISignaler *self )
 {
@@ -870,5 +1308,12 @@ on_instance_finalized( sData *sdata, GObject *finalized_object )
 
 	g_debug( "%s: sdata=%p, finalized_object=%p", thisfn, ( void * ) sdata, ( void * ) finalized_object );
 
+	if( sdata->deferrables ){
+		g_hash_table_unref( sdata->deferrables );
+	}
+	if( sdata->pending_objects ){
+		g_hash_table_unref( sdata->pending_objects );
+	}
+	g_list_free_full( sdata->pending, ( GDestroyNotify ) pending_free );
 	g_free( sdata );
 }
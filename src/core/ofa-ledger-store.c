@@ -213,16 +213,19 @@ ofa_ledger_store_new( ofaIGetter *getter )
 static gint
 on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaLedgerStore *self )
 {
-	gchar *anumber, *bnumber;
+	ofoLedger *a_obj, *b_obj;
 	gint cmp;
 
-	gtk_tree_model_get( tmodel, a, LEDGER_COL_MNEMO, &anumber, -1 );
-	gtk_tree_model_get( tmodel, b, LEDGER_COL_MNEMO, &bnumber, -1 );
+	gtk_tree_model_get( tmodel, a, LEDGER_COL_OBJECT, &a_obj, -1 );
+	gtk_tree_model_get( tmodel, b, LEDGER_COL_OBJECT, &b_obj, -1 );
 
-	cmp = my_collate( anumber, bnumber );
+	/* the object may not have been set yet on a just-inserted row */
+	cmp = g_strcmp0(
+			a_obj ? ofo_ledger_get_mnemo_key( a_obj ) : NULL,
+			b_obj ? ofo_ledger_get_mnemo_key( b_obj ) : NULL );
 
-	g_free( anumber );
-	g_free( bnumber );
+	g_clear_object( &a_obj );
+	g_clear_object( &b_obj );
 
 	return( cmp );
 }
@@ -363,16 +366,16 @@ signaler_connect_to_signaling_system( ofaLedgerStore *self )
 
 	signaler = ofa_igetter_get_signaler( priv->getter );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_COLLECTION_RELOAD, G_CALLBACK( signaler_on_reload_collection ), self );
+	handler = ofa_isignaler_connect_reload( signaler, OFO_TYPE_LEDGER, G_CALLBACK( signaler_on_reload_collection ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 }
 
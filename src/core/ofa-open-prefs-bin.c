@@ -47,6 +47,7 @@ typedef struct {
 	GtkWidget    *properties_btn;
 	GtkWidget    *balances_btn;
 	GtkWidget    *integrity_btn;
+	GtkWidget    *preload_btn;
 }
 	ofaOpenPrefsBinPrivate;
 
@@ -59,6 +60,7 @@ static void  on_non_empty_notes_toggled( GtkToggleButton *button, ofaOpenPrefsBi
 static void  on_display_properties_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self );
 static void  on_check_balances_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self );
 static void  on_check_integrity_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self );
+static void  on_preload_collections_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self );
 static void  on_bin_changed( ofaOpenPrefsBin *self );
 static void  ibin_iface_init( myIBinInterface *iface );
 static guint ibin_get_interface_version( void );
@@ -201,6 +203,11 @@ setup_bin( ofaOpenPrefsBin *self )
 	g_signal_connect( btn, "toggled", G_CALLBACK( on_check_integrity_toggled ), self );
 	priv->integrity_btn = btn;
 
+	btn = my_utils_container_get_child_by_name( GTK_CONTAINER( self ), "p1-preload" );
+	g_return_if_fail( btn && GTK_IS_CHECK_BUTTON( btn ));
+	g_signal_connect( btn, "toggled", G_CALLBACK( on_preload_collections_toggled ), self );
+	priv->preload_btn = btn;
+
 	gtk_widget_destroy( toplevel );
 	g_object_unref( builder );
 }
@@ -228,6 +235,9 @@ setup_data( ofaOpenPrefsBin *self )
 
 	active = ofa_open_prefs_get_check_integrity( priv->prefs );
 	gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( priv->integrity_btn ), active );
+
+	active = ofa_open_prefs_get_preload_collections( priv->prefs );
+	gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( priv->preload_btn ), active );
 }
 
 static void
@@ -302,6 +312,20 @@ on_check_integrity_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self )
 	on_bin_changed( self );
 }
 
+static void
+on_preload_collections_toggled( GtkToggleButton *button, ofaOpenPrefsBin *self )
+{
+	ofaOpenPrefsBinPrivate *priv;
+	gboolean active;
+
+	priv = ofa_open_prefs_bin_get_instance_private( self );
+
+	active = gtk_toggle_button_get_active( button );
+	ofa_open_prefs_set_preload_collections( priv->prefs, active );
+
+	on_bin_changed( self );
+}
+
 static void
 on_bin_changed( ofaOpenPrefsBin *self )
 {
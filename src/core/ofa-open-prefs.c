@@ -49,6 +49,7 @@ typedef struct {
 	gboolean     display_properties;
 	gboolean     check_balances;
 	gboolean     check_integrity;
+	gboolean     preload_collections;
 }
 	ofaOpenPrefsPrivate;
 
@@ -121,6 +122,7 @@ ofa_open_prefs_init( ofaOpenPrefs *self )
 	priv->display_properties = FALSE;
 	priv->check_balances = FALSE;
 	priv->check_integrity = FALSE;
+	priv->preload_collections = FALSE;
 }
 
 static void
@@ -373,6 +375,49 @@ ofa_open_prefs_set_check_integrity( ofaOpenPrefs *prefs, gboolean check_integrit
 	priv->check_integrity = check_integrity;
 }
 
+/**
+ * ofa_open_prefs_get_preload_collections:
+ * @prefs: this #ofaOpenPrefs object.
+ *
+ * Returns: %TRUE if the collections should be preloaded when opening
+ * the dossier.
+ */
+gboolean
+ofa_open_prefs_get_preload_collections( ofaOpenPrefs *prefs )
+{
+	ofaOpenPrefsPrivate *priv;
+
+	g_return_val_if_fail( prefs && OFA_IS_OPEN_PREFS( prefs ), FALSE );
+
+	priv = ofa_open_prefs_get_instance_private( prefs );
+
+	g_return_val_if_fail( !priv->dispose_has_run, FALSE );
+
+	return( priv->preload_collections );
+}
+
+/**
+ * ofa_open_prefs_set_preload_collections:
+ * @prefs: this #ofaOpenPrefs object.
+ * @preload_collections: whether the collections should be preloaded
+ *  when opening the dossier.
+ *
+ * Set @preload_collections.
+ */
+void
+ofa_open_prefs_set_preload_collections( ofaOpenPrefs *prefs, gboolean preload_collections )
+{
+	ofaOpenPrefsPrivate *priv;
+
+	g_return_if_fail( prefs && OFA_IS_OPEN_PREFS( prefs ));
+
+	priv = ofa_open_prefs_get_instance_private( prefs );
+
+	g_return_if_fail( !priv->dispose_has_run );
+
+	priv->preload_collections = preload_collections;
+}
+
 /**
  * ofa_open_prefs_apply_settings:
  * @prefs: this #ofaOpenPrefs object.
@@ -428,6 +473,7 @@ ofa_open_prefs_change_settings( ofaOpenPrefs *prefs, myISettings *settings, cons
 /*
  * Settings are:
  *     open_notes(b); non_empty(b); open_properties(b); check_balances(b); check_integrity(b);
+ *     preload_collections(b);
  */
 static void
 read_settings( ofaOpenPrefs *self )
@@ -472,6 +518,12 @@ read_settings( ofaOpenPrefs *self )
 		priv->check_integrity = my_utils_boolean_from_str( cstr );
 	}
 
+	it = it ? it->next : NULL;
+	cstr = it ? ( const gchar * ) it->data : NULL;
+	if( my_strlen( cstr )){
+		priv->preload_collections = my_utils_boolean_from_str( cstr );
+	}
+
 	my_isettings_free_string_list( priv->settings, strlist );
 	g_free( key );
 }
@@ -484,12 +536,13 @@ write_settings( ofaOpenPrefs *self )
 
 	priv = ofa_open_prefs_get_instance_private( self );
 
-	str = g_strdup_printf( "%s;%s;%s;%s;%s;",
+	str = g_strdup_printf( "%s;%s;%s;%s;%s;%s;",
 			priv->display_notes ? "True":"False",
 			priv->non_empty_notes ? "True":"False",
 			priv->display_properties ? "True":"False",
 			priv->check_balances ? "True":"False",
-			priv->check_integrity ? "True":"False" );
+			priv->check_integrity ? "True":"False",
+			priv->preload_collections ? "True":"False" );
 
 	key = g_strdup_printf( "%s-settings", priv->key );
 	my_isettings_set_string( priv->settings, priv->group, key, str );
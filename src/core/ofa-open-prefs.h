@@ -108,6 +108,11 @@ gboolean      ofa_open_prefs_get_check_integrity   ( ofaOpenPrefs *prefs );
 void          ofa_open_prefs_set_check_integrity   ( ofaOpenPrefs *prefs,
 														gboolean check_integrity );
 
+gboolean      ofa_open_prefs_get_preload_collections( ofaOpenPrefs *prefs );
+
+void          ofa_open_prefs_set_preload_collections( ofaOpenPrefs *prefs,
+														gboolean preload_collections );
+
 void          ofa_open_prefs_apply_settings        ( ofaOpenPrefs *prefs );
 
 void          ofa_open_prefs_change_settings       ( ofaOpenPrefs *prefs,
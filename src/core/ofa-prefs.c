@@ -71,6 +71,10 @@ typedef struct {
 	gboolean           assistant_confirm_on_escape;
 	gboolean           assistant_confirm_on_cancel;
 
+	/* audit trail
+	 */
+	ofeIDBAuditMode    audit_mode;
+
 	/* check dbms integrity
 	 */
 	gboolean           check_integrity_display_all;
@@ -99,6 +103,7 @@ static const gchar *st_account          = "ofaPreferences-Account";
 static const gchar *st_amount           = "ofaPreferences-Amount";
 static const gchar *st_application      = "ofaPreferences-Application";
 static const gchar *st_assistant        = "ofaPreferences-Assistant";
+static const gchar *st_audit            = "ofaPreferences-Audit";
 static const gchar *st_check_integrity  = "ofaPreferences-CheckIntegrity";
 static const gchar *st_date             = "ofaPreferences-Date";
 static const gchar *st_export           = "ofaPreferences-Export";
@@ -113,6 +118,13 @@ typedef struct {
 }
 	sEnum;
 
+static const sEnum st_audit_mode[] = {
+		{ OFA_IDBAUDIT_SYNC,   "S" },
+		{ OFA_IDBAUDIT_COMMIT, "C" },
+		{ OFA_IDBAUDIT_ASYNC,  "A" },
+		{ 0 }
+};
+
 static const sEnum st_mainbook_startup_mode[] = {
 		{ MAINBOOK_STARTNORMAL, "N" },
 		{ MAINBOOK_STARTMINI,   "M" },
@@ -146,6 +158,8 @@ static void         appli_write_settings( ofaPrefs *self );
 static gboolean     is_willing_to_quit( ofaPrefs *self );
 static void         assistant_read_settings( ofaPrefs *self );
 static void         assistant_write_settings( ofaPrefs *self );
+static void         audit_read_settings( ofaPrefs *self );
+static void         audit_write_settings( ofaPrefs *self );
 static void         check_integrity_read_settings( ofaPrefs *self );
 static void         check_integrity_write_settings( ofaPrefs *self );
 static void         date_read_settings( ofaPrefs *self );
@@ -236,6 +250,8 @@ ofa_prefs_init( ofaPrefs *self )
 	priv->assistant_confirm_on_escape = TRUE;
 	priv->assistant_confirm_on_cancel = FALSE;
 
+	priv->audit_mode = OFA_IDBAUDIT_COMMIT;
+
 	priv->check_integrity_display_all = FALSE;
 
 	priv->date_display_format = MY_DATE_YYMD;
@@ -288,6 +304,7 @@ ofa_prefs_new( ofaIGetter *getter )
 	amount_read_settings( prefs );
 	appli_read_settings( prefs );
 	assistant_read_settings( prefs );
+	audit_read_settings( prefs );
 	check_integrity_read_settings( prefs );
 	date_read_settings( prefs );
 	export_read_settings( prefs );
@@ -1059,6 +1076,105 @@ assistant_write_settings( ofaPrefs *self )
 	g_free( str );
 }
 
+/**
+ * ofa_prefs_audit_get_mode:
+ * @getter: a #ofaIGetter instance.
+ *
+ * Returns: how the audit trail of the dossier should be written.
+ */
+ofeIDBAuditMode
+ofa_prefs_audit_get_mode( ofaIGetter *getter )
+{
+	ofaPrefs *prefs;
+	ofaPrefsPrivate *priv;
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), OFA_IDBAUDIT_COMMIT );
+
+	prefs = ofa_igetter_get_user_prefs( getter );
+	g_return_val_if_fail( prefs && OFA_IS_PREFS( prefs ), OFA_IDBAUDIT_COMMIT );
+
+	priv = ofa_prefs_get_instance_private( prefs );
+	g_return_val_if_fail( !priv->dispose_has_run, OFA_IDBAUDIT_COMMIT );
+
+	return( priv->audit_mode );
+}
+
+/**
+ * ofa_prefs_audit_set_user_settings:
+ * @getter: a #ofaIGetter instance.
+ * @mode: how the audit trail should be written.
+ *
+ * Set the user settings.
+ *
+ * The new mode applies to the dossier which is opened after the call;
+ * it is up to the caller to apply it to the currently opened dossier.
+ */
+void
+ofa_prefs_audit_set_user_settings( ofaIGetter *getter, ofeIDBAuditMode mode )
+{
+	ofaPrefs *prefs;
+	ofaPrefsPrivate *priv;
+
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	prefs = ofa_igetter_get_user_prefs( getter );
+	g_return_if_fail( prefs && OFA_IS_PREFS( prefs ));
+
+	priv = ofa_prefs_get_instance_private( prefs );
+	g_return_if_fail( !priv->dispose_has_run );
+
+	priv->audit_mode = mode;
+
+	audit_write_settings( prefs );
+}
+
+/*
+ * Audit settings: mode;
+ */
+static void
+audit_read_settings( ofaPrefs *self )
+{
+	ofaPrefsPrivate *priv;
+	myISettings *settings;
+	GList *strlist, *it;
+	const gchar *cstr;
+
+	priv = ofa_prefs_get_instance_private( self );
+
+	settings = ofa_igetter_get_user_settings( priv->getter );
+	g_return_if_fail( settings && MY_IS_ISETTINGS( settings ));
+
+	strlist = my_isettings_get_string_list( settings, HUB_USER_SETTINGS_GROUP, st_audit );
+
+	it = strlist;
+	cstr = it ? ( const gchar * ) it->data : NULL;
+	if( my_strlen( cstr )){
+		priv->audit_mode = enum_code_to_enum( st_audit_mode, cstr, priv->audit_mode );
+	}
+
+	my_isettings_free_string_list( settings, strlist );
+}
+
+static void
+audit_write_settings( ofaPrefs *self )
+{
+	ofaPrefsPrivate *priv;
+	myISettings *settings;
+	gchar *str;
+
+	priv = ofa_prefs_get_instance_private( self );
+
+	settings = ofa_igetter_get_user_settings( priv->getter );
+	g_return_if_fail( settings && MY_IS_ISETTINGS( settings ));
+
+	str = g_strdup_printf( "%s;",
+			enum_enum_to_code( st_audit_mode, priv->audit_mode, OFA_IDBAUDIT_COMMIT ));
+
+	my_isettings_set_string( settings, HUB_USER_SETTINGS_GROUP, st_audit, str );
+
+	g_free( str );
+}
+
 /**
  * ofa_prefs_check_integrity_get_display_all:
  * @getter: a #ofaIGetter instance.
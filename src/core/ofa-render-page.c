@@ -64,6 +64,12 @@ typedef struct {
 	gdouble        render_height;
 	GList         *dataset;
 	GList         *pages;
+
+	/* asynchronous dataset load
+	 */
+	GCancellable  *cancellable;
+	gchar         *render_label;
+	gboolean       print_after_load;
 }
 	ofaRenderPagePrivate;
 
@@ -93,6 +99,9 @@ static void               setup_page_size( ofaRenderPage *self );
 static GList             *get_dataset( ofaRenderPage *page );
 static void               render_page_free_dataset( ofaRenderPage *page );
 static void               on_render_clicked( GtkButton *button, ofaRenderPage *page );
+static void               load_dataset_async( ofaRenderPage *page, gboolean print_after_load );
+static void               load_dataset_on_ready( GObject *source, GAsyncResult *result, ofaRenderPage *page );
+static void               load_dataset_cancel( ofaRenderPage *page );
 static void               render_pdf_pages( ofaRenderPage *page );
 static void               on_print_clicked( GtkButton *button, ofaRenderPage *page );
 static void               clear_rendered_pages( ofaRenderPage *self );
@@ -117,6 +126,7 @@ static void
 render_page_finalize( GObject *instance )
 {
 	static const gchar *thisfn = "ofa_render_page_finalize";
+	ofaRenderPagePrivate *priv;
 
 	g_debug( "%s: instance=%p (%s)",
 			thisfn, ( void * ) instance, G_OBJECT_TYPE_NAME( instance ));
@@ -124,6 +134,9 @@ render_page_finalize( GObject *instance )
 	g_return_if_fail( instance && OFA_IS_RENDER_PAGE( instance ));
 
 	/* free data members here */
+	priv = ofa_render_page_get_instance_private( OFA_RENDER_PAGE( instance ));
+
+	g_free( priv->render_label );
 
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofa_render_page_parent_class )->finalize( instance );
@@ -132,11 +145,19 @@ render_page_finalize( GObject *instance )
 static void
 render_page_dispose( GObject *instance )
 {
+	ofaRenderPagePrivate *priv;
+
 	g_return_if_fail( instance && OFA_IS_RENDER_PAGE( instance ));
 
 	if( !OFA_PAGE( instance )->prot->dispose_has_run ){
 
 		/* unref object members here */
+		priv = ofa_render_page_get_instance_private( OFA_RENDER_PAGE( instance ));
+
+		if( priv->cancellable ){
+			g_cancellable_cancel( priv->cancellable );
+			g_clear_object( &priv->cancellable );
+		}
 	}
 
 	/* chain up to the parent class */
@@ -344,6 +365,7 @@ ofa_render_page_set_args_changed( ofaRenderPage *page, gboolean is_valid, const
 	priv = ofa_render_page_get_instance_private( page );
 
 	/* clear all datas as well as drawing area */
+	load_dataset_cancel( page );
 	render_page_free_dataset( page );
 	clear_rendered_pages( page );
 	ofa_render_area_clear( priv->render_area );
@@ -398,11 +420,23 @@ on_render_clicked( GtkButton *button, ofaRenderPage *page )
 
 	priv = ofa_render_page_get_instance_private( page );
 
+	/* while loading, the render button acts as a cancel button */
+	if( priv->cancellable ){
+		load_dataset_cancel( page );
+		set_message( page, _( "Cancelled by the user." ), MSG_INFO );
+		return;
+	}
+
 	/* clear all datas as well as drawing area */
 	render_page_free_dataset( page );
 	clear_rendered_pages( page );
 	ofa_render_area_clear( priv->render_area );
 
+	if( OFA_RENDER_PAGE_GET_CLASS( page )->get_dataset_async ){
+		load_dataset_async( page, FALSE );
+		return;
+	}
+
 	/* render pages */
 	render_pdf_pages( page );
 
@@ -410,6 +444,93 @@ on_render_clicked( GtkButton *button, ofaRenderPage *page )
 	ofa_render_area_queue_draw( priv->render_area );
 }
 
+/*
+ * Asynchronously load the dataset, then render (and maybe print) the
+ * pages.
+ * The render button is relabeled so that the user may cancel the load.
+ */
+static void
+load_dataset_async( ofaRenderPage *page, gboolean print_after_load )
+{
+	ofaRenderPagePrivate *priv;
+
+	priv = ofa_render_page_get_instance_private( page );
+
+	priv->cancellable = g_cancellable_new();
+	priv->print_after_load = print_after_load;
+
+	g_free( priv->render_label );
+	priv->render_label = g_strdup( gtk_button_get_label( GTK_BUTTON( priv->render_btn )));
+	gtk_button_set_label( GTK_BUTTON( priv->render_btn ), _( "_Cancel" ));
+	gtk_widget_set_sensitive( priv->print_btn, FALSE );
+
+	progress_begin( page );
+	g_signal_emit_by_name( priv->progress_bar, "my-text", _( "Loading the dataset..." ));
+
+	OFA_RENDER_PAGE_GET_CLASS( page )->get_dataset_async(
+			page, priv->cancellable, ( GAsyncReadyCallback ) load_dataset_on_ready, g_object_ref( page ));
+}
+
+static void
+load_dataset_on_ready( GObject *source, GAsyncResult *result, ofaRenderPage *page )
+{
+	ofaRenderPagePrivate *priv;
+	GList *dataset;
+	GError *error;
+
+	priv = ofa_render_page_get_instance_private( page );
+
+	error = NULL;
+	dataset = OFA_RENDER_PAGE_GET_CLASS( page )->get_dataset_finish( page, result, &error );
+
+	if( error ){
+		if( !g_error_matches( error, G_IO_ERROR, G_IO_ERROR_CANCELLED ) &&
+				!OFA_PAGE( page )->prot->dispose_has_run ){
+			load_dataset_cancel( page );
+			set_message( page, error->message, MSG_ERROR );
+		}
+		g_error_free( error );
+
+	} else if( OFA_PAGE( page )->prot->dispose_has_run ){
+		if( OFA_RENDER_PAGE_GET_CLASS( page )->free_dataset ){
+			OFA_RENDER_PAGE_GET_CLASS( page )->free_dataset( page, dataset );
+		}
+
+	} else {
+		load_dataset_cancel( page );
+		priv->dataset = dataset;
+
+		render_pdf_pages( page );
+		ofa_render_area_queue_draw( priv->render_area );
+
+		if( priv->print_after_load ){
+			on_print_clicked( GTK_BUTTON( priv->print_btn ), page );
+		}
+	}
+
+	g_object_unref( page );
+}
+
+/*
+ * Cancel the current load, if any, and restore the buttons.
+ */
+static void
+load_dataset_cancel( ofaRenderPage *page )
+{
+	ofaRenderPagePrivate *priv;
+
+	priv = ofa_render_page_get_instance_private( page );
+
+	if( priv->cancellable ){
+		g_cancellable_cancel( priv->cancellable );
+		g_clear_object( &priv->cancellable );
+
+		gtk_button_set_label( GTK_BUTTON( priv->render_btn ), priv->render_label );
+		gtk_widget_set_sensitive( priv->print_btn, TRUE );
+		progress_end( page );
+	}
+}
+
 static void
 render_pdf_pages( ofaRenderPage *page )
 {
@@ -473,6 +594,13 @@ on_print_clicked( GtkButton *button, ofaRenderPage *page )
 
 	priv = ofa_render_page_get_instance_private( page );
 
+	if( !priv->pages && !priv->dataset && OFA_RENDER_PAGE_GET_CLASS( page )->get_dataset_async ){
+		if( !priv->cancellable ){
+			load_dataset_async( page, TRUE );
+		}
+		return;
+	}
+
 	if( !priv->pages ){
 		render_pdf_pages( page );
 	}
@@ -109,11 +109,13 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ACC_NUMBER ),
 				OFA_TYPE_STRING,
 				TRUE,					/* importable */
-				FALSE },				/* amount, counter: export zero as empty */
+				FALSE,					/* amount, counter: export zero as empty */
+				TRUE },
 		{ OFA_BOX_CSV( ACC_CRE_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ACC_CRE_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -125,7 +127,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ACC_CURRENCY ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ACC_ROOT ),
 				OFA_TYPE_STRING,
 				TRUE,
@@ -161,7 +164,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ACC_UPD_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ACC_UPD_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -205,7 +209,8 @@ static const ofsBoxDef st_archive_defs[] = {
 		{ OFA_BOX_CSV( ACC_NUMBER ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ACC_ARC_DATE ),
 				OFA_TYPE_DATE,
 				TRUE,
@@ -229,7 +234,8 @@ static const ofsBoxDef st_doc_defs[] = {
 		{ OFA_BOX_CSV( ACC_NUMBER ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ACC_DOC_ID ),
 				OFA_TYPE_COUNTER,
 				TRUE,
@@ -243,6 +249,7 @@ static const ofsBoxDef st_doc_defs[] = {
 typedef struct {
 	GList *archives;					/* archived balances of the account */
 	GList *docs;
+	gchar *number_key;					/* collation key of the account number */
 }
 	ofoAccountPrivate;
 
@@ -314,7 +321,7 @@ static gboolean            account_do_update( ofoAccount *account, const ofaIDBC
 static gboolean            account_do_update_arc( ofoAccount *account, const ofaIDBConnect *connect, const gchar *prev_number );
 static gboolean            account_do_update_amounts( ofoAccount *account, ofaIGetter *getter );
 static gboolean            account_do_delete( ofoAccount *account, const ofaIDBConnect *connect );
-static gint                account_cmp_by_number( const ofoAccount *a, const gchar *number );
+static gint                account_cmp_by_number_key( const ofoAccount *a, const gchar *number_key );
 static void                icollectionable_iface_init( myICollectionableInterface *iface );
 static guint               icollectionable_get_interface_version( void );
 static GList              *icollectionable_load_collection( void *user_data );
@@ -385,6 +392,7 @@ static void
 account_finalize( GObject *instance )
 {
 	static const gchar *thisfn = "ofo_account_finalize";
+	ofoAccountPrivate *priv;
 
 	g_debug( "%s: instance=%p (%s): %s - %s",
 			thisfn, ( void * ) instance, G_OBJECT_TYPE_NAME( instance ),
@@ -395,6 +403,8 @@ account_finalize( GObject *instance )
 
 	/* free data members here */
 	archives_list_free( OFO_ACCOUNT( instance ));
+	priv = ofo_account_get_instance_private( OFO_ACCOUNT( instance ));
+	g_free( priv->number_key );
 
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofo_account_parent_class )->finalize( instance );
@@ -427,6 +437,7 @@ ofo_account_init( ofoAccount *self )
 
 	priv->archives = NULL;
 	priv->docs = NULL;
+	priv->number_key = NULL;
 }
 
 static void
@@ -520,13 +531,21 @@ ofo_account_get_by_number( ofaIGetter *getter, const gchar *number )
 	return( account_find_by_number( dataset, number ));
 }
 
+/*
+ * The collation key of the searched number is computed once, and then
+ * only compared to the cached keys of the accounts.
+ */
 static ofoAccount *
 account_find_by_number( GList *set, const gchar *number )
 {
 	GList *found;
+	gchar *number_key;
 
+	number_key = my_collate_key( number );
 	found = g_list_find_custom(
-				set, number, ( GCompareFunc ) account_cmp_by_number );
+				set, number_key, ( GCompareFunc ) account_cmp_by_number_key );
+	g_free( number_key );
+
 	if( found ){
 		return( OFO_ACCOUNT( found->data ));
 	}
@@ -624,6 +643,37 @@ ofo_account_get_number( const ofoAccount *account )
 	account_get_string( ACC_NUMBER );
 }
 
+/**
+ * ofo_account_get_number_key:
+ * @account: the #ofoAccount account
+ *
+ * Returns: the collation key of the number of the @account, as
+ * computed by my_collate_key().
+ *
+ * The key is computed on first request, and kept until the number
+ * be modified. Comparing two keys with g_strcmp0() gives the same
+ * result than comparing the account numbers with my_collate().
+ *
+ * The returned value is owned by the @account, and should not be
+ * released by the caller.
+ */
+const gchar *
+ofo_account_get_number_key( const ofoAccount *account )
+{
+	ofoAccountPrivate *priv;
+
+	g_return_val_if_fail( account && OFO_IS_ACCOUNT( account ), NULL );
+	g_return_val_if_fail( !OFO_BASE( account )->prot->dispose_has_run, NULL );
+
+	priv = ofo_account_get_instance_private(( ofoAccount * ) account );
+
+	if( !priv->number_key ){
+		priv->number_key = my_collate_key( ofo_account_get_number( account ));
+	}
+
+	return( priv->number_key );
+}
+
 /**
  * ofo_account_get_cre_user:
  * @account: the #ofoAccount account
@@ -1064,7 +1114,8 @@ ofo_account_get_solde_at_date( ofoAccount *account, const GDate *date, GDate *de
 
 	for( it=dataset ; it ; it=it->next ){
 		entry = OFO_ENTRY( it->data );
-		if( my_collate( ofo_entry_get_account( entry ), acc_number ) != 0 ){
+		/* both account numbers are interned strings */
+		if( ofo_entry_get_account( entry ) != acc_number ){
 			continue;
 		}
 		status = ofo_entry_get_status( entry );
@@ -1342,8 +1393,10 @@ ofo_account_is_child_of( const ofoAccount *account, const gchar *candidate )
 
 	account_number = ofo_account_get_number( account );
 
+	/* a string which starts with the account number is greater than it
+	 * as soon as it is longer */
 	is_child = g_str_has_prefix( candidate, account_number ) &&
-				g_utf8_collate( candidate, account_number ) > 0;
+				strlen( candidate ) > strlen( account_number );
 
 	return( is_child );
 }
@@ -1445,7 +1498,13 @@ ofo_account_get_balance_type_short( ofeAccountType type )
 void
 ofo_account_set_number( ofoAccount *account, const gchar *number )
 {
+	ofoAccountPrivate *priv;
+
 	account_set_string( ACC_NUMBER, number );
+
+	priv = ofo_account_get_instance_private( account );
+	g_free( priv->number_key );
+	priv->number_key = NULL;
 }
 
 /*
@@ -2581,9 +2640,9 @@ account_do_delete( ofoAccount *account, const ofaIDBConnect *connect )
 }
 
 static gint
-account_cmp_by_number( const ofoAccount *a, const gchar *number )
+account_cmp_by_number_key( const ofoAccount *a, const gchar *number_key )
 {
-	return( my_collate( ofo_account_get_number( a ), number ));
+	return( g_strcmp0( ofo_account_get_number_key( a ), number_key ));
 }
 
 /*
@@ -38,7 +38,11 @@ typedef struct {
 
 	/* initialization
 	 */
-	ofaIGetter *getter;
+	ofaIGetter  *getter;
+
+	/* runtime
+	 */
+	ofaBoxArena *arena;					/* when loaded in an arena */
 }
 	ofoBasePrivate;
 
@@ -48,21 +52,47 @@ enum {
 	PROP_GETTER_ID = 1,
 };
 
+/* an asynchronous dataset load
+ * the rows are read by the worker thread of the connection, then
+ * parsed and allocated as objects in a thread of the GTask pool
+ */
+typedef struct {
+	const ofsBoxDef *defs;
+	GType            type;
+	ofaIGetter      *getter;
+	gboolean         in_arena;
+	GSList          *rows;
+}
+	sLoadDataset;
+
+static GList *load_dataset( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter, gboolean in_arena );
+static void   load_dataset_async( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter, gboolean in_arena, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data );
+static void   load_dataset_on_rows( ofaIDBConnect *connect, GAsyncResult *result, GTask *task );
+static void   load_dataset_thread( GTask *task, gpointer source, sLoadDataset *sload, GCancellable *cancellable );
+static void   load_dataset_free( sLoadDataset *sload );
+static GList *load_rows( const ofsBoxDef *defs, const ofaIDBConnect *cnx, const gchar *from, ofaBoxArena *arena );
+static GList *dataset_from_rows( GList *rows, GType type, ofaIGetter *getter, ofaBoxArena *arena );
+static void   free_dataset( GList *dataset );
+
 G_DEFINE_TYPE_EXTENDED( ofoBase, ofo_base, G_TYPE_OBJECT, 0,
 		G_ADD_PRIVATE( ofoBase ))
 
 static void
 base_finalize( GObject *instance )
 {
+	ofoBasePrivate *priv;
 	ofoBaseProtected *prot;
 
 	/* free data members here */
+	priv = ofo_base_get_instance_private( OFO_BASE( instance ));
 	prot = OFO_BASE( instance )->prot;
 
 	/* only free ofaBox fields list here so that it is left available
-	 * in finalize method of the child classes */
+	 * in finalize method of the child classes;
+	 * the arena, if any, must survive the fields list */
 	ofa_box_free_fields_list( prot->fields );
 	prot->fields = NULL;
+	ofa_box_arena_unref( priv->arena );
 
 	g_free( prot );
 
@@ -151,6 +181,11 @@ base_set_property( GObject *instance, guint property_id, const GValue *value, GP
 static void
 ofo_base_init( ofoBase *self )
 {
+	ofoBasePrivate *priv;
+
+	priv = ofo_base_get_instance_private( self );
+	priv->arena = NULL;
+
 	self->prot = g_new0( ofoBaseProtected, 1 );
 	self->prot->dispose_has_run = FALSE;
 	self->prot->fields = NULL;
@@ -206,33 +241,262 @@ ofo_base_init_fields_list( const ofsBoxDef *defs )
 GList *
 ofo_base_load_dataset( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter )
 {
-	static const gchar *thisfn = "ofo_base_load_dataset";
-	const ofaIDBConnect *connect;
-	ofoBase *object;
-	GList *rows, *dataset, *it;
-	ofaHub *hub;
+	g_return_val_if_fail( defs, NULL );
+	g_return_val_if_fail( type, NULL );
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
+
+	return( load_dataset( defs, from, type, getter, FALSE ));
+}
 
+/**
+ * ofo_base_load_dataset_in_arena:
+ * @defs: the #ofsBoxDefs list of field definitions for this object
+ * @from: the 'from' part of the query
+ * @type: the #GType of the #ofoBase -derived object to be allocated
+ * @getter: a #ofaIGetter instance.
+ *
+ * Load the dataset for the specified @type class, allocating the
+ * fields of all the objects in large blocks of a shared #ofaBoxArena.
+ *
+ * This is meant for read-mostly datasets (e.g. the datasets loaded to
+ * be rendered or exported): the objects behave as usual, but the
+ * structure of their fields list must not be modified, and the arena
+ * is only released with the last object of the dataset.
+ *
+ * Returns: the ordered list of loaded objects.
+ */
+GList *
+ofo_base_load_dataset_in_arena( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter )
+{
 	g_return_val_if_fail( defs, NULL );
 	g_return_val_if_fail( type, NULL );
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 
-	dataset = NULL;
+	return( load_dataset( defs, from, type, getter, TRUE ));
+}
+
+static GList *
+load_dataset( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter, gboolean in_arena )
+{
+	static const gchar *thisfn = "ofo_base_load_dataset";
+	const ofaIDBConnect *connect;
+	GList *rows, *dataset;
+	ofaHub *hub;
+	ofaBoxArena *arena;
+
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
-	rows = ofo_base_load_rows( defs, connect, from );
+	arena = in_arena ? ofa_box_arena_new() : NULL;
+	rows = load_rows( defs, connect, from, arena );
+	dataset = dataset_from_rows( rows, type, getter, arena );
+	ofa_box_arena_unref( arena );
+
+	g_debug( "%s: type=%s, count=%d, in_arena=%s",
+			thisfn, g_type_name( type ), g_list_length( dataset ), in_arena ? "True":"False" );
+
+	return( dataset );
+}
+
+/**
+ * ofo_base_load_dataset_async:
+ * @defs: the #ofsBoxDefs list of field definitions for this object
+ * @from: the 'from' part of the query
+ * @type: the #GType of the #ofoBase -derived object to be allocated
+ * @getter: a #ofaIGetter instance.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the dataset
+ *  is loaded.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously load the full dataset for the specified @type class.
+ *
+ * The query is run by the worker thread of the dossier connection,
+ * and the objects are allocated in another thread, so that the main
+ * loop is not blocked. The @callback is called from the main loop, and
+ * should call #ofo_base_load_dataset_finish() to get the dataset.
+ */
+void
+ofo_base_load_dataset_async( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter,
+								GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	g_return_if_fail( defs );
+	g_return_if_fail( type );
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	load_dataset_async( defs, from, type, getter, FALSE, cancellable, callback, user_data );
+}
+
+/**
+ * ofo_base_load_dataset_in_arena_async:
+ * @defs: the #ofsBoxDefs list of field definitions for this object
+ * @from: the 'from' part of the query
+ * @type: the #GType of the #ofoBase -derived object to be allocated
+ * @getter: a #ofaIGetter instance.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the dataset
+ *  is loaded.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously load the dataset for the specified @type class, as
+ * #ofo_base_load_dataset_in_arena() does.
+ *
+ * The @callback should call #ofo_base_load_dataset_finish() to get
+ * the dataset.
+ */
+void
+ofo_base_load_dataset_in_arena_async( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter,
+								GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	g_return_if_fail( defs );
+	g_return_if_fail( type );
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	load_dataset_async( defs, from, type, getter, TRUE, cancellable, callback, user_data );
+}
+
+static void
+load_dataset_async( const ofsBoxDef *defs, const gchar *from, GType type, ofaIGetter *getter, gboolean in_arena,
+								GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	sLoadDataset *sload;
+	GTask *task;
+	gchar *columns, *query;
+	ofaHub *hub;
+
+	task = g_task_new( NULL, cancellable, callback, user_data );
+
+	sload = g_new0( sLoadDataset, 1 );
+	sload->defs = defs;
+	sload->type = type;
+	sload->getter = getter;
+	sload->in_arena = in_arena;
+	g_task_set_task_data( task, sload, ( GDestroyNotify ) load_dataset_free );
+
+	columns = ofa_box_dbms_get_columns_list( defs );
+	query = g_strdup_printf( "SELECT %s FROM %s", columns, from );
+	g_free( columns );
+
+	hub = ofa_igetter_get_hub( getter );
+	ofa_idbconnect_query_async(
+			ofa_hub_get_connect( hub ), query, cancellable, ( GAsyncReadyCallback ) load_dataset_on_rows, task );
+
+	g_free( query );
+}
+
+/*
+ * Main loop: the rows have been read, parse them in a thread
+ */
+static void
+load_dataset_on_rows( ofaIDBConnect *connect, GAsyncResult *result, GTask *task )
+{
+	sLoadDataset *sload;
+	GError *error;
+
+	sload = ( sLoadDataset * ) g_task_get_task_data( task );
+	error = NULL;
+
+	if( ofa_idbconnect_query_finish( connect, result, &sload->rows, &error )){
+		g_task_run_in_thread( task, ( GTaskThreadFunc ) load_dataset_thread );
+
+	} else {
+		g_task_return_error( task, error );
+	}
+
+	g_object_unref( task );
+}
+
+/*
+ * GTask thread: the box parsers and the objects constructors do not
+ * use any unprotected shared data
+ */
+static void
+load_dataset_thread( GTask *task, gpointer source, sLoadDataset *sload, GCancellable *cancellable )
+{
+	static const gchar *thisfn = "ofo_base_load_dataset_thread";
+	GSList *irow;
+	GList *fields, *dataset;
+	ofaBoxArena *arena;
+
+	if( g_task_return_error_if_cancelled( task )){
+		return;
+	}
+
+	arena = sload->in_arena ? ofa_box_arena_new() : NULL;
+	fields = NULL;
+	for( irow=sload->rows ; irow ; irow=irow->next ){
+		fields = g_list_prepend( fields, ofa_box_dbms_parse_result_ex( sload->defs, irow, arena ));
+	}
+	ofa_idbconnect_free_results( sload->rows );
+	sload->rows = NULL;
+	dataset = dataset_from_rows( g_list_reverse( fields ), sload->type, sload->getter, arena );
+	ofa_box_arena_unref( arena );
+
+	g_debug( "%s: type=%s, count=%d", thisfn, g_type_name( sload->type ), g_list_length( dataset ));
+
+	g_task_return_pointer( task, dataset, ( GDestroyNotify ) free_dataset );
+}
+
+static void
+load_dataset_free( sLoadDataset *sload )
+{
+	ofa_idbconnect_free_results( sload->rows );
+	g_free( sload );
+}
+
+/**
+ * ofo_base_load_dataset_finish:
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: [allow-none]: a placeholder for a #GError.
+ *
+ * Finishes an asynchronous load started with
+ * #ofo_base_load_dataset_async().
+ *
+ * Returns: the ordered list of loaded objects, or %NULL if an error
+ * has occurred or the load has been cancelled.
+ */
+GList *
+ofo_base_load_dataset_finish( GAsyncResult *result, GError **error )
+{
+	g_return_val_if_fail( g_task_is_valid( result, NULL ), NULL );
+
+	return( g_task_propagate_pointer( G_TASK( result ), error ));
+}
+
+/*
+ * Allocate an object of @type for each row of @rows, the object taking
+ * the ownership of the fields list, and a reference on the @arena the
+ * fields have been allocated from.
+ * @rows is freed here.
+ */
+static GList *
+dataset_from_rows( GList *rows, GType type, ofaIGetter *getter, ofaBoxArena *arena )
+{
+	ofoBase *object;
+	ofoBasePrivate *priv;
+	GList *dataset, *it;
+
+	dataset = NULL;
 
 	for( it=rows ; it ; it=it->next ){
 		object = g_object_new( type, "ofo-base-getter", getter, NULL );
 		object->prot->fields = it->data;
+		if( arena ){
+			priv = ofo_base_get_instance_private( object );
+			priv->arena = ofa_box_arena_ref( arena );
+		}
 		dataset = g_list_prepend( dataset, object );
 	}
 	g_list_free( rows );
 
-	g_debug( "%s: type=%s, count=%d", thisfn, g_type_name( type ), g_list_length( dataset ));
-
 	return( g_list_reverse( dataset ));
 }
 
+static void
+free_dataset( GList *dataset )
+{
+	g_list_free_full( dataset, ( GDestroyNotify ) g_object_unref );
+}
+
 /**
  * ofo_base_load_rows:
  * @defs: the #ofsBoxDefs list of field definitions for this object
@@ -245,14 +509,20 @@ ofo_base_load_dataset( const ofsBoxDef *defs, const gchar *from, GType type, ofa
  */
 GList *
 ofo_base_load_rows( const ofsBoxDef *defs, const ofaIDBConnect *cnx, const gchar *from )
+{
+	g_return_val_if_fail( defs, NULL );
+	g_return_val_if_fail( cnx && OFA_IS_IDBCONNECT( cnx ), NULL );
+
+	return( load_rows( defs, cnx, from, NULL ));
+}
+
+static GList *
+load_rows( const ofsBoxDef *defs, const ofaIDBConnect *cnx, const gchar *from, ofaBoxArena *arena )
 {
 	gchar *columns, *query;
 	GSList *result, *irow;
 	GList *rows;
 
-	g_return_val_if_fail( defs, NULL );
-	g_return_val_if_fail( cnx && OFA_IS_IDBCONNECT( cnx ), NULL );
-
 	rows = NULL;
 	columns = ofa_box_dbms_get_columns_list( defs );
 	query = g_strdup_printf( "SELECT %s FROM %s", columns, from );
@@ -260,7 +530,7 @@ ofo_base_load_rows( const ofsBoxDef *defs, const ofaIDBConnect *cnx, const gchar
 
 	if( ofa_idbconnect_query_ex( cnx, query, &result, TRUE )){
 		for( irow=result ; irow ; irow=irow->next ){
-			rows = g_list_prepend( rows, ofa_box_dbms_parse_result( defs, irow ));
+			rows = g_list_prepend( rows, ofa_box_dbms_parse_result_ex( defs, irow, arena ));
 		}
 		ofa_idbconnect_free_results( result );
 	}
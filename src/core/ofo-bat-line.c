@@ -53,18 +53,24 @@ typedef struct {
 
 	/* dbms data
 	 */
-	ofxCounter bat_id;						/* bat (imported file) id */
-	ofxCounter line_id;						/* line id */
-	GDate      deffect;
-	GDate      dope;
-	gchar     *ref;
-	gchar     *label;
-	gchar     *currency;
-	ofxAmount  amount;
+	ofxCounter   bat_id;					/* bat (imported file) id */
+	ofxCounter   line_id;					/* line id */
+	GDate        deffect;
+	GDate        dope;
+	gchar       *ref;
+	gchar       *label;
+	const gchar *currency;					/* interned */
+	ofxAmount    amount;
 }
 	ofoBatLinePrivate;
 
+#define BAT_LINE_SELECT                 "SELECT BAT_ID,BAT_LINE_ID,BAT_LINE_DEFFECT,BAT_LINE_DOPE," \
+											"	BAT_LINE_REF,BAT_LINE_LABEL,BAT_LINE_CURRENCY," \
+											"	BAT_LINE_AMOUNT " \
+											"	FROM OFA_T_BAT_LINES "
+
 static GList       *bat_line_load_dataset( ofaIGetter *getter, const gchar *where );
+static GList       *bat_line_dataset_from_result( ofaIGetter *getter, GSList *result );
 static gchar       *intlist_to_str( GList *list );
 static const GDate *bat_line_get_dope( ofoBatLine *bat );
 static const gchar *bat_line_get_label( ofoBatLine *bat );
@@ -96,7 +102,7 @@ bat_line_finalize( GObject *instance )
 	/* free data members here */
 	g_free( priv->ref );
 	g_free( priv->label );
-	g_free( priv->currency );
+	my_utils_intern_unref( priv->currency );
 
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofo_bat_line_parent_class )->finalize( instance );
@@ -155,18 +161,27 @@ GList *
 ofo_bat_line_get_dataset( ofaIGetter *getter, ofxCounter bat_id )
 {
 	static const gchar *thisfn = "ofo_bat_line_get_dataset";
+	ofaHub *hub;
+	const ofaIDBConnect *connect;
+	ofsIDBStatement *stmt;
+	GSList *result;
 	GList *dataset;
-	gchar *where;
 
 	g_debug( "%s: getter=%p, bat_id=%lu", thisfn, ( void * ) getter, bat_id );
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 
-	where = g_strdup_printf( "WHERE BAT_ID=%ld", bat_id );
+	dataset = NULL;
+	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
 
-	dataset = bat_line_load_dataset( getter, where );
+	stmt = ofa_idbconnect_prepare( connect, BAT_LINE_SELECT "WHERE BAT_ID=?" );
+	ofa_idbconnect_bind_int( stmt, 0, bat_id );
 
-	g_free( where );
+	if( ofa_idbconnect_execute_ex( connect, stmt, &result, TRUE )){
+		dataset = bat_line_dataset_from_result( getter, result );
+		ofa_idbconnect_free_results( result );
+	}
 
 	return( dataset );
 }
@@ -181,58 +196,67 @@ bat_line_load_dataset( ofaIGetter *getter, const gchar *where )
 	ofaHub *hub;
 	const ofaIDBConnect *connect;
 	gchar *query;
-	GSList *result, *irow, *icol;
+	GSList *result;
 	GList *dataset;
-	ofxCounter bat_id;
-	ofoBatLine *line;
-	GDate date;
 
 	dataset = NULL;
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
 
-	query = g_strdup_printf(
-					"SELECT BAT_ID,BAT_LINE_ID,BAT_LINE_DEFFECT,BAT_LINE_DOPE,"
-					"	BAT_LINE_REF,BAT_LINE_LABEL,BAT_LINE_CURRENCY,"
-					"	BAT_LINE_AMOUNT "
-					"	FROM OFA_T_BAT_LINES %s", where ? where : "" );
+	query = g_strdup_printf( BAT_LINE_SELECT "%s", where ? where : "" );
 
 	if( ofa_idbconnect_query_ex( connect, query, &result, TRUE )){
-		for( irow=result ; irow ; irow=irow->next ){
-			icol = ( GSList * ) irow->data;
-			bat_id = atol(( gchar * ) icol->data );
-			line = ofo_bat_line_new( getter );
-			ofo_bat_line_set_bat_id( line, bat_id );
-			icol = icol->next;
-			bat_line_set_line_id( line, atol(( gchar * ) icol->data ));
-			icol = icol->next;
-			my_date_set_from_sql( &date, ( const gchar * ) icol->data );
-			ofo_bat_line_set_deffect( line, &date );
-			icol = icol->next;
-			if( icol->data ){
-				my_date_set_from_sql( &date, ( const gchar * ) icol->data );
-				ofo_bat_line_set_dope( line, &date );
-			}
-			icol = icol->next;
-			if( icol->data ){
-				ofo_bat_line_set_ref( line, ( gchar * ) icol->data );
-			}
-			icol = icol->next;
-			ofo_bat_line_set_label( line, ( gchar * ) icol->data );
-			icol = icol->next;
-			if( icol->data ){
-				ofo_bat_line_set_currency( line, ( gchar * ) icol->data );
-			}
-			icol = icol->next;
-			ofo_bat_line_set_amount( line,
-					my_double_set_from_sql(( const gchar * ) icol->data ));
-
-			dataset = g_list_prepend( dataset, line );
-		}
+		dataset = bat_line_dataset_from_result( getter, result );
 		ofa_idbconnect_free_results( result );
 	}
 	g_free( query );
 
+	return( dataset );
+}
+
+static GList *
+bat_line_dataset_from_result( ofaIGetter *getter, GSList *result )
+{
+	GSList *irow, *icol;
+	GList *dataset;
+	ofxCounter bat_id;
+	ofoBatLine *line;
+	GDate date;
+
+	dataset = NULL;
+
+	for( irow=result ; irow ; irow=irow->next ){
+		icol = ( GSList * ) irow->data;
+		bat_id = atol(( gchar * ) icol->data );
+		line = ofo_bat_line_new( getter );
+		ofo_bat_line_set_bat_id( line, bat_id );
+		icol = icol->next;
+		bat_line_set_line_id( line, atol(( gchar * ) icol->data ));
+		icol = icol->next;
+		my_date_set_from_sql( &date, ( const gchar * ) icol->data );
+		ofo_bat_line_set_deffect( line, &date );
+		icol = icol->next;
+		if( icol->data ){
+			my_date_set_from_sql( &date, ( const gchar * ) icol->data );
+			ofo_bat_line_set_dope( line, &date );
+		}
+		icol = icol->next;
+		if( icol->data ){
+			ofo_bat_line_set_ref( line, ( gchar * ) icol->data );
+		}
+		icol = icol->next;
+		ofo_bat_line_set_label( line, ( gchar * ) icol->data );
+		icol = icol->next;
+		if( icol->data ){
+			ofo_bat_line_set_currency( line, ( gchar * ) icol->data );
+		}
+		icol = icol->next;
+		ofo_bat_line_set_amount( line,
+				my_double_set_from_sql(( const gchar * ) icol->data ));
+
+		dataset = g_list_prepend( dataset, line );
+	}
+
 	return( g_list_reverse( dataset ));
 }
 
@@ -293,6 +317,7 @@ ofo_bat_line_get_dataset_for_print_reconcil( ofaIGetter *getter,
 	ofaIDBConnect *connect;
 	GList *bats, *lines, *dataset;
 	gchar *sdate, *slist, *query, *where;
+	ofsIDBStatement *stmt;
 	GSList *result, *irow, *icol;
 	gboolean ok;
 	GDate row_end;
@@ -315,10 +340,10 @@ ofo_bat_line_get_dataset_for_print_reconcil( ofaIGetter *getter,
 
 	/* get the list of candidates BAT files,
 	 * stopping at the first after the requested date */
-	query = g_strdup_printf(
-				"SELECT BAT_ID,BAT_END FROM OFA_T_BAT WHERE BAT_ACCOUNT='%s' ORDER BY BAT_END",
-				account_id );
-	ok = ofa_idbconnect_query_ex( connect, query, &result, TRUE );
+	stmt = ofa_idbconnect_prepare( connect,
+				"SELECT BAT_ID,BAT_END FROM OFA_T_BAT WHERE BAT_ACCOUNT=? ORDER BY BAT_END" );
+	ofa_idbconnect_bind_string( stmt, 0, account_id );
+	ok = ofa_idbconnect_execute_ex( connect, stmt, &result, TRUE );
 	if( ok ){
 		for( irow=result ; irow ; irow=irow->next ){
 			icol = ( GSList * ) irow->data;
@@ -335,7 +360,6 @@ ofo_bat_line_get_dataset_for_print_reconcil( ofaIGetter *getter,
 		}
 		ofa_idbconnect_free_results( result );
 	}
-	g_free( query );
 
 	/* now get the list of bat lines id's
 	 * which are not conciliated
@@ -430,7 +454,7 @@ ofo_bat_line_get_bat_id_from_bat_line_id( ofaIGetter *getter, ofxCounter line_id
 {
 	ofaHub *hub;
 	const ofaIDBConnect *connect;
-	GString *query;
+	ofsIDBStatement *stmt;
 	GSList *result, *icol;
 	ofxCounter bat_id;
 
@@ -440,10 +464,10 @@ ofo_bat_line_get_bat_id_from_bat_line_id( ofaIGetter *getter, ofxCounter line_id
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
 
-	query = g_string_new( "SELECT BAT_ID FROM OFA_T_BAT_LINES " );
-	g_string_append_printf( query, "WHERE BAT_LINE_ID=%ld", line_id );
+	stmt = ofa_idbconnect_prepare( connect, "SELECT BAT_ID FROM OFA_T_BAT_LINES WHERE BAT_LINE_ID=?" );
+	ofa_idbconnect_bind_int( stmt, 0, line_id );
 
-	if( ofa_idbconnect_query_ex( connect, query->str, &result, TRUE )){
+	if( ofa_idbconnect_execute_ex( connect, stmt, &result, TRUE )){
 		if( result ){
 			icol = ( GSList * ) result->data;
 			if( icol ){
@@ -452,7 +476,6 @@ ofo_bat_line_get_bat_id_from_bat_line_id( ofaIGetter *getter, ofxCounter line_id
 			ofa_idbconnect_free_results( result );
 		}
 	}
-	g_string_free( query, TRUE );
 
 	return( bat_id );
 }
@@ -754,8 +777,8 @@ ofo_bat_line_set_currency( ofoBatLine *bat, const gchar *currency )
 
 	priv = ofo_bat_line_get_instance_private( bat );
 
-	g_free( priv->currency );
-	priv->currency = g_strdup( currency );
+	my_utils_intern_unref( priv->currency );
+	priv->currency = my_utils_intern_ref( currency );
 }
 
 /**
@@ -814,13 +837,12 @@ static gboolean
 bat_line_insert_main( ofoBatLine *bat, ofaIGetter *getter )
 {
 	ofaHub *hub;
-	GString *query;
-	gchar *str;
-	const GDate *dope;
+	ofsIDBStatement *stmt;
 	gboolean ok;
 	const gchar *cur_code;
 	ofoCurrency *cur_obj;
 	const ofaIDBConnect *connect;
+	guint digits;
 
 	cur_code = ofo_bat_line_get_currency( bat );
 	cur_obj = my_strlen( cur_code ) ? ofo_currency_get_by_code( getter, cur_code ) : NULL;
@@ -828,60 +850,24 @@ bat_line_insert_main( ofoBatLine *bat, ofaIGetter *getter )
 
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
+	digits = cur_obj ? ofo_currency_get_digits( cur_obj ) : HUB_DEFAULT_DECIMALS_AMOUNT;
 
-	query = g_string_new( "INSERT INTO OFA_T_BAT_LINES" );
-
-	str = my_date_to_str( ofo_bat_line_get_deffect( bat ), MY_DATE_SQL );
-
-	g_string_append_printf( query,
+	stmt = ofa_idbconnect_prepare( connect,
+			"INSERT INTO OFA_T_BAT_LINES"
 			"	(BAT_ID,BAT_LINE_ID,BAT_LINE_DEFFECT,BAT_LINE_DOPE,BAT_LINE_REF,"
 			"	 BAT_LINE_LABEL,BAT_LINE_CURRENCY,BAT_LINE_AMOUNT) "
-			"	VALUES (%ld,%ld,'%s',",
-					ofo_bat_line_get_bat_id( bat ),
-					ofo_bat_line_get_line_id( bat ),
-					str );
-	g_free( str );
-
-	dope = bat_line_get_dope( bat );
-	if( my_date_is_valid( dope )){
-		str = my_date_to_str( dope, MY_DATE_SQL );
-		g_string_append_printf( query, "'%s',", str );
-		g_free( str );
-	} else {
-		query = g_string_append( query, "NULL," );
-	}
-
-	str = my_utils_quote_sql( ofo_bat_line_get_ref( bat ));
-	if( my_strlen( str )){
-		g_string_append_printf( query, "'%s',", str );
-	} else {
-		query = g_string_append( query, "NULL," );
-	}
-	g_free( str );
-
-	str = my_utils_quote_sql( bat_line_get_label( bat ));
-	if( my_strlen( str )){
-		g_string_append_printf( query, "'%s',", str );
-	} else {
-		query = g_string_append( query, "NULL," );
-	}
-	g_free( str );
-
-	if( my_strlen( cur_code )){
-		g_string_append_printf( query, "'%s',", cur_code );
-	} else {
-		query = g_string_append( query, "NULL," );
-	}
-
-	str = ofa_amount_to_sql( ofo_bat_line_get_amount( bat ), cur_obj );
-	g_string_append_printf( query, "%s", str );
-	g_free( str );
-
-	query = g_string_append( query, ")" );
-
-	ok = ofa_idbconnect_query( connect, query->str, TRUE );
-
-	g_string_free( query, TRUE );
+			"	VALUES (?,?,?,?,?,?,?,?)" );
+
+	ofa_idbconnect_bind_int( stmt, 0, ofo_bat_line_get_bat_id( bat ));
+	ofa_idbconnect_bind_int( stmt, 1, ofo_bat_line_get_line_id( bat ));
+	ofa_idbconnect_bind_date( stmt, 2, ofo_bat_line_get_deffect( bat ));
+	ofa_idbconnect_bind_date( stmt, 3, bat_line_get_dope( bat ));
+	ofa_idbconnect_bind_string( stmt, 4, ofo_bat_line_get_ref( bat ));
+	ofa_idbconnect_bind_string( stmt, 5, bat_line_get_label( bat ));
+	ofa_idbconnect_bind_string( stmt, 6, cur_code );
+	ofa_idbconnect_bind_amount( stmt, 7, ofo_bat_line_get_amount( bat ), digits );
+
+	ok = ofa_idbconnect_execute( connect, stmt, TRUE );
 
 	return( ok );
 }
@@ -51,14 +51,14 @@ typedef struct {
 
 	/* OFA_T_CONCIL table content
 	 */
-	ofxCounter  id;
-	GDate       dval;
-	gchar      *user;
-	myStampVal *stamp;
+	ofxCounter   id;
+	GDate        dval;
+	const gchar *user;						/* interned */
+	myStampVal  *stamp;
 
 	/* OFA_T_CONCIL_IDS table content
 	 */
-	GList     *ids;						/* a list of ofsConcilId records */
+	GList       *ids;						/* a list of ofsConcilId records */
 }
 	ofoConcilPrivate;
 
@@ -96,7 +96,7 @@ concil_finalize( GObject *instance )
 
 	/* free data members here */
 
-	g_free( priv->user );
+	my_utils_intern_unref( priv->user );
 	my_stamp_free( priv->stamp );
 	g_list_free_full( priv->ids, ( GDestroyNotify ) ofs_concil_id_free );
 
@@ -431,8 +431,8 @@ ofo_concil_set_upd_user( ofoConcil *concil, const gchar *user )
 
 	priv = ofo_concil_get_instance_private( concil );
 
-	g_free( priv->user );
-	priv->user = g_strdup( user );
+	my_utils_intern_unref( priv->user );
+	priv->user = my_utils_intern_ref( user );
 }
 
 /**
@@ -465,7 +465,7 @@ concil_add_other_id( ofoConcil *concil, const gchar *type, ofxCounter id )
 	priv = ofo_concil_get_instance_private( concil );
 
 	sid = g_new0( ofsConcilId, 1 );
-	sid->type = g_strdup( type );
+	sid->type = my_utils_intern_ref( type );
 	sid->other_id = id;
 
 	priv->ids = g_list_prepend( priv->ids, ( gpointer ) sid );
@@ -563,6 +563,7 @@ get_other_orphans( ofaIGetter *getter, const gchar *type, const gchar *column, c
 	GList *orphans;
 	GSList *result, *irow, *icol;
 	gchar *query;
+	ofsIDBStatement *stmt;
 	ofxCounter recid;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
@@ -572,10 +573,14 @@ get_other_orphans( ofaIGetter *getter, const gchar *type, const gchar *column, c
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
 
+	/* the column and table are identifiers, which cannot be bound */
 	query = g_strdup_printf( "SELECT DISTINCT(REC_ID) FROM OFA_T_CONCIL_IDS "
-			"	WHERE REC_IDS_TYPE='%s' AND REC_IDS_OTHER NOT IN (SELECT %s FROM %s)", type, column, table );
+			"	WHERE REC_IDS_TYPE=? AND REC_IDS_OTHER NOT IN (SELECT %s FROM %s)", column, table );
 
-	if( ofa_idbconnect_query_ex( connect, query, &result, FALSE )){
+	stmt = ofa_idbconnect_prepare( connect, query );
+	ofa_idbconnect_bind_string( stmt, 0, type );
+
+	if( ofa_idbconnect_execute_ex( connect, stmt, &result, FALSE )){
 		for( irow=result ; irow ; irow=irow->next ){
 			icol = irow->data;
 			recid = atol(( const gchar * ) icol->data );
@@ -629,23 +634,20 @@ ofo_concil_insert( ofoConcil *concil )
 static gboolean
 concil_do_insert( ofoConcil *concil, const ofaIDBConnect *connect )
 {
-	gchar *query, *sdate, *stamp;
+	ofsIDBStatement *stmt;
 	gboolean ok;
 
-	sdate = my_date_to_str( ofo_concil_get_dval( concil ), MY_DATE_SQL );
-	stamp = my_stamp_to_str( ofo_concil_get_upd_stamp( concil ), MY_STAMP_YYMDHMS );
-
-	query = g_strdup_printf(
+	stmt = ofa_idbconnect_prepare( connect,
 			"INSERT INTO OFA_T_CONCIL "
 			"	(REC_ID,REC_DVAL,REC_USER,REC_STAMP) VALUES "
-			"	(%ld,'%s','%s','%s')",
-			ofo_concil_get_id( concil ), sdate, ofo_concil_get_upd_user( concil ), stamp );
+			"	(?,?,?,?)" );
 
-	ok = ofa_idbconnect_query( connect, query, TRUE );
+	ofa_idbconnect_bind_int( stmt, 0, ofo_concil_get_id( concil ));
+	ofa_idbconnect_bind_date( stmt, 1, ofo_concil_get_dval( concil ));
+	ofa_idbconnect_bind_string( stmt, 2, ofo_concil_get_upd_user( concil ));
+	ofa_idbconnect_bind_stamp( stmt, 3, ofo_concil_get_upd_stamp( concil ));
 
-	g_free( stamp );
-	g_free( sdate );
-	g_free( query );
+	ok = ofa_idbconnect_execute( connect, stmt, TRUE );
 
 	return( ok );
 }
@@ -694,18 +696,19 @@ ofo_concil_add_id( ofoConcil *concil, const gchar *type, ofxCounter id )
 static gboolean
 concil_do_insert_id( ofoConcil *concil, const gchar *type, ofxCounter id, const ofaIDBConnect *connect )
 {
-	gchar *query;
+	ofsIDBStatement *stmt;
 	gboolean ok;
 
-	query = g_strdup_printf(
+	stmt = ofa_idbconnect_prepare( connect,
 			"INSERT INTO OFA_T_CONCIL_IDS "
 			"	(REC_ID,REC_IDS_TYPE,REC_IDS_OTHER) VALUES "
-			"	(%ld,'%s',%ld)",
-			ofo_concil_get_id( concil ), type, id );
+			"	(?,?,?)" );
 
-	ok = ofa_idbconnect_query( connect, query, TRUE );
+	ofa_idbconnect_bind_int( stmt, 0, ofo_concil_get_id( concil ));
+	ofa_idbconnect_bind_string( stmt, 1, type );
+	ofa_idbconnect_bind_int( stmt, 2, id );
 
-	g_free( query );
+	ok = ofa_idbconnect_execute( connect, stmt, TRUE );
 
 	return( ok );
 }
@@ -747,26 +750,18 @@ ofo_concil_delete( ofoConcil *concil )
 static gboolean
 concil_do_delete( ofoConcil *concil, const ofaIDBConnect *connect )
 {
-	gchar *query;
+	ofsIDBStatement *stmt;
 	gboolean ok;
 
-	query = g_strdup_printf(
-			"DELETE FROM OFA_T_CONCIL"
-			"	WHERE REC_ID=%ld",
-					ofo_concil_get_id( concil ));
-
-	ok = ofa_idbconnect_query( connect, query, TRUE );
+	stmt = ofa_idbconnect_prepare( connect, "DELETE FROM OFA_T_CONCIL WHERE REC_ID=?" );
+	ofa_idbconnect_bind_int( stmt, 0, ofo_concil_get_id( concil ));
 
-	g_free( query );
-
-	query = g_strdup_printf(
-			"DELETE FROM OFA_T_CONCIL_IDS"
-			"	WHERE REC_ID=%ld",
-					ofo_concil_get_id( concil ));
+	ok = ofa_idbconnect_execute( connect, stmt, TRUE );
 
-	ok &= ofa_idbconnect_query( connect, query, TRUE );
+	stmt = ofa_idbconnect_prepare( connect, "DELETE FROM OFA_T_CONCIL_IDS WHERE REC_ID=?" );
+	ofa_idbconnect_bind_int( stmt, 0, ofo_concil_get_id( concil ));
 
-	g_free( query );
+	ok &= ofa_idbconnect_execute( connect, stmt, TRUE );
 
 	return( ok );
 }
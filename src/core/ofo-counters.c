@@ -86,6 +86,7 @@ static ofxCounter  read_counter_by_key( ofoCounters *self, ofaIDBConnect *connec
 static ofxCounter  get_last_counter( ofaIGetter *getter, const gchar *key );
 static ofxCounter *get_last_counter_ptr( ofoCounters *self, ofoCountersPrivate *priv, const gchar *key );
 static ofxCounter  get_next_counter( ofaIGetter *getter, const gchar *key );
+static ofxCounter  reserve_counters( ofaIGetter *getter, const gchar *key, guint count );
 
 G_DEFINE_TYPE_EXTENDED( ofoCounters, ofo_counters, G_TYPE_OBJECT, 0,
 		G_ADD_PRIVATE( ofoCounters ))
@@ -343,6 +344,23 @@ ofo_counters_get_next_entry_id( ofaIGetter *getter )
 	return( get_next_counter( getter, st_entry_id ));
 }
 
+/**
+ * ofo_counters_reserve_entry_ids:
+ * @getter: a #ofaIGetter instance.
+ * @count: the count of identifiers to be reserved.
+ *
+ * Reserves @count consecutive Entry identifiers with a single update
+ * of the DBMS.
+ *
+ * Returns: the first reserved Entry identifier, the last one being
+ * this returned value + @count - 1.
+ */
+ofxCounter
+ofo_counters_reserve_entry_ids( ofaIGetter *getter, guint count )
+{
+	return( reserve_counters( getter, st_entry_id, count ));
+}
+
 /**
  * ofo_counters_get_last_ope_id:
  * @getter: a #ofaIGetter instance.
@@ -367,6 +385,23 @@ ofo_counters_get_next_ope_id( ofaIGetter *getter )
 	return( get_next_counter( getter, st_ope_id ));
 }
 
+/**
+ * ofo_counters_reserve_ope_ids:
+ * @getter: a #ofaIGetter instance.
+ * @count: the count of identifiers to be reserved.
+ *
+ * Reserves @count consecutive Operation identifiers with a single
+ * update of the DBMS.
+ *
+ * Returns: the first reserved Operation identifier, the last one being
+ * this returned value + @count - 1.
+ */
+ofxCounter
+ofo_counters_reserve_ope_ids( ofaIGetter *getter, guint count )
+{
+	return( reserve_counters( getter, st_ope_id, count ));
+}
+
 /**
  * ofo_counters_get_last_settlement_id:
  * @getter: a #ofaIGetter instance.
@@ -391,6 +426,23 @@ ofo_counters_get_next_settlement_id( ofaIGetter *getter )
 	return( get_next_counter( getter, st_settlement_id ));
 }
 
+/**
+ * ofo_counters_reserve_settlement_ids:
+ * @getter: a #ofaIGetter instance.
+ * @count: the count of identifiers to be reserved.
+ *
+ * Reserves @count consecutive Settlement identifiers with a single
+ * update of the DBMS.
+ *
+ * Returns: the first reserved Settlement identifier, the last one
+ * being this returned value + @count - 1.
+ */
+ofxCounter
+ofo_counters_reserve_settlement_ids( ofaIGetter *getter, guint count )
+{
+	return( reserve_counters( getter, st_settlement_id, count ));
+}
+
 /**
  * ofo_counters_get_last_tiers_id:
  * @getter: a #ofaIGetter instance.
@@ -474,6 +526,15 @@ get_last_counter_ptr( ofoCounters *self, ofoCountersPrivate *priv, const gchar *
 
 static ofxCounter
 get_next_counter( ofaIGetter *getter, const gchar *key )
+{
+	return( reserve_counters( getter, key, 1 ));
+}
+
+/*
+ * Reserve @count consecutive identifiers, returning the first one
+ */
+static ofxCounter
+reserve_counters( ofaIGetter *getter, const gchar *key, guint count )
 {
 	ofoCounters *counters;
 	ofoCountersPrivate *priv;
@@ -484,6 +545,7 @@ get_next_counter( ofaIGetter *getter, const gchar *key )
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), 0 );
 	g_return_val_if_fail( my_strlen( key ), 0 );
+	g_return_val_if_fail( count > 0, 0 );
 
 	hub = ofa_igetter_get_hub( getter );
 	g_return_val_if_fail( hub && OFA_IS_HUB( hub ), 0 );
@@ -499,7 +561,7 @@ get_next_counter( ofaIGetter *getter, const gchar *key )
 	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), 0 );
 
 	pnumber = get_last_counter_ptr( counters, priv, key );
-	*pnumber += 1;
+	*pnumber += count;
 
 	query = g_strdup_printf(
 			"UPDATE OFA_T_DOSSIER_IDS "
@@ -508,7 +570,7 @@ get_next_counter( ofaIGetter *getter, const gchar *key )
 	ofa_idbconnect_query( connect, query, TRUE );
 	g_free( query );
 
-	return( *pnumber );
+	return( *pnumber - count + 1 );
 }
 
 /**
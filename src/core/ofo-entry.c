@@ -115,7 +115,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_CRE_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },					/* string: interned */
 		{ OFA_BOX_CSV( ENT_CRE_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -123,7 +124,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_OPE_TEMPLATE ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_OPE_NUMBER ),
 				OFA_TYPE_COUNTER,
 				TRUE,
@@ -147,15 +149,18 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_ACCOUNT ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_CURRENCY ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_LEDGER ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_DEBIT ),
 				OFA_TYPE_AMOUNT,
 				TRUE,
@@ -175,7 +180,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_UPD_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_UPD_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -183,15 +189,18 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_IPERIOD ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_STATUS ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_RULE ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_STLMT_NUMBER ),
 				OFA_TYPE_COUNTER,
 				TRUE,
@@ -199,7 +208,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( ENT_STLMT_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( ENT_STLMT_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -207,6 +217,65 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ 0 }
 };
 
+/* the projection loaded to print the books: only the columns which are
+ * actually rendered, with the same definitions than above
+ */
+static const ofsBoxDef st_print_defs[] = {
+		{ OFA_BOX_CSV( ENT_NUMBER ),
+				OFA_TYPE_COUNTER,
+				FALSE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_OPE_TEMPLATE ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE,
+				TRUE },
+		{ OFA_BOX_CSV( ENT_DOPE ),
+				OFA_TYPE_DATE,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_DEFFECT ),
+				OFA_TYPE_DATE,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_LABEL ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_REF ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_ACCOUNT ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE,
+				TRUE },
+		{ OFA_BOX_CSV( ENT_CURRENCY ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE,
+				TRUE },
+		{ OFA_BOX_CSV( ENT_LEDGER ),
+				OFA_TYPE_STRING,
+				TRUE,
+				FALSE,
+				TRUE },
+		{ OFA_BOX_CSV( ENT_DEBIT ),
+				OFA_TYPE_AMOUNT,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_CREDIT ),
+				OFA_TYPE_AMOUNT,
+				TRUE,
+				FALSE },
+		{ OFA_BOX_CSV( ENT_STLMT_NUMBER ),
+				OFA_TYPE_COUNTER,
+				TRUE,
+				TRUE },
+		{ 0 }
+};
+
 static const ofsBoxDef st_doc_defs[] = {
 		{ OFA_BOX_CSV( ENT_NUMBER ),
 				OFA_TYPE_COUNTER,
@@ -222,6 +291,12 @@ static const ofsBoxDef st_doc_defs[] = {
 #define ENTRY_TABLES_COUNT              2
 #define ENTRY_EXPORT_VERSION            3
 
+/* batched inserts: count of bound columns per row, and max count of
+ * rows per INSERT statement (must be a power of two)
+ */
+#define ENTRY_INSERT_COLUMNS            24
+#define ENTRY_INSERT_BATCH              64
+
 typedef struct {
 	gboolean  import_settled;
 	GList    *docs;
@@ -291,8 +366,16 @@ static sRule st_rule[] = {
 		{ 0 },
 };
 
+static const gchar *st_order_print_by_account = "ORDER BY ENT_ACCOUNT ASC,ENT_DOPE ASC,ENT_DEFFECT ASC,ENT_NUMBER ASC";
+static const gchar *st_order_print_by_ledger  = "ORDER BY ENT_LEDGER ASC,ENT_DOPE ASC,ENT_DEFFECT ASC,ENT_NUMBER ASC";
+
+static gchar       *where_for_print_by_account( const gchar *from_account, const gchar *to_account, const GDate *from_date, const GDate *to_date );
+static gchar       *where_for_print_by_ledger( const GSList *mnemos, const GDate *from_date, const GDate *to_date );
 static gchar       *effect_in_exercice( ofaIGetter *getter );
-static GList       *entry_load_dataset( ofaIGetter *getter, const gchar *where, const gchar *order );
+static void         get_dataset_on_loaded( GObject *source, GAsyncResult *result, GTask *task );
+static GList       *entry_load_dataset( ofaIGetter *getter, const gchar *where, const gchar *order, gboolean in_arena );
+static GList       *entry_load_print_dataset( ofaIGetter *getter, const gchar *where, const gchar *order );
+static gchar       *entry_get_from( const gchar *where, const gchar *order );
 static GDate       *entry_get_min_deffect( const ofoEntry *entry, GDate *date, ofaIGetter *getter );
 static gboolean     entry_get_import_settled( ofoEntry *entry );
 static void         entry_set_number( ofoEntry *entry, ofxCounter number );
@@ -307,7 +390,17 @@ static void         entry_set_settlement_stamp( ofoEntry *entry, const myStampVa
 static void         entry_set_import_settled( ofoEntry *entry, gboolean settled );
 static gboolean     entry_compute_status( ofoEntry *entry, gboolean set_deffect, ofaIGetter *getter );
 static GList       *get_orphans( ofaIGetter *getter, const gchar *table );
+static gchar       *entry_ledger_balance_get_query( const gchar *ledger, const GDate *from_date, const GDate *to_date );
+static GList       *entry_ledger_balance_add( GList *dataset, const ofaIDBConnect *connect, const gchar *query );
+static gint         entry_ledger_balance_cmp( const ofsLedgerBalance *a, const ofsLedgerBalance *b );
 static gboolean     entry_do_insert( ofoEntry *entry, ofaIGetter *getter );
+static gboolean     entry_do_insert_rows( GList *entries, guint rows, ofaIGetter *getter );
+static gboolean     entry_months_update( const ofaIDBConnect *connect, const gchar *where, gint sign );
+static gboolean     entry_transaction_start( const ofaIDBConnect *connect, gboolean *started );
+static gboolean     entry_transaction_end( const ofaIDBConnect *connect, gboolean started, gboolean ok );
+static gchar       *entry_get_insert_query( guint rows );
+static gboolean     entry_bind_insert( ofoEntry *entry, ofsIDBStatement *stmt, guint offset, const gchar *userid, const myStampVal *stamp, ofaIGetter *getter );
+static void         entry_set_inserted( ofoEntry *entry, const gchar *userid, const myStampVal *stamp );
 static void         error_ledger( const gchar *ledger );
 static void         error_ope_template( const gchar *model );
 static void         error_currency( const gchar *currency );
@@ -558,79 +651,184 @@ ofo_entry_get_dataset_account_balance( ofaIGetter *getter,
  * allocated #ofsLedgerBalance structures, that the user should
  * #ofs_ledger_balance_list_free().
  *
- * The returned dataset is ordered by ascending currency.
+ * The whole months of the period are read from the per-month balances
+ * of the ledgers, and only the entries of the partial boundary months
+ * are aggregated.
+ *
+ * The returned dataset is ordered by ascending ledger and currency.
  */
 GList *
 ofo_entry_get_dataset_ledger_balance( ofaIGetter *getter,
 										const gchar *ledger,
 										const GDate *from_date, const GDate *to_date )
 {
-	static const gchar *thisfn = "ofo_entry_get_dataset_ledger_balance";
 	GList *dataset;
+	GDate first_month, last_month, date;
 	GString *query;
-	gboolean first;
 	gchar *str;
-	GSList *result, *irow, *icol;
-	ofsLedgerBalance *sbal;
 	ofaHub *hub;
+	const ofaIDBConnect *connect;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 
+	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
+	dataset = NULL;
+
+	/* first_month is the first whole month of the period
+	 * last_month is the first day of its last whole month */
+	my_date_clear( &first_month );
+	if( my_date_is_valid( from_date )){
+		g_date_set_dmy( &first_month, 1, g_date_get_month( from_date ), g_date_get_year( from_date ));
+		if( g_date_get_day( from_date ) > 1 ){
+			g_date_add_months( &first_month, 1 );
+		}
+	}
+	my_date_clear( &last_month );
+	if( my_date_is_valid( to_date )){
+		g_date_set_dmy( &last_month, 1, g_date_get_month( to_date ), g_date_get_year( to_date ));
+		if( !g_date_is_last_of_month( to_date )){
+			g_date_subtract_months( &last_month, 1 );
+		}
+	}
+
+	/* no whole month: only aggregate the entries */
+	if( my_date_is_valid( &first_month ) && my_date_is_valid( &last_month ) &&
+			my_date_compare( &first_month, &last_month ) > 0 ){
+		str = entry_ledger_balance_get_query( ledger, from_date, to_date );
+		dataset = entry_ledger_balance_add( dataset, connect, str );
+		g_free( str );
+
+		return( dataset );
+	}
+
+	/* the whole months */
+	query = g_string_new(
+			"SELECT LED_MNEMO,LED_CUR_CODE,SUM(LED_MONTH_DEBIT),SUM(LED_MONTH_CREDIT) "
+			"FROM OFA_T_LEDGERS_MONTHS WHERE 1 " );
+	if( my_strlen( ledger )){
+		g_string_append_printf( query, "AND LED_MNEMO='%s' ", ledger );
+	}
+	if( my_date_is_valid( &first_month )){
+		str = my_date_to_str( &first_month, MY_DATE_SQL );
+		g_string_append_printf( query, "AND LED_MONTH>='%s' ", str );
+		g_free( str );
+	}
+	if( my_date_is_valid( &last_month )){
+		str = my_date_to_str( &last_month, MY_DATE_SQL );
+		g_string_append_printf( query, "AND LED_MONTH<='%s' ", str );
+		g_free( str );
+	}
+	query = g_string_append( query, "GROUP BY LED_MNEMO,LED_CUR_CODE" );
+	dataset = entry_ledger_balance_add( dataset, connect, query->str );
+	g_string_free( query, TRUE );
+
+	/* the entries of the partial starting month */
+	if( my_date_is_valid( from_date ) && g_date_get_day( from_date ) > 1 ){
+		my_date_set_from_date( &date, &first_month );
+		g_date_subtract_days( &date, 1 );
+		str = entry_ledger_balance_get_query( ledger, from_date, &date );
+		dataset = entry_ledger_balance_add( dataset, connect, str );
+		g_free( str );
+	}
+
+	/* the entries of the partial ending month */
+	if( my_date_is_valid( to_date ) && !g_date_is_last_of_month( to_date )){
+		g_date_set_dmy( &date, 1, g_date_get_month( to_date ), g_date_get_year( to_date ));
+		str = entry_ledger_balance_get_query( ledger, &date, to_date );
+		dataset = entry_ledger_balance_add( dataset, connect, str );
+		g_free( str );
+	}
+
+	return( dataset );
+}
+
+/*
+ * Returns the query which aggregates the non-deleted entries of the
+ * @ledger (or of all ledgers) between the two effect dates
+ */
+static gchar *
+entry_ledger_balance_get_query( const gchar *ledger, const GDate *from_date, const GDate *to_date )
+{
+	GString *query;
+	gchar *str;
+
 	query = g_string_new(
 				"SELECT ENT_LEDGER,ENT_CURRENCY,SUM(ENT_DEBIT),SUM(ENT_CREDIT) "
 				"FROM OFA_T_ENTRIES WHERE " );
-	first = FALSE;
-	dataset = NULL;
 	if( my_strlen( ledger )){
-		g_string_append_printf( query, "ENT_LEDGER='%s' ", ledger );
-		first = TRUE;
+		g_string_append_printf( query, "ENT_LEDGER='%s' AND ", ledger );
 	}
 	if( my_date_is_valid( from_date )){
-		if( first ){
-			query = g_string_append( query, "AND " );
-		}
 		str = my_date_to_str( from_date, MY_DATE_SQL );
-		g_string_append_printf( query, "ENT_DEFFECT>='%s' ", str );
+		g_string_append_printf( query, "ENT_DEFFECT>='%s' AND ", str );
 		g_free( str );
-		first = TRUE;
 	}
 	if( my_date_is_valid( to_date )){
-		if( first ){
-			query = g_string_append( query, "AND " );
-		}
 		str = my_date_to_str( to_date, MY_DATE_SQL );
-		g_string_append_printf( query, "ENT_DEFFECT<='%s' ", str );
+		g_string_append_printf( query, "ENT_DEFFECT<='%s' AND ", str );
 		g_free( str );
-		first = TRUE;
-	}
-	if( first ){
-		query = g_string_append( query, "AND " );
 	}
 	g_string_append_printf( query, "ENT_STATUS!='%s' ", ofo_entry_status_get_dbms( ENT_STATUS_DELETED ));
-	query = g_string_append( query, "GROUP BY ENT_LEDGER,ENT_CURRENCY ORDER BY ENT_LEDGER,ENT_CURRENCY ASC " );
+	query = g_string_append( query, "GROUP BY ENT_LEDGER,ENT_CURRENCY" );
 
-	hub = ofa_igetter_get_hub( getter );
+	return( g_string_free( query, FALSE ));
+}
 
-	if( ofa_idbconnect_query_ex( ofa_hub_get_connect( hub ), query->str, &result, TRUE )){
+/*
+ * Run the @query, which returns (ledger,currency,debit,credit) rows,
+ * and add the amounts to the @dataset, which is kept ordered by
+ * ledger and currency
+ */
+static GList *
+entry_ledger_balance_add( GList *dataset, const ofaIDBConnect *connect, const gchar *query )
+{
+	static const gchar *thisfn = "ofo_entry_ledger_balance_add";
+	GSList *result, *irow, *icol;
+	ofsLedgerBalance *sbal;
+	const gchar *ledger, *currency;
+	ofxAmount debit, credit;
+
+	if( ofa_idbconnect_query_ex( connect, query, &result, TRUE )){
 		for( irow=result ; irow ; irow=irow->next ){
-			sbal = g_new0( ofsLedgerBalance, 1 );
 			icol = ( GSList * ) irow->data;
-			sbal->ledger = g_strdup(( const gchar * ) icol->data );
+			ledger = ( const gchar * ) icol->data;
 			icol = icol->next;
-			sbal->currency = g_strdup(( const gchar * ) icol->data );
+			currency = ( const gchar * ) icol->data;
 			icol = icol->next;
-			sbal->debit = my_double_set_from_sql(( const gchar * ) icol->data );
+			debit = my_double_set_from_sql(( const gchar * ) icol->data );
 			icol = icol->next;
-			sbal->credit = my_double_set_from_sql(( const gchar * ) icol->data );
-			g_debug( "%s: account=%s, currency=%s, debit=%lf, credit=%lf",
-					thisfn, sbal->ledger, sbal->currency, sbal->debit, sbal->credit );
-			dataset = g_list_prepend( dataset, sbal );
+			credit = my_double_set_from_sql(( const gchar * ) icol->data );
+
+			sbal = ofs_ledger_balance_find_currency( dataset, ledger, currency );
+			if( !sbal ){
+				sbal = g_new0( ofsLedgerBalance, 1 );
+				sbal->ledger = g_strdup( ledger );
+				sbal->currency = g_strdup( currency );
+				dataset = g_list_insert_sorted( dataset, sbal, ( GCompareFunc ) entry_ledger_balance_cmp );
+			}
+			sbal->debit += debit;
+			sbal->credit += credit;
+			g_debug( "%s: ledger=%s, currency=%s, debit=%lf, credit=%lf",
+					thisfn, ledger, currency, debit, credit );
 		}
 		ofa_idbconnect_free_results( result );
 	}
-	g_string_free( query, TRUE );
 
-	return( g_list_reverse( dataset ));
+	return( dataset );
+}
+
+static gint
+entry_ledger_balance_cmp( const ofsLedgerBalance *a, const ofsLedgerBalance *b )
+{
+	gint cmp;
+
+	cmp = g_strcmp0( a->ledger, b->ledger );
+	if( cmp == 0 ){
+		cmp = g_strcmp0( a->currency, b->currency );
+	}
+
+	return( cmp );
 }
 
 /**
@@ -646,6 +844,10 @@ ofo_entry_get_dataset_ledger_balance( ofaIGetter *getter,
  * that the user should #ofo_entry_free_dataset().
  *
  * The returned dataset is ordered by ascending account/dope/deffect/number.
+ *
+ * Only the printed columns are loaded: the number, the operation
+ * template, the dates, the label, the reference, the account, the
+ * currency, the ledger, the amounts and the settlement number.
  */
 GList *
 ofo_entry_get_dataset_for_print_by_account( ofaIGetter *getter,
@@ -653,15 +855,64 @@ ofo_entry_get_dataset_for_print_by_account( ofaIGetter *getter,
 												const GDate *from_date, const GDate *to_date )
 {
 	GList *dataset;
+	gchar *where;
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
+
+	where = where_for_print_by_account( from_account, to_account, from_date, to_date );
+	dataset = entry_load_print_dataset( getter, where, st_order_print_by_account );
+	g_free( where );
+
+	return( dataset );
+}
+
+/**
+ * ofo_entry_get_dataset_for_print_by_account_async:
+ * @getter: a #ofaIGetter instance.
+ * @from_account: the starting account.
+ * @to_account: the ending account.
+ * @from_date: the starting effect date.
+ * @to_date: the ending effect date.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the dataset
+ *  is loaded.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously loads the same dataset than
+ * #ofo_entry_get_dataset_for_print_by_account().
+ *
+ * The @callback should call #ofo_entry_get_dataset_for_print_finish()
+ * to get the dataset.
+ */
+void
+ofo_entry_get_dataset_for_print_by_account_async( ofaIGetter *getter,
+												const gchar *from_account, const gchar *to_account,
+												const GDate *from_date, const GDate *to_date,
+												GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	gchar *where, *from;
+
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	where = where_for_print_by_account( from_account, to_account, from_date, to_date );
+	from = entry_get_from( where, st_order_print_by_account );
+
+	ofo_base_load_dataset_in_arena_async(
+			st_print_defs, from, OFO_TYPE_ENTRY, getter, cancellable, callback, user_data );
+
+	g_free( from );
+	g_free( where );
+}
+
+static gchar *
+where_for_print_by_account( const gchar *from_account, const gchar *to_account, const GDate *from_date, const GDate *to_date )
+{
 	GString *query;
 	gboolean first;
 	gchar *str;
 
-	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
-
 	query = g_string_new( "" );
 	first = TRUE;
-	dataset = NULL;
 
 	if( my_strlen( from_account )){
 		g_string_append_printf( query, "ENT_ACCOUNT>='%s' ", from_account );
@@ -697,12 +948,7 @@ ofo_entry_get_dataset_for_print_by_account( ofaIGetter *getter,
 	}
 	g_string_append_printf( query, "ENT_STATUS!='%s' ", ofo_entry_status_get_dbms( ENT_STATUS_DELETED ));
 
-	dataset = entry_load_dataset( getter,  query->str,
-			"ORDER BY ENT_ACCOUNT ASC,ENT_DOPE ASC,ENT_DEFFECT ASC,ENT_NUMBER ASC" );
-
-	g_string_free( query, TRUE );
-
-	return( dataset );
+	return( g_string_free( query, FALSE ));
 }
 
 /**
@@ -717,6 +963,9 @@ ofo_entry_get_dataset_for_print_by_account( ofaIGetter *getter,
  * #ofoEntry, that the user should #ofo_entry_free_dataset().
  *
  * The returned dataset is ordered by ascending ledger/dope/deffect/number.
+ *
+ * Only the printed columns are loaded, as for
+ * #ofo_entry_get_dataset_for_print_by_account().
  */
 GList *
 ofo_entry_get_dataset_for_print_by_ledger( ofaIGetter *getter,
@@ -724,17 +973,83 @@ ofo_entry_get_dataset_for_print_by_ledger( ofaIGetter *getter,
 												const GDate *from_date, const GDate *to_date )
 {
 	GList *dataset;
+	gchar *where;
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
+
+	where = where_for_print_by_ledger( mnemos, from_date, to_date );
+	dataset = entry_load_print_dataset( getter, where, st_order_print_by_ledger );
+	g_free( where );
+
+	return( dataset );
+}
+
+/**
+ * ofo_entry_get_dataset_for_print_by_ledger_async:
+ * @getter: a #ofaIGetter instance.
+ * @mnemos: a list of requested ledger mnemos.
+ * @from_date: the starting effect date.
+ * @to_date: the ending effect date.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the dataset
+ *  is loaded.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously loads the same dataset than
+ * #ofo_entry_get_dataset_for_print_by_ledger().
+ *
+ * The @callback should call #ofo_entry_get_dataset_for_print_finish()
+ * to get the dataset.
+ */
+void
+ofo_entry_get_dataset_for_print_by_ledger_async( ofaIGetter *getter,
+												const GSList *mnemos,
+												const GDate *from_date, const GDate *to_date,
+												GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	gchar *where, *from;
+
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	where = where_for_print_by_ledger( mnemos, from_date, to_date );
+	from = entry_get_from( where, st_order_print_by_ledger );
+
+	ofo_base_load_dataset_in_arena_async(
+			st_print_defs, from, OFO_TYPE_ENTRY, getter, cancellable, callback, user_data );
+
+	g_free( from );
+	g_free( where );
+}
+
+/**
+ * ofo_entry_get_dataset_for_print_finish:
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: [allow-none]: a placeholder for a #GError.
+ *
+ * Finishes an asynchronous load started with one of the
+ * ofo_entry_get_dataset_for_print_xxx_async() functions.
+ *
+ * Returns: the dataset, that the user should #ofo_entry_free_dataset().
+ */
+GList *
+ofo_entry_get_dataset_for_print_finish( GAsyncResult *result, GError **error )
+{
+	return( ofo_base_load_dataset_finish( result, error ));
+}
+
+/*
+ * (ENT_LEDGER=xxxx or ENT_LEDGER=xxx or ENT_LEDGER=xxx)
+ */
+static gchar *
+where_for_print_by_ledger( const GSList *mnemos, const GDate *from_date, const GDate *to_date )
+{
 	GString *query;
 	gboolean first;
 	gchar *str;
 	const GSList *it;
 
-	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
-
 	query = g_string_new( "" );
-	dataset = NULL;
 
-	/* (ENT_LEDGER=xxxx or ENT_LEDGER=xxx or ENT_LEDGER=xxx) */
 	query = g_string_append_c( query, '(' );
 	for( it=mnemos, first=TRUE ; it ; it=it->next ){
 		if( !first ){
@@ -756,12 +1071,7 @@ ofo_entry_get_dataset_for_print_by_ledger( ofaIGetter *getter,
 	}
 	g_string_append_printf( query, "AND ENT_STATUS!='%s' ", ofo_entry_status_get_dbms( ENT_STATUS_DELETED ));
 
-	dataset = entry_load_dataset( getter, query->str,
-			"ORDER BY ENT_LEDGER ASC,ENT_DOPE ASC,ENT_DEFFECT ASC,ENT_NUMBER ASC" );
-
-	g_string_free( query, TRUE );
-
-	return( dataset );
+	return( g_string_free( query, FALSE ));
 }
 
 /**
@@ -800,7 +1110,7 @@ ofo_entry_get_dataset_for_print_reconcil( ofaIGetter *getter,
 
 	g_string_append_printf( where, " AND ENT_STATUS!='%s' ", ofo_entry_status_get_dbms( ENT_STATUS_DELETED ));
 
-	dataset = entry_load_dataset( getter, where->str, NULL );
+	dataset = entry_load_dataset( getter, where->str, NULL, TRUE );
 
 	g_string_free( where, TRUE );
 
@@ -835,7 +1145,7 @@ ofo_entry_get_dataset_for_exercice_by_status( ofaIGetter *getter, ofeEntryStatus
 		g_string_append_printf( where, " AND ENT_STATUS='%s' ", ofo_entry_status_get_dbms( status ));
 	}
 
-	dataset = entry_load_dataset( getter, where->str, NULL );
+	dataset = entry_load_dataset( getter, where->str, NULL, FALSE );
 
 	g_string_free( where, TRUE );
 
@@ -894,6 +1204,92 @@ ofo_entry_get_dataset( ofaIGetter *getter )
 	return( my_icollector_collection_get( collector, OFO_TYPE_ENTRY, getter ));
 }
 
+/**
+ * ofo_entry_get_dataset_async:
+ * @getter: a #ofaIGetter instance.
+ * @cancellable: [allow-none]: a #GCancellable object.
+ * @callback: the #GAsyncReadyCallback to be called when the dataset
+ *  is available.
+ * @user_data: user data to be passed to @callback.
+ *
+ * Asynchronously loads *all* entries, if not already done.
+ *
+ * The @callback should call #ofo_entry_get_dataset_finish() to get
+ * the dataset.
+ */
+void
+ofo_entry_get_dataset_async( ofaIGetter *getter,
+								GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
+{
+	GTask *task;
+	myICollector *collector;
+	GList *dataset;
+
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	task = g_task_new( NULL, cancellable, callback, user_data );
+	g_task_set_task_data( task, getter, NULL );
+
+	collector = ofa_igetter_get_collector( getter );
+
+	/* an empty collection is not reloaded */
+	if( my_icollector_collection_is_loaded( collector, OFO_TYPE_ENTRY )){
+		dataset = my_icollector_collection_get( collector, OFO_TYPE_ENTRY, NULL );
+		g_task_return_pointer( task, dataset, NULL );
+		g_object_unref( task );
+
+	} else {
+		ofo_base_load_dataset_async(
+				st_boxed_defs, "OFA_T_ENTRIES", OFO_TYPE_ENTRY, getter,
+				cancellable, ( GAsyncReadyCallback ) get_dataset_on_loaded, task );
+	}
+}
+
+static void
+get_dataset_on_loaded( GObject *source, GAsyncResult *result, GTask *task )
+{
+	ofaIGetter *getter;
+	myICollector *collector;
+	GList *dataset;
+	GError *error;
+
+	error = NULL;
+	dataset = ofo_base_load_dataset_finish( result, &error );
+
+	if( error ){
+		g_task_return_error( task, error );
+
+	} else {
+		getter = OFA_IGETTER( g_task_get_task_data( task ));
+		collector = ofa_igetter_get_collector( getter );
+		dataset = my_icollector_collection_set( collector, OFO_TYPE_ENTRY, dataset );
+		g_task_return_pointer( task, dataset, NULL );
+	}
+
+	g_object_unref( task );
+}
+
+/**
+ * ofo_entry_get_dataset_finish:
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: [allow-none]: a placeholder for a #GError.
+ *
+ * Finishes an asynchronous load started with
+ * #ofo_entry_get_dataset_async().
+ *
+ * Returns: *all* entries.
+ *
+ * The returned list is owned by the #myICollector of the application,
+ * and should not be released by the caller.
+ */
+GList *
+ofo_entry_get_dataset_finish( GAsyncResult *result, GError **error )
+{
+	g_return_val_if_fail( g_task_is_valid( result, NULL ), NULL );
+
+	return( g_task_propagate_pointer( G_TASK( result ), error ));
+}
+
 /**
  * ofo_entry_get_count:
  * @getter: a #ofaIGetter instance.
@@ -1023,15 +1419,51 @@ ofo_entry_get_settlement_by_number( ofaIGetter *getter, ofxCounter number, gchar
 
 /*
  * returns a #GList * of all #ofoEntry's which satisfy the @where clause
+ * the read-only datasets (print, render) are loaded in an arena
+ */
+static GList *
+entry_load_dataset( ofaIGetter *getter, const gchar *where, const gchar *order, gboolean in_arena )
+{
+	GList *dataset;
+	gchar *from;
+
+	from = entry_get_from( where, order );
+
+	dataset = in_arena ?
+			ofo_base_load_dataset_in_arena( st_boxed_defs, from, OFO_TYPE_ENTRY, getter ) :
+			ofo_base_load_dataset( st_boxed_defs, from, OFO_TYPE_ENTRY, getter );
+
+	g_free( from );
+
+	return( dataset );
+}
+
+/*
+ * returns a #GList * of the #ofoEntry's which satisfy the @where
+ * clause, only loading the printed columns
  */
 static GList *
-entry_load_dataset( ofaIGetter *getter, const gchar *where, const gchar *order )
+entry_load_print_dataset( ofaIGetter *getter, const gchar *where, const gchar *order )
 {
 	GList *dataset;
+	gchar *from;
+
+	from = entry_get_from( where, order );
+	dataset = ofo_base_load_dataset_in_arena( st_print_defs, from, OFO_TYPE_ENTRY, getter );
+	g_free( from );
+
+	return( dataset );
+}
+
+/*
+ * Returns the 'from' part of the query, as a newly allocated string.
+ */
+static gchar *
+entry_get_from( const gchar *where, const gchar *order )
+{
 	GString *query;
 	const gchar *real_order;
 
-	dataset = NULL;
 	query = g_string_new( "OFA_T_ENTRIES " );
 
 	if( my_strlen( where )){
@@ -1046,15 +1478,7 @@ entry_load_dataset( ofaIGetter *getter, const gchar *where, const gchar *order )
 
 	query = g_string_append( query, real_order );
 
-	dataset = ofo_base_load_dataset(
-					st_boxed_defs,
-					query->str,
-					OFO_TYPE_ENTRY,
-					getter );
-
-	g_string_free( query, TRUE );
-
-	return( dataset );
+	return( g_string_free( query, FALSE ));
 }
 
 /**
@@ -1067,8 +1491,10 @@ gboolean
 ofo_entry_use_account( ofaIGetter *getter, const gchar *account )
 {
 	ofaHub *hub;
-	gchar *query;
-	gint count;
+	const ofaIDBConnect *connect;
+	ofsIDBStatement *stmt;
+	GSList *result;
+	gboolean found;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
 
@@ -1076,17 +1502,20 @@ ofo_entry_use_account( ofaIGetter *getter, const gchar *account )
 		return( FALSE );
 	}
 
-	query = g_strdup_printf(
-			"SELECT COUNT(*) FROM OFA_T_ENTRIES WHERE ENT_ACCOUNT='%s'",
-			account );
-
+	found = FALSE;
 	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
 
-	ofa_idbconnect_query_int( ofa_hub_get_connect( hub ), query, &count, TRUE );
+	stmt = ofa_idbconnect_prepare( connect,
+			"SELECT 1 FROM OFA_T_ENTRIES WHERE ENT_ACCOUNT=? LIMIT 1" );
+	ofa_idbconnect_bind_string( stmt, 0, account );
 
-	g_free( query );
+	if( ofa_idbconnect_execute_ex( connect, stmt, &result, TRUE )){
+		found = ( result != NULL );
+		ofa_idbconnect_free_results( result );
+	}
 
-	return( count > 0 );
+	return( found );
 }
 
 /**
@@ -1099,8 +1528,10 @@ gboolean
 ofo_entry_use_ledger( ofaIGetter *getter, const gchar *ledger )
 {
 	ofaHub *hub;
-	gchar *query;
-	gint count;
+	const ofaIDBConnect *connect;
+	ofsIDBStatement *stmt;
+	GSList *result;
+	gboolean found;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
 
@@ -1108,17 +1539,20 @@ ofo_entry_use_ledger( ofaIGetter *getter, const gchar *ledger )
 		return( FALSE );
 	}
 
-	query = g_strdup_printf(
-			"SELECT COUNT(*) FROM OFA_T_ENTRIES WHERE ENT_LEDGER='%s'",
-			ledger );
-
+	found = FALSE;
 	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
 
-	ofa_idbconnect_query_int( ofa_hub_get_connect( hub ), query, &count, TRUE );
+	stmt = ofa_idbconnect_prepare( connect,
+			"SELECT 1 FROM OFA_T_ENTRIES WHERE ENT_LEDGER=? LIMIT 1" );
+	ofa_idbconnect_bind_string( stmt, 0, ledger );
 
-	g_free( query );
+	if( ofa_idbconnect_execute_ex( connect, stmt, &result, TRUE )){
+		found = ( result != NULL );
+		ofa_idbconnect_free_results( result );
+	}
 
-	return( count > 0 );
+	return( found );
 }
 
 /**
@@ -2254,204 +2688,596 @@ get_orphans( ofaIGetter *getter, const gchar *table )
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 	g_return_val_if_fail( my_strlen( table ), NULL );
 
-	orphans = NULL;
-	hub = ofa_igetter_get_hub( getter );
-	connect = ofa_hub_get_connect( hub );
+	orphans = NULL;
+	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
+
+	query = g_strdup_printf( "SELECT DISTINCT(ENT_NUMBER) FROM %s "
+			"	WHERE ENT_NUMBER NOT IN (SELECT ENT_NUMBER FROM OFA_T_ENTRIES)", table );
+
+	if( ofa_idbconnect_query_ex( connect, query, &result, FALSE )){
+		for( irow=result ; irow ; irow=irow->next ){
+			icol = irow->data;
+			entnum = atol(( const gchar * ) icol->data );
+			orphans = g_list_prepend( orphans, ( gpointer ) entnum );
+		}
+		ofa_idbconnect_free_results( result );
+	}
+
+	g_free( query );
+
+	return( orphans );
+}
+
+/**
+ * ofo_entry_insert:
+ *
+ * Allocates a sequential number to the entry, and records it in the
+ * dbms. Send the corresponding advertising messages if no error occurs.
+ */
+gboolean
+ofo_entry_insert( ofoEntry *entry )
+{
+	static const gchar *thisfn = "ofo_entry_insert";
+	gboolean ok;
+	ofaIGetter *getter;
+	ofaISignaler *signaler;
+
+	g_debug( "%s: entry=%p", thisfn, ( void * ) entry );
+
+	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
+	g_return_val_if_fail( !OFO_BASE( entry )->prot->dispose_has_run, FALSE );
+
+	ok = FALSE;
+	getter = ofo_base_get_getter( OFO_BASE( entry ));
+	signaler = ofa_igetter_get_signaler( getter );
+
+	entry_set_number( entry, ofo_counters_get_next_entry_id( getter ));
+	entry_compute_status( entry, FALSE, getter );
+
+	/* rationale: see ofo-account.c */
+	ofo_entry_get_dataset( getter );
+
+	if( entry_do_insert( entry, getter )){
+		if( ofo_entry_get_period( entry ) != ENT_PERIOD_PAST ){
+			my_icollector_collection_add_object(
+					ofa_igetter_get_collector( getter ), MY_ICOLLECTIONABLE( entry ), NULL, getter );
+			g_signal_emit_by_name( signaler, SIGNALER_BASE_NEW, entry );
+		}
+		ok = TRUE;
+	}
+
+	return( ok );
+}
+
+/**
+ * ofo_entry_insert_list:
+ * @getter: a #ofaIGetter instance.
+ * @entries: a list of #ofoEntry objects.
+ *
+ * Allocates sequential numbers to the entries, and records them in
+ * the DBMS. This is the bulk equivalent of ofo_entry_insert():
+ * - the numbers are reserved with only one update of the counters,
+ * - the rows are inserted by multi-rows INSERT statements,
+ * - a settlement number already set on an entry is inserted with it.
+ *
+ * The caller is expected to run this inside a transaction if the
+ * insertion must be atomic.
+ *
+ * Unlike ofo_entry_insert(), the entries are neither added to
+ * the collection nor advertised: as the transaction may yet be
+ * cancelled, the caller should call ofo_entry_insert_list_notify()
+ * once the insertion has been committed, and keeps the ownership of
+ * the entries until then.
+ *
+ * Returns: %TRUE if all the entries have been successfully inserted.
+ */
+gboolean
+ofo_entry_insert_list( ofaIGetter *getter, GList *entries )
+{
+	static const gchar *thisfn = "ofo_entry_insert_list";
+	ofxCounter number;
+	GList *it;
+	ofoEntry *entry;
+	guint count, rows;
+	gboolean ok;
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
+
+	count = g_list_length( entries );
+
+	g_debug( "%s: getter=%p, entries=%p, count=%u",
+			thisfn, ( void * ) getter, ( void * ) entries, count );
+
+	if( count == 0 ){
+		return( TRUE );
+	}
+
+	number = ofo_counters_reserve_entry_ids( getter, count );
+
+	for( it=entries ; it ; it=it->next ){
+		entry = OFO_ENTRY( it->data );
+		g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
+		g_return_val_if_fail( !OFO_BASE( entry )->prot->dispose_has_run, FALSE );
+		entry_set_number( entry, number++ );
+		entry_compute_status( entry, FALSE, getter );
+	}
+
+	/* rationale: see ofo-account.c */
+	ofo_entry_get_dataset( getter );
+
+	/* insert the rows by chunks of a power of two, so that at most
+	 * log2(ENTRY_INSERT_BATCH)+1 distinct statements are prepared */
+	ok = TRUE;
+	for( it=entries ; it && ok ; it=g_list_nth( it, rows )){
+		for( rows=ENTRY_INSERT_BATCH ; rows > count ; rows /= 2 )
+			;
+		ok = entry_do_insert_rows( it, rows, getter );
+		count -= rows;
+	}
+
+	return( ok );
+}
+
+/**
+ * ofo_entry_insert_list_notify:
+ * @getter: a #ofaIGetter instance.
+ * @entries: the list of #ofoEntry objects which have been successfully
+ *  inserted by ofo_entry_insert_list().
+ *
+ * Adds the @entries to the collection and sends the corresponding
+ * advertising messages, as a batch.
+ *
+ * This takes the ownership of the entries: they are either given to
+ * the collection, or released if they are in the past. The list
+ * itself is left to the caller.
+ */
+void
+ofo_entry_insert_list_notify( ofaIGetter *getter, GList *entries )
+{
+	ofaISignaler *signaler;
+	myICollector *collector;
+	GList *it;
+	ofoEntry *entry;
+
+	g_return_if_fail( getter && OFA_IS_IGETTER( getter ));
+
+	signaler = ofa_igetter_get_signaler( getter );
+	collector = ofa_igetter_get_collector( getter );
+
+	ofa_isignaler_begin_batch( signaler );
+
+	for( it=entries ; it ; it=it->next ){
+		entry = OFO_ENTRY( it->data );
+		if( ofo_entry_get_period( entry ) != ENT_PERIOD_PAST ){
+			my_icollector_collection_add_object( collector, MY_ICOLLECTIONABLE( entry ), NULL, getter );
+			g_signal_emit_by_name( signaler, SIGNALER_BASE_NEW, entry );
+		} else {
+			g_object_unref( entry );
+		}
+	}
+
+	ofa_isignaler_end_batch( signaler );
+}
+
+/**
+ * ofo_entry_future_to_current:
+ * @getter: a #ofaIGetter instance.
+ *
+ * Moves the future entries which now fall into the current exercice
+ * to the current period, and reports their amounts into the current
+ * balances of the accounts and the ledgers. Status is unchanged.
+ *
+ * This is the set-based equivalent of the SIGNALER_EXERCICE_RECOMPUTE
+ * per-entry handlers: the balances are aggregated by account and by
+ * ledger and currency, and the entries are updated with a single
+ * statement, all of this inside of a transaction.
+ *
+ * As the entries, accounts and ledgers collections are then reloaded,
+ * only one SIGNALER_COLLECTION_RELOAD signal is sent for each of these
+ * types.
+ *
+ * Returns: %TRUE if successful.
+ */
+gboolean
+ofo_entry_future_to_current( ofaIGetter *getter )
+{
+	static const gchar *thisfn = "ofo_entry_future_to_current";
+	ofaHub *hub;
+	const ofaIDBConnect *connect;
+	ofaISignaler *signaler;
+	myICollector *collector;
+	gchar *where, *query, *sums;
+	const gchar *rough, *validated;
+	gboolean ok;
+
+	g_debug( "%s: getter=%p", thisfn, ( void * ) getter );
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
+
+	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
+	signaler = ofa_igetter_get_signaler( getter );
+	collector = ofa_igetter_get_collector( getter );
+
+	rough = ofo_entry_status_get_dbms( ENT_STATUS_ROUGH );
+	validated = ofo_entry_status_get_dbms( ENT_STATUS_VALIDATED );
+
+	query = effect_in_exercice( getter );
+	g_return_val_if_fail( query, FALSE );
+	where = g_strdup_printf( "%s AND ENT_IPERIOD='%s' AND ENT_RULE='%s'",
+			query, ofo_entry_period_get_dbms( ENT_PERIOD_FUTURE ), ofo_entry_rule_get_dbms( ENT_RULE_NORMAL ));
+	g_free( query );
+
+	sums = g_strdup_printf(
+			"SUM(CASE WHEN ENT_STATUS='%s' THEN ENT_DEBIT ELSE 0 END) AS CR_DEBIT,"
+			"SUM(CASE WHEN ENT_STATUS='%s' THEN ENT_CREDIT ELSE 0 END) AS CR_CREDIT,"
+			"SUM(CASE WHEN ENT_STATUS='%s' THEN ENT_DEBIT ELSE 0 END) AS CV_DEBIT,"
+			"SUM(CASE WHEN ENT_STATUS='%s' THEN ENT_CREDIT ELSE 0 END) AS CV_CREDIT",
+			rough, rough, validated, validated );
+
+	ok = ofa_idbconnect_transaction_start( connect, FALSE, NULL );
+
+	/* add the amounts to the current balances of the accounts */
+	if( ok ){
+		query = g_strdup_printf(
+				"UPDATE OFA_T_ACCOUNTS A, "
+				"	(SELECT ENT_ACCOUNT,%s FROM OFA_T_ENTRIES WHERE %s GROUP BY ENT_ACCOUNT) E "
+				"	SET A.ACC_CR_DEBIT=IFNULL(A.ACC_CR_DEBIT,0)+E.CR_DEBIT,"
+				"		A.ACC_CR_CREDIT=IFNULL(A.ACC_CR_CREDIT,0)+E.CR_CREDIT,"
+				"		A.ACC_CV_DEBIT=IFNULL(A.ACC_CV_DEBIT,0)+E.CV_DEBIT,"
+				"		A.ACC_CV_CREDIT=IFNULL(A.ACC_CV_CREDIT,0)+E.CV_CREDIT "
+				"	WHERE A.ACC_NUMBER=E.ENT_ACCOUNT", sums, where );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
+	}
+
+	/* add the amounts to the current balances of the ledgers,
+	 * creating the balance row if needed */
+	if( ok ){
+		query = g_strdup_printf(
+				"INSERT INTO OFA_T_LEDGERS_CUR "
+				"	(LED_MNEMO,LED_CUR_CODE,"
+				"	 LED_CUR_CR_DEBIT,LED_CUR_CR_CREDIT,LED_CUR_CV_DEBIT,LED_CUR_CV_CREDIT) "
+				"	SELECT ENT_LEDGER,ENT_CURRENCY,%s FROM OFA_T_ENTRIES WHERE %s "
+				"	GROUP BY ENT_LEDGER,ENT_CURRENCY "
+				"	ON DUPLICATE KEY UPDATE "
+				"		LED_CUR_CR_DEBIT=IFNULL(LED_CUR_CR_DEBIT,0)+VALUES(LED_CUR_CR_DEBIT),"
+				"		LED_CUR_CR_CREDIT=IFNULL(LED_CUR_CR_CREDIT,0)+VALUES(LED_CUR_CR_CREDIT),"
+				"		LED_CUR_CV_DEBIT=IFNULL(LED_CUR_CV_DEBIT,0)+VALUES(LED_CUR_CV_DEBIT),"
+				"		LED_CUR_CV_CREDIT=IFNULL(LED_CUR_CV_CREDIT,0)+VALUES(LED_CUR_CV_CREDIT)",
+				sums, where );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
+	}
 
-	query = g_strdup_printf( "SELECT DISTINCT(ENT_NUMBER) FROM %s "
-			"	WHERE ENT_NUMBER NOT IN (SELECT ENT_NUMBER FROM OFA_T_ENTRIES)", table );
+	/* last move the entries themselves */
+	if( ok ){
+		query = g_strdup_printf(
+				"UPDATE OFA_T_ENTRIES SET ENT_IPERIOD='%s' WHERE %s",
+				ofo_entry_period_get_dbms( ENT_PERIOD_CURRENT ), where );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
+	}
 
-	if( ofa_idbconnect_query_ex( connect, query, &result, FALSE )){
-		for( irow=result ; irow ; irow=irow->next ){
-			icol = irow->data;
-			entnum = atol(( const gchar * ) icol->data );
-			orphans = g_list_prepend( orphans, ( gpointer ) entnum );
-		}
-		ofa_idbconnect_free_results( result );
+	if( ok ){
+		ok = ofa_idbconnect_transaction_commit( connect, FALSE, NULL );
+	} else {
+		ofa_idbconnect_transaction_cancel( connect, FALSE, NULL );
 	}
 
-	g_free( query );
+	if( ok ){
+		my_icollector_collection_free( collector, OFO_TYPE_ENTRY );
+		g_signal_emit_by_name( signaler, SIGNALER_COLLECTION_RELOAD, OFO_TYPE_ENTRY );
+		my_icollector_collection_free( collector, OFO_TYPE_ACCOUNT );
+		g_signal_emit_by_name( signaler, SIGNALER_COLLECTION_RELOAD, OFO_TYPE_ACCOUNT );
+		my_icollector_collection_free( collector, OFO_TYPE_LEDGER );
+		g_signal_emit_by_name( signaler, SIGNALER_COLLECTION_RELOAD, OFO_TYPE_LEDGER );
+	}
 
-	return( orphans );
+	g_free( sums );
+	g_free( where );
+
+	return( ok );
 }
 
 /**
- * ofo_entry_insert:
+ * ofo_entry_ledger_months_remove:
+ * @connect: the #ofaIDBConnect connection.
+ * @where: a SQL condition on the OFA_T_ENTRIES table.
  *
- * Allocates a sequential number to the entry, and records it in the
- * dbms. Send the corresponding advertising messages if no error occurs.
+ * Removes the amounts of the entries selected by @where from the
+ * per-month balances of the ledgers, then drops the months which are
+ * left empty.
+ *
+ * This is to be called just before physically deleting these entries
+ * from the DBMS, e.g. when archiving the entries of a closed exercice.
+ *
+ * Returns: %TRUE if successful.
  */
 gboolean
-ofo_entry_insert( ofoEntry *entry )
+ofo_entry_ledger_months_remove( const ofaIDBConnect *connect, const gchar *where )
 {
-	static const gchar *thisfn = "ofo_entry_insert";
 	gboolean ok;
-	ofaIGetter *getter;
-	ofaISignaler *signaler;
 
-	g_debug( "%s: entry=%p", thisfn, ( void * ) entry );
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+	g_return_val_if_fail( my_strlen( where ), FALSE );
 
-	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
-	g_return_val_if_fail( !OFO_BASE( entry )->prot->dispose_has_run, FALSE );
+	ok = entry_months_update( connect, where, -1 ) &&
+			ofa_idbconnect_query( connect,
+					"DELETE FROM OFA_T_LEDGERS_MONTHS WHERE LED_MONTH_DEBIT=0 AND LED_MONTH_CREDIT=0", TRUE );
 
-	ok = FALSE;
-	getter = ofo_base_get_getter( OFO_BASE( entry ));
-	signaler = ofa_igetter_get_signaler( getter );
+	return( ok );
+}
 
-	entry_set_number( entry, ofo_counters_get_next_entry_id( getter ));
-	entry_compute_status( entry, FALSE, getter );
+static gboolean
+entry_do_insert( ofoEntry *entry, ofaIGetter *getter )
+{
+	GList *list;
+	gboolean ok;
 
-	/* rationale: see ofo-account.c */
-	ofo_entry_get_dataset( getter );
+	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
 
-	if( entry_do_insert( entry, getter )){
-		if( ofo_entry_get_period( entry ) != ENT_PERIOD_PAST ){
-			my_icollector_collection_add_object(
-					ofa_igetter_get_collector( getter ), MY_ICOLLECTIONABLE( entry ), NULL, getter );
-			g_signal_emit_by_name( signaler, SIGNALER_BASE_NEW, entry );
-		}
-		ok = TRUE;
-	}
+	list = g_list_append( NULL, entry );
+	ok = entry_do_insert_rows( list, 1, getter );
+	g_list_free( list );
 
 	return( ok );
 }
 
+/*
+ * Insert the @rows first entries of the @entries list with one
+ * multi-rows statement.
+ */
 static gboolean
-entry_do_insert( ofoEntry *entry, ofaIGetter *getter )
+entry_do_insert_rows( GList *entries, guint rows, ofaIGetter *getter )
 {
-	GString *query;
-	gchar *label, *ref;
-	gchar *sdeff, *sdope, *sdebit, *scredit, *stamp_str, *notes;
+	ofsIDBStatement *stmt;
 	gboolean ok;
 	myStampVal *stamp;
-	const gchar *model, *cur_code, *userid, *rule, *status, *period;
-	ofoCurrency *cur_obj;
+	const gchar *userid;
 	const ofaIDBConnect *connect;
-	ofxCounter ope_number, tiers;
 	ofaHub *hub;
+	gchar *query;
+	GString *where;
+	GList *it;
+	guint i;
+	gboolean started;
 
-	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
-
-	cur_code = ofo_entry_get_currency( entry );
-	cur_obj = ofo_currency_get_by_code( getter, cur_code );
-	g_return_val_if_fail( cur_obj && OFO_IS_CURRENCY( cur_obj ), FALSE );
+	g_return_val_if_fail( rows > 0 && rows <= ENTRY_INSERT_BATCH, FALSE );
 
 	hub = ofa_igetter_get_hub( getter );
 	connect = ofa_hub_get_connect( hub );
 	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
 
+	ok = TRUE;
 	userid = ofa_idbconnect_get_account( connect );
-	label = my_utils_quote_sql( ofo_entry_get_label( entry ));
-	ref = my_utils_quote_sql( ofo_entry_get_ref( entry ));
-	sdeff = my_date_to_str( ofo_entry_get_deffect( entry ), MY_DATE_SQL );
-	sdope = my_date_to_str( ofo_entry_get_dope( entry ), MY_DATE_SQL );
 	stamp = my_stamp_new_now();
-	stamp_str = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
 
-	query = g_string_new( "INSERT INTO OFA_T_ENTRIES " );
+	query = entry_get_insert_query( rows );
+	stmt = ofa_idbconnect_prepare( connect, query );
+	g_free( query );
 
-	g_string_append_printf( query,
-			"	(ENT_NUMBER,ENT_CRE_USER,ENT_CRE_STAMP,ENT_OPE_TEMPLATE,ENT_OPE_NUMBER,"
-			"	 ENT_DOPE,ENT_DEFFECT,ENT_LABEL,ENT_REF,ENT_ACCOUNT,ENT_CURRENCY,"
-			"	 ENT_LEDGER,ENT_DEBIT,ENT_CREDIT,ENT_TIERS,ENT_NOTES,"
-			"	 ENT_UPD_USER,ENT_UPD_STAMP,ENT_IPERIOD,ENT_STATUS,ENT_RULE) "
-			"	VALUES (%ld,'%s','%s',",
-			ofo_entry_get_number( entry ),
-			userid,
-			stamp_str );
-
-	model = ofo_entry_get_ope_template( entry );
-	if( my_strlen( model )){
-		g_string_append_printf( query, "'%s',", model );
-	} else {
-		query = g_string_append( query, "NULL," );
+	for( i=0, it=entries ; i<rows && it && ok ; ++i, it=it->next ){
+		ok = entry_bind_insert( OFO_ENTRY( it->data ), stmt, i*ENTRY_INSERT_COLUMNS, userid, stamp, getter );
 	}
 
-	ope_number = ofo_entry_get_ope_number( entry );
-	if( ope_number > 0 ){
-		g_string_append_printf( query, "%ld,", ope_number );
-	} else {
-		query = g_string_append( query, "NULL," );
-	}
+	ok = ok && i == rows && entry_transaction_start( connect, &started );
 
-	g_string_append_printf( query,
-			"'%s','%s','%s',",
-				sdope, sdeff, label );
+	if( ok ){
+		ok = ofa_idbconnect_execute( connect, stmt, TRUE );
 
-	if( my_strlen( ref )){
-		g_string_append_printf( query, "'%s',", ref );
-	} else {
-		query = g_string_append( query, "NULL," );
+		if( ok ){
+			where = g_string_new( "ENT_NUMBER IN (" );
+			for( i=0, it=entries ; i<rows ; ++i, it=it->next ){
+				g_string_append_printf( where, "%s%ld", i ? "," : "", ofo_entry_get_number( OFO_ENTRY( it->data )));
+			}
+			where = g_string_append( where, ")" );
+			ok = entry_months_update( connect, where->str, 1 );
+			g_string_free( where, TRUE );
+		}
+
+		ok = entry_transaction_end( connect, started, ok );
+	}
+
+	if( ok ){
+		for( i=0, it=entries ; i<rows ; ++i, it=it->next ){
+			entry_set_inserted( OFO_ENTRY( it->data ), userid, stamp );
+		}
 	}
 
-	g_string_append_printf( query,
-			"'%s','%s','%s',",
-				ofo_entry_get_account( entry ),
-				cur_code,
-				ofo_entry_get_ledger( entry ));
+	my_stamp_free( stamp );
+
+	return( ok );
+}
 
-	sdebit = ofa_amount_to_sql( ofo_entry_get_debit( entry ), cur_obj );
-	scredit = ofa_amount_to_sql( ofo_entry_get_credit( entry ), cur_obj );
+/*
+ * Add (resp. subtract if @sign is negative) the amounts of the
+ * non-deleted entries selected by @where to the per-month balances of
+ * their ledger and currency.
+ *
+ * This must be run in the same transaction than the update of the
+ * entries: before it to subtract the previous amounts, after it to
+ * add the new ones.
+ */
+static gboolean
+entry_months_update( const ofaIDBConnect *connect, const gchar *where, gint sign )
+{
+	gchar *query;
+	gboolean ok;
+	const gchar *op;
 
-	g_string_append_printf( query,
-				"%s,%s,",
-				sdebit,
-				scredit );
+	op = sign < 0 ? "-" : "";
 
-	tiers = ofo_entry_get_tiers( entry );
-	if( tiers > 0 ){
-		g_string_append_printf( query, "%lu,", tiers );
-	} else {
-		query = g_string_append( query, "NULL," );
+	query = g_strdup_printf(
+			"INSERT INTO OFA_T_LEDGERS_MONTHS "
+			"	(LED_MNEMO,LED_CUR_CODE,LED_MONTH,LED_MONTH_DEBIT,LED_MONTH_CREDIT) "
+			"	SELECT ENT_LEDGER,ENT_CURRENCY,DATE_FORMAT(ENT_DEFFECT,'%%Y-%%m-01'),"
+			"		%sSUM(IFNULL(ENT_DEBIT,0)),%sSUM(IFNULL(ENT_CREDIT,0)) "
+			"	FROM OFA_T_ENTRIES WHERE (%s) AND ENT_STATUS!='%s' "
+			"	GROUP BY ENT_LEDGER,ENT_CURRENCY,DATE_FORMAT(ENT_DEFFECT,'%%Y-%%m-01') "
+			"	ON DUPLICATE KEY UPDATE "
+			"		LED_MONTH_DEBIT=LED_MONTH_DEBIT+VALUES(LED_MONTH_DEBIT),"
+			"		LED_MONTH_CREDIT=LED_MONTH_CREDIT+VALUES(LED_MONTH_CREDIT)",
+			op, op, where, ofo_entry_status_get_dbms( ENT_STATUS_DELETED ));
+
+	ok = ofa_idbconnect_query( connect, query, TRUE );
+	g_free( query );
+
+	return( ok );
+}
+
+/*
+ * Start a transaction, unless the caller has already started one
+ * (transactions do not nest).
+ * @started is set to %TRUE if the transaction has been started here,
+ * and must so be terminated by entry_transaction_end().
+ */
+static gboolean
+entry_transaction_start( const ofaIDBConnect *connect, gboolean *started )
+{
+	gboolean ok;
+
+	ok = TRUE;
+	*started = FALSE;
+
+	if( !ofa_idbconnect_transaction_is_started( connect )){
+		ok = ofa_idbconnect_transaction_start( connect, FALSE, NULL );
+		*started = ok;
 	}
 
-	notes = my_utils_quote_sql( ofo_entry_get_notes( entry ));
-	if( my_strlen( notes )){
-		g_string_append_printf( query, "'%s',", notes );
-	} else {
-		query = g_string_append( query, "NULL," );
+	return( ok );
+}
+
+static gboolean
+entry_transaction_end( const ofaIDBConnect *connect, gboolean started, gboolean ok )
+{
+	if( started ){
+		if( ok ){
+			ok = ofa_idbconnect_transaction_commit( connect, FALSE, NULL );
+		} else {
+			ofa_idbconnect_transaction_cancel( connect, FALSE, NULL );
+		}
+	}
+
+	return( ok );
+}
+
+static gchar *
+entry_get_insert_query( guint rows )
+{
+	GString *query;
+	guint i;
+
+	query = g_string_new(
+			"INSERT INTO OFA_T_ENTRIES "
+			"	(ENT_NUMBER,ENT_CRE_USER,ENT_CRE_STAMP,ENT_OPE_TEMPLATE,ENT_OPE_NUMBER,"
+			"	 ENT_DOPE,ENT_DEFFECT,ENT_LABEL,ENT_REF,ENT_ACCOUNT,ENT_CURRENCY,"
+			"	 ENT_LEDGER,ENT_DEBIT,ENT_CREDIT,ENT_TIERS,ENT_NOTES,"
+			"	 ENT_UPD_USER,ENT_UPD_STAMP,ENT_IPERIOD,ENT_STATUS,ENT_RULE,"
+			"	 ENT_STLMT_NUMBER,ENT_STLMT_USER,ENT_STLMT_STAMP) "
+			"	VALUES " );
+
+	for( i=0 ; i<rows ; ++i ){
+		g_string_append_printf( query, "%s(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)", i ? "," : "" );
 	}
 
-	g_string_append_printf( query,
-			"'%s','%s',",
-				userid,
-				stamp_str );
+	return( g_string_free( query, FALSE ));
+}
+
+/*
+ * Bind the ENTRY_INSERT_COLUMNS parameters of @entry, starting at
+ * @offset in @stmt
+ */
+static gboolean
+entry_bind_insert( ofoEntry *entry, ofsIDBStatement *stmt, guint offset, const gchar *userid, const myStampVal *stamp, ofaIGetter *getter )
+{
+	const gchar *cur_code, *rule, *status, *period;
+	ofoCurrency *cur_obj;
+	ofxCounter ope_number, tiers, stlmt_number;
+	guint digits;
+
+	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
+
+	cur_code = ofo_entry_get_currency( entry );
+	cur_obj = ofo_currency_get_by_code( getter, cur_code );
+	g_return_val_if_fail( cur_obj && OFO_IS_CURRENCY( cur_obj ), FALSE );
 
 	period = ofa_box_get_string( OFO_BASE( entry )->prot->fields, ENT_IPERIOD );
 	g_return_val_if_fail( my_strlen( period ) == 1, FALSE );
-	g_string_append_printf( query, "'%s',", period );
 
 	status = ofa_box_get_string( OFO_BASE( entry )->prot->fields, ENT_STATUS );
 	g_return_val_if_fail( my_strlen( status ) == 1, FALSE );
-	g_string_append_printf( query, "'%s',", status );
 
 	rule = ofa_box_get_string( OFO_BASE( entry )->prot->fields, ENT_RULE );
 	g_return_val_if_fail( my_strlen( rule ) == 1, FALSE );
-	g_string_append_printf( query, "'%s')", rule );
 
-	if( ofa_idbconnect_query( connect, query->str, TRUE )){
+	digits = ofo_currency_get_digits( cur_obj );
 
-		entry_set_cre_user( entry, userid );
-		entry_set_cre_stamp( entry, stamp );
+	ofa_idbconnect_bind_int( stmt, offset+0, ofo_entry_get_number( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+1, userid );
+	ofa_idbconnect_bind_stamp( stmt, offset+2, stamp );
+	ofa_idbconnect_bind_string( stmt, offset+3, ofo_entry_get_ope_template( entry ));
 
-		entry_set_upd_user( entry, userid );
-		entry_set_upd_stamp( entry, stamp );
+	ope_number = ofo_entry_get_ope_number( entry );
+	if( ope_number > 0 ){
+		ofa_idbconnect_bind_int( stmt, offset+4, ope_number );
+	} else {
+		ofa_idbconnect_bind_null( stmt, offset+4 );
+	}
 
-		ok = TRUE;
+	ofa_idbconnect_bind_date( stmt, offset+5, ofo_entry_get_dope( entry ));
+	ofa_idbconnect_bind_date( stmt, offset+6, ofo_entry_get_deffect( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+7, ofo_entry_get_label( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+8, ofo_entry_get_ref( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+9, ofo_entry_get_account( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+10, cur_code );
+	ofa_idbconnect_bind_string( stmt, offset+11, ofo_entry_get_ledger( entry ));
+	ofa_idbconnect_bind_amount( stmt, offset+12, ofo_entry_get_debit( entry ), digits );
+	ofa_idbconnect_bind_amount( stmt, offset+13, ofo_entry_get_credit( entry ), digits );
+
+	tiers = ofo_entry_get_tiers( entry );
+	if( tiers > 0 ){
+		ofa_idbconnect_bind_int( stmt, offset+14, tiers );
+	} else {
+		ofa_idbconnect_bind_null( stmt, offset+14 );
+	}
+
+	ofa_idbconnect_bind_string( stmt, offset+15, ofo_entry_get_notes( entry ));
+	ofa_idbconnect_bind_string( stmt, offset+16, userid );
+	ofa_idbconnect_bind_stamp( stmt, offset+17, stamp );
+	ofa_idbconnect_bind_string( stmt, offset+18, period );
+	ofa_idbconnect_bind_string( stmt, offset+19, status );
+	ofa_idbconnect_bind_string( stmt, offset+20, rule );
+
+	/* a settlement number may have been set before the insertion */
+	stlmt_number = ofo_entry_get_settlement_number( entry );
+	if( stlmt_number > 0 ){
+		ofa_idbconnect_bind_int( stmt, offset+21, stlmt_number );
+		ofa_idbconnect_bind_string( stmt, offset+22, userid );
+		ofa_idbconnect_bind_stamp( stmt, offset+23, stamp );
+	} else {
+		ofa_idbconnect_bind_null( stmt, offset+21 );
+		ofa_idbconnect_bind_null( stmt, offset+22 );
+		ofa_idbconnect_bind_null( stmt, offset+23 );
 	}
 
-	g_string_free( query, TRUE );
-	g_free( notes );
-	g_free( sdebit );
-	g_free( scredit );
-	g_free( sdeff );
-	g_free( sdope );
-	g_free( ref );
-	g_free( label );
-	g_free( stamp_str );
-	my_stamp_free( stamp );
+	return( TRUE );
+}
 
-	return( ok );
+static void
+entry_set_inserted( ofoEntry *entry, const gchar *userid, const myStampVal *stamp )
+{
+	entry_set_cre_user( entry, userid );
+	entry_set_cre_stamp( entry, stamp );
+
+	entry_set_upd_user( entry, userid );
+	entry_set_upd_stamp( entry, stamp );
+
+	if( ofo_entry_get_settlement_number( entry ) > 0 ){
+		entry_set_settlement_user( entry, userid );
+		entry_set_settlement_stamp( entry, stamp );
+	}
 }
 
 static void
@@ -2584,16 +3410,17 @@ static gboolean
 entry_do_update( ofoEntry *entry, ofaIGetter *getter )
 {
 	ofaHub *hub;
-	GString *query;
-	gchar *sdeff, *sdope, *sdeb, *scre, *notes;
-	gchar *stamp_str, *label, *ref;
+	ofsIDBStatement *stmt;
 	myStampVal *stamp;
 	gboolean ok;
-	const gchar *model, *cstr, *userid, *rule, *period;
+	const gchar *userid, *rule, *period;
 	const gchar *cur_code;
 	ofoCurrency *cur_obj;
 	const ofaIDBConnect *connect;
 	ofxCounter tiers;
+	guint digits;
+	gchar *where;
+	gboolean started;
 
 	g_return_val_if_fail( entry && OFO_IS_ENTRY( entry ), FALSE );
 
@@ -2605,85 +3432,68 @@ entry_do_update( ofoEntry *entry, ofaIGetter *getter )
 	connect = ofa_hub_get_connect( hub );
 	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
 
-	userid = ofa_idbconnect_get_account( connect );
-	label = my_utils_quote_sql( ofo_entry_get_label( entry ));
-	sdope = my_date_to_str( ofo_entry_get_dope( entry ), MY_DATE_SQL );
-	sdeff = my_date_to_str( ofo_entry_get_deffect( entry ), MY_DATE_SQL );
-	sdeb = ofa_amount_to_sql( ofo_entry_get_debit( entry ), cur_obj );
-	scre = ofa_amount_to_sql( ofo_entry_get_credit( entry ), cur_obj );
-	stamp = my_stamp_new_now();
-	stamp_str = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
-
-	query = g_string_new( "UPDATE OFA_T_ENTRIES " );
-
-	g_string_append_printf( query,
-			"	SET ENT_DEFFECT='%s',ENT_DOPE='%s',ENT_LABEL='%s',",
-			sdeff, sdope,
-			label );
-
-	cstr = ofo_entry_get_ref( entry );
-	ref = my_strlen( cstr ) ? my_utils_quote_sql( cstr ) : NULL;
-	if( my_strlen( ref )){
-		g_string_append_printf( query, " ENT_REF='%s',", ref );
-	} else {
-		query = g_string_append( query, " ENT_REF=NULL," );
-	}
-
-	g_string_append_printf( query,
-			"	ENT_ACCOUNT='%s',ENT_CURRENCY='%s',ENT_LEDGER='%s',",
-			ofo_entry_get_account( entry ),
-			cur_code,
-			ofo_entry_get_ledger( entry ));
-
-	model = ofo_entry_get_ope_template( entry );
-	if( !my_strlen( model )){
-		query = g_string_append( query, " ENT_OPE_TEMPLATE=NULL," );
-	} else {
-		g_string_append_printf( query, " ENT_OPE_TEMPLATE='%s',", model );
-	}
-
 	rule = ofa_box_get_string( OFO_BASE( entry )->prot->fields, ENT_RULE );
 	g_return_val_if_fail( my_strlen( rule ) == 1, FALSE );
-	g_string_append_printf( query, "ENT_RULE='%s',", rule );
-
-	tiers = ofo_entry_get_tiers( entry );
-	if( tiers > 0 ){
-		g_string_append_printf( query, "ENT_TIERS=%lu,", tiers );
-	} else {
-		query = g_string_append( query, "ENT_TIERS=NULL," );
-	}
 
 	period = ofa_box_get_string( OFO_BASE( entry )->prot->fields, ENT_IPERIOD );
 	g_return_val_if_fail( my_strlen( period ) == 1, FALSE );
-	g_string_append_printf( query, "ENT_IPERIOD='%s',", period );
 
-	notes = my_utils_quote_sql( ofo_entry_get_notes( entry ));
-	if( my_strlen( notes )){
-		g_string_append_printf( query, "ENT_NOTES='%s',", notes );
+	ok = FALSE;
+	userid = ofa_idbconnect_get_account( connect );
+	digits = ofo_currency_get_digits( cur_obj );
+	stamp = my_stamp_new_now();
+
+	stmt = ofa_idbconnect_prepare( connect,
+			"UPDATE OFA_T_ENTRIES "
+			"	SET ENT_DEFFECT=?,ENT_DOPE=?,ENT_LABEL=?,ENT_REF=?,"
+			"	ENT_ACCOUNT=?,ENT_CURRENCY=?,ENT_LEDGER=?,ENT_OPE_TEMPLATE=?,"
+			"	ENT_RULE=?,ENT_TIERS=?,ENT_IPERIOD=?,ENT_NOTES=?,"
+			"	ENT_DEBIT=?,ENT_CREDIT=?,"
+			"	ENT_UPD_USER=?,ENT_UPD_STAMP=? "
+			"	WHERE ENT_NUMBER=?" );
+
+	ofa_idbconnect_bind_date( stmt, 0, ofo_entry_get_deffect( entry ));
+	ofa_idbconnect_bind_date( stmt, 1, ofo_entry_get_dope( entry ));
+	ofa_idbconnect_bind_string( stmt, 2, ofo_entry_get_label( entry ));
+	ofa_idbconnect_bind_string( stmt, 3, ofo_entry_get_ref( entry ));
+	ofa_idbconnect_bind_string( stmt, 4, ofo_entry_get_account( entry ));
+	ofa_idbconnect_bind_string( stmt, 5, cur_code );
+	ofa_idbconnect_bind_string( stmt, 6, ofo_entry_get_ledger( entry ));
+	ofa_idbconnect_bind_string( stmt, 7, ofo_entry_get_ope_template( entry ));
+	ofa_idbconnect_bind_string( stmt, 8, rule );
+
+	tiers = ofo_entry_get_tiers( entry );
+	if( tiers > 0 ){
+		ofa_idbconnect_bind_int( stmt, 9, tiers );
 	} else {
-		query = g_string_append( query, "ENT_NOTES=NULL," );
+		ofa_idbconnect_bind_null( stmt, 9 );
+	}
+
+	ofa_idbconnect_bind_string( stmt, 10, period );
+	ofa_idbconnect_bind_string( stmt, 11, ofo_entry_get_notes( entry ));
+	ofa_idbconnect_bind_amount( stmt, 12, ofo_entry_get_debit( entry ), digits );
+	ofa_idbconnect_bind_amount( stmt, 13, ofo_entry_get_credit( entry ), digits );
+	ofa_idbconnect_bind_string( stmt, 14, userid );
+	ofa_idbconnect_bind_stamp( stmt, 15, stamp );
+	ofa_idbconnect_bind_int( stmt, 16, ofo_entry_get_number( entry ));
+
+	/* the effect date, the ledger, the currency and the amounts may all
+	 * have changed: move the entry out of its previous month balance,
+	 * then into the new one */
+	if( entry_transaction_start( connect, &started )){
+		where = g_strdup_printf( "ENT_NUMBER=%ld", ofo_entry_get_number( entry ));
+		ok = entry_months_update( connect, where, -1 ) &&
+				ofa_idbconnect_execute( connect, stmt, TRUE ) &&
+				entry_months_update( connect, where, 1 );
+		ok = entry_transaction_end( connect, started, ok );
+		g_free( where );
 	}
 
-	g_string_append_printf( query,
-			"	ENT_DEBIT=%s,ENT_CREDIT=%s,"
-			"	ENT_UPD_USER='%s',ENT_UPD_STAMP='%s' "
-			"	WHERE ENT_NUMBER=%ld",
-			sdeb, scre, userid, stamp_str, ofo_entry_get_number( entry ));
-
-	if( ofa_idbconnect_query( connect, query->str, TRUE )){
+	if( ok ){
 		entry_set_upd_user( entry, userid );
 		entry_set_upd_stamp( entry, stamp );
-		ok = TRUE;
 	}
 
-	g_string_free( query, TRUE );
-	g_free( label );
-	g_free( ref );
-	g_free( sdeff );
-	g_free( sdope );
-	g_free( sdeb );
-	g_free( scre );
-	g_free( stamp_str );
 	my_stamp_free( stamp );
 
 	return( ok );
@@ -2786,7 +3596,7 @@ ofo_entry_unsettle_by_number( ofaIGetter *getter, ofxCounter stlmt_number )
 
 	/* get the list of entries */
 	where = g_strdup_printf( "ENT_STLMT_NUMBER=%ld", stlmt_number );
-	entries = entry_load_dataset( getter, where, NULL );
+	entries = entry_load_dataset( getter, where, NULL, FALSE );
 	g_free( where );
 
 	/* update the entries, simultaneously sending messages */
@@ -2872,11 +3682,15 @@ ofo_entry_validate_by_ledger( ofaIGetter *getter, const gchar *mnemo, const GDat
 
 	g_signal_emit_by_name( signaler, SIGNALER_CHANGE_COUNT, -1, ENT_STATUS_VALIDATED, ( gulong ) g_list_length( dataset ));
 
+	ofa_isignaler_begin_batch( signaler );
+
 	for( it=dataset ; it ; it=it->next ){
 		entry = OFO_ENTRY( it->data );
 		ofo_entry_validate( entry );
 	}
 
+	ofa_isignaler_end_batch( signaler );
+
 	ofo_entry_free_dataset( dataset );
 
 	return( TRUE );
@@ -2897,15 +3711,20 @@ ofo_entry_validate_by_opes( ofaIGetter *getter, GList *opes )
 {
 	GList *it;
 	gboolean ok;
+	ofaISignaler *signaler;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
 
 	ok = TRUE;
+	signaler = ofa_igetter_get_signaler( getter );
+	ofa_isignaler_begin_batch( signaler );
 
 	for( it=opes ; it && ok ; it=it->next ){
 		ok = do_validate_by_ope( getter, ( ofxCounter ) it->data );
 	}
 
+	ofa_isignaler_end_batch( signaler );
+
 	return( ok );
 }
 
@@ -3332,7 +4151,7 @@ static guint
 iimportable_import( ofaIImporter *importer, ofsImporterParms *parms, GSList *lines )
 {
 	GList *dataset;
-	gchar *bck_table;
+	gchar *bck_table, *bck_months;
 	ofaHub *hub;
 	ofaIDBConnect *connect;
 
@@ -3343,13 +4162,16 @@ iimportable_import( ofaIImporter *importer, ofsImporterParms *parms, GSList *lin
 
 	if( parms->parse_errs == 0 && parms->parsed_count > 0 ){
 		bck_table = ofa_idbconnect_table_backup( connect, "OFA_T_ENTRIES" );
+		bck_months = ofa_idbconnect_table_backup( connect, "OFA_T_LEDGERS_MONTHS" );
 		iimportable_import_insert( importer, parms, dataset );
 
 		if( parms->insert_errs > 0 ){
 			ofa_idbconnect_table_restore( connect, bck_table, "OFA_T_ENTRIES" );
+			ofa_idbconnect_table_restore( connect, bck_months, "OFA_T_LEDGERS_MONTHS" );
 		}
 
 		g_free( bck_table );
+		g_free( bck_months );
 	}
 
 	if( dataset ){
@@ -4437,7 +5259,8 @@ iimportable_import_insert( ofaIImporter *importer, ofsImporterParms *parms, GLis
 static gboolean
 entry_drop_content( const ofaIDBConnect *connect )
 {
-	return( ofa_idbconnect_query( connect, "DELETE FROM OFA_T_ENTRIES", TRUE ));
+	return( ofa_idbconnect_query( connect, "DELETE FROM OFA_T_ENTRIES", TRUE ) &&
+			ofa_idbconnect_query( connect, "DELETE FROM OFA_T_LEDGERS_MONTHS", TRUE ));
 }
 
 /*
@@ -4620,10 +5443,12 @@ signaler_on_entry_period_status_changed( ofaISignaler *signaler, ofoEntry *entry
 											void *empty )
 {
 	static const gchar *thisfn = "ofo_entry_signaler_on_entry_period_status_changed";
-	gchar *query;
+	gchar *query, *where;
 	ofaIGetter *getter;
 	ofaHub *hub;
+	const ofaIDBConnect *connect;
 	const gchar *cperiod, *cstatus;
+	gboolean months, started, ok;
 
 	g_debug( "%s: signaler=%p, entry=%p, prev_period=%d, prev_status=%d, new_period=%d, new_status=%d, empty=%p",
 			thisfn, ( void * ) signaler, ( void * ) entry,
@@ -4646,7 +5471,28 @@ signaler_on_entry_period_status_changed( ofaISignaler *signaler, ofoEntry *entry
 					"UPDATE OFA_T_ENTRIES SET ENT_IPERIOD='%s',ENT_STATUS='%s' WHERE ENT_NUMBER=%ld",
 						cperiod, cstatus, ofo_entry_get_number( entry ));
 
-	if( ofa_idbconnect_query( ofa_hub_get_connect( hub ), query, TRUE )){
+	connect = ofa_hub_get_connect( hub );
+
+	/* the per-month balances only count the non-deleted entries */
+	months = ( prev_status != -1 && new_status != -1 &&
+				( prev_status == ENT_STATUS_DELETED ) != ( new_status == ENT_STATUS_DELETED ));
+
+	if( !months ){
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+
+	} else if( entry_transaction_start( connect, &started )){
+		where = g_strdup_printf( "ENT_NUMBER=%ld", ofo_entry_get_number( entry ));
+		ok = entry_months_update( connect, where, -1 ) &&
+				ofa_idbconnect_query( connect, query, TRUE ) &&
+				entry_months_update( connect, where, 1 );
+		ok = entry_transaction_end( connect, started, ok );
+		g_free( where );
+
+	} else {
+		ok = FALSE;
+	}
+
+	if( ok ){
 		g_signal_emit_by_name( signaler, SIGNALER_BASE_UPDATED, entry, NULL );
 	}
 
@@ -4855,7 +5701,7 @@ remediate_status( ofaIGetter *getter, const gchar *where, ofeEntryPeriod new_per
 	ofaISignaler *signaler;
 
 	count = 0;
-	dataset = entry_load_dataset( getter, where, NULL );
+	dataset = entry_load_dataset( getter, where, NULL, FALSE );
 	count = g_list_length( dataset );
 
 	signaler = ofa_igetter_get_signaler( getter );
@@ -5025,16 +5871,30 @@ signaler_on_updated_currency_code( ofaISignaler *signaler, const gchar *prev_id,
 	ofaIGetter *getter;
 	ofaHub *hub;
 	gchar *query;
+	const ofaIDBConnect *connect;
+	gboolean started, ok;
 
 	getter = ofa_isignaler_get_getter( signaler );
 	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
 
-	query = g_strdup_printf(
-			"UPDATE OFA_T_ENTRIES "
-			"	SET ENT_CURRENCY='%s' WHERE ENT_CURRENCY='%s' ", code, prev_id );
+	if( entry_transaction_start( connect, &started )){
+		query = g_strdup_printf(
+				"UPDATE OFA_T_ENTRIES "
+				"	SET ENT_CURRENCY='%s' WHERE ENT_CURRENCY='%s' ", code, prev_id );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
 
-	ofa_idbconnect_query( ofa_hub_get_connect( hub ), query, TRUE );
-	g_free( query );
+		if( ok ){
+			query = g_strdup_printf(
+					"UPDATE OFA_T_LEDGERS_MONTHS "
+					"	SET LED_CUR_CODE='%s' WHERE LED_CUR_CODE='%s' ", code, prev_id );
+			ok = ofa_idbconnect_query( connect, query, TRUE );
+			g_free( query );
+		}
+
+		entry_transaction_end( connect, started, ok );
+	}
 
 	free_collection( signaler );
 }
@@ -5050,16 +5910,30 @@ signaler_on_updated_ledger_mnemo( ofaISignaler *signaler, const gchar *prev_id,
 	ofaIGetter *getter;
 	ofaHub *hub;
 	gchar *query;
+	const ofaIDBConnect *connect;
+	gboolean started, ok;
 
 	getter = ofa_isignaler_get_getter( signaler );
 	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
 
-	query = g_strdup_printf(
-			"UPDATE OFA_T_ENTRIES"
-			"	SET ENT_LEDGER='%s' WHERE ENT_LEDGER='%s' ", mnemo, prev_id );
+	if( entry_transaction_start( connect, &started )){
+		query = g_strdup_printf(
+				"UPDATE OFA_T_ENTRIES"
+				"	SET ENT_LEDGER='%s' WHERE ENT_LEDGER='%s' ", mnemo, prev_id );
+		ok = ofa_idbconnect_query( connect, query, TRUE );
+		g_free( query );
 
-	ofa_idbconnect_query( ofa_hub_get_connect( hub ), query, TRUE );
-	g_free( query );
+		if( ok ){
+			query = g_strdup_printf(
+					"UPDATE OFA_T_LEDGERS_MONTHS "
+					"	SET LED_MNEMO='%s' WHERE LED_MNEMO='%s' ", mnemo, prev_id );
+			ok = ofa_idbconnect_query( connect, query, TRUE );
+			g_free( query );
+		}
+
+		entry_transaction_end( connect, started, ok );
+	}
 
 	free_collection( signaler );
 }
@@ -99,11 +99,13 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( LED_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,					/* importable */
-				FALSE },				/* amount, counter: export zero as empty */
+				FALSE,					/* amount, counter: export zero as empty */
+				TRUE },
 		{ OFA_BOX_CSV( LED_CRE_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( LED_CRE_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -119,7 +121,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( LED_UPD_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( LED_UPD_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -199,7 +202,8 @@ static const ofsBoxDef st_archive_defs[] = {
 		{ OFA_BOX_CSV( LED_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( LED_ARC_CURRENCY ),
 				OFA_TYPE_STRING,
 				TRUE,
@@ -223,7 +227,8 @@ static const ofsBoxDef st_doc_defs[] = {
 		{ OFA_BOX_CSV( LED_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( LED_DOC_ID ),
 				OFA_TYPE_COUNTER,
 				TRUE,
@@ -238,6 +243,7 @@ typedef struct {
 	GList *balances;					/* the balances per currency as a GList of GList fields */
 	GList *archives;					/* archived balances of the ledger */
 	GList *docs;
+	gchar *mnemo_key;					/* collation key of the mnemonic */
 }
 	ofoLedgerPrivate;
 
@@ -265,7 +271,7 @@ static gboolean   ledger_insert_main( ofoLedger *ledger, const ofaIDBConnect *co
 static gboolean   ledger_do_update( ofoLedger *ledger, const gchar *prev_mnemo, const ofaIDBConnect *connect );
 static gboolean   ledger_do_update_balance( ofoLedger *ledger, GList *balance, ofaIGetter *getter );
 static gboolean   ledger_do_delete( ofoLedger *ledger, const ofaIDBConnect *connect );
-static gint       ledger_cmp_by_mnemo( const ofoLedger *a, const gchar *mnemo );
+static gint       ledger_cmp_by_mnemo_key( const ofoLedger *a, const gchar *mnemo_key );
 static void       icollectionable_iface_init( myICollectionableInterface *iface );
 static guint      icollectionable_get_interface_version( void );
 static GList     *icollectionable_load_collection( void *user_data );
@@ -326,6 +332,7 @@ static void
 ledger_finalize( GObject *instance )
 {
 	static const gchar *thisfn = "ofo_ledger_finalize";
+	ofoLedgerPrivate *priv;
 
 	g_debug( "%s: instance=%p (%s): %s - %s",
 			thisfn, ( void * ) instance, G_OBJECT_TYPE_NAME( instance ),
@@ -338,6 +345,9 @@ ledger_finalize( GObject *instance )
 
 	free_detail_currencies( OFO_LEDGER( instance ));
 
+	priv = ofo_ledger_get_instance_private( OFO_LEDGER( instance ));
+	g_free( priv->mnemo_key );
+
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofo_ledger_parent_class )->finalize( instance );
 }
@@ -370,6 +380,7 @@ ofo_ledger_init( ofoLedger *self )
 	priv->balances = NULL;
 	priv->archives = NULL;
 	priv->docs = NULL;
+	priv->mnemo_key = NULL;
 }
 
 static void
@@ -432,8 +443,11 @@ static ofoLedger *
 ledger_find_by_mnemo( GList *set, const gchar *mnemo )
 {
 	GList *found;
+	gchar *mnemo_key;
 
-	found = g_list_find_custom( set, mnemo, ( GCompareFunc ) ledger_cmp_by_mnemo );
+	mnemo_key = my_collate_key( mnemo );
+	found = g_list_find_custom( set, mnemo_key, ( GCompareFunc ) ledger_cmp_by_mnemo_key );
+	g_free( mnemo_key );
 
 	if( found ){
 		return( OFO_LEDGER( found->data ));
@@ -486,6 +500,36 @@ ofo_ledger_get_mnemo( const ofoLedger *ledger )
 	ofo_base_getter( LEDGER, ledger, string, NULL, LED_MNEMO );
 }
 
+/**
+ * ofo_ledger_get_mnemo_key:
+ * @ledger: this #ofoLedger object.
+ *
+ * Returns: the collation key of the mnemonic of the @ledger, as
+ * computed by my_collate_key().
+ *
+ * The key is computed on first request, and kept until the mnemonic
+ * be modified.
+ *
+ * The returned value is owned by the @ledger, and should not be
+ * released by the caller.
+ */
+const gchar *
+ofo_ledger_get_mnemo_key( const ofoLedger *ledger )
+{
+	ofoLedgerPrivate *priv;
+
+	g_return_val_if_fail( ledger && OFO_IS_LEDGER( ledger ), NULL );
+	g_return_val_if_fail( !OFO_BASE( ledger )->prot->dispose_has_run, NULL );
+
+	priv = ofo_ledger_get_instance_private(( ofoLedger * ) ledger );
+
+	if( !priv->mnemo_key ){
+		priv->mnemo_key = my_collate_key( ofo_ledger_get_mnemo( ledger ));
+	}
+
+	return( priv->mnemo_key );
+}
+
 /**
  * ofo_ledger_get_label:
  */
@@ -715,7 +759,13 @@ ledger_set_cre_stamp( ofoLedger *ledger, const myStampVal *stamp )
 void
 ofo_ledger_set_mnemo( ofoLedger *ledger, const gchar *mnemo )
 {
+	ofoLedgerPrivate *priv;
+
 	ofo_base_setter( LEDGER, ledger, string, LED_MNEMO, mnemo );
+
+	priv = ofo_ledger_get_instance_private( ledger );
+	g_free( priv->mnemo_key );
+	priv->mnemo_key = NULL;
 }
 
 /**
@@ -2112,13 +2162,9 @@ ledger_do_delete( ofoLedger *ledger, const ofaIDBConnect *connect )
 }
 
 static gint
-ledger_cmp_by_mnemo( const ofoLedger *a, const gchar *mnemo )
+ledger_cmp_by_mnemo_key( const ofoLedger *a, const gchar *mnemo_key )
 {
-	const gchar *mnemo_a;
-
-	mnemo_a = ofo_ledger_get_mnemo( a );
-
-	return( my_collate( mnemo_a, mnemo ));
+	return( g_strcmp0( ofo_ledger_get_mnemo_key( a ), mnemo_key ));
 }
 
 /*
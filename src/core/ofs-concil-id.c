@@ -26,6 +26,8 @@
 #include <config.h>
 #endif
 
+#include "my/my-utils.h"
+
 #include "api/ofs-concil-id.h"
 
 /**
@@ -43,7 +45,7 @@ ofs_concil_id_new( void )
 void
 ofs_concil_id_free( ofsConcilId *sid )
 {
-	g_free( sid->type );
+	my_utils_intern_unref( sid->type );
 	g_free( sid );
 }
 
@@ -58,7 +60,7 @@ ofs_concil_id_free( ofsConcilId *sid )
 gboolean
 ofs_concil_id_is_equal( const ofsConcilId *sid, const gchar *type, ofxCounter id )
 {
-	return( !g_utf8_collate( sid->type, type ) && sid->other_id == id );
+	return( !g_strcmp0( sid->type, type ) && sid->other_id == id );
 }
 
 /**
@@ -77,7 +79,7 @@ ofs_concil_id_get_first( GList *ids, const gchar *type )
 
 	for( it=ids ; it ; it=it->next ){
 		sid = ( ofsConcilId * ) it->data;
-		if( !g_utf8_collate( sid->type, type )){
+		if( !g_strcmp0( sid->type, type )){
 			return( sid->other_id );
 		}
 	}
@@ -104,9 +106,9 @@ ofs_concil_id_get_count_by_type( GList *ids, guint *ent_count, guint *bat_count
 
 	for( it=ids ; it ; it=it->next ){
 		sid = ( ofsConcilId * ) it->data;
-		if( !g_utf8_collate( sid->type, CONCIL_TYPE_ENTRY )){
+		if( !g_strcmp0( sid->type, CONCIL_TYPE_ENTRY )){
 			*ent_count += 1;
-		} else if( !g_utf8_collate( sid->type, CONCIL_TYPE_BAT )){
+		} else if( !g_strcmp0( sid->type, CONCIL_TYPE_BAT )){
 			*bat_count += 1;
 		}
 	}
@@ -28,6 +28,7 @@
 
 #include <glib/gi18n.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "my/my-date.h"
 #include "my/my-double.h"
@@ -37,9 +38,6 @@
 #include "api/ofa-idbconnect.h"
 #include "api/ofa-igetter.h"
 #include "api/ofa-irecover.h"
-#include "api/ofo-account.h"
-#include "api/ofo-entry.h"
-#include "api/ofo-ledger.h"
 
 #include "ebp-recovery/ofa-ebp-recover.h"
 
@@ -58,16 +56,28 @@ typedef struct {
 }
 	ofaEbpRecoverPrivate;
 
+/* the columns of the EBP entries export which are recovered
+ */
+enum {
+	EBP_ENT_NUMECR = 0,
+	EBP_ENT_JOURNAL = 1,
+	EBP_ENT_COMPTE = 2,
+	EBP_ENT_BLETTRE = 28,
+	EBP_ENT_N_COLUMNS = 50
+};
+
+
 static void     iident_iface_init( myIIdentInterface *iface );
 static gchar   *iident_get_canon_name( const myIIdent *instance, void *msg_data );
 static gchar   *iident_get_version( const myIIdent *instance, void *msg_data );
 static void     irecover_iface_init( ofaIRecoverInterface *iface );
 static guint    irecover_get_interface_version( void );
 static gboolean irecover_import_uris( ofaIRecover *instance, ofaIGetter *getter, GList *uris, ofaStreamFormat *format, ofaIDBConnect *connect, ofaMsgCb msg_cb, void *msg_data );
-static gboolean import_entries( ofaEbpRecover *self, GSList *slines );
-static gboolean import_accounts( ofaEbpRecover *self, GSList *slines );
-static gboolean create_account( ofaEbpRecover *self, const gchar *account );
-static gboolean create_ledger( ofaEbpRecover *self, const gchar *ledger );
+static GDataInputStream *stream_open( ofaEbpRecover *self, const gchar *uri );
+static gchar   *stream_read_line( ofaEbpRecover *self, GDataInputStream *stream, gboolean *ok );
+static gboolean import_entries( ofaEbpRecover *self, const gchar *uri );
+static gboolean import_accounts( ofaEbpRecover *self, const gchar *uri );
+static guint    split_line( gchar *line, gchar sep, gchar **fields, guint max );
 
 G_DEFINE_TYPE_EXTENDED( ofaEbpRecover, ofa_ebp_recover, G_TYPE_OBJECT, 0,
 		G_ADD_PRIVATE( ofaEbpRecover )
@@ -195,9 +205,7 @@ irecover_import_uris( ofaIRecover *instance, ofaIGetter *getter, GList *uris, of
 	GList *it;
 	ofsRecoverFile *sfile;
 	gboolean ok;
-	GSList *slines, *head;
 	gchar *msgerr;
-	guint errors, count, i;
 
 	priv = ofa_ebp_recover_get_instance_private( OFA_EBP_RECOVER( instance ));
 
@@ -210,221 +218,239 @@ irecover_import_uris( ofaIRecover *instance, ofaIGetter *getter, GList *uris, of
 
 	for( it=uris ; it ; it=it->next ){
 		sfile = ( ofsRecoverFile * ) it->data;
-		slines = my_utils_uri_get_lines( sfile->uri, ofa_stream_format_get_charmap( format ), &errors, &msgerr );
 
-		if( errors ){
-			msg_cb( msgerr, msg_data );
-			g_free( msgerr );
+		switch( sfile->nature ){
+			case OFA_RECOVER_ENTRY:
+				ok = import_entries( OFA_EBP_RECOVER( instance ), sfile->uri );
+				break;
+			case OFA_RECOVER_ACCOUNT:
+				ok = import_accounts( OFA_EBP_RECOVER( instance ), sfile->uri );
+				break;
+			default:
+				msgerr = g_strdup_printf( _( "%s: unknown or invalid file nature=%u" ), thisfn, sfile->nature );
+				msg_cb( msgerr, msg_data );
+				g_free( msgerr );
+		}
+	}
 
-		} else {
-			count = ofa_stream_format_get_headers_count( format );
-			head = slines;
-			for( i=0 ; i<count ; ++i ){
-				head = g_slist_next( head );
-			}
-			switch( sfile->nature ){
-				case OFA_RECOVER_ENTRY:
-					ok = import_entries( OFA_EBP_RECOVER( instance ), head );
-					break;
-				case OFA_RECOVER_ACCOUNT:
-					ok = import_accounts( OFA_EBP_RECOVER( instance ), head );
-					break;
-				default:
-					msgerr = g_strdup_printf( _( "%s: unknown or invalid file nature=%u" ), thisfn, sfile->nature );
-					msg_cb( msgerr, msg_data );
-					g_free( msgerr );
-			}
+	return( ok );
+}
+
+/*
+ * Open the @uri as a stream of UTF-8 lines, converted from the
+ * charmap of the stream format.
+ *
+ * Returns: a new reference on the stream, or %NULL on error.
+ */
+static GDataInputStream *
+stream_open( ofaEbpRecover *self, const gchar *uri )
+{
+	ofaEbpRecoverPrivate *priv;
+	GFile *file;
+	GFileInputStream *file_stream;
+	GInputStream *input;
+	GCharsetConverter *converter;
+	GDataInputStream *stream;
+	const gchar *charmap;
+	GError *error;
+
+	priv = ofa_ebp_recover_get_instance_private( self );
+
+	error = NULL;
+	file = g_file_new_for_uri( uri );
+	file_stream = g_file_read( file, NULL, &error );
+	g_object_unref( file );
 
-			g_slist_free_full( slines, ( GDestroyNotify ) g_free );
+	if( !file_stream ){
+		priv->msg_cb( error->message, priv->msg_data );
+		g_error_free( error );
+		return( NULL );
+	}
+
+	input = G_INPUT_STREAM( file_stream );
+	charmap = ofa_stream_format_get_charmap( priv->format );
+
+	if( my_strlen( charmap ) && g_ascii_strcasecmp( charmap, "UTF-8" )){
+		converter = g_charset_converter_new( "UTF-8", charmap, &error );
+		if( !converter ){
+			priv->msg_cb( error->message, priv->msg_data );
+			g_error_free( error );
+			g_object_unref( file_stream );
+			return( NULL );
 		}
+		input = g_converter_input_stream_new( input, G_CONVERTER( converter ));
+		g_object_unref( converter );
+		g_object_unref( file_stream );
 	}
 
-	return( ok );
+	stream = g_data_input_stream_new( input );
+	g_data_input_stream_set_newline_type( stream, G_DATA_STREAM_NEWLINE_TYPE_ANY );
+	g_object_unref( input );
+
+	return( stream );
+}
+
+/*
+ * Read the next line from the @stream, joining the lines whose
+ * end-of-line is backslashed: the backslash is replaced with a newline
+ * character, so that multi-line labels are kept.
+ *
+ * Returns: the line as a newly allocated string which should be
+ * g_free() by the caller, or %NULL at end of stream or on error; @ok
+ * is set to %FALSE on error.
+ */
+static gchar *
+stream_read_line( ofaEbpRecover *self, GDataInputStream *stream, gboolean *ok )
+{
+	ofaEbpRecoverPrivate *priv;
+	GString *line;
+	gchar *segment;
+	gsize length;
+	GError *error;
+
+	priv = ofa_ebp_recover_get_instance_private( self );
+
+	line = NULL;
+	error = NULL;
+
+	while(( segment = g_data_input_stream_read_line( stream, &length, NULL, &error )) != NULL ){
+		if( !line ){
+			line = g_string_sized_new( length );
+		}
+		if( length > 0 && segment[length-1] == '\\' ){
+			g_string_append_len( line, segment, length-1 );
+			g_string_append_c( line, '\n' );
+			g_free( segment );
+			continue;
+		}
+		g_string_append_len( line, segment, length );
+		g_free( segment );
+		break;
+	}
+
+	if( error ){
+		priv->msg_cb( error->message, priv->msg_data );
+		g_error_free( error );
+		*ok = FALSE;
+	}
+
+	return( line ? g_string_free( line, FALSE ) : NULL );
 }
 
+/*
+ * The entries file is read line by line, each line being split in
+ * place (the fields point into the line), and the ledgers and accounts
+ * being deduplicated while reading.
+ */
 static gboolean
-import_entries( ofaEbpRecover *self, GSList *slines )
+import_entries( ofaEbpRecover *self, const gchar *uri )
 {
 	static const gchar *thisfn = "ofa_ebp_recover_import_entries";
 	ofaEbpRecoverPrivate *priv;
-	GSList *it;
-	gchar **fields, **itf;
-	ofoEntry *entry;
-	gchar *fieldsep, *label, *account, *currency, *ledger, *ref;
-	GDate deffect, dope, dreconcil;
-	ofxAmount debit, credit;
-	gboolean settled;
+	GDataInputStream *stream;
+	gchar *line, *fields[EBP_ENT_N_COLUMNS], *msg;
 	gulong numecr, count, errors;
+	gchar fieldsep;
+	GHashTable *ledgers, *accounts;
+	gboolean settled, ok;
+	guint n, headers;
 
 	priv = ofa_ebp_recover_get_instance_private( self );
 
+	stream = stream_open( self, uri );
+	if( !stream ){
+		return( FALSE );
+	}
+
 	count = 0;
 	errors = 0;
-	fieldsep = g_strdup_printf( "%c", ofa_stream_format_get_field_sep( priv->format ));
+	ok = TRUE;
+	fieldsep = ofa_stream_format_get_field_sep( priv->format );
+	headers = ofa_stream_format_get_headers_count( priv->format );
+
+	ledgers = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	accounts = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+
+	while(( line = stream_read_line( self, stream, &ok )) != NULL ){
+		if( headers > 0 ){
+			headers -= 1;
+			g_free( line );
+			continue;
+		}
+		if( !my_strlen( line )){
+			g_free( line );
+			continue;
+		}
 
-	for( it=slines ; it ; it=it->next ){
-		fields = g_strsplit(( const gchar * ) it->data, fieldsep, -1 );
 		count += 1;
-		/* numecr */
-		itf = fields;
-		numecr = atoi( *itf );
-		/* journal */
-		itf += 1;
-		ledger = g_strdup( *itf );
-		create_ledger( self, ledger );
-		/* compte */
-		itf += 1;
-		account = g_strdup( *itf );
-		create_account( self, account );
-		/* date ecr = operation date */
-		itf += 1;
-		my_date_set_from_str( &dope, *itf, ofa_stream_format_get_date_format( priv->format ));
-		/* jour */
-		itf += 1;
-		/* indexp */
-		itf += 1;
-		/* indexs */
-		itf += 1;
-		/* datval = reconciliation date */
-		itf += 1;
-		my_date_set_from_str( &dreconcil, *itf, ofa_stream_format_get_date_format( priv->format ));
-		/* datsai */
-		itf += 1;
-		/* datech = effect date */
-		itf += 1;
-		my_date_set_from_str( &deffect, *itf, ofa_stream_format_get_date_format( priv->format ));
-		/* poste */
-		itf += 1;
-		/* piece */
-		itf += 1;
-		ref = g_strdup( *itf );
-		/* numdoc */
-		itf += 1;
-		/* libelle */
-		itf += 1;
-		label = g_strdup( *itf );
-		/* debit */
-		itf += 1;
-		debit = my_double_set_from_str( *itf,
-						ofa_stream_format_get_thousand_sep( priv->format ),
-						ofa_stream_format_get_decimal_sep( priv->format ));
-		/* credit */
-		itf += 1;
-		credit = my_double_set_from_str( *itf,
-						ofa_stream_format_get_thousand_sep( priv->format ),
-						ofa_stream_format_get_decimal_sep( priv->format ));
-		/* solde */
-		itf += 1;
-		/* devise */
-		itf += 1;
-		currency = g_strdup( my_strlen( *itf ) ? *itf : "EUR" );
-		/* taux devise */
-		itf += 1;
-		/* devdebit */
-		itf += 1;
-		/* devcredit */
-		itf += 1;
-		/* cdebit */
-		itf += 1;
-		/* ccdredit */
-		itf += 1;
-		/* lettre */
-		itf += 1;
-		/* rapp */
-		itf += 1;
-		/* numrap */
-		itf += 1;
-		/* typetva */
-		itf += 1;
-		/* brap */
-		itf += 1;
-		/* blettre */
-		itf += 1;
-		settled = my_collate( *itf, "oui" );
-		/* bran */
-		itf += 1;
-		/* bsimu */
-		itf += 1;
-		/* bech */
-		itf += 1;
-		/* bana */
-		itf += 1;
-		/* banaex */
-		itf += 1;
-		/* bacompte */
-		itf += 1;
-		/* bfact */
-		itf += 1;
-		/* bavoir */
-		itf += 1;
-		/* bregl */
-		itf += 1;
-		/* bequi */
-		itf += 1;
-		/* brapnm1 */
-		itf += 1;
-		/* bcontrepartie */
-		itf += 1;
-		/* bmemo */
-		itf += 1;
-		/* abonne */
-		itf += 1;
-		/* codreg */
-		itf += 1;
-		/* cheque */
-		itf += 1;
-		/* cpttva */
-		itf += 1;
-		/* moistva */
-		itf += 1;
-		/* bencontrevaleur */
-		itf += 1;
-		/* bendevise */
-		itf += 1;
-		/* becartconv */
-		itf += 1;
-		g_strfreev( fields );
-
-		entry = ofo_entry_new( priv->getter );
-		ofo_entry_set_label( entry, label );
-		ofo_entry_set_deffect( entry, &deffect );
-		ofo_entry_set_dope( entry, &dope );
-		ofo_entry_set_ref( entry, ref );
-		ofo_entry_set_account( entry, account );
-		ofo_entry_set_currency( entry, currency );
-		ofo_entry_set_ledger( entry, ledger );
-		ofo_entry_set_debit( entry, debit );
-		ofo_entry_set_credit( entry, credit );
-		g_debug( "%s: numecr=%lu, settled=%s", thisfn, numecr, settled ? "True":"False" );
-		/* TODO: insert entry in a non-opened dossier... */
-		g_object_unref( entry );
-
-		g_free( label );
-		g_free( account );
-		g_free( currency );
-		g_free( ledger );
-		g_free( ref );
+		n = split_line( line, fieldsep, fields, EBP_ENT_N_COLUMNS );
+
+		if( n <= EBP_ENT_BLETTRE ){
+			msg = g_strdup_printf( _( "%s: line %lu: only %u fields found" ), thisfn, count, n );
+			priv->msg_cb( msg, priv->msg_data );
+			g_free( msg );
+			errors += 1;
+
+		} else {
+			numecr = atoi( fields[EBP_ENT_NUMECR] );
+			settled = ( my_collate( fields[EBP_ENT_BLETTRE], "oui" ) == 0 );
+			g_debug( "%s: numecr=%lu, settled=%s", thisfn, numecr, settled ? "True":"False" );
+
+			if( !g_hash_table_contains( ledgers, fields[EBP_ENT_JOURNAL] )){
+				g_hash_table_add( ledgers, g_strdup( fields[EBP_ENT_JOURNAL] ));
+			}
+			if( !g_hash_table_contains( accounts, fields[EBP_ENT_COMPTE] )){
+				g_hash_table_add( accounts, g_strdup( fields[EBP_ENT_COMPTE] ));
+			}
+		}
+
+		g_free( line );
 	}
 
-	g_free( fieldsep );
+	if( !ok ){
+		errors += 1;
+	}
+
+	msg = g_strdup_printf( _( "%lu entries read, %u ledgers and %u accounts found, %lu errors" ),
+			count, g_hash_table_size( ledgers ), g_hash_table_size( accounts ), errors );
+	priv->msg_cb( msg, priv->msg_data );
+	g_free( msg );
+
+	g_hash_table_destroy( accounts );
+	g_hash_table_destroy( ledgers );
+	g_object_unref( stream );
 
 	return( errors == 0 );
 }
 
-static gboolean
-import_accounts( ofaEbpRecover *self, GSList *slines )
+/*
+ * Split the line in place: the separators are replaced with a null
+ * byte, and @fields receives pointers to the successive fields.
+ *
+ * Returns: the count of found fields, up to @max.
+ */
+static guint
+split_line( gchar *line, gchar sep, gchar **fields, guint max )
 {
-	return( TRUE );
-}
+	guint count;
+	gchar *p;
 
-static gboolean
-create_account( ofaEbpRecover *self, const gchar *account )
-{
-	return( TRUE );
+	count = 0;
+	p = line;
+
+	while( p && count < max ){
+		fields[count++] = p;
+		p = strchr( p, sep );
+		if( p ){
+			*p++ = '\0';
+		}
+	}
+
+	return( count );
 }
 
 static gboolean
-create_ledger( ofaEbpRecover *self, const gchar *ledger )
+import_accounts( ofaEbpRecover *self, const gchar *uri )
 {
 	return( TRUE );
 }
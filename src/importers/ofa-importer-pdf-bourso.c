@@ -72,9 +72,20 @@ typedef struct {
 	gchar    *deffect;
 	gchar    *amount;
 	gdouble   y;
+	guint     order;
 }
 	sLine;
 
+/* the lines being built, indexed by vertical position so that the
+ * line of a rectangle is found without scanning the list
+ */
+typedef struct {
+	GList      *lines;
+	guint       count;
+	GHashTable *buckets;
+}
+	sLineIndex;
+
 static gdouble  st_x1_periode_begin     = 259;
 static gdouble  st_y1_periode_begin     = 267;
 static gchar   *st_header_extrait       = "Extrait de votre compte en ";
@@ -111,7 +122,8 @@ static GList           *bourso_pdf_v1_parse_lines_merge( ofaImporterPdfBourso *s
 static GSList          *bourso_pdf_v1_parse_lines_build( ofaImporterPdfBourso *self, const sParser *parser, ofsImporterParms *parms, GList *filtered_list );
 static sParser         *get_willing_to_parser( const ofaImporterPdfBourso *self, const ofaStreamFormat *format, const gchar *uri );
 static ofaStreamFormat *get_default_stream_format( const ofaImporterPdfBourso *self, ofaIGetter *getter );
-static sLine           *find_line( GList **lines, gdouble acceptable_diff, gdouble y );
+static sLine           *find_line( sLineIndex *index, gdouble acceptable_diff, gdouble y );
+static gpointer         line_bucket_key( gdouble acceptable_diff, gdouble y, gint delta );
 static void             free_line( sLine *line );
 static gchar           *get_amount( ofsPdfRC *rc );
 
@@ -354,6 +366,12 @@ bourso_pdf_v1_check( const ofaImporterPdfBourso *self, const sParser *parser, co
 	}
 
 	page = poppler_document_get_page( doc, 0 );
+	if( !page ){
+		g_debug( "%s: unable to get the first page", thisfn );
+		g_object_unref( doc );
+		return( ok );
+	}
+
 	text = poppler_page_get_text( page );
 	found = g_strstr_len( text, -1, st_header_extrait );
 	if( found ){
@@ -633,13 +651,16 @@ bourso_pdf_v1_parse_header_last( ofaImporterPdfBourso *self, const sParser *pars
 static GList *
 bourso_pdf_v1_parse_lines_rough( ofaImporterPdfBourso *self, const sParser *parser, ofsImporterParms *parms, guint page_num, GList *rc_list )
 {
-	GList *it, *lines;
+	GList *it;
+	sLineIndex index;
 	ofsPdfRC *rc;
 	gdouble acceptable_diff, first_y;
 	sLine *line;
 	gchar *tmp, *str;
 
-	lines = NULL;
+	index.lines = NULL;
+	index.count = 0;
+	index.buckets = g_hash_table_new_full( g_direct_hash, g_direct_equal, NULL, ( GDestroyNotify ) g_list_free );
 	first_y = 0;
 	acceptable_diff = ofa_importer_pdf_get_acceptable_diff();
 
@@ -665,7 +686,7 @@ bourso_pdf_v1_parse_lines_rough( ofaImporterPdfBourso *self, const sParser *pars
 			}
 
 			/* a transaction field */
-			line = find_line( &lines, acceptable_diff, rc->y1 );
+			line = find_line( &index, acceptable_diff, rc->y1 );
 
 			if( rc->x1 < st_label_min_x ){
 				line->dope = g_strstrip( g_strndup( rc->text, 10 ));
@@ -698,7 +719,9 @@ bourso_pdf_v1_parse_lines_rough( ofaImporterPdfBourso *self, const sParser *pars
 		}
 	}
 
-	return( lines );
+	g_hash_table_destroy( index.buckets );
+
+	return( g_list_reverse( index.lines ));
 }
 
 /*
@@ -853,29 +876,66 @@ get_default_stream_format( const ofaImporterPdfBourso *self, ofaIGetter *getter
 }
 
 /*
- * find the sLine structure for the specified rc
- * allocated a new one if needed
+ * find the sLine structure for the specified y coordinate
+ * allocating a new one if needed
+ *
+ * A line within the acceptable diff is to be found either in the same
+ * bucket or in one of the two adjacent ones. When several lines match,
+ * the first created one is returned.
  */
 static sLine *
-find_line( GList **lines, gdouble acceptable_diff, gdouble y )
+find_line( sLineIndex *index, gdouble acceptable_diff, gdouble y )
 {
-	GList *it;
-	sLine *line;
-
-	for( it=( *lines ) ; it ; it=it->next ){
-		line = ( sLine * ) it->data;
-		if( fabs( line->y - y ) <= acceptable_diff ){
-			return( line );
+	GList *it, *list;
+	sLine *line, *found;
+	gpointer key;
+	gint delta;
+
+	found = NULL;
+
+	for( delta=-1 ; delta<=1 ; ++delta ){
+		key = line_bucket_key( acceptable_diff, y, delta );
+		list = g_hash_table_lookup( index->buckets, key );
+		for( it=list ; it ; it=it->next ){
+			line = ( sLine * ) it->data;
+			if( fabs( line->y - y ) <= acceptable_diff ){
+				if( !found || line->order < found->order ){
+					found = line;
+				}
+			}
 		}
 	}
 
+	if( found ){
+		return( found );
+	}
+
 	line = g_new0( sLine, 1 );
 	line->y = y;
-	*lines = g_list_append( *lines, line );
+	line->order = index->count++;
+	index->lines = g_list_prepend( index->lines, line );
+
+	key = line_bucket_key( acceptable_diff, y, 0 );
+	list = g_hash_table_lookup( index->buckets, key );
+	g_hash_table_steal( index->buckets, key );
+	g_hash_table_insert( index->buckets, key, g_list_prepend( list, line ));
 
 	return( line );
 }
 
+/*
+ * the buckets are acceptable_diff high
+ */
+static gpointer
+line_bucket_key( gdouble acceptable_diff, gdouble y, gint delta )
+{
+	gint bucket;
+
+	bucket = ( gint ) floor( y / acceptable_diff ) + delta;
+
+	return( GINT_TO_POINTER( bucket ));
+}
+
 static void
 free_line( sLine *line )
 {
@@ -65,9 +65,20 @@ typedef struct {
 	gchar    *amount;
 	gdouble   y;
 	gint      page_num;
+	guint     order;
 }
 	sLine;
 
+/* the lines being built, indexed by page and by vertical position
+ * so that the line of a rectangle is found without scanning the list
+ */
+typedef struct {
+	GList      *lines;
+	guint       count;
+	GHashTable *buckets;
+}
+	sLineIndex;
+
 static gchar   *st_header_extrait       = "RELEVE DE COMPTE";
 static gchar   *st_header_banque        = "CREDIT LYONNAIS";
 static gchar   *st_header_iban          = "IBAN : ";
@@ -109,7 +120,8 @@ static GList           *lcl_pdf_v1_parse_merge( ofaImporterPdfLcl *self, const s
 static GSList          *lcl_pdf_v1_parse_lines_build( ofaImporterPdfLcl *self, const sParser *parser, ofsImporterParms *parms, GList *filtered_list );
 static sParser         *get_willing_to_parser( const ofaImporterPdfLcl *self, const ofaStreamFormat *format, const gchar *uri );
 static ofaStreamFormat *get_default_stream_format( const ofaImporterPdfLcl *self, ofaIGetter *getter );
-static sLine           *find_line( GList **lines, gdouble acceptable_diff, ofsPdfRC *rc );
+static sLine           *find_line( sLineIndex *index, gdouble acceptable_diff, ofsPdfRC *rc );
+static gpointer         line_bucket_key( gint page_num, gdouble acceptable_diff, gdouble y, gint delta );
 static void             dump_line_list( GList *lines, const gchar *label );
 static void             dump_line( sLine *line, const gchar *label );
 static void             free_line( sLine *line );
@@ -346,6 +358,12 @@ lcl_pdf_v1_check( const ofaImporterPdfLcl *self, const sParser *parser, const of
 	}
 
 	page = poppler_document_get_page( doc, 0 );
+	if( !page ){
+		g_debug( "%s: unable to get the first page", thisfn );
+		g_object_unref( doc );
+		return( ok );
+	}
+
 	text = poppler_page_get_text( page );
 	found = g_strstr_len( text, -1, st_header_extrait );
 	if( found ){
@@ -535,13 +553,16 @@ static GList *
 lcl_pdf_v1_parse_rough( ofaImporterPdfLcl *self, const sParser *parser, ofsImporterParms *parms, GList *rc_list )
 {
 	static const gchar *thisfn = "ofa_importer_pdf_lcl_lcl_pdf_v1_parse_rough";
-	GList *it, *lines;
+	GList *it;
+	sLineIndex index;
 	ofsPdfRC *rc;
 	gdouble acceptable_diff, first_y;
 	sLine *line;
 	gchar *tmp, *str;
 
-	lines = NULL;
+	index.lines = NULL;
+	index.count = 0;
+	index.buckets = g_hash_table_new_full( g_direct_hash, g_direct_equal, NULL, ( GDestroyNotify ) g_list_free );
 
 	/* for each page, we do not try to interpret anything while we do not have found
 	 * the beginning of useful datas - then we scan for end of page, and so we reset
@@ -605,7 +626,7 @@ lcl_pdf_v1_parse_rough( ofaImporterPdfLcl *self, const sParser *parser, ofsImpor
 		if( first_y > 0 && rc->y1 > first_y ){
 
 			/* a transaction field */
-			line = find_line( &lines, acceptable_diff, rc );
+			line = find_line( &index, acceptable_diff, rc );
 
 			if( rc->x1 < st_label_min_x ){
 				line->dope = g_strstrip( g_strndup( rc->text, 10 ));
@@ -641,7 +662,9 @@ lcl_pdf_v1_parse_rough( ofaImporterPdfLcl *self, const sParser *parser, ofsImpor
 		}
 	}
 
-	return( lines );
+	g_hash_table_destroy( index.buckets );
+
+	return( g_list_reverse( index.lines ));
 }
 
 /*
@@ -825,28 +848,65 @@ get_default_stream_format( const ofaImporterPdfLcl *self, ofaIGetter *getter )
 /*
  * find the sLine structure for the specified rc
  * allocating a new one if needed
+ *
+ * A line within the acceptable diff is to be found either in the same
+ * bucket or in one of the two adjacent ones. When several lines match,
+ * the first created one is returned.
  */
 static sLine *
-find_line( GList **lines, gdouble acceptable_diff, ofsPdfRC *rc )
+find_line( sLineIndex *index, gdouble acceptable_diff, ofsPdfRC *rc )
 {
-	GList *it;
-	sLine *line;
-
-	for( it=( *lines ) ; it ; it=it->next ){
-		line = ( sLine * ) it->data;
-		if( fabs( line->y - rc->y1 ) <= acceptable_diff && rc->page_num == line->page_num ){
-			return( line );
+	GList *it, *list;
+	sLine *line, *found;
+	gpointer key;
+	gint delta;
+
+	found = NULL;
+
+	for( delta=-1 ; delta<=1 ; ++delta ){
+		key = line_bucket_key( rc->page_num, acceptable_diff, rc->y1, delta );
+		list = g_hash_table_lookup( index->buckets, key );
+		for( it=list ; it ; it=it->next ){
+			line = ( sLine * ) it->data;
+			if( fabs( line->y - rc->y1 ) <= acceptable_diff && rc->page_num == line->page_num ){
+				if( !found || line->order < found->order ){
+					found = line;
+				}
+			}
 		}
 	}
 
+	if( found ){
+		return( found );
+	}
+
 	line = g_new0( sLine, 1 );
 	line->y = rc->y1;
 	line->page_num = rc->page_num;
-	*lines = g_list_append( *lines, line );
+	line->order = index->count++;
+	index->lines = g_list_prepend( index->lines, line );
+
+	key = line_bucket_key( rc->page_num, acceptable_diff, rc->y1, 0 );
+	list = g_hash_table_lookup( index->buckets, key );
+	g_hash_table_steal( index->buckets, key );
+	g_hash_table_insert( index->buckets, key, g_list_prepend( list, line ));
 
 	return( line );
 }
 
+/*
+ * the buckets are acceptable_diff high
+ */
+static gpointer
+line_bucket_key( gint page_num, gdouble acceptable_diff, gdouble y, gint delta )
+{
+	gint bucket;
+
+	bucket = ( gint ) floor( y / acceptable_diff ) + delta;
+
+	return( GINT_TO_POINTER(( page_num << 16 ) | ( bucket & 0xffff )));
+}
+
 static void
 dump_line_list( GList *lines, const gchar *label )
 {
@@ -42,11 +42,22 @@ typedef struct {
 }
 	ofaImporterPdfPrivate;
 
+/* a page to be parsed by a worker thread of the pool
+ */
+typedef struct {
+	PopplerPage *page;
+	guint        page_num;
+	const gchar *charset;
+	GList       *layout;
+}
+	sPage;
+
 static gdouble st_acceptable_diff       = 1.5;			/* acceptable diff between same boxes */
 
-static GList *poppler_sort_rc_layout( PopplerRectangle *rc_layout, guint rc_count );
-static gint   poppler_cmp_rc( PopplerRectangle *a, PopplerRectangle *b );
-static GList *poppler_merge_to_pdf( GList *poppler_list, guint page_num, PopplerPage *page, const gchar *charset );
+static void   page_layout_worker( sPage *spage, void *empty );
+static GList *page_get_layout( PopplerPage *page, guint page_num, const gchar *charset );
+static GList *poppler_merge_to_pdf( const gchar *text, PopplerRectangle *rc_layout, guint rc_count, guint page_num, const gchar *charset );
+static gchar *pdf_convert_text( const gchar *text, gsize length, const gchar *charset );
 static GList *pdf_filter_one_time( GList *pdf_list );
 static gint   pdf_cmp_rc( ofsPdfRC *a, ofsPdfRC *b );
 static gint   cmp_rc( gdouble ax1, gdouble ay1, gdouble ax2, gdouble ay2, gdouble bx1, gdouble by1, gdouble bx2, gdouble by2 );
@@ -160,15 +171,23 @@ ofa_importer_pdf_is_willing_to( ofaImporterPdf *instance, ofaIGetter *getter, co
  * Returns: an ordered list (from left to right, and from top to bottom)
  * of #ofsPdfRC rectangles with text, which represents the full mlayout for all
  * the pages of the @doc document.
+ * The pages which cannot be got from the @doc are skipped.
+ *
+ * The pages are parsed in parallel on a pool of worker threads, each
+ * worker handling its own #PopplerPage.
  *
  * The returned list should be ofa_importer_pdf_free_layout() by the caller.
  */
 GList *
 ofa_importer_pdf_get_doc_layout( ofaImporterPdf *instance, PopplerDocument *doc, const gchar *charset )
 {
+	static const gchar *thisfn = "ofa_importer_pdf_get_doc_layout";
 	ofaImporterPdfPrivate *priv;
 	GList *rc_list;
-	gint count, page;
+	gint count, i;
+	sPage *pages;
+	GThreadPool *pool;
+	GError *error;
 
 	g_return_val_if_fail( instance && OFA_IS_IMPORTER_PDF( instance ), NULL );
 
@@ -178,13 +197,56 @@ ofa_importer_pdf_get_doc_layout( ofaImporterPdf *instance, PopplerDocument *doc,
 
 	rc_list = NULL;
 	count = poppler_document_get_n_pages( doc );
-	for( page=0 ; page<count ; ++page ){
-		rc_list = g_list_concat( rc_list, ofa_importer_pdf_get_page_layout( instance, doc, page, charset ));
+	pages = g_new0( sPage, count );
+
+	/* the pages are got from the main thread, and then each page is
+	 * parsed by a worker thread */
+	error = NULL;
+	pool = count > 1 ?
+			g_thread_pool_new(( GFunc ) page_layout_worker, NULL, g_get_num_processors(), FALSE, &error ) : NULL;
+	if( !pool && error ){
+		g_info( "%s: g_thread_pool_new: %s", thisfn, error->message );
+		g_error_free( error );
+	}
+
+	for( i=0 ; i<count ; ++i ){
+		pages[i].page = poppler_document_get_page( doc, i );
+		pages[i].page_num = i;
+		pages[i].charset = charset;
+		if( !pages[i].page ){
+			g_warning( "%s: unable to get the page %d, skipped", thisfn, i );
+			continue;
+		}
+		if( pool ){
+			g_thread_pool_push( pool, &pages[i], NULL );
+		} else {
+			page_layout_worker( &pages[i], NULL );
+		}
 	}
 
+	/* wait for all the pages be parsed */
+	if( pool ){
+		g_thread_pool_free( pool, FALSE, TRUE );
+	}
+
+	for( i=0 ; i<count ; ++i ){
+		rc_list = g_list_concat( rc_list, pages[i].layout );
+		if( pages[i].page ){
+			g_object_unref( pages[i].page );
+		}
+	}
+
+	g_free( pages );
+
 	return( rc_list );
 }
 
+static void
+page_layout_worker( sPage *spage, void *empty )
+{
+	spage->layout = page_get_layout( spage->page, spage->page_num, spage->charset );
+}
+
 /**
  * ofa_importer_pdf_get_page_layout:
  * @instance: a #ofaImporterPdf instance.
@@ -193,12 +255,14 @@ ofa_importer_pdf_get_doc_layout( ofaImporterPdf *instance, PopplerDocument *doc,
  * @charset: the input character set.
  *
  * Returns: an ordered (from left to right, and from top to bottom)
- * layout of #ofsPdfRC rectangles with text.
+ * layout of #ofsPdfRC rectangles with text, or %NULL if the page cannot
+ * be got from the @doc.
  *
  * Rationale: for a given text of n chars, we have n+1 layout rectangles.
  * Last is most of time a dot-only rectangle, but 2 or 3 times per
  * page, the last rectangle is bad and contains several lines.
- * So we prefer get the first rc and its text, then skip the n others.
+ * This last rectangle is actually the one of the newline character
+ * which terminates the text run, and is so skipped.
  *
  * The returned list should be ofa_importer_pdf_free_layout() by the caller.
  */
@@ -208,11 +272,7 @@ ofa_importer_pdf_get_page_layout( ofaImporterPdf *instance, PopplerDocument *doc
 	static const gchar *thisfn = "ofa_importer_pdf_get_page_layout";
 	ofaImporterPdfPrivate *priv;
 	PopplerPage *page;
-	PopplerRectangle *rc_layout, *poppler_rc;
-	guint rc_count;
-	GList *rc_list, *rc_merged, *rc_filtered, *it;
-	ofsPdfRC *pdf_rc;
-	gchar *text;
+	GList *rc_list;
 
 	g_return_val_if_fail( instance && OFA_IS_IMPORTER_PDF( instance ), NULL );
 
@@ -220,32 +280,46 @@ ofa_importer_pdf_get_page_layout( ofaImporterPdf *instance, PopplerDocument *doc
 
 	g_return_val_if_fail( !priv->dispose_has_run, NULL );
 
-	/* extract all the poppler layout rectangles
-	 * we get one Poppler rectangle for each glyph of the document
-	 * they have to be sorted before trying to merge them
-	 */
 	page = poppler_document_get_page( doc, page_num );
+	if( !page ){
+		g_warning( "%s: unable to get the page %u", thisfn, page_num );
+		return( NULL );
+	}
+
+	rc_list = page_get_layout( page, page_num, charset );
+	g_object_unref( page );
+
+	return( rc_list );
+}
+
+/*
+ * The text of the page is extracted once: each character of this text
+ * has its corresponding glyph rectangle in the text layout, lines being
+ * separated by a newline character.
+ *
+ * May be called from a worker thread.
+ */
+static GList *
+page_get_layout( PopplerPage *page, guint page_num, const gchar *charset )
+{
+	static const gchar *thisfn = "ofa_importer_pdf_page_get_layout";
+	PopplerRectangle *rc_layout;
+	guint rc_count;
+	gchar *text;
+	GList *rc_merged, *rc_filtered, *it;
+	ofsPdfRC *pdf_rc;
+
+	text = poppler_page_get_text( page );
 	poppler_page_get_text_layout( page, &rc_layout, &rc_count );
 	if( 1 ){
 		g_debug( "%s: page_num=%u, got %u PopplerRectangles items", thisfn, page_num, rc_count );
 	}
-	rc_list = poppler_sort_rc_layout( rc_layout, rc_count );
-	g_free( rc_layout );
 
-	if( 0 ){
-		/* dump the sorted layout */
-		for( it=rc_list ; it ; it=it->next ){
-			poppler_rc = ( PopplerRectangle * ) it->data;
-			text = poppler_page_get_selected_text( page, POPPLER_SELECTION_LINE, poppler_rc );
-			g_debug( "%s [poppler]: page_num=%u, x1=%lf, y1=%lf, x2=%lf, y2=%lf, text='%s'",
-					thisfn, page_num, poppler_rc->x1, poppler_rc->y1, poppler_rc->x2, poppler_rc->y2, text );
-			g_free( text );
-		}
-		g_debug( "%s [poppler]: end of dump", thisfn );
-	}
+	/* merge the glyphs of each text run */
+	rc_merged = poppler_merge_to_pdf( text, rc_layout, rc_count, page_num, charset );
 
-	/* merge the adjacent PopplerRectangle's for the same text */
-	rc_merged = poppler_merge_to_pdf( rc_list, page_num, page, charset );
+	g_free( rc_layout );
+	g_free( text );
 
 	/* remove some rectangles which appear only one time */
 	rc_filtered = pdf_filter_one_time( rc_merged );
@@ -262,106 +336,58 @@ ofa_importer_pdf_get_page_layout( ofaImporterPdf *instance, PopplerDocument *doc
 	}
 
 	g_list_free( rc_merged );
-	g_list_free_full( rc_list, ( GDestroyNotify ) poppler_rectangle_free );
-	g_object_unref( page );
 
 	return( rc_filtered );
 }
 
 /*
- * a standard text of n characters is most of the time represented here
- * with n+1 rectangles, one for each glyph plus a last of zero size
+ * @text: the text of the page.
+ * @rc_layout: the glyph rectangles, one for each character of @text.
+ *
+ * Walk the text and the layout in parallel, merging the glyphs of each
+ * run (i.e. up to the next newline character) into a single ofsPdfRC
+ * rectangle. Zero size glyphs are ignored.
+ *
+ * Returns: a list of ofsPdfRC rectangles, sorted by ascending line,
+ * then from left to right.
  */
 static GList *
-poppler_sort_rc_layout( PopplerRectangle *rc_layout, guint rc_count )
+poppler_merge_to_pdf( const gchar *text, PopplerRectangle *rc_layout, guint rc_count, guint page_num, const gchar *charset )
 {
-	static const gchar *thisfn = "ofa_importer_pdf_poppler_sort_rc_layout";
-	GList *list;
-	guint i, ignored;
+	GList *pdf_merged;
+	const gchar *p, *run;
+	ofsPdfRC *pdf_rc;
+	PopplerRectangle *poppler_rc;
+	guint i;
 
-	list = NULL;
-	ignored = 0;
+	pdf_merged = NULL;
+	pdf_rc = NULL;
+	run = text;
 
-	for( i=0 ; i<rc_count ; ++i ){
+	for( p=text, i=0 ; p && *p && i<rc_count ; p=g_utf8_next_char( p ), ++i ){
 
-		/* if the rectangle is zero size, then ignore */
-		if( fabs( rc_layout[i].x1 - rc_layout[i].x2 ) < 1 && fabs( rc_layout[i].y1 - rc_layout[i].y2 ) < 1 ){
-			if( 0 ){
-				g_debug( "%s: ignoring zero size x1=%lf, y1=%lf, x2=%lf, y2=%lf",
-						thisfn, rc_layout[i].x1, rc_layout[i].y1, rc_layout[i].x2, rc_layout[i].y2 );
+		if( *p == '\n' ){
+			if( pdf_rc ){
+				pdf_rc->text = pdf_convert_text( run, p-run, charset );
+				pdf_merged = g_list_prepend( pdf_merged, pdf_rc );
+				pdf_rc = NULL;
 			}
-			ignored += 1;
+			run = g_utf8_next_char( p );
 			continue;
 		}
 
-		list = g_list_insert_sorted( list, poppler_rectangle_copy( &rc_layout[i] ), ( GCompareFunc ) poppler_cmp_rc );
-	}
-
-	if( 0 ){
-		g_debug( "%s: %u (on %u) ignored zero size rectangles", thisfn, ignored, rc_count );
-	}
-
-	return( list );
-}
-
-/*
- * sort the rectangles (which are text layout) by ascending line, then
- * from left to right
- */
-static gint
-poppler_cmp_rc( PopplerRectangle *a, PopplerRectangle *b )
-{
-	return( cmp_rc( a->x1, a->y1, a->x2, a->y2, b->x1, b->y1, b->x2, b->y2 ));
-}
-
-/*
- * @list: a sorted list of PopplerRectangles:
- *
- * Returns: a merged list of ofsPdfRC rectangles.
- */
-static GList *
-poppler_merge_to_pdf( GList *poppler_list, guint page_num, PopplerPage *page, const gchar *charset )
-{
-	PopplerRectangle *poppler_rc;
-	GList *pdf_merged, *it;
-	gchar *text, *prev_text, *tmp, *str;
-	ofsPdfRC *pdf_rc;
-	GError *error;
-
-	pdf_rc = NULL;
-	prev_text = NULL;
-	pdf_merged = NULL;
-
-	/* merge the adjacent PopplerRectangle's for the same text */
-	for( it=poppler_list ; it ; it=it->next ){
-		poppler_rc = ( PopplerRectangle * ) it->data;
-
-		text = poppler_page_get_selected_text( page, POPPLER_SELECTION_LINE, poppler_rc );
-
-		/* convert to UTF-8 if needed */
-		if( text && charset && my_collate( charset, "UTF-8" )){
-			error = NULL;
-			tmp = g_convert( text, -1, "UTF-8", charset, NULL, NULL, &error );
-			if( !tmp ){
-				str = g_strdup_printf( "'%s': unable to convert from %s to UTF-8: %s",
-						text, charset, error->message );
-				g_info( "%s", str );
-				g_free( str );
-			} else {
-				g_free( text );
-				text = tmp;
-			}
+		/* if the rectangle is zero size, then ignore */
+		poppler_rc = &rc_layout[i];
+		if( fabs( poppler_rc->x1 - poppler_rc->x2 ) < 1 && fabs( poppler_rc->y1 - poppler_rc->y2 ) < 1 ){
+			continue;
 		}
 
-		if( pdf_rc && prev_text && !my_collate( prev_text, text )){
-			if( pdf_rc->x2 < poppler_rc->x2 ){
-				pdf_rc->x2 = poppler_rc->x2;
-			}
-			if( pdf_rc->y2 < poppler_rc->y2 ){
-				pdf_rc->y2 = poppler_rc->y2;
-			}
+		if( pdf_rc ){
+			pdf_rc->x1 = MIN( pdf_rc->x1, poppler_rc->x1 );
+			pdf_rc->y1 = MIN( pdf_rc->y1, poppler_rc->y1 );
+			pdf_rc->x2 = MAX( pdf_rc->x2, poppler_rc->x2 );
+			pdf_rc->y2 = MAX( pdf_rc->y2, poppler_rc->y2 );
 			pdf_rc->count += 1;
-			pdf_merged = g_list_remove( pdf_merged, pdf_rc );
 
 		} else {
 			pdf_rc = g_new0( ofsPdfRC, 1 );
@@ -371,19 +397,42 @@ poppler_merge_to_pdf( GList *poppler_list, guint page_num, PopplerPage *page, co
 			pdf_rc->y1 = poppler_rc->y1;
 			pdf_rc->x2 = poppler_rc->x2;
 			pdf_rc->y2 = poppler_rc->y2;
-			pdf_rc->text = g_strdup( text );
 		}
+	}
 
-		g_free( prev_text );
-		prev_text = g_strdup( text );
-		g_free( text );
-
-		pdf_merged = g_list_insert_sorted( pdf_merged, pdf_rc, ( GCompareFunc ) pdf_cmp_rc );
+	if( pdf_rc ){
+		pdf_rc->text = pdf_convert_text( run, p-run, charset );
+		pdf_merged = g_list_prepend( pdf_merged, pdf_rc );
 	}
 
-	g_free( prev_text );
+	return( g_list_sort( pdf_merged, ( GCompareFunc ) pdf_cmp_rc ));
+}
+
+/*
+ * Returns: the text of the run, converted to UTF-8 if needed, as a
+ * newly allocated string.
+ */
+static gchar *
+pdf_convert_text( const gchar *text, gsize length, const gchar *charset )
+{
+	gchar *str, *tmp;
+	GError *error;
+
+	str = g_strndup( text, length );
+
+	if( charset && my_collate( charset, "UTF-8" )){
+		error = NULL;
+		tmp = g_convert( str, -1, "UTF-8", charset, NULL, NULL, &error );
+		if( !tmp ){
+			g_info( "'%s': unable to convert from %s to UTF-8: %s", str, charset, error->message );
+			g_error_free( error );
+		} else {
+			g_free( str );
+			str = tmp;
+		}
+	}
 
-	return( pdf_merged );
+	return( str );
 }
 
 /*
@@ -35,6 +35,12 @@
 
 G_BEGIN_DECLS
 
+/**
+ * MY_DOUBLE_STR_SIZE:
+ * The recommended size of the buffer provided to my_double_to_str_buf().
+ */
+#define MY_DOUBLE_STR_SIZE             64
+
 gboolean   my_double_is_zero          ( gdouble value, gint decimal_digits );
 
 gchar     *my_double_undecorate       ( const gchar *decorated, gunichar thousand_sep, gunichar decimal_sep );
@@ -49,6 +55,7 @@ gchar     *my_bigint_to_str           ( glong value, gunichar thousand_sep );
 gchar     *my_double_to_sql           ( gdouble value );
 gchar     *my_double_to_sql_ex        ( gdouble value, gint decimals );
 gchar     *my_double_to_str           ( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_degits );
+gsize      my_double_to_str_buf       ( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits, gchar *buffer, gsize size );
 
 gdouble    my_double_round_to_decimals( gdouble value, guint decimals );
 
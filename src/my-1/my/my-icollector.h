@@ -105,6 +105,13 @@ GList   *my_icollector_collection_get            ( myICollector *instance,
 														GType type,
 														void *user_data );
 
+GList   *my_icollector_collection_set            ( myICollector *instance,
+														GType type,
+														GList *dataset );
+
+gboolean my_icollector_collection_is_loaded      ( myICollector *instance,
+														GType type );
+
 void     my_icollector_collection_add_object     ( myICollector *instance,
 														myICollectionable *object,
 														GCompareFunc func,
@@ -41,9 +41,21 @@
  * The myIProgress implementation may also provide a text view for
  * possible error messages.
  *
- * Note that this #myIProgress interface is absolutely transparent,
- * i.e. does not do any work before of after the implementation. All
- * the behavior is fully dependant of the implementation.
+ * Note that this #myIProgress interface is almost transparent, i.e.
+ * does not do any work before of after the implementation, but:
+ *
+ * - rate-limits the pulses: for a same worker, at most 20 pulses per
+ *   second are forwarded to the implementation; the last pulse (when
+ *   count reaches total) is always forwarded, and a pending pulse is
+ *   flushed before any other call of the same worker, or at the end
+ *   of the pulse interval;
+ *
+ * - may be called from any thread: calls which do not come from the
+ *   main thread are forwarded to the implementation from the default
+ *   main context, in the order they have been made.
+ *
+ * Apart from that, all the behavior is fully dependant of the
+ * implementation.
  */
 
 #include <gtk/gtk.h>
@@ -37,6 +37,11 @@
  * - my-double
  * - my-text
  * - my-pulse.
+ *
+ * The signal handlers let Gtk process its pending events, so that
+ * the bar is displayed even when the caller runs its work from the
+ * main thread; this is throttled to about 20 updates per second, the
+ * final state and the texts being always displayed.
  */
 
 #include <gtk/gtk.h>
@@ -39,10 +39,20 @@ G_BEGIN_DECLS
 /**
  * myStampVal:
  *
- * An opaque data structure which holds a timestamp.
+ * A data structure which holds a timestamp.
+ *
+ * The structure is defined here so that it may be embedded in other
+ * structures, but its members should only be accessed through the
+ * my_stamp_xxx() functions.
  */
 typedef struct _myStampVal myStampVal;
 
+struct _myStampVal {
+	/*< private >*/
+	guint64 sec;
+	guint64 usec;
+};
+
 /**
  * myStampFormat:
  *
@@ -40,6 +40,7 @@ G_BEGIN_DECLS
 
 gchar        *my_casefold                             ( const gchar *str );
 gint          my_collate                              ( const gchar *a, const gchar *b );
+gchar        *my_collate_key                          ( const gchar *str );
 glong         my_strlen                               ( const gchar *str );
 
 void          my_utils_dump_gslist                    ( const GSList *list );
@@ -68,6 +69,9 @@ gchar        *my_utils_str_replace                    ( const gchar *string, con
 gchar        *my_utils_str_from_uint_list             ( GList *uint_list, const gchar *sep );
 GList        *my_utils_str_to_uint_list               ( const gchar *string, const gchar *sep );
 
+const gchar  *my_utils_intern_ref                     ( const gchar *str );
+void          my_utils_intern_unref                   ( const gchar *str );
+
 GtkWidget    *my_utils_builder_load_from_path         ( const gchar *path_xml, const gchar *widget_name );
 GtkWidget    *my_utils_builder_load_from_resource     ( const gchar *resource, const gchar *widget_name );
 
@@ -49,6 +49,12 @@ static const sDateFormat st_date_format[] = {
 		{ 0 }
 };
 
+static const guint16 st_days_before_month[13] = {
+		0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+};
+
+static gboolean date_set_from_sql_fast( GDate *date, const gchar *string );
+static gint     date_parse_digits( const gchar *string, guint count );
 static gboolean parse_ddmmyyyy_string( GDate *date, const gchar *string, gint *year );
 static gboolean parse_yyyymmdd_string( GDate *date, const gchar *string );
 static gboolean parse_dmydot_string( GDate *date, const gchar *string, gint *year );
@@ -237,6 +243,9 @@ my_date_set_from_date( GDate *date, const GDate *orig )
  * NB: this function only accepts a SQL date, not a full timestamp.
  * 	See my_date_set_from_stamp().
  *
+ * The fixed 'yyyy-mm-dd' format, which is the one returned by the
+ * DBMS, is parsed directly; other strings are left to g_date_set_parse().
+ *
  * Returns: @date, in order to be able to chain the functions.
  */
 GDate *
@@ -246,13 +255,69 @@ my_date_set_from_sql( GDate *date, const gchar *string )
 
 	g_date_clear( date, 1 );
 
-	if( my_strlen( string ) && g_utf8_collate( string, "0000-00-00" )){
+	if( my_strlen( string ) &&
+			!date_set_from_sql_fast( date, string ) &&
+			g_utf8_collate( string, "0000-00-00" )){
 		g_date_set_parse( date, string );
 	}
 
 	return( date );
 }
 
+/*
+ * Strict 'yyyy-mm-dd' parser, checked (and timed) by test-my-date.
+ *
+ * Returns: %TRUE if @string exactly matches the format, @date being
+ * then set if the string is a valid date, or left cleared (e.g. for
+ * the '0000-00-00' zero date).
+ * Returns %FALSE if @string is not in this fixed format.
+ */
+static gboolean
+date_set_from_sql_fast( GDate *date, const gchar *string )
+{
+	gint y, m, d, prev;
+	guint32 julian;
+
+	/* each check stops on the end of a shorter string */
+	if(( y = date_parse_digits( string, 4 )) < 0 || string[4] != '-' ||
+			( m = date_parse_digits( string+5, 2 )) < 0 || string[7] != '-' ||
+			( d = date_parse_digits( string+8, 2 )) < 0 || string[10] != '\0' ){
+		return( FALSE );
+	}
+
+	if( g_date_valid_dmy( d, m, y )){
+		prev = y-1;
+		julian = prev*365 + prev/4 - prev/100 + prev/400 + st_days_before_month[m] + d;
+		if( m > 2 && g_date_is_leap_year( y )){
+			julian += 1;
+		}
+		g_date_set_julian( date, julian );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * Returns the value of the @count first characters of @string, or -1
+ * if one of them is not a digit (which includes the end of the string).
+ */
+static gint
+date_parse_digits( const gchar *string, guint count )
+{
+	gint value;
+	guint i;
+
+	value = 0;
+	for( i=0 ; i<count ; ++i ){
+		if( string[i] < '0' || string[i] > '9' ){
+			return( -1 );
+		}
+		value = 10*value + string[i] - '0';
+	}
+
+	return( value );
+}
+
 /**
  * my_date_set_from_str:
  * @date: [out]: a not-null pointer to the destination GDate structure
@@ -27,6 +27,7 @@
 #endif
 
 #define _GNU_SOURCE
+#include <locale.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -46,7 +47,24 @@ static GRegex      *st_locale_decimal_regex  = NULL;
 static GRegex      *st_inter_regex           = NULL;
 static const gchar *st_inter                 = "|";
 
+/* whether the locale lets double_format_fast() be used, i.e. whether
+ * printf() groups the digits by three with single-byte separators
+ */
+static gboolean     st_locale_fast           = FALSE;
+
+/* double_format_fast() only handles values which are exactly held
+ * as integers once scaled, and which are not too close of a rounding
+ * tie, so that its rounding is the same than those of printf()
+ */
+#define DOUBLE_FAST_MAX_DIGITS           9
+#define DOUBLE_FAST_MAX_SCALED           1e12
+#define DOUBLE_FAST_TIE_MARGIN           1e-4
+
+static const gdouble st_pow10[1+DOUBLE_FAST_MAX_DIGITS] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
 static void   double_set_locale( void );
+static gint   double_format_fast( gchar *buffer, gsize size, gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits );
 static gchar *double_decorate( const gchar *text, gunichar thousand_sep, gunichar decimal_sep );
 
 /**
@@ -133,6 +151,7 @@ double_set_locale( void )
 {
 	static const gchar *thisfn = "my_double_set_locale";
 	gchar *str, *p, *srev;
+	struct lconv *lc;
 
 	if( !st_locale_thousand_sep ){
 		str = g_strdup_printf( "%'.1lf", 1000.0 );
@@ -157,6 +176,20 @@ double_set_locale( void )
 		str = g_strdup_printf( "\\%s", st_inter );
 		st_inter_regex = g_regex_new( str, 0, 0, NULL );
 		g_free( str );
+
+		lc = localeconv();
+		st_locale_fast = lc &&
+				my_strlen( lc->thousands_sep ) == 1 &&
+				lc->thousands_sep[0] == ( gchar ) st_locale_thousand_sep &&
+				!g_ascii_isdigit( lc->thousands_sep[0] ) &&
+				lc->thousands_sep[0] != '-' && lc->thousands_sep[0] != st_inter[0] &&
+				my_strlen( lc->decimal_point ) == 1 &&
+				lc->decimal_point[0] == ( gchar ) st_locale_decimal_sep &&
+				lc->decimal_point[0] != lc->thousands_sep[0] &&
+				lc->grouping && lc->grouping[0] == 3 &&
+				( lc->grouping[1] == 0 || lc->grouping[1] == 3 );
+
+		g_debug( "%s: fast formatting is %s", thisfn, st_locale_fast ? "enabled" : "disabled" );
 	}
 }
 
@@ -367,8 +400,13 @@ my_bigint_to_str( glong value, gunichar thousand_sep )
 gchar *
 my_double_to_str( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits )
 {
+	gchar buffer[MY_DOUBLE_STR_SIZE];
 	gchar *text, *deco;
 
+	if( double_format_fast( buffer, sizeof( buffer ), value, thousand_sep, decimal_sep, decimal_digits ) >= 0 ){
+		return( g_strdup( buffer ));
+	}
+
 	text = g_strdup_printf( "%'.*lf", decimal_digits, value);
 	deco = double_decorate( text, thousand_sep, decimal_sep );
 
@@ -377,6 +415,129 @@ my_double_to_str( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gi
 	return( deco );
 }
 
+/**
+ * my_double_to_str_buf:
+ * @value:
+ * @thousand_sep:
+ * @decimal_sep:
+ * @decimal_digits:
+ * @buffer: [out]: the destination buffer.
+ * @size: the size of @buffer, should be at least MY_DOUBLE_STR_SIZE.
+ *
+ * Writes into @buffer the same string than my_double_to_str(), without
+ * any allocation for the most common values. The result is truncated
+ * if it does not fit in @buffer, and always null-terminated.
+ *
+ * Returns: the length of the full string.
+ */
+gsize
+my_double_to_str_buf( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits, gchar *buffer, gsize size )
+{
+	gint len;
+	gchar *text;
+	gsize full;
+
+	g_return_val_if_fail( buffer && size > 0, 0 );
+
+	len = double_format_fast( buffer, size, value, thousand_sep, decimal_sep, decimal_digits );
+	if( len >= 0 ){
+		return(( gsize ) len );
+	}
+
+	text = my_double_to_str( value, thousand_sep, decimal_sep, decimal_digits );
+	full = g_strlcpy( buffer, text, size );
+	g_free( text );
+
+	return( full );
+}
+
+/*
+ * double_format_fast:
+ *
+ * Writes the digits, the thousand separators and the decimal separator
+ * of @value directly into @buffer, with the same result than the
+ * printf() + double_decorate() path: this is checked (and timed) on a
+ * fuzzed corpus by test-my-double.
+ *
+ * Returns: the length of the written string, or -1 if @value cannot
+ * be formatted here (and @buffer is then left unchanged).
+ */
+static gint
+double_format_fast( gchar *buffer, gsize size, gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits )
+{
+	gchar digits[32];
+	gdouble scaled, fract;
+	guint64 ival;
+	gint ndigits, nint, len, i;
+	gboolean negative;
+	gchar tsep, dsep, *p;
+
+	double_set_locale();
+
+	if( !st_locale_fast ||
+			decimal_digits < 0 || decimal_digits > DOUBLE_FAST_MAX_DIGITS ||
+			!isfinite( value ) || decimal_sep == ( gunichar ) st_inter[0] ){
+		return( -1 );
+	}
+
+	negative = signbit( value );
+	scaled = fabs( value ) * st_pow10[decimal_digits];
+	if( scaled >= DOUBLE_FAST_MAX_SCALED ){
+		return( -1 );
+	}
+
+	ival = ( guint64 ) scaled;
+	fract = scaled - ( gdouble ) ival;
+	if( fabs( fract-0.5 ) < DOUBLE_FAST_TIE_MARGIN ){
+		return( -1 );
+	}
+	if( fract > 0.5 ){
+		ival += 1;
+	}
+
+	/* digits are computed from the least significant one,
+	 * printf() always writing at least one integer digit */
+	ndigits = 0;
+	do {
+		digits[ndigits++] = '0' + ( gchar )( ival % 10 );
+		ival /= 10;
+	} while( ival );
+	while( ndigits <= decimal_digits ){
+		digits[ndigits++] = '0';
+	}
+
+	/* as in double_decorate(), a zero separator leaves the intermediate
+	 * thousand separator, resp. the locale decimal separator */
+	tsep = thousand_sep ? ( gchar ) thousand_sep : st_inter[0];
+	dsep = decimal_sep ? ( gchar ) decimal_sep : ( gchar ) st_locale_decimal_sep;
+
+	nint = ndigits - decimal_digits;
+	len = ( negative ? 1 : 0 ) + nint + ( nint-1 )/3 + ( decimal_digits ? 1+decimal_digits : 0 );
+	if(( gsize ) len >= size ){
+		return( -1 );
+	}
+
+	p = buffer;
+	if( negative ){
+		*p++ = '-';
+	}
+	for( i=ndigits-1 ; i>=decimal_digits ; --i ){
+		*p++ = digits[i];
+		if( i > decimal_digits && ( i-decimal_digits ) % 3 == 0 ){
+			*p++ = tsep;
+		}
+	}
+	if( decimal_digits ){
+		*p++ = dsep;
+		for( i=decimal_digits-1 ; i>=0 ; --i ){
+			*p++ = digits[i];
+		}
+	}
+	*p = '\0';
+
+	return( len );
+}
+
 /*
  * double_decorate:
  *
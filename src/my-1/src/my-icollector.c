@@ -226,6 +226,69 @@ my_icollector_collection_get( myICollector *instance, GType type, void *user_dat
 	return( typed ? typed->t.list : NULL );
 }
 
+/**
+ * my_icollector_collection_set:
+ * @instance: this #myICollector instance.
+ * @type: the GType type of the collection.
+ * @dataset: a #GList of #myICollectionable objects of this @type.
+ *
+ * Defines the @dataset as the collection of @type objects, when it
+ * has been loaded outside of the #myICollectionable interface (e.g.
+ * asynchronously).
+ *
+ * The @instance #myICollector takes ownership of the @dataset.
+ * If the collection has been loaded in the meanwhile, then @dataset
+ * is released, and the already loaded collection is kept.
+ *
+ * Returns: the collection, which is owned by the @instance, and should
+ * not be released by the caller.
+ */
+GList *
+my_icollector_collection_set( myICollector *instance, GType type, GList *dataset )
+{
+	sCollector *sdata;
+	sTyped *typed;
+
+	g_return_val_if_fail( instance && MY_IS_ICOLLECTOR( instance ), NULL );
+
+	sdata = get_collector_data( instance );
+	typed = find_typed_by_type( sdata, type );
+
+	if( typed ){
+		g_return_val_if_fail( typed->is_collection, NULL );
+		g_list_free_full( dataset, ( GDestroyNotify ) g_object_unref );
+
+	} else {
+		typed = g_new0( sTyped, 1 );
+		typed->type = type;
+		typed->is_collection = TRUE;
+		typed->t.list = dataset;
+		sdata->typed_list = g_list_prepend( sdata->typed_list, typed );
+	}
+
+	return( typed->t.list );
+}
+
+/**
+ * my_icollector_collection_is_loaded:
+ * @instance: this #myICollector instance.
+ * @type: the GType type of the collection.
+ *
+ * Returns: %TRUE if the collection of @type objects has been loaded,
+ * even if it is empty.
+ */
+gboolean
+my_icollector_collection_is_loaded( myICollector *instance, GType type )
+{
+	sCollector *sdata;
+
+	g_return_val_if_fail( instance && MY_IS_ICOLLECTOR( instance ), FALSE );
+
+	sdata = get_collector_data( instance );
+
+	return( find_typed_by_type( sdata, type ) != NULL );
+}
+
 /*
  * @user_data: [allow-none]: data passed to #myICollectionable when
  *  loading the collection (if not %NULL)
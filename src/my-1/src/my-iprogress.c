@@ -29,12 +29,90 @@
 #include "my/my-iprogress.h"
 
 #define IPROGRESS_LAST_VERSION            1
+#define IPROGRESS_DATA                    "my-iprogress-data"
 
-static guint st_initializations         = 0;	/* interface initialization count */
+/* the minimal delay between two pulses forwarded to the implementation
+ * for a same worker, in microseconds (i.e. at most 20 pulses per second)
+ */
+#define IPROGRESS_PULSE_INTERVAL          50000
+
+/* a data structure attached to each #myIProgress instance
+ * the mutex protects the workers hash table, as pulses may be called
+ * from any thread
+ */
+typedef struct {
+	GMutex      mutex;
+	GHashTable *workers;
+}
+	sIProgress;
+
+/* the throttling state of each worker
+ */
+typedef struct {
+	gint64   last_pulse;
+	gboolean pending;
+	gboolean scheduled;			/* a flush of the pending pulse is scheduled */
+	gulong   count;
+	gulong   total;
+}
+	sWorker;
 
-static GType register_type( void );
-static void  interface_base_init( myIProgressInterface *klass );
-static void  interface_base_finalize( myIProgressInterface *klass );
+/* the scheduled flush of a pending pulse
+ */
+typedef struct {
+	myIProgress *instance;
+	const void  *worker;
+}
+	sFlush;
+
+/* a call to be forwarded to the implementation from the main thread
+ */
+typedef enum {
+	CALL_START_WORK = 0,
+	CALL_START_PROGRESS,
+	CALL_PULSE,
+	CALL_SET_ROW,
+	CALL_SET_OK,
+	CALL_SET_TEXT
+}
+	eCall;
+
+typedef struct {
+	eCall        call;
+	myIProgress *instance;
+	const void  *worker;
+	GtkWidget   *widget;
+	gboolean     with_bar;
+	gulong       count;
+	gulong       total;
+	guint        type;
+	gchar       *text;
+}
+	sCall;
+
+static guint    st_initializations      = 0;	/* interface initialization count */
+static GThread *st_main_thread          = NULL;
+
+static GType       register_type( void );
+static void        interface_base_init( myIProgressInterface *klass );
+static void        interface_base_finalize( myIProgressInterface *klass );
+static sIProgress *get_instance_data( myIProgress *instance );
+static void        on_instance_finalized( sIProgress *sdata );
+static gboolean    pulse_throttle( myIProgress *instance, const void *worker, gulong count, gulong total );
+static gboolean    pulse_get_pending( myIProgress *instance, const void *worker, gulong *count, gulong *total );
+static void        pulse_flush( myIProgress *instance, const void *worker );
+static gboolean    pulse_on_timeout( sFlush *sflush );
+static sCall      *call_new( eCall call, myIProgress *instance, const void *worker, GtkWidget *widget );
+static void        call_defer( sCall *scall );
+static gboolean    call_on_idle( sCall *scall );
+static void        call_dispatch( sCall *scall );
+static void        call_free( sCall *scall );
+static void        do_start_work( myIProgress *instance, const void *worker, GtkWidget *widget );
+static void        do_start_progress( myIProgress *instance, const void *worker, GtkWidget *widget, gboolean with_bar );
+static void        do_pulse( myIProgress *instance, const void *worker, gulong count, gulong total );
+static void        do_set_row( myIProgress *instance, const void *worker, GtkWidget *widget );
+static void        do_set_ok( myIProgress *instance, const void *worker, GtkWidget *widget, gulong errs_count );
+static void        do_set_text( myIProgress *instance, const void *worker, guint type, const gchar *text );
 
 /**
  * my_iprogress_get_type:
@@ -93,6 +171,10 @@ interface_base_init( myIProgressInterface *klass )
 	if( st_initializations == 0 ){
 
 		g_debug( "%s: klass=%p (%s)", thisfn, ( void * ) klass, G_OBJECT_CLASS_NAME( klass ));
+
+		/* the interface is initialized when the first implementation
+		 * is instanciated, i.e. from the main (Gtk) thread */
+		st_main_thread = g_thread_self();
 	}
 
 	st_initializations += 1;
@@ -174,18 +256,17 @@ my_iprogress_get_interface_version( GType type )
 void
 my_iprogress_start_work( myIProgress *instance, const void *worker, GtkWidget *widget )
 {
-	static const gchar *thisfn = "my_iprogress_start_work";
-
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
-	if( MY_IPROGRESS_GET_INTERFACE( instance )->start_work ){
-		MY_IPROGRESS_GET_INTERFACE( instance )->start_work( instance, worker, widget );
+	pulse_flush( instance, worker );
+
+	if( g_thread_self() != st_main_thread ){
+		call_defer( call_new( CALL_START_WORK, instance, worker, widget ));
 		return;
 	}
 
-	g_info( "%s: myIProgress's %s implementation does not provide 'start_work()' method",
-			thisfn, G_OBJECT_TYPE_NAME( instance ));
+	do_start_work( instance, worker, widget );
 }
 
 /**
@@ -205,18 +286,21 @@ my_iprogress_start_work( myIProgress *instance, const void *worker, GtkWidget *w
 void
 my_iprogress_start_progress( myIProgress *instance, const void *worker, GtkWidget *widget, gboolean with_bar )
 {
-	static const gchar *thisfn = "my_iprogress_start_progress";
+	sCall *scall;
 
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
-	if( MY_IPROGRESS_GET_INTERFACE( instance )->start_progress ){
-		MY_IPROGRESS_GET_INTERFACE( instance )->start_progress( instance, worker, widget, with_bar );
+	pulse_flush( instance, worker );
+
+	if( g_thread_self() != st_main_thread ){
+		scall = call_new( CALL_START_PROGRESS, instance, worker, widget );
+		scall->with_bar = with_bar;
+		call_defer( scall );
 		return;
 	}
 
-	g_info( "%s: myIProgress's %s implementation does not provide 'start_progress()' method",
-			thisfn, G_OBJECT_TYPE_NAME( instance ));
+	do_start_progress( instance, worker, widget, with_bar );
 }
 
 /**
@@ -233,18 +317,24 @@ my_iprogress_start_progress( myIProgress *instance, const void *worker, GtkWidge
 void
 my_iprogress_pulse( myIProgress *instance, const void *worker, gulong count, gulong total )
 {
-	static const gchar *thisfn = "my_iprogress_pulse";
+	sCall *scall;
 
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
-	if( MY_IPROGRESS_GET_INTERFACE( instance )->pulse ){
-		MY_IPROGRESS_GET_INTERFACE( instance )->pulse( instance, worker, count, total );
+	if( !pulse_throttle( instance, worker, count, total )){
 		return;
 	}
 
-	g_info( "%s: myIProgress's %s implementation does not provide 'pulse()' method",
-			thisfn, G_OBJECT_TYPE_NAME( instance ));
+	if( g_thread_self() != st_main_thread ){
+		scall = call_new( CALL_PULSE, instance, worker, NULL );
+		scall->count = count;
+		scall->total = total;
+		call_defer( scall );
+		return;
+	}
+
+	do_pulse( instance, worker, count, total );
 }
 
 /**
@@ -261,18 +351,17 @@ my_iprogress_pulse( myIProgress *instance, const void *worker, gulong count, gul
 void
 my_iprogress_set_row( myIProgress *instance, const void *worker, GtkWidget *widget )
 {
-	static const gchar *thisfn = "my_iprogress_set_row";
-
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
-	if( MY_IPROGRESS_GET_INTERFACE( instance )->set_row ){
-		MY_IPROGRESS_GET_INTERFACE( instance )->set_row( instance, worker, widget );
+	pulse_flush( instance, worker );
+
+	if( g_thread_self() != st_main_thread ){
+		call_defer( call_new( CALL_SET_ROW, instance, worker, widget ));
 		return;
 	}
 
-	g_info( "%s: myIProgress's %s implementation does not provide 'set_row()' method",
-			thisfn, G_OBJECT_TYPE_NAME( instance ));
+	do_set_row( instance, worker, widget );
 }
 
 /**
@@ -291,18 +380,21 @@ my_iprogress_set_row( myIProgress *instance, const void *worker, GtkWidget *widg
 void
 my_iprogress_set_ok( myIProgress *instance, const void *worker, GtkWidget *widget, gulong errs_count )
 {
-	static const gchar *thisfn = "my_iprogress_set_ok";
+	sCall *scall;
 
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
-	if( MY_IPROGRESS_GET_INTERFACE( instance )->set_ok ){
-		MY_IPROGRESS_GET_INTERFACE( instance )->set_ok( instance, worker, widget, errs_count );
+	pulse_flush( instance, worker );
+
+	if( g_thread_self() != st_main_thread ){
+		scall = call_new( CALL_SET_OK, instance, worker, widget );
+		scall->count = errs_count;
+		call_defer( scall );
 		return;
 	}
 
-	g_info( "%s: myIProgress's %s implementation does not provide 'set_ok()' method",
-			thisfn, G_OBJECT_TYPE_NAME( instance ));
+	do_set_ok( instance, worker, widget, errs_count );
 }
 
 /**
@@ -319,11 +411,344 @@ my_iprogress_set_ok( myIProgress *instance, const void *worker, GtkWidget *widge
 void
 my_iprogress_set_text( myIProgress *instance, const void *worker, guint type, const gchar *text )
 {
-	static const gchar *thisfn = "my_iprogress_set_text";
+	sCall *scall;
 
 	g_return_if_fail( instance && MY_IS_IPROGRESS( instance ));
 	g_return_if_fail( worker );
 
+	if( g_thread_self() != st_main_thread ){
+		scall = call_new( CALL_SET_TEXT, instance, worker, NULL );
+		scall->type = type;
+		scall->text = g_strdup( text );
+		call_defer( scall );
+		return;
+	}
+
+	do_set_text( instance, worker, type, text );
+}
+
+static sIProgress *
+get_instance_data( myIProgress *instance )
+{
+	static GMutex st_data_mutex;
+	sIProgress *sdata;
+
+	g_mutex_lock( &st_data_mutex );
+
+	sdata = ( sIProgress * ) g_object_get_data( G_OBJECT( instance ), IPROGRESS_DATA );
+
+	if( !sdata ){
+		sdata = g_new0( sIProgress, 1 );
+		g_mutex_init( &sdata->mutex );
+		sdata->workers = g_hash_table_new_full( g_direct_hash, g_direct_equal, NULL, g_free );
+		g_object_set_data_full( G_OBJECT( instance ), IPROGRESS_DATA, sdata, ( GDestroyNotify ) on_instance_finalized );
+	}
+
+	g_mutex_unlock( &st_data_mutex );
+
+	return( sdata );
+}
+
+static void
+on_instance_finalized( sIProgress *sdata )
+{
+	static const gchar *thisfn = "my_iprogress_on_instance_finalized";
+
+	g_debug( "%s: sdata=%p", thisfn, ( void * ) sdata );
+
+	g_hash_table_destroy( sdata->workers );
+	g_mutex_clear( &sdata->mutex );
+	g_free( sdata );
+}
+
+/*
+ * Returns: %TRUE if the pulse must be forwarded to the implementation.
+ *
+ * The first pulse and the last one (count >= total) are always
+ * forwarded; in between, a pulse is only forwarded if enough time has
+ * elapsed since the previous one, else it is kept as pending and
+ * replaces a previous pending pulse, if any.
+ */
+static gboolean
+pulse_throttle( myIProgress *instance, const void *worker, gulong count, gulong total )
+{
+	sIProgress *sdata;
+	sWorker *sworker;
+	sFlush *sflush;
+	gint64 now;
+	gboolean forward;
+
+	sdata = get_instance_data( instance );
+	now = g_get_monotonic_time();
+	forward = TRUE;
+
+	g_mutex_lock( &sdata->mutex );
+
+	sworker = ( sWorker * ) g_hash_table_lookup( sdata->workers, worker );
+
+	if( !sworker ){
+		sworker = g_new0( sWorker, 1 );
+		g_hash_table_insert( sdata->workers, ( gpointer ) worker, sworker );
+
+	} else if( count < total && now - sworker->last_pulse < IPROGRESS_PULSE_INTERVAL ){
+		sworker->pending = TRUE;
+		sworker->count = count;
+		sworker->total = total;
+		forward = FALSE;
+
+		/* make sure the pending pulse will be displayed, even if no
+		 * other call comes for this worker */
+		if( !sworker->scheduled ){
+			sflush = g_new0( sFlush, 1 );
+			sflush->instance = g_object_ref( instance );
+			sflush->worker = worker;
+			sworker->scheduled = TRUE;
+			/* same priority as the calls forwarded from the worker
+			 * threads, so that it is not displayed before them */
+			g_timeout_add_full( G_PRIORITY_DEFAULT_IDLE,
+					IPROGRESS_PULSE_INTERVAL/1000, ( GSourceFunc ) pulse_on_timeout, sflush, NULL );
+		}
+	}
+
+	if( forward ){
+		sworker->last_pulse = now;
+		sworker->pending = FALSE;
+	}
+
+	g_mutex_unlock( &sdata->mutex );
+
+	return( forward );
+}
+
+/*
+ * Returns: %TRUE if a pulse was pending for this worker, and clears it.
+ */
+static gboolean
+pulse_get_pending( myIProgress *instance, const void *worker, gulong *count, gulong *total )
+{
+	sIProgress *sdata;
+	sWorker *sworker;
+	gboolean pending;
+
+	sdata = get_instance_data( instance );
+	pending = FALSE;
+
+	g_mutex_lock( &sdata->mutex );
+
+	sworker = ( sWorker * ) g_hash_table_lookup( sdata->workers, worker );
+
+	if( sworker && sworker->pending ){
+		pending = TRUE;
+		*count = sworker->count;
+		*total = sworker->total;
+		sworker->pending = FALSE;
+		sworker->last_pulse = g_get_monotonic_time();
+	}
+
+	g_mutex_unlock( &sdata->mutex );
+
+	return( pending );
+}
+
+/*
+ * Forward the last pending pulse of the worker (if any) before any
+ * other call, so that the display ends up with the latest known state.
+ */
+static void
+pulse_flush( myIProgress *instance, const void *worker )
+{
+	sCall *scall;
+	gulong count, total;
+
+	if( pulse_get_pending( instance, worker, &count, &total )){
+
+		if( g_thread_self() != st_main_thread ){
+			scall = call_new( CALL_PULSE, instance, worker, NULL );
+			scall->count = count;
+			scall->total = total;
+			call_defer( scall );
+
+		} else {
+			do_pulse( instance, worker, count, total );
+		}
+	}
+}
+
+/*
+ * Main thread: display the pending pulse of the worker, if it has not
+ * been flushed by another call in the meantime.
+ */
+static gboolean
+pulse_on_timeout( sFlush *sflush )
+{
+	sIProgress *sdata;
+	sWorker *sworker;
+
+	sdata = get_instance_data( sflush->instance );
+
+	g_mutex_lock( &sdata->mutex );
+	sworker = ( sWorker * ) g_hash_table_lookup( sdata->workers, sflush->worker );
+	if( sworker ){
+		sworker->scheduled = FALSE;
+	}
+	g_mutex_unlock( &sdata->mutex );
+
+	pulse_flush( sflush->instance, sflush->worker );
+
+	g_object_unref( sflush->instance );
+	g_free( sflush );
+
+	return( G_SOURCE_REMOVE );
+}
+
+static sCall *
+call_new( eCall call, myIProgress *instance, const void *worker, GtkWidget *widget )
+{
+	sCall *scall;
+
+	scall = g_new0( sCall, 1 );
+	scall->call = call;
+	scall->instance = g_object_ref( instance );
+	scall->worker = worker;
+	scall->widget = widget ? g_object_ref( widget ) : NULL;
+
+	return( scall );
+}
+
+/*
+ * Calls which come from another thread than the main one are forwarded
+ * to the implementation from an idle callback of the default main
+ * context: idle sources of a same priority being dispatched in the
+ * order they have been added, the calls of a worker keep their order.
+ *
+ * Note that g_main_context_invoke() would directly run the call in the
+ * worker thread while the default context is not owned (e.g. while a
+ * dialog is not yet run), which must be avoided for Gtk calls.
+ */
+static void
+call_defer( sCall *scall )
+{
+	g_idle_add(( GSourceFunc ) call_on_idle, scall );
+}
+
+static gboolean
+call_on_idle( sCall *scall )
+{
+	call_dispatch( scall );
+	call_free( scall );
+
+	return( G_SOURCE_REMOVE );
+}
+
+static void
+call_dispatch( sCall *scall )
+{
+	switch( scall->call ){
+		case CALL_START_WORK:
+			do_start_work( scall->instance, scall->worker, scall->widget );
+			break;
+		case CALL_START_PROGRESS:
+			do_start_progress( scall->instance, scall->worker, scall->widget, scall->with_bar );
+			break;
+		case CALL_PULSE:
+			do_pulse( scall->instance, scall->worker, scall->count, scall->total );
+			break;
+		case CALL_SET_ROW:
+			do_set_row( scall->instance, scall->worker, scall->widget );
+			break;
+		case CALL_SET_OK:
+			do_set_ok( scall->instance, scall->worker, scall->widget, scall->count );
+			break;
+		case CALL_SET_TEXT:
+			do_set_text( scall->instance, scall->worker, scall->type, scall->text );
+			break;
+	}
+}
+
+static void
+call_free( sCall *scall )
+{
+	g_clear_object( &scall->widget );
+	g_object_unref( scall->instance );
+	g_free( scall->text );
+	g_free( scall );
+}
+
+static void
+do_start_work( myIProgress *instance, const void *worker, GtkWidget *widget )
+{
+	static const gchar *thisfn = "my_iprogress_start_work";
+
+	if( MY_IPROGRESS_GET_INTERFACE( instance )->start_work ){
+		MY_IPROGRESS_GET_INTERFACE( instance )->start_work( instance, worker, widget );
+		return;
+	}
+
+	g_info( "%s: myIProgress's %s implementation does not provide 'start_work()' method",
+			thisfn, G_OBJECT_TYPE_NAME( instance ));
+}
+
+static void
+do_start_progress( myIProgress *instance, const void *worker, GtkWidget *widget, gboolean with_bar )
+{
+	static const gchar *thisfn = "my_iprogress_start_progress";
+
+	if( MY_IPROGRESS_GET_INTERFACE( instance )->start_progress ){
+		MY_IPROGRESS_GET_INTERFACE( instance )->start_progress( instance, worker, widget, with_bar );
+		return;
+	}
+
+	g_info( "%s: myIProgress's %s implementation does not provide 'start_progress()' method",
+			thisfn, G_OBJECT_TYPE_NAME( instance ));
+}
+
+static void
+do_pulse( myIProgress *instance, const void *worker, gulong count, gulong total )
+{
+	static const gchar *thisfn = "my_iprogress_pulse";
+
+	if( MY_IPROGRESS_GET_INTERFACE( instance )->pulse ){
+		MY_IPROGRESS_GET_INTERFACE( instance )->pulse( instance, worker, count, total );
+		return;
+	}
+
+	g_info( "%s: myIProgress's %s implementation does not provide 'pulse()' method",
+			thisfn, G_OBJECT_TYPE_NAME( instance ));
+}
+
+static void
+do_set_row( myIProgress *instance, const void *worker, GtkWidget *widget )
+{
+	static const gchar *thisfn = "my_iprogress_set_row";
+
+	if( MY_IPROGRESS_GET_INTERFACE( instance )->set_row ){
+		MY_IPROGRESS_GET_INTERFACE( instance )->set_row( instance, worker, widget );
+		return;
+	}
+
+	g_info( "%s: myIProgress's %s implementation does not provide 'set_row()' method",
+			thisfn, G_OBJECT_TYPE_NAME( instance ));
+}
+
+static void
+do_set_ok( myIProgress *instance, const void *worker, GtkWidget *widget, gulong errs_count )
+{
+	static const gchar *thisfn = "my_iprogress_set_ok";
+
+	if( MY_IPROGRESS_GET_INTERFACE( instance )->set_ok ){
+		MY_IPROGRESS_GET_INTERFACE( instance )->set_ok( instance, worker, widget, errs_count );
+		return;
+	}
+
+	g_info( "%s: myIProgress's %s implementation does not provide 'set_ok()' method",
+			thisfn, G_OBJECT_TYPE_NAME( instance ));
+}
+
+static void
+do_set_text( myIProgress *instance, const void *worker, guint type, const gchar *text )
+{
+	static const gchar *thisfn = "my_iprogress_set_text";
+
 	if( MY_IPROGRESS_GET_INTERFACE( instance )->set_text ){
 		MY_IPROGRESS_GET_INTERFACE( instance )->set_text( instance, worker, type, text );
 		return;
@@ -33,9 +33,18 @@
  */
 typedef struct {
 	gboolean        dispose_has_run;
+
+	/* runtime
+	 */
+	gint64          last_update;
+	gboolean        updating;
 }
 	myProgressBarPrivate;
 
+/* the minimal delay between two display updates, in microseconds
+ */
+#define PROGRESS_BAR_UPDATE_INTERVAL    50000
+
 /* signals defined here
  */
 enum {
@@ -50,6 +59,7 @@ static guint st_signals[ N_SIGNALS ]    = { 0 };
 static void on_double( myProgressBar *self, gdouble progress, void *empty );
 static void on_text( myProgressBar *self, const gchar *text, void *empty );
 static void on_pulse( myProgressBar *self, void *empty );
+static void update_display( myProgressBar *self, gboolean force );
 
 G_DEFINE_TYPE_EXTENDED( myProgressBar, my_progress_bar, GTK_TYPE_PROGRESS_BAR, 0,
 		G_ADD_PRIVATE( myProgressBar ))
@@ -104,6 +114,8 @@ my_progress_bar_init( myProgressBar *self )
 	priv = my_progress_bar_get_instance_private( self );
 
 	priv->dispose_has_run = FALSE;
+	priv->last_update = 0;
+	priv->updating = FALSE;
 }
 
 static void
@@ -213,10 +225,7 @@ on_double( myProgressBar *self, gdouble progress, void *empty )
 
 	gtk_progress_bar_set_fraction( GTK_PROGRESS_BAR( self ), progress );
 
-	/* let Gtk update the display */
-	while( gtk_events_pending()){
-		gtk_main_iteration();
-	}
+	update_display( self, progress >= 1.0 );
 }
 
 static void
@@ -227,10 +236,7 @@ on_text( myProgressBar *self, const gchar *text, void *empty )
 	gtk_progress_bar_set_show_text( GTK_PROGRESS_BAR( self ), TRUE );
 	gtk_progress_bar_set_text( GTK_PROGRESS_BAR( self ), text );
 
-	/* let Gtk update the display */
-	while( gtk_events_pending()){
-		gtk_main_iteration();
-	}
+	update_display( self, TRUE );
 }
 
 static void
@@ -240,8 +246,40 @@ on_pulse( myProgressBar *self, void *empty )
 
 	gtk_progress_bar_pulse( GTK_PROGRESS_BAR( self ));
 
-	/* let Gtk update the display */
+	update_display( self, FALSE );
+}
+
+/*
+ * Let Gtk update the display, so that the bar progresses even when the
+ * caller runs its work synchronously from the main thread.
+ *
+ * The pending events are processed at most once per
+ * PROGRESS_BAR_UPDATE_INTERVAL, unless @force is set (the final state
+ * and the texts are always displayed).
+ */
+static void
+update_display( myProgressBar *self, gboolean force )
+{
+	myProgressBarPrivate *priv;
+	gint64 now;
+
+	priv = my_progress_bar_get_instance_private( self );
+
+	now = g_get_monotonic_time();
+
+	if( priv->updating || ( !force && now - priv->last_update < PROGRESS_BAR_UPDATE_INTERVAL )){
+		return;
+	}
+
+	/* the bar may be destroyed while processing the events */
+	g_object_ref( self );
+	priv->updating = TRUE;
+	priv->last_update = now;
+
 	while( gtk_events_pending()){
 		gtk_main_iteration();
 	}
+
+	priv->updating = FALSE;
+	g_object_unref( self );
 }
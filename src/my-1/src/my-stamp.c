@@ -32,11 +32,19 @@
 
 #include "my/my-stamp.h"
 
-struct _myStampVal {
-	guint64 sec;
-	guint64 usec;
-};
+/* the last local hour converted by set_from_sql_fast()
+ */
+typedef struct {
+	gint64 key;
+	time_t sec;
+}
+	sHourCache;
+
+G_LOCK_DEFINE_STATIC( st_hour_cache );
+static sHourCache st_hour_cache = { -1, 0 };
 
+static gboolean    set_from_sql_fast( myStampVal *timeval, const gchar *str );
+static gint        stamp_parse_digits( const gchar *str, guint count );
 static myStampVal *set_from_str_yymdhms( myStampVal *timeval, const gchar *str );
 static myStampVal *set_from_str_dmyyhm( myStampVal *timeval, const gchar *str );
 static myStampVal *set_from_str_yymd( myStampVal *timeval, const gchar *str );
@@ -257,6 +265,10 @@ my_stamp_set_now( myStampVal *stamp )
 myStampVal *
 my_stamp_set_from_sql( myStampVal *stamp, const gchar *str )
 {
+	if( str && set_from_sql_fast( stamp, str )){
+		return( stamp );
+	}
+
 	return( set_from_str_yymdhms( stamp, str ));
 }
 
@@ -342,6 +354,87 @@ set_from_str_yymdhms( myStampVal *timeval, const gchar *str )
 	return( timeval );
 }
 
+/*
+ * Strict 'yyyy-mm-dd hh:mi:ss' parser, as returned by the DBMS.
+ *
+ * The conversion to local time is done once per hour through mktime(),
+ * which has to consult the timezone on each call; the rows loaded from
+ * the DBMS usually share a few distinct hours. DST transitions happen
+ * on hour boundaries, so adding the minutes and seconds to the start of
+ * the hour gives the same result than a full mktime(), as checked (and
+ * timed) by test-my-stamp.
+ *
+ * Returns: %FALSE if @str is not in this fixed format, or is out of
+ * the normal ranges, in which case it is left to set_from_str_yymdhms().
+ */
+static gboolean
+set_from_sql_fast( myStampVal *timeval, const gchar *str )
+{
+	gint y, m, d, H, M, S;
+	gint64 key;
+	struct tm broken;
+	time_t sec;
+
+	/* each check stops on the end of a shorter string */
+	if(( y = stamp_parse_digits( str, 4 )) < 0 || str[4] != '-' ||
+			( m = stamp_parse_digits( str+5, 2 )) < 0 || str[7] != '-' ||
+			( d = stamp_parse_digits( str+8, 2 )) < 0 || str[10] != ' ' ||
+			( H = stamp_parse_digits( str+11, 2 )) < 0 || str[13] != ':' ||
+			( M = stamp_parse_digits( str+14, 2 )) < 0 || str[16] != ':' ||
+			( S = stamp_parse_digits( str+17, 2 )) < 0 || str[19] != '\0' ){
+		return( FALSE );
+	}
+
+	if( y < 1900 || m < 1 || m > 12 || d < 1 || d > 31 || H > 23 || M > 59 || S > 59 ){
+		return( FALSE );
+	}
+
+	key = (((( gint64 ) y*100 + m )*100 + d )*100 ) + H;
+
+	G_LOCK( st_hour_cache );
+
+	if( key != st_hour_cache.key ){
+		memset( &broken, '\0', sizeof( broken ));
+		broken.tm_year = y - 1900;
+		broken.tm_mon = m-1;	/* 0 to 11 */
+		broken.tm_mday = d;
+		broken.tm_hour = H;
+		broken.tm_isdst = -1;
+
+		st_hour_cache.sec = mktime( &broken );
+		st_hour_cache.key = key;
+	}
+	sec = st_hour_cache.sec;
+
+	G_UNLOCK( st_hour_cache );
+
+	timeval->sec = sec + M*60 + S;
+	timeval->usec = 0;
+
+	return( TRUE );
+}
+
+/*
+ * Returns the value of the @count first characters of @str, or -1
+ * if one of them is not a digit (which includes the end of the string).
+ */
+static gint
+stamp_parse_digits( const gchar *str, guint count )
+{
+	gint value;
+	guint i;
+
+	value = 0;
+	for( i=0 ; i<count ; ++i ){
+		if( str[i] < '0' || str[i] > '9' ){
+			return( -1 );
+		}
+		value = 10*value + str[i] - '0';
+	}
+
+	return( value );
+}
+
 /*
  * The string is expected to be 'dd/mm/yyyy hh:mi'
  */
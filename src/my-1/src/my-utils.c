@@ -47,6 +47,11 @@ static GRegex      *st_quote_single_regex      = NULL;
 static GRegex      *st_long_dash_regex         = NULL;
 static const gchar *st_save_restore_group      = "orgtrychlosmy";
 
+/* the pool of interned strings: string -> reference count
+ */
+static GHashTable  *st_intern_pool             = NULL;
+G_LOCK_DEFINE_STATIC( st_intern_pool );
+
 static gchar      *quote_backslashes( const gchar *str );
 static gboolean    utils_quote_cb( const GMatchInfo *info, GString *res, gpointer data );
 static gboolean    utils_unquote_cb( const GMatchInfo *info, GString *res, gpointer data );
@@ -92,6 +97,25 @@ my_collate( const gchar *a, const gchar *b )
 	return( a && b ? g_utf8_collate( a, b ) : ( a ? 1 : ( b ? -1 : 0 )));
 }
 
+/**
+ * my_collate_key:
+ * @str: [allow-none]: a UTF-8 string.
+ *
+ * Returns: a newly allocated collation key for @str, or %NULL if @str
+ * is %NULL.
+ *
+ * Two keys compare with g_strcmp0() in the same order than the source
+ * strings compare with my_collate(), which lets the callers compute
+ * the key once and reuse it for all subsequent comparisons.
+ *
+ * The returned key should be g_free() by the caller.
+ */
+gchar *
+my_collate_key( const gchar *str )
+{
+	return( str ? g_utf8_collate_key( str, -1 ) : NULL );
+}
+
 /**
  * my_strlen:
  * @str:
@@ -932,6 +956,82 @@ my_utils_str_to_uint_list( const gchar *string, const gchar *sep )
 	return( g_list_reverse( list ));
 }
 
+/**
+ * my_utils_intern_ref:
+ * @str: [allow-none]: a string.
+ *
+ * Returns: the pooled copy of @str, or %NULL if @str is %NULL.
+ *
+ * All the callers which intern equal strings share the same copy, so
+ * that interned strings may be compared by their address.
+ *
+ * Contrarily to g_intern_string(), the pool keeps a reference count
+ * on each string: the returned value must be released with
+ * my_utils_intern_unref() when no more used, and the copy is freed
+ * with its last reference.
+ */
+const gchar *
+my_utils_intern_ref( const gchar *str )
+{
+	gpointer orig_key, count;
+	const gchar *interned;
+
+	if( !str ){
+		return( NULL );
+	}
+
+	G_LOCK( st_intern_pool );
+
+	if( !st_intern_pool ){
+		st_intern_pool = g_hash_table_new( g_str_hash, g_str_equal );
+	}
+
+	if( g_hash_table_lookup_extended( st_intern_pool, str, &orig_key, &count )){
+		g_hash_table_insert( st_intern_pool, orig_key, GUINT_TO_POINTER( GPOINTER_TO_UINT( count )+1 ));
+		interned = ( const gchar * ) orig_key;
+
+	} else {
+		interned = g_strdup( str );
+		g_hash_table_insert( st_intern_pool, ( gpointer ) interned, GUINT_TO_POINTER( 1 ));
+	}
+
+	G_UNLOCK( st_intern_pool );
+
+	return( interned );
+}
+
+/**
+ * my_utils_intern_unref:
+ * @str: [allow-none]: a string returned by my_utils_intern_ref().
+ *
+ * Release a reference on the interned @str.
+ */
+void
+my_utils_intern_unref( const gchar *str )
+{
+	static const gchar *thisfn = "my_utils_intern_unref";
+	gpointer orig_key, count;
+
+	if( !str ){
+		return;
+	}
+
+	G_LOCK( st_intern_pool );
+
+	if( st_intern_pool && g_hash_table_lookup_extended( st_intern_pool, str, &orig_key, &count )){
+		if( GPOINTER_TO_UINT( count ) > 1 ){
+			g_hash_table_insert( st_intern_pool, orig_key, GUINT_TO_POINTER( GPOINTER_TO_UINT( count )-1 ));
+		} else {
+			g_hash_table_remove( st_intern_pool, orig_key );
+			g_free( orig_key );
+		}
+	} else {
+		g_warning( "%s: str=%s is not interned", thisfn, str );
+	}
+
+	G_UNLOCK( st_intern_pool );
+}
+
 /**
  * my_utils_container_get_child_by_name:
  */
@@ -0,0 +1,219 @@
+/*
+ * Open Firm Accounting
+ * A double-entry accounting application for professional services.
+ *
+ * Copyright (C) 2014-2020 Pierre Wieser (see AUTHORS)
+ *
+ * Open Firm Accounting is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * Open Firm Accounting is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Open Firm Accounting; see the file COPYING. If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Pierre Wieser <pwieser@trychlos.org>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <locale.h>
+#include <string.h>
+
+#include "my/my-date.h"
+#include "my/my-utils.h"
+
+/* the count of fuzzed dates, resp. of parsed dates in a benchmark
+ * (the latter being multiplied when run with '-m perf')
+ */
+#define TEST_FUZZ_COUNT                 200000
+#define TEST_BENCH_COUNT                100000
+#define TEST_BENCH_PERF                 20
+
+/* the julian day of 9999-12-31
+ */
+#define TEST_MAX_JULIAN                 3652059
+
+static void test_set_from_sql_old( GDate *date, const gchar *string );
+static void test_sql_valid( void );
+static void test_sql_fields( void );
+static void test_sql_malformed( void );
+static void test_sql_bench( void );
+
+int
+main( int argc, char *argv[] )
+{
+	setlocale( LC_ALL, "" );
+
+	g_test_init( &argc, &argv, NULL );
+
+	g_test_add_func( "/my-date/set-from-sql/valid", test_sql_valid );
+	g_test_add_func( "/my-date/set-from-sql/fields", test_sql_fields );
+	g_test_add_func( "/my-date/set-from-sql/malformed", test_sql_malformed );
+	g_test_add_func( "/my-date/set-from-sql/bench", test_sql_bench );
+
+	return( g_test_run());
+}
+
+/*
+ * The previous implementation of my_date_set_from_sql().
+ */
+static void
+test_set_from_sql_old( GDate *date, const gchar *string )
+{
+	g_date_clear( date, 1 );
+
+	if( my_strlen( string ) && g_utf8_collate( string, "0000-00-00" )){
+		g_date_set_parse( date, string );
+	}
+}
+
+/*
+ * Each valid date, written as 'yyyy-mm-dd', must be parsed to the same
+ * julian day.
+ */
+static void
+test_sql_valid( void )
+{
+	GDate ref, date;
+	gchar *str;
+	guint i, count;
+
+	count = g_test_thorough() ? 100*TEST_FUZZ_COUNT : TEST_FUZZ_COUNT;
+
+	for( i=0 ; i<count ; ++i ){
+		g_date_clear( &ref, 1 );
+		g_date_set_julian( &ref, g_test_rand_int_range( 1, TEST_MAX_JULIAN+1 ));
+		str = g_strdup_printf( "%4.4u-%2.2u-%2.2u",
+				g_date_get_year( &ref ), g_date_get_month( &ref ), g_date_get_day( &ref ));
+
+		my_date_set_from_sql( &date, str );
+		if( !g_date_valid( &date ) || g_date_get_julian( &date ) != g_date_get_julian( &ref )){
+			g_test_message( "string=%s", str );
+		}
+		g_assert_true( g_date_valid( &date ));
+		g_assert_cmpuint( g_date_get_julian( &date ), ==, g_date_get_julian( &ref ));
+
+		g_free( str );
+	}
+}
+
+/*
+ * Each well-formed string must give a valid date if and only if its
+ * fields are valid, the date being left cleared else.
+ */
+static void
+test_sql_fields( void )
+{
+	GDate date;
+	gchar *str;
+	gint y, m, d;
+	guint i;
+
+	for( i=0 ; i<TEST_FUZZ_COUNT ; ++i ){
+		y = g_test_rand_int_range( 0, 10000 );
+		m = g_test_rand_int_range( 0, 14 );
+		d = g_test_rand_int_range( 0, 33 );
+		str = g_strdup_printf( "%4.4d-%2.2d-%2.2d", y, m, d );
+
+		my_date_set_from_sql( &date, str );
+		if( g_date_valid_dmy( d, m, y )){
+			g_assert_true( g_date_valid( &date ));
+			g_assert_cmpuint( g_date_get_year( &date ), ==, y );
+			g_assert_cmpuint( g_date_get_month( &date ), ==, m );
+			g_assert_cmpuint( g_date_get_day( &date ), ==, d );
+		} else {
+			g_assert_false( g_date_valid( &date ));
+		}
+
+		g_free( str );
+	}
+
+	my_date_set_from_sql( &date, "0000-00-00" );
+	g_assert_false( g_date_valid( &date ));
+}
+
+/*
+ * The strings which are not in the fixed format must be parsed as
+ * before.
+ */
+static void
+test_sql_malformed( void )
+{
+	static const gchar *strings[] = {
+			"", "2020", "2020-01", "2020-01-0", "2020-1-05", "20-01-05", "2020/01/05",
+			"20200105", " 2020-01-05", "2020-01-05 ", "2020-01-05 10:11:12", "2020-01-5x",
+			"+020-01-05", "2020-0a-05", "05/01/2020", "5 January 2020", NULL };
+	GDate ref, date;
+	guint i;
+
+	for( i=0 ; strings[i] ; ++i ){
+		test_set_from_sql_old( &ref, strings[i] );
+		my_date_set_from_sql( &date, strings[i] );
+
+		g_assert_cmpint( g_date_valid( &date ), ==, g_date_valid( &ref ));
+		if( g_date_valid( &ref )){
+			g_assert_cmpuint( g_date_get_julian( &date ), ==, g_date_get_julian( &ref ));
+		}
+	}
+
+	my_date_set_from_sql( &date, NULL );
+	g_assert_false( g_date_valid( &date ));
+}
+
+/*
+ * Time the parsing of the dates as loaded from the DBMS.
+ */
+static void
+test_sql_bench( void )
+{
+	GDate date;
+	GDate ref;
+	gchar **strings;
+	gdouble elapsed;
+	guint i, count;
+	gulong total;
+
+	count = g_test_perf() ? TEST_BENCH_PERF*TEST_BENCH_COUNT : TEST_BENCH_COUNT;
+	strings = g_new( gchar *, count );
+	for( i=0 ; i<count ; ++i ){
+		g_date_clear( &ref, 1 );
+		g_date_set_dmy( &ref, 1, G_DATE_JANUARY, 2000 );
+		g_date_add_days( &ref, g_test_rand_int_range( 0, 30*365 ));
+		strings[i] = g_strdup_printf( "%4.4u-%2.2u-%2.2u",
+				g_date_get_year( &ref ), g_date_get_month( &ref ), g_date_get_day( &ref ));
+	}
+	total = 0;
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		my_date_set_from_sql( &date, strings[i] );
+		total += g_date_get_julian( &date );
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "my_date_set_from_sql(): %.1f ns per date", 1e9*elapsed/count );
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		test_set_from_sql_old( &date, strings[i] );
+		total -= g_date_valid( &date ) ? g_date_get_julian( &date ) : 0;
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "g_date_set_parse(): %.1f ns per date", 1e9*elapsed/count );
+
+	g_test_message( "checksum=%lu", total );
+
+	for( i=0 ; i<count ; ++i ){
+		g_free( strings[i] );
+	}
+	g_free( strings );
+}
@@ -0,0 +1,283 @@
+/*
+ * Open Firm Accounting
+ * A double-entry accounting application for professional services.
+ *
+ * Copyright (C) 2014-2020 Pierre Wieser (see AUTHORS)
+ *
+ * Open Firm Accounting is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * Open Firm Accounting is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Open Firm Accounting; see the file COPYING. If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Pierre Wieser <pwieser@trychlos.org>
+ */
+
+/* double_format_fast() and double_decorate() are static: the source
+ * is included so that the fast path may be compared with the printf()
+ * + double_decorate() one
+ */
+#include "my-double.c"
+
+/* the count of fuzzed values, resp. of formatted values in a benchmark
+ * (the latter being multiplied when run with '-m perf')
+ */
+#define TEST_FUZZ_COUNT                 200000
+#define TEST_BENCH_COUNT                100000
+#define TEST_BENCH_PERF                 20
+
+static const gunichar st_thousand_seps[] = { '\0', ' ', '.', ',', '\'' };
+static const gunichar st_decimal_seps[]  = { '\0', ',', '.' };
+
+static gboolean test_set_locale( void );
+static gdouble  test_rand_value( gint decimal_digits );
+static gchar   *test_format_ref( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits );
+static void     test_format_corpus( void );
+static void     test_format_buffer( void );
+static void     test_format_bench( void );
+
+int
+main( int argc, char *argv[] )
+{
+	g_test_init( &argc, &argv, NULL );
+
+	if( !test_set_locale()){
+		g_test_message( "no locale groups the digits by three: only the fallback is checked" );
+	}
+
+	g_test_add_func( "/my-double/format-fast/corpus", test_format_corpus );
+	g_test_add_func( "/my-double/format-fast/buffer", test_format_buffer );
+	g_test_add_func( "/my-double/format-fast/bench", test_format_bench );
+
+	return( g_test_run());
+}
+
+/*
+ * The fast path is only enabled for the locales which group the digits
+ * by three with single-byte separators: select the first one which is
+ * available, the user locale first.
+ *
+ * This must be done before the first call to my-double, which then
+ * caches the locale separators.
+ */
+static gboolean
+test_set_locale( void )
+{
+	static const gchar *candidates[] = { "", "en_US.UTF-8", "fr_FR.UTF-8", "de_DE.UTF-8", "C.UTF-8", NULL };
+	struct lconv *lc;
+	guint i;
+
+	for( i=0 ; candidates[i] ; ++i ){
+		if( setlocale( LC_ALL, candidates[i] )){
+			lc = localeconv();
+			if( my_strlen( lc->thousands_sep ) == 1 && lc->grouping && lc->grouping[0] == 3 ){
+				break;
+			}
+		}
+	}
+	if( !candidates[i] ){
+		setlocale( LC_ALL, "C" );
+	}
+
+	double_set_locale();
+	g_test_message( "locale=%s, fast path is %s",
+			setlocale( LC_ALL, NULL ), st_locale_fast ? "enabled" : "disabled" );
+
+	return( st_locale_fast );
+}
+
+/*
+ * Returns a random value among:
+ * - amounts rounded to @decimal_digits, on all the magnitudes;
+ * - values close of a rounding tie;
+ * - any double, including the very large or the very small ones.
+ */
+static gdouble
+test_rand_value( gint decimal_digits )
+{
+	gdouble value, scale;
+
+	scale = pow( 10.0, decimal_digits );
+	value = g_test_rand_double_range( -1.0, 1.0 ) * pow( 10.0, g_test_rand_int_range( 0, 14 ));
+
+	switch( g_test_rand_int_range( 0, 4 )){
+		case 0:
+			value = round( value*scale ) / scale;
+			break;
+		case 1:
+			value = ( trunc( value*scale ) + 0.5 ) / scale;
+			break;
+		case 2:
+			value = ( trunc( value*scale ) + 0.5 + g_test_rand_double_range( -1e-3, 1e-3 )) / scale;
+			break;
+		default:
+			value = g_test_rand_double();
+			break;
+	}
+
+	return( value );
+}
+
+/*
+ * The reference printf() + double_decorate() path.
+ */
+static gchar *
+test_format_ref( gdouble value, gunichar thousand_sep, gunichar decimal_sep, gint decimal_digits )
+{
+	gchar *text, *deco;
+
+	text = g_strdup_printf( "%'.*lf", decimal_digits, value );
+	deco = double_decorate( text, thousand_sep, decimal_sep );
+	g_free( text );
+
+	return( deco );
+}
+
+/*
+ * Each value which is handled by the fast path must be formatted
+ * exactly as by the reference path, for all the separators; the other
+ * values must leave the buffer unchanged.
+ */
+static void
+test_format_corpus( void )
+{
+	static const gdouble specials[] = {
+			0.0, -0.0, 0.5, -0.5, 1.005, 999.995, 1000.0, -1000.0, 123456789.125,
+			999999999999.0, 1e12, -1e12, 1e-10, 1e300, INFINITY, -INFINITY, NAN };
+	gchar buffer[MY_DOUBLE_STR_SIZE];
+	gchar *ref, *str;
+	gdouble value;
+	gunichar tsep, dsep;
+	guint i, count, fast;
+	gint digits, len;
+
+	count = g_test_thorough() ? 100*TEST_FUZZ_COUNT : TEST_FUZZ_COUNT;
+	fast = 0;
+
+	for( i=0 ; i<count+G_N_ELEMENTS( specials ) ; ++i ){
+		digits = g_test_rand_int_range( 0, DOUBLE_FAST_MAX_DIGITS+2 );
+		value = i < G_N_ELEMENTS( specials ) ? specials[i] : test_rand_value( digits );
+		tsep = st_thousand_seps[g_test_rand_int_range( 0, G_N_ELEMENTS( st_thousand_seps ))];
+		dsep = st_decimal_seps[g_test_rand_int_range( 0, G_N_ELEMENTS( st_decimal_seps ))];
+
+		ref = test_format_ref( value, tsep, dsep, digits );
+
+		buffer[0] = 'x';
+		buffer[1] = '\0';
+		len = double_format_fast( buffer, sizeof( buffer ), value, tsep, dsep, digits );
+
+		if( len >= 0 ){
+			if( g_strcmp0( buffer, ref ) != 0 ){
+				g_test_message( "value=%.17g, digits=%d, thousand_sep='%c', decimal_sep='%c'",
+						value, digits, tsep, dsep );
+			}
+			g_assert_cmpstr( buffer, ==, ref );
+			g_assert_cmpint( len, ==, strlen( ref ));
+			fast += 1;
+		} else {
+			g_assert_cmpstr( buffer, ==, "x" );
+		}
+
+		str = my_double_to_str( value, tsep, dsep, digits );
+		g_assert_cmpstr( str, ==, ref );
+		g_free( str );
+
+		g_free( ref );
+	}
+
+	g_test_message( "%u values, of which %u through the fast path", i, fast );
+
+	if( st_locale_fast ){
+		g_assert_cmpuint( fast, >, 0 );
+	}
+}
+
+/*
+ * my_double_to_str_buf() always null-terminates the (maybe truncated)
+ * string, and returns the length of the full string.
+ */
+static void
+test_format_buffer( void )
+{
+	gchar buffer[MY_DOUBLE_STR_SIZE];
+	gchar *ref;
+	gdouble value;
+	gsize size, len;
+	guint i;
+
+	for( i=0 ; i<TEST_FUZZ_COUNT/100 ; ++i ){
+		value = test_rand_value( 2 );
+		ref = test_format_ref( value, ' ', ',', 2 );
+
+		len = my_double_to_str_buf( value, ' ', ',', 2, buffer, sizeof( buffer ));
+		g_assert_cmpuint( len, ==, strlen( ref ));
+		g_assert_cmpstr( buffer, ==, ref );
+
+		size = g_test_rand_int_range( 1, strlen( ref )+1 );
+		len = my_double_to_str_buf( value, ' ', ',', 2, buffer, size );
+		g_assert_cmpuint( len, ==, strlen( ref ));
+		g_assert_cmpuint( strlen( buffer ), ==, size-1 );
+		g_assert_true( strncmp( buffer, ref, size-1 ) == 0 );
+
+		g_free( ref );
+	}
+}
+
+/*
+ * Time the formatting of usual amounts (two decimal digits) through
+ * my_double_to_str_buf(), my_double_to_str() and the reference path.
+ */
+static void
+test_format_bench( void )
+{
+	gchar buffer[MY_DOUBLE_STR_SIZE];
+	gdouble *values;
+	gdouble elapsed;
+	gchar *str;
+	guint i, count;
+	gsize total;
+
+	count = g_test_perf() ? TEST_BENCH_PERF*TEST_BENCH_COUNT : TEST_BENCH_COUNT;
+	values = g_new( gdouble, count );
+	for( i=0 ; i<count ; ++i ){
+		values[i] = round( g_test_rand_double_range( -1e7, 1e7 )) / 100.0;
+	}
+	total = 0;
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		total += my_double_to_str_buf( values[i], ' ', ',', 2, buffer, sizeof( buffer ));
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "my_double_to_str_buf(): %.1f ns per value", 1e9*elapsed/count );
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		str = my_double_to_str( values[i], ' ', ',', 2 );
+		total += strlen( str );
+		g_free( str );
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "my_double_to_str(): %.1f ns per value", 1e9*elapsed/count );
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		str = test_format_ref( values[i], ' ', ',', 2 );
+		total += strlen( str );
+		g_free( str );
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "printf() + double_decorate(): %.1f ns per value", 1e9*elapsed/count );
+
+	g_assert_cmpuint( total, >, 0 );
+	g_free( values );
+}
@@ -0,0 +1,296 @@
+/*
+ * Open Firm Accounting
+ * A double-entry accounting application for professional services.
+ *
+ * Copyright (C) 2014-2020 Pierre Wieser (see AUTHORS)
+ *
+ * Open Firm Accounting is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * Open Firm Accounting is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Open Firm Accounting; see the file COPYING. If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Pierre Wieser <pwieser@trychlos.org>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "my/my-stamp.h"
+
+/* the count of fuzzed stamps, resp. of parsed stamps in a benchmark
+ * (the latter being multiplied when run with '-m perf')
+ */
+#define TEST_FUZZ_COUNT                 200000
+#define TEST_BENCH_COUNT                100000
+#define TEST_BENCH_PERF                 20
+
+/* the stamps are checked in a timezone which has DST transitions
+ */
+#define TEST_TIMEZONE                   "Europe/Paris"
+
+typedef struct {
+	gint y;
+	gint m;
+	gint d;
+	gint H;
+	gint M;
+	gint S;
+}
+	sFields;
+
+static gchar   *test_fields_to_str( const sFields *fields );
+static time_t   test_mktime( const sFields *fields, gint isdst, struct tm *result );
+static gboolean test_is_regular( const sFields *fields, time_t *sec0, time_t *sec1 );
+static void     test_check_fields( const sFields *fields );
+static void     test_sql_random( void );
+static void     test_sql_transitions( void );
+static void     test_sql_malformed( void );
+static void     test_sql_bench( void );
+
+int
+main( int argc, char *argv[] )
+{
+	g_setenv( "TZ", TEST_TIMEZONE, TRUE );
+	tzset();
+
+	g_test_init( &argc, &argv, NULL );
+
+	g_test_add_func( "/my-stamp/set-from-sql/random", test_sql_random );
+	g_test_add_func( "/my-stamp/set-from-sql/transitions", test_sql_transitions );
+	g_test_add_func( "/my-stamp/set-from-sql/malformed", test_sql_malformed );
+	g_test_add_func( "/my-stamp/set-from-sql/bench", test_sql_bench );
+
+	return( g_test_run());
+}
+
+static gchar *
+test_fields_to_str( const sFields *fields )
+{
+	return( g_strdup_printf( "%4.4d-%2.2d-%2.2d %2.2d:%2.2d:%2.2d",
+				fields->y, fields->m, fields->d, fields->H, fields->M, fields->S ));
+}
+
+static time_t
+test_mktime( const sFields *fields, gint isdst, struct tm *result )
+{
+	struct tm broken;
+	time_t sec;
+
+	memset( &broken, '\0', sizeof( broken ));
+	broken.tm_year = fields->y - 1900;
+	broken.tm_mon = fields->m-1;
+	broken.tm_mday = fields->d;
+	broken.tm_hour = fields->H;
+	broken.tm_min = fields->M;
+	broken.tm_sec = fields->S;
+	broken.tm_isdst = isdst;
+
+	sec = mktime( &broken );
+	localtime_r( &sec, result );
+
+	return( sec );
+}
+
+/*
+ * Returns: %TRUE if the local time exists exactly once, i.e. is
+ * neither skipped by nor repeated around a DST transition.
+ *
+ * For these irregular times, mktime() is free to pick either offset
+ * (and glibc depends on its previous calls), so that both @sec0 and
+ * @sec1 are accepted.
+ */
+static gboolean
+test_is_regular( const sFields *fields, time_t *sec0, time_t *sec1 )
+{
+	struct tm res;
+	time_t sec[2];
+	gint isdst, count;
+
+	count = 0;
+	for( isdst=0 ; isdst<=1 ; ++isdst ){
+		sec[isdst] = test_mktime( fields, isdst, &res );
+		if( res.tm_isdst == isdst &&
+				res.tm_year == fields->y-1900 && res.tm_mon == fields->m-1 && res.tm_mday == fields->d &&
+				res.tm_hour == fields->H && res.tm_min == fields->M && res.tm_sec == fields->S ){
+			count += 1;
+		}
+	}
+	*sec0 = sec[0];
+	*sec1 = sec[1];
+
+	return( count == 1 );
+}
+
+/*
+ * The strict parser must give the same timestamp than the sscanf() +
+ * mktime() one.
+ */
+static void
+test_check_fields( const sFields *fields )
+{
+	myStampVal fast, ref;
+	gchar *str;
+	time_t sec0, sec1;
+
+	str = test_fields_to_str( fields );
+
+	my_stamp_set_from_sql( &fast, str );
+	my_stamp_set_from_str( &ref, str, MY_STAMP_YYMDHMS );
+
+	if( my_stamp_compare( &fast, &ref ) != 0 ){
+		if( test_is_regular( fields, &sec0, &sec1 )){
+			g_test_message( "string=%s, fast=%ld, ref=%ld",
+					str, ( glong ) my_stamp_get_seconds( &fast ), ( glong ) my_stamp_get_seconds( &ref ));
+			g_assert_cmpint( my_stamp_get_seconds( &fast ), ==, my_stamp_get_seconds( &ref ));
+		} else {
+			g_assert_true( my_stamp_get_seconds( &fast ) == sec0 || my_stamp_get_seconds( &fast ) == sec1 );
+		}
+	}
+	g_assert_cmpuint( my_stamp_get_usecs( &fast ), ==, 0 );
+
+	g_free( str );
+}
+
+/*
+ * Random stamps, which exercise both the misses and (for the same
+ * hours) the hits of the hour cache.
+ */
+static void
+test_sql_random( void )
+{
+	sFields fields;
+	guint i, count;
+
+	count = g_test_thorough() ? 100*TEST_FUZZ_COUNT : TEST_FUZZ_COUNT;
+
+	for( i=0 ; i<count ; ++i ){
+		if( i == 0 || g_test_rand_bit()){
+			fields.y = g_test_rand_int_range( 1971, 2038 );
+			fields.m = g_test_rand_int_range( 1, 13 );
+			fields.d = g_test_rand_int_range( 1, 29 );
+			fields.H = g_test_rand_int_range( 0, 24 );
+		}
+		fields.M = g_test_rand_int_range( 0, 60 );
+		fields.S = g_test_rand_int_range( 0, 60 );
+
+		test_check_fields( &fields );
+	}
+}
+
+/*
+ * All the minutes around the DST transitions of a few years.
+ */
+static void
+test_sql_transitions( void )
+{
+	static const sFields days[] = {
+			{ 2019,  3, 31 }, { 2019, 10, 27 },
+			{ 2020,  3, 29 }, { 2020, 10, 25 },
+			{ 2021,  3, 28 }, { 2021, 10, 31 },
+			{ 0 }};
+	sFields fields;
+	guint i;
+
+	for( i=0 ; days[i].y ; ++i ){
+		fields = days[i];
+		for( fields.H=0 ; fields.H<5 ; ++fields.H ){
+			for( fields.M=0 ; fields.M<60 ; ++fields.M ){
+				fields.S = g_test_rand_int_range( 0, 60 );
+				test_check_fields( &fields );
+			}
+		}
+	}
+}
+
+/*
+ * The strings which are not in the fixed format, or have out-of-range
+ * fields, must be parsed as before.
+ *
+ * Only strings with the six fields are checked here, as the previous
+ * parser leaves the missing ones uninitialized.
+ */
+static void
+test_sql_malformed( void )
+{
+	static const gchar *strings[] = {
+			"2020-1-05 10:11:12", "2020-01-05 10:11:12.345", " 2020-01-05 10:11:12",
+			"2020-01-05  10:11:12", "2020-01-05 24:00:00",
+			"2020-01-05 10:60:00", "2020-13-05 10:11:12", "2020-01-32 10:11:12",
+			"2020-02-30 10:11:12", "1899-12-31 23:59:59", NULL };
+	myStampVal fast, ref;
+	guint i;
+
+	for( i=0 ; strings[i] ; ++i ){
+		memset( &fast, '\0', sizeof( fast ));
+		memset( &ref, '\0', sizeof( ref ));
+		my_stamp_set_from_sql( &fast, strings[i] );
+		my_stamp_set_from_str( &ref, strings[i], MY_STAMP_YYMDHMS );
+		g_assert_cmpint( my_stamp_compare( &fast, &ref ), ==, 0 );
+	}
+}
+
+/*
+ * Time the parsing of stamps as loaded from the DBMS, i.e. sorted and
+ * sharing a few hours.
+ */
+static void
+test_sql_bench( void )
+{
+	myStampVal stamp;
+	sFields fields;
+	gchar **strings;
+	gdouble elapsed;
+	guint i, count;
+	guint64 total;
+
+	count = g_test_perf() ? TEST_BENCH_PERF*TEST_BENCH_COUNT : TEST_BENCH_COUNT;
+	strings = g_new( gchar *, count );
+	fields.y = 2020;
+	fields.m = 1;
+	fields.d = 1;
+	for( i=0 ; i<count ; ++i ){
+		fields.H = 8 + ( i*10/count );
+		fields.M = g_test_rand_int_range( 0, 60 );
+		fields.S = g_test_rand_int_range( 0, 60 );
+		strings[i] = test_fields_to_str( &fields );
+	}
+	total = 0;
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		my_stamp_set_from_sql( &stamp, strings[i] );
+		total += my_stamp_get_seconds( &stamp );
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "my_stamp_set_from_sql(): %.1f ns per stamp", 1e9*elapsed/count );
+
+	g_test_timer_start();
+	for( i=0 ; i<count ; ++i ){
+		my_stamp_set_from_str( &stamp, strings[i], MY_STAMP_YYMDHMS );
+		total -= my_stamp_get_seconds( &stamp );
+	}
+	elapsed = g_test_timer_elapsed();
+	g_test_minimized_result( 1e9*elapsed/count, "sscanf() + mktime(): %.1f ns per stamp", 1e9*elapsed/count );
+
+	g_assert_cmpuint( total, ==, 0 );
+
+	for( i=0 ; i<count ; ++i ){
+		g_free( strings[i] );
+	}
+	g_free( strings );
+}
@@ -0,0 +1,1358 @@
+/*
+ * Open Firm Accounting
+ * A double-entry accounting application for professional services.
+ *
+ * Copyright (C) 2014-2020 Pierre Wieser (see AUTHORS)
+ *
+ * Open Firm Accounting is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * Open Firm Accounting is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Open Firm Accounting; see the file COPYING. If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Pierre Wieser <pwieser@trychlos.org>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <mysql/mysql.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "my/my-utils.h"
+
+#include "api/ofa-idbconnect.h"
+
+#include "ofa-mysql-backup.h"
+#include "ofa-mysql-connect.h"
+#include "ofa-mysql-exercice-meta.h"
+
+/* the first line of a native dump, followed by the format version
+ */
+#define BACKUP_SIGNATURE                "-- Openbook native dump"
+#define BACKUP_VERSION                  1
+
+/* the comment which introduces the datas of a table, and the one which
+ * terminates a complete dump
+ */
+#define BACKUP_TABLE_PREFIX             "-- Table "
+#define BACKUP_TRAILER                  "-- Dump completed"
+
+/* the maximum count of parallel connections used to dump the tables
+ */
+#define BACKUP_MAX_THREADS              4
+
+/* the size above which a multi-row INSERT statement is flushed; this
+ * must be kept lower than the default max_allowed_packet of the server
+ */
+#define BACKUP_MAX_STATEMENT            ( 1024*1024 )
+
+/* the size of the buffers exchanged with the archive
+ */
+#define BACKUP_BUFSIZE                  16384
+
+/* the maximum count of archive buffers queued to the restore thread
+ */
+#define RESTORE_MAX_BUFFERS             16
+
+/* the beginning of the statement which swaps the restored tables
+ */
+#define RESTORE_RENAME                  "RENAME TABLE "
+
+/* the parameters needed to open a dedicated connection
+ */
+typedef struct {
+	const gchar *host;
+	guint        port;
+	const gchar *socket;
+	const gchar *database;
+	const gchar *account;
+	const gchar *password;
+}
+	sCnx;
+
+/* the backup operation
+ * - the tables are dumped by the worker threads, each on its own
+ *   connection and inside of its own consistent snapshot, into a
+ *   temporary file;
+ * - the temporary files are then streamed in the table order from the
+ *   main thread, which is the only one to talk to the archive, and
+ *   keeps running the main loop while waiting for the workers.
+ */
+typedef struct {
+	sCnx       cnx;
+	GPtrArray *tables;
+	ofaMsgCb   msg_cb;
+	ofaDataCb  data_cb;
+	void      *user_data;
+
+	/* shared with the worker threads */
+	GMutex     mutex;
+	guint      next_dump;
+	guint      running;
+	gboolean   aborted;
+
+	/* main thread only */
+	GList     *workers;
+	guint      next_write;
+	gboolean   ok;
+}
+	sBackup;
+
+typedef struct {
+	sBackup   *sope;
+	MYSQL     *mysql;
+	GThread   *thread;
+}
+	sWorker;
+
+typedef struct {
+	sBackup   *sope;
+	gchar     *name;
+	gchar     *fname;
+	gulong     rows;
+	gboolean   ok;
+	gboolean   done;
+}
+	sTable;
+
+/* the restore operation
+ * - the archive is read from the main thread, which queues the buffers
+ *   to the worker thread, and keeps running the main loop;
+ * - the worker thread executes the statements into a temporary
+ *   database, and only swaps the restored tables into the target
+ *   database once the whole stream has been applied.
+ */
+typedef struct {
+	sCnx       cnx;							/* on the temporary database */
+	const gchar *database;					/* the target database */
+	gchar     *tmp_database;				/* receives the restored tables */
+	gchar     *old_database;				/* receives the previous tables */
+	ofaMsgCb   msg_cb;
+	ofaDataCb  data_cb;
+	void      *user_data;
+	GString   *head;
+
+	/* shared with the worker thread */
+	GAsyncQueue *buffers;					/* an empty GBytes ends the stream */
+	gboolean   read_failed;					/* set before the end of the stream */
+
+	/* main thread only */
+	gboolean   done;
+
+	/* worker thread */
+	GString   *stmt;
+	GString   *comment;
+	gchar      quote;
+	gboolean   escaped;
+	gboolean   in_comment;
+	gboolean   trailer_seen;
+	gulong     count;
+	gboolean   ok;
+}
+	sRestore;
+
+typedef struct {
+	ofaMsgCb   msg_cb;
+	void      *user_data;
+	gchar     *msg;
+}
+	sMessage;
+
+static MYSQL   *cnx_open( sCnx *cnx, gchar **msgerr );
+static void     backup_write_string( sBackup *sope, const gchar *str );
+static gboolean backup_open_workers( ofaMysqlConnect *connect, sBackup *sope );
+static gboolean backup_start_snapshots( ofaMysqlConnect *connect, sBackup *sope );
+static void     backup_wait_tables( sBackup *sope );
+static gboolean backup_stream_file( sBackup *sope, sTable *table );
+static gpointer backup_thread( sWorker *worker );
+static sTable  *backup_next_table( sBackup *sope );
+static void     backup_abort( sBackup *sope );
+static gboolean backup_dump_table( MYSQL *mysql, sTable *table );
+static gboolean backup_dump_rows( MYSQL *mysql, sTable *table, FILE *fp );
+static gboolean backup_on_table_done( sTable *table );
+static void     backup_free_worker( sWorker *worker );
+static void     backup_free_table( sTable *table );
+static gssize   restore_read( sRestore *sope, gchar *buffer, gsize bufsize );
+static gboolean restore_create_databases( ofaMysqlConnect *connect, sRestore *sope );
+static gboolean restore_create_database( ofaMysqlConnect *connect, const gchar *query, sRestore *sope );
+static void     restore_drop_databases( ofaMysqlConnect *connect, sRestore *sope );
+static void     restore_feed( sRestore *sope );
+static gpointer restore_thread( sRestore *sope );
+static gboolean restore_parse( sRestore *sope, MYSQL *mysql, const gchar *buffer, gsize length );
+static gboolean restore_execute( sRestore *sope, MYSQL *mysql );
+static void     restore_on_comment( sRestore *sope );
+static gboolean restore_swap( sRestore *sope, MYSQL *mysql );
+static gboolean restore_list_renames( MYSQL *mysql, const gchar *query, const gchar *from, const gchar *to, GString *rename );
+static gboolean restore_on_done( sRestore *sope );
+static void     send_message( ofaMsgCb msg_cb, void *user_data, gchar *msg );
+static gboolean on_message( sMessage *smsg );
+
+/**
+ * ofa_mysql_backup_db_run:
+ * @connect: a #ofaMysqlConnect object which handles a user connection
+ *  on the dossier/exercice to be backuped.
+ * @msg_cb: a callback for messages to be displayed.
+ * @data_cb: a callback for datas to be archived.
+ * @user_data: user data to be provided to the callbacks.
+ *
+ * Backup the currently connected database through the client library.
+ *
+ * Each table is read with mysql_use_result(), so that the rows are
+ * streamed from the server rather than stored in memory. Up to
+ * BACKUP_MAX_THREADS tables are dumped in parallel, each worker thread
+ * using its own connection with the credentials of @connect.
+ *
+ * All the worker connections start a consistent snapshot while the
+ * tables are read-locked by @connect, so that they all see the same
+ * state of the database; the lock is released as soon as the
+ * snapshots are started, and the dump does not block the writers.
+ * The backup is aborted if the tables cannot be locked.
+ *
+ * As for the command-line backup, the outputed SQL script doesn't
+ * contain any CREATE DATABASE nor USE, so that we will be able to
+ * reload the data to any database name.
+ *
+ * Both @msg_cb and @data_cb are only called from the main thread,
+ * which keeps running the main loop while waiting for the dumped
+ * tables, so that the progress messages are displayed; the caller is
+ * expected to prevent any user action during the backup (e.g. by
+ * running a modal dialog).
+ *
+ * Returns: %TRUE if the database has been successfully backuped,
+ * %FALSE else.
+ */
+gboolean
+ofa_mysql_backup_db_run( ofaMysqlConnect *connect, ofaMsgCb msg_cb, ofaDataCb data_cb, void *user_data )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_db_run";
+	sBackup *sope;
+	GList *list, *it;
+	sTable *table;
+	sWorker *worker;
+	gchar *str;
+	gboolean ok;
+
+	g_debug( "%s: connect=%p, msg_cb=%p, data_cb=%p, user_data=%p",
+			thisfn, ( void * ) connect, ( void * ) msg_cb, ( void * ) data_cb, user_data );
+
+	g_return_val_if_fail( connect && OFA_IS_MYSQL_CONNECT( connect ), FALSE );
+	g_return_val_if_fail( data_cb, FALSE );
+
+	sope = g_new0( sBackup, 1 );
+	sope->cnx.host = ofa_mysql_connect_get_host( connect );
+	sope->cnx.port = ofa_mysql_connect_get_port( connect );
+	sope->cnx.socket = ofa_mysql_connect_get_socket( connect );
+	sope->cnx.database = ofa_mysql_connect_get_database( connect );
+	sope->cnx.account = ofa_idbconnect_get_account( OFA_IDBCONNECT( connect ));
+	sope->cnx.password = ofa_idbconnect_get_password( OFA_IDBCONNECT( connect ));
+	sope->msg_cb = msg_cb;
+	sope->data_cb = data_cb;
+	sope->user_data = user_data;
+	sope->ok = TRUE;
+	g_mutex_init( &sope->mutex );
+
+	/* dump the tables in a reproducible order */
+	sope->tables = g_ptr_array_new_with_free_func(( GDestroyNotify ) backup_free_table );
+	list = g_list_sort( ofa_mysql_connect_get_tables_list( connect ), ( GCompareFunc ) g_strcmp0 );
+	for( it=list ; it ; it=it->next ){
+		table = g_new0( sTable, 1 );
+		table->sope = sope;
+		table->name = g_strdup(( const gchar * ) it->data );
+		g_ptr_array_add( sope->tables, table );
+	}
+	ofa_mysql_connect_free_tables_list( list );
+
+	ok = backup_open_workers( connect, sope ) &&
+			backup_start_snapshots( connect, sope );
+
+	if( ok ){
+		str = g_strdup_printf(
+				"%s %u\n"
+				"-- Database: %s\n"
+				"-- Tables: %u\n"
+				"SET NAMES utf8;\n"
+				"SET FOREIGN_KEY_CHECKS=0;\n"
+				"SET UNIQUE_CHECKS=0;\n"
+				"SET AUTOCOMMIT=0;\n",
+				BACKUP_SIGNATURE, BACKUP_VERSION, sope->cnx.database, sope->tables->len );
+		backup_write_string( sope, str );
+		g_free( str );
+
+		for( it=sope->workers ; it ; it=it->next ){
+			worker = ( sWorker * ) it->data;
+			worker->thread = g_thread_new( "ofa-mysql-backup", ( GThreadFunc ) backup_thread, worker );
+			sope->running += 1;
+		}
+
+		backup_wait_tables( sope );
+
+		for( it=sope->workers ; it ; it=it->next ){
+			worker = ( sWorker * ) it->data;
+			g_thread_join( worker->thread );
+			worker->thread = NULL;
+		}
+
+		ok = sope->ok && sope->next_write == sope->tables->len;
+	}
+
+	if( ok ){
+		str = g_strdup_printf(
+				"\n"
+				"COMMIT;\n"
+				"SET UNIQUE_CHECKS=1;\n"
+				"SET FOREIGN_KEY_CHECKS=1;\n"
+				"%s\n", BACKUP_TRAILER );
+		backup_write_string( sope, str );
+		g_free( str );
+	}
+
+	g_list_free_full( sope->workers, ( GDestroyNotify ) backup_free_worker );
+	g_ptr_array_free( sope->tables, TRUE );
+	g_mutex_clear( &sope->mutex );
+	g_free( sope );
+
+	g_debug( "%s: returning %s", thisfn, ok ? "True":"False" );
+
+	return( ok );
+}
+
+/*
+ * Open a new connection from a (maybe worker) thread.
+ */
+static MYSQL *
+cnx_open( sCnx *cnx, gchar **msgerr )
+{
+	MYSQL *mysql;
+
+	mysql = mysql_init( NULL );
+	if( !mysql ){
+		*msgerr = g_strdup( _( "unable to allocate a new MySQL connection" ));
+		return( NULL );
+	}
+
+	mysql_options( mysql, MYSQL_SET_CHARSET_NAME, "utf8" );
+
+	if( !mysql_real_connect( mysql,
+			cnx->host, cnx->account, cnx->password, cnx->database, cnx->port, cnx->socket, 0 )){
+		*msgerr = g_strdup( mysql_error( mysql ));
+		mysql_close( mysql );
+		return( NULL );
+	}
+
+	return( mysql );
+}
+
+/*
+ * main thread
+ */
+static void
+backup_write_string( sBackup *sope, const gchar *str )
+{
+	sope->data_cb(( void * ) str, strlen( str ), sope->user_data );
+}
+
+/*
+ * main thread
+ *
+ * Open the connections of the worker threads.
+ */
+static gboolean
+backup_open_workers( ofaMysqlConnect *connect, sBackup *sope )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_open_workers";
+	sWorker *worker;
+	MYSQL *mysql;
+	guint i, count;
+	gchar *msgerr, *str;
+
+	count = MIN( sope->tables->len, BACKUP_MAX_THREADS );
+
+	for( i=0 ; i<count ; ++i ){
+		msgerr = NULL;
+		mysql = cnx_open( &sope->cnx, &msgerr );
+		if( !mysql ){
+			g_warning( "%s: %s", thisfn, msgerr );
+			if( sope->msg_cb ){
+				str = g_strdup_printf( _( "-- Unable to open a backup connection: %s\n" ), msgerr );
+				sope->msg_cb( str, sope->user_data );
+				g_free( str );
+			}
+			g_free( msgerr );
+			return( FALSE );
+		}
+		worker = g_new0( sWorker, 1 );
+		worker->sope = sope;
+		worker->mysql = mysql;
+		sope->workers = g_list_prepend( sope->workers, worker );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * main thread
+ *
+ * Read-lock all the tables from @connect, start a consistent snapshot
+ * on each worker connection, and release the lock.
+ *
+ * Locking the tables only requires the LOCK TABLES privilege on the
+ * dossier database, which the dossier user is granted (while FLUSH
+ * TABLES WITH READ LOCK would require the RELOAD global privilege).
+ * The lock waits for the pending write transactions to be committed,
+ * and prevents any new write until it is released, so that all the
+ * snapshots see the same committed state.
+ */
+static gboolean
+backup_start_snapshots( ofaMysqlConnect *connect, sBackup *sope )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_start_snapshots";
+	GString *query;
+	GList *it;
+	sWorker *worker;
+	sTable *table;
+	guint i;
+	gchar *msgerr, *str;
+	gboolean ok;
+
+	if( sope->tables->len == 0 ){
+		return( TRUE );
+	}
+
+	query = g_string_new( "LOCK TABLES " );
+	for( i=0 ; i<sope->tables->len ; ++i ){
+		table = ( sTable * ) g_ptr_array_index( sope->tables, i );
+		g_string_append_printf( query, "%s`%s` READ", i ? "," : "", table->name );
+	}
+
+	ok = ofa_mysql_connect_query( connect, query->str );
+	g_string_free( query, TRUE );
+
+	if( !ok ){
+		msgerr = ofa_idbconnect_get_last_error( OFA_IDBCONNECT( connect ));
+		g_warning( "%s: unable to lock the tables: %s", thisfn, msgerr );
+		if( sope->msg_cb ){
+			str = g_strdup_printf( _( "-- Unable to lock the tables: %s\n" ), msgerr );
+			sope->msg_cb( str, sope->user_data );
+			g_free( str );
+		}
+		g_free( msgerr );
+		return( FALSE );
+	}
+
+	for( it=sope->workers ; it && ok ; it=it->next ){
+		worker = ( sWorker * ) it->data;
+		ok = mysql_query( worker->mysql, "SET SESSION TRANSACTION ISOLATION LEVEL REPEATABLE READ" ) == 0 &&
+				mysql_query( worker->mysql, "START TRANSACTION WITH CONSISTENT SNAPSHOT" ) == 0;
+		if( !ok ){
+			g_warning( "%s: unable to start a snapshot: %s", thisfn, mysql_error( worker->mysql ));
+			if( sope->msg_cb ){
+				str = g_strdup_printf( _( "-- Unable to start a consistent snapshot: %s\n" ), mysql_error( worker->mysql ));
+				sope->msg_cb( str, sope->user_data );
+				g_free( str );
+			}
+		}
+	}
+
+	if( !ofa_mysql_connect_query( connect, "UNLOCK TABLES" )){
+		msgerr = ofa_idbconnect_get_last_error( OFA_IDBCONNECT( connect ));
+		g_warning( "%s: unable to unlock the tables: %s", thisfn, msgerr );
+		g_free( msgerr );
+	}
+
+	return( ok );
+}
+
+/*
+ * main thread
+ *
+ * Wait for the tables to be dumped, and stream them in the table order.
+ * This returns when all the workers have terminated; in the meanwhile,
+ * the main loop is iterated, the workers waking it up each time a
+ * table or a thread is done.
+ */
+static void
+backup_wait_tables( sBackup *sope )
+{
+	sTable *table;
+	gboolean done;
+
+	while( sope->next_write < sope->tables->len ){
+		table = ( sTable * ) g_ptr_array_index( sope->tables, sope->next_write );
+
+		g_mutex_lock( &sope->mutex );
+		while( !table->done && sope->running > 0 ){
+			g_mutex_unlock( &sope->mutex );
+			g_main_context_iteration( NULL, TRUE );
+			g_mutex_lock( &sope->mutex );
+		}
+		done = table->done;
+		g_mutex_unlock( &sope->mutex );
+
+		/* all the workers have terminated without dumping this table */
+		if( !done || !backup_on_table_done( table )){
+			sope->ok = FALSE;
+			backup_abort( sope );
+			break;
+		}
+		sope->next_write += 1;
+	}
+
+	g_mutex_lock( &sope->mutex );
+	while( sope->running > 0 ){
+		g_mutex_unlock( &sope->mutex );
+		g_main_context_iteration( NULL, TRUE );
+		g_mutex_lock( &sope->mutex );
+	}
+	g_mutex_unlock( &sope->mutex );
+}
+
+/*
+ * main thread
+ */
+static gboolean
+backup_stream_file( sBackup *sope, sTable *table )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_stream_file";
+	FILE *fp;
+	gchar *buffer;
+	gsize count;
+	gboolean ok;
+
+	fp = g_fopen( table->fname, "rb" );
+	if( !fp ){
+		g_warning( "%s: %s: %s", thisfn, table->fname, g_strerror( errno ));
+		return( FALSE );
+	}
+
+	buffer = g_new( gchar, BACKUP_BUFSIZE );
+	while(( count = fread( buffer, 1, BACKUP_BUFSIZE, fp )) > 0 ){
+		sope->data_cb( buffer, count, sope->user_data );
+	}
+	ok = ( ferror( fp ) == 0 );
+	if( !ok ){
+		g_warning( "%s: %s: read error", thisfn, table->fname );
+	}
+	g_free( buffer );
+	fclose( fp );
+
+	/* release the disk space as soon as possible */
+	g_remove( table->fname );
+
+	return( ok );
+}
+
+/*
+ * worker thread
+ *
+ * Dump the tables inside of the snapshot opened on the connection of
+ * the @worker.
+ */
+static gpointer
+backup_thread( sWorker *worker )
+{
+	sBackup *sope;
+	sTable *table;
+	gboolean ok;
+
+	sope = worker->sope;
+
+	mysql_thread_init();
+
+	while(( table = backup_next_table( sope ))){
+		ok = backup_dump_table( worker->mysql, table );
+		if( !ok ){
+			backup_abort( sope );
+		}
+		g_mutex_lock( &sope->mutex );
+		table->ok = ok;
+		table->done = TRUE;
+		g_mutex_unlock( &sope->mutex );
+		g_main_context_wakeup( NULL );
+	}
+
+	mysql_query( worker->mysql, "COMMIT" );
+
+	mysql_thread_end();
+
+	g_mutex_lock( &sope->mutex );
+	sope->running -= 1;
+	g_mutex_unlock( &sope->mutex );
+	g_main_context_wakeup( NULL );
+
+	return( NULL );
+}
+
+static sTable *
+backup_next_table( sBackup *sope )
+{
+	sTable *table;
+
+	table = NULL;
+
+	g_mutex_lock( &sope->mutex );
+	if( !sope->aborted && sope->next_dump < sope->tables->len ){
+		table = ( sTable * ) g_ptr_array_index( sope->tables, sope->next_dump );
+		sope->next_dump += 1;
+	}
+	g_mutex_unlock( &sope->mutex );
+
+	return( table );
+}
+
+static void
+backup_abort( sBackup *sope )
+{
+	g_mutex_lock( &sope->mutex );
+	sope->aborted = TRUE;
+	g_mutex_unlock( &sope->mutex );
+}
+
+/*
+ * worker thread
+ *
+ * Dump the structure and the datas of the table to a temporary file.
+ */
+static gboolean
+backup_dump_table( MYSQL *mysql, sTable *table )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_dump_table";
+	GError *error;
+	gint fd;
+	FILE *fp;
+	gchar *query;
+	MYSQL_RES *res;
+	MYSQL_ROW row;
+	gboolean ok;
+
+	error = NULL;
+	fd = g_file_open_tmp( "ofa-mysql-backup-XXXXXX.sql", &table->fname, &error );
+	if( fd < 0 ){
+		g_warning( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+		return( FALSE );
+	}
+
+	fp = fdopen( fd, "wb" );
+	if( !fp ){
+		g_warning( "%s: %s: %s", thisfn, table->fname, g_strerror( errno ));
+		close( fd );
+		return( FALSE );
+	}
+
+	ok = FALSE;
+	query = g_strdup_printf( "SHOW CREATE TABLE `%s`", table->name );
+
+	if( mysql_query( mysql, query ) != 0 ){
+		g_warning( "%s: %s: %s", thisfn, query, mysql_error( mysql ));
+
+	} else {
+		res = mysql_store_result( mysql );
+		row = res ? mysql_fetch_row( res ) : NULL;
+		if( row && row[1] ){
+			fprintf( fp, "\n%s%s\nDROP TABLE IF EXISTS `%s`;\n%s;\n", BACKUP_TABLE_PREFIX, table->name, table->name, row[1] );
+			ok = TRUE;
+		} else {
+			g_warning( "%s: %s: empty result", thisfn, query );
+		}
+		if( res ){
+			mysql_free_result( res );
+		}
+	}
+
+	g_free( query );
+
+	if( ok ){
+		ok = backup_dump_rows( mysql, table, fp );
+	}
+
+	if( ferror( fp ) != 0 ){
+		g_warning( "%s: %s: write error", thisfn, table->fname );
+		ok = FALSE;
+	}
+	if( fclose( fp ) != 0 ){
+		g_warning( "%s: %s: %s", thisfn, table->fname, g_strerror( errno ));
+		ok = FALSE;
+	}
+
+	return( ok );
+}
+
+/*
+ * Stream the rows from the server, writing multi-row INSERT statements
+ * of at most (about) BACKUP_MAX_STATEMENT bytes.
+ *
+ * Numeric columns are written as-is, while other columns are quoted
+ * with mysql_real_escape_string(), which also takes care of the binary
+ * datas. The escaped newlines guarantee that each INSERT statement is
+ * written on a single line.
+ */
+static gboolean
+backup_dump_rows( MYSQL *mysql, sTable *table, FILE *fp )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_dump_rows";
+	gchar *query, *escaped;
+	gsize escaped_size;
+	MYSQL_RES *res;
+	MYSQL_ROW row;
+	MYSQL_FIELD *fields;
+	unsigned long *lengths;
+	guint i, fields_count;
+	GString *stmt;
+	gulong len;
+	gboolean ok;
+
+	query = g_strdup_printf( "SELECT * FROM `%s`", table->name );
+	ok = ( mysql_query( mysql, query ) == 0 );
+
+	if( !ok ){
+		g_warning( "%s: %s: %s", thisfn, query, mysql_error( mysql ));
+		g_free( query );
+		return( FALSE );
+	}
+
+	res = mysql_use_result( mysql );
+	if( !res ){
+		g_warning( "%s: %s: %s", thisfn, query, mysql_error( mysql ));
+		g_free( query );
+		return( FALSE );
+	}
+
+	fields_count = mysql_num_fields( res );
+	fields = mysql_fetch_fields( res );
+	stmt = g_string_sized_new( BACKUP_MAX_STATEMENT+BACKUP_BUFSIZE );
+	escaped_size = 0;
+	escaped = NULL;
+
+	while(( row = mysql_fetch_row( res ))){
+		lengths = mysql_fetch_lengths( res );
+
+		if( stmt->len == 0 ){
+			g_string_printf( stmt, "INSERT INTO `%s` VALUES (", table->name );
+		} else {
+			g_string_append( stmt, ",(" );
+		}
+
+		for( i=0 ; i<fields_count ; ++i ){
+			if( i > 0 ){
+				g_string_append_c( stmt, ',' );
+			}
+			if( !row[i] ){
+				g_string_append( stmt, "NULL" );
+
+			} else if( IS_NUM( fields[i].type )){
+				g_string_append_len( stmt, row[i], lengths[i] );
+
+			} else {
+				if( escaped_size < 2*lengths[i]+1 ){
+					escaped_size = 2*lengths[i]+1;
+					escaped = g_realloc( escaped, escaped_size );
+				}
+				len = mysql_real_escape_string( mysql, escaped, row[i], lengths[i] );
+				g_string_append_c( stmt, '\'' );
+				g_string_append_len( stmt, escaped, len );
+				g_string_append_c( stmt, '\'' );
+			}
+		}
+
+		g_string_append_c( stmt, ')' );
+		table->rows += 1;
+
+		if( stmt->len >= BACKUP_MAX_STATEMENT ){
+			g_string_append( stmt, ";\n" );
+			fwrite( stmt->str, 1, stmt->len, fp );
+			g_string_truncate( stmt, 0 );
+		}
+	}
+
+	/* mysql_fetch_row() also returns NULL on error */
+	if( mysql_errno( mysql ) != 0 ){
+		g_warning( "%s: %s: %s", thisfn, query, mysql_error( mysql ));
+		ok = FALSE;
+
+	} else if( stmt->len > 0 ){
+		g_string_append( stmt, ";\n" );
+		fwrite( stmt->str, 1, stmt->len, fp );
+	}
+
+	mysql_free_result( res );
+	g_string_free( stmt, TRUE );
+	g_free( escaped );
+	g_free( query );
+
+	return( ok );
+}
+
+/*
+ * main thread
+ *
+ * Returns: %TRUE if the @table has been successfully dumped and
+ * streamed.
+ */
+static gboolean
+backup_on_table_done( sTable *table )
+{
+	sBackup *sope;
+	gchar *str;
+	gboolean ok;
+
+	sope = table->sope;
+	ok = table->ok;
+
+	if( ok ){
+		if( sope->msg_cb ){
+			str = g_strdup_printf( _( "-- Dumping data for table %s: %lu rows\n" ), table->name, table->rows );
+			sope->msg_cb( str, sope->user_data );
+			g_free( str );
+		}
+		ok = backup_stream_file( sope, table );
+
+	} else if( sope->msg_cb ){
+		str = g_strdup_printf( _( "-- Unable to dump table %s\n" ), table->name );
+		sope->msg_cb( str, sope->user_data );
+		g_free( str );
+	}
+
+	return( ok );
+}
+
+static void
+backup_free_worker( sWorker *worker )
+{
+	if( worker->mysql ){
+		mysql_close( worker->mysql );
+	}
+	g_free( worker );
+}
+
+static void
+backup_free_table( sTable *table )
+{
+	if( table->fname ){
+		g_remove( table->fname );
+		g_free( table->fname );
+	}
+	g_free( table->name );
+	g_free( table );
+}
+
+/**
+ * ofa_mysql_backup_restore_db_run:
+ * @connect: a #ofaMysqlConnect object which handles an opened superuser
+ *  connection on the DBMS server.
+ * @period: the #ofaMysqlExerciceMeta object which qualifies the target
+ *  exercice.
+ * @msg_cb: a callback for messages to be displayed.
+ * @data_cb: a callback which provides the archived datas.
+ * @user_data: user data to be provided to the callbacks.
+ * @native: [out]: set to %TRUE if the archive has been produced by
+ *  the native backup.
+ *
+ * Restores a native backup on the target database.
+ *
+ * The beginning of the datas is first examined: if the archive has not
+ * been produced by ofa_mysql_backup_db_run(), then @native is set to
+ * %FALSE and the target database is left unchanged, the caller being
+ * expected to fall back to the command-line restore.
+ *
+ * Else, the SQL script is executed statement by statement into a new
+ * temporary database, on a dedicated connection, by a worker thread.
+ * Only when the whole stream has been successfully applied, the
+ * restored tables replace those of the target database with a single
+ * (atomic) RENAME TABLE statement. The target database is so left
+ * unchanged if the archive cannot be read, is truncated, or if a
+ * statement fails.
+ *
+ * Both @msg_cb and @data_cb are only called from the main thread,
+ * which reads the archive and queues the buffers to the worker thread,
+ * and keeps running the main loop until the restore is complete.
+ *
+ * Returns: %TRUE if the archive has been successfully restored, %FALSE
+ * else.
+ */
+gboolean
+ofa_mysql_backup_restore_db_run( ofaMysqlConnect *connect, ofaMysqlExerciceMeta *period,
+									ofaMsgCb msg_cb, ofaDataCb data_cb, void *user_data, gboolean *native )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_db_run";
+	sRestore *sope;
+	gchar *buffer;
+	gssize count;
+	GThread *thread;
+	gboolean ok;
+
+	g_debug( "%s: connect=%p, period=%p, msg_cb=%p, data_cb=%p, user_data=%p, native=%p",
+			thisfn, ( void * ) connect, ( void * ) period,
+			( void * ) msg_cb, ( void * ) data_cb, user_data, ( void * ) native );
+
+	g_return_val_if_fail( connect && OFA_IS_MYSQL_CONNECT( connect ), FALSE );
+	g_return_val_if_fail( period && OFA_IS_MYSQL_EXERCICE_META( period ), FALSE );
+	g_return_val_if_fail( data_cb, FALSE );
+	g_return_val_if_fail( native, FALSE );
+
+	sope = g_new0( sRestore, 1 );
+	sope->cnx.host = ofa_mysql_connect_get_host( connect );
+	sope->cnx.port = ofa_mysql_connect_get_port( connect );
+	sope->cnx.socket = ofa_mysql_connect_get_socket( connect );
+	sope->cnx.account = ofa_idbconnect_get_account( OFA_IDBCONNECT( connect ));
+	sope->cnx.password = ofa_idbconnect_get_password( OFA_IDBCONNECT( connect ));
+	sope->database = ofa_mysql_exercice_meta_get_database( period );
+	sope->msg_cb = msg_cb;
+	sope->data_cb = data_cb;
+	sope->user_data = user_data;
+	sope->head = g_string_sized_new( BACKUP_BUFSIZE );
+
+	/* read enough datas to identify a native dump */
+	buffer = g_new( gchar, BACKUP_BUFSIZE );
+	while( sope->head->len < strlen( BACKUP_SIGNATURE )){
+		count = restore_read( sope, buffer, BACKUP_BUFSIZE );
+		if( count <= 0 ){
+			break;
+		}
+		g_string_append_len( sope->head, buffer, count );
+	}
+	g_free( buffer );
+
+	*native = g_str_has_prefix( sope->head->str, BACKUP_SIGNATURE );
+	ok = FALSE;
+
+	if( !*native ){
+		g_debug( "%s: not a native dump", thisfn );
+
+	} else if( restore_create_databases( connect, sope )){
+		sope->buffers = g_async_queue_new_full(( GDestroyNotify ) g_bytes_unref );
+		thread = g_thread_new( "ofa-mysql-restore", ( GThreadFunc ) restore_thread, sope );
+
+		restore_feed( sope );
+
+		/* iterate the main loop until the thread has terminated */
+		while( !sope->done ){
+			g_main_context_iteration( NULL, TRUE );
+		}
+
+		g_thread_join( thread );
+		g_async_queue_unref( sope->buffers );
+		ok = sope->ok;
+		g_debug( "%s: count=%lu statements", thisfn, sope->count );
+	}
+
+	restore_drop_databases( connect, sope );
+
+	g_string_free( sope->head, TRUE );
+	g_free( sope->tmp_database );
+	g_free( sope->old_database );
+	g_free( sope );
+
+	g_debug( "%s: returning %s", thisfn, ok ? "True":"False" );
+
+	return( ok );
+}
+
+/*
+ * main thread
+ *
+ * The archive returns a negative count on error
+ */
+static gssize
+restore_read( sRestore *sope, gchar *buffer, gsize bufsize )
+{
+	return(( gssize ) sope->data_cb( buffer, bufsize, sope->user_data ));
+}
+
+/*
+ * main thread
+ *
+ * Create the temporary database which receives the restored tables,
+ * the one which will receive the previous tables of the target, and
+ * the target database itself if it does not exist yet.
+ *
+ * @connect: must handle a superuser connection on the DBMS
+ */
+static gboolean
+restore_create_databases( ofaMysqlConnect *connect, sRestore *sope )
+{
+	gchar *query;
+	gboolean ok;
+
+	sope->tmp_database = ofa_mysql_connect_get_new_database( connect, sope->database );
+	sope->cnx.database = sope->tmp_database;
+	query = g_strdup_printf( "CREATE DATABASE %s CHARACTER SET utf8", sope->tmp_database );
+	ok = restore_create_database( connect, query, sope );
+	g_free( query );
+
+	if( ok ){
+		sope->old_database = ofa_mysql_connect_get_new_database( connect, sope->database );
+		query = g_strdup_printf( "CREATE DATABASE %s CHARACTER SET utf8", sope->old_database );
+		ok = restore_create_database( connect, query, sope );
+		g_free( query );
+	}
+
+	if( ok ){
+		query = g_strdup_printf( "CREATE DATABASE IF NOT EXISTS %s CHARACTER SET utf8", sope->database );
+		ok = restore_create_database( connect, query, sope );
+		g_free( query );
+	}
+
+	return( ok );
+}
+
+static gboolean
+restore_create_database( ofaMysqlConnect *connect, const gchar *query, sRestore *sope )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_create_database";
+	gchar *msgerr;
+	gboolean ok;
+
+	ok = ofa_mysql_connect_query( connect, query );
+
+	if( !ok ){
+		msgerr = ofa_idbconnect_get_last_error( OFA_IDBCONNECT( connect ));
+		g_warning( "%s: %s: %s", thisfn, query, msgerr );
+		if( sope->msg_cb ){
+			sope->msg_cb( msgerr, sope->user_data );
+		}
+		g_free( msgerr );
+	}
+
+	return( ok );
+}
+
+/*
+ * main thread
+ *
+ * Drop the temporary database, which is empty after a successful
+ * restore, and the one which has received the previous tables.
+ */
+static void
+restore_drop_databases( ofaMysqlConnect *connect, sRestore *sope )
+{
+	if( sope->tmp_database ){
+		ofa_mysql_connect_drop_database( connect, sope->tmp_database, NULL );
+	}
+	if( sope->old_database ){
+		ofa_mysql_connect_drop_database( connect, sope->old_database, NULL );
+	}
+}
+
+/*
+ * main thread
+ *
+ * Read the archive and queue the buffers to the worker thread, the
+ * already read head first, and an empty buffer at the end of the
+ * stream.
+ *
+ * At most RESTORE_MAX_BUFFERS buffers are queued: the main loop is
+ * iterated while waiting for the worker, which wakes it up after each
+ * consumed buffer. Reading stops as soon as the worker has terminated.
+ */
+static void
+restore_feed( sRestore *sope )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_feed";
+	gchar *buffer;
+	gssize count;
+
+	g_async_queue_push( sope->buffers, g_bytes_new( sope->head->str, sope->head->len ));
+	buffer = g_new( gchar, BACKUP_BUFSIZE );
+
+	while( !sope->done ){
+		if( g_async_queue_length( sope->buffers ) >= RESTORE_MAX_BUFFERS ){
+			g_main_context_iteration( NULL, TRUE );
+			continue;
+		}
+		count = restore_read( sope, buffer, BACKUP_BUFSIZE );
+		if( count < 0 ){
+			g_warning( "%s: unable to read the archive", thisfn );
+			sope->read_failed = TRUE;
+		}
+		if( count <= 0 ){
+			break;
+		}
+		g_async_queue_push( sope->buffers, g_bytes_new( buffer, count ));
+		g_main_context_iteration( NULL, FALSE );
+	}
+
+	g_async_queue_push( sope->buffers, g_bytes_new( NULL, 0 ));
+	g_free( buffer );
+}
+
+/*
+ * worker thread
+ */
+static gpointer
+restore_thread( sRestore *sope )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_thread";
+	MYSQL *mysql;
+	GBytes *bytes;
+	gconstpointer data;
+	gsize length;
+	gchar *msgerr;
+	gboolean ok;
+
+	mysql_thread_init();
+
+	msgerr = NULL;
+	mysql = cnx_open( &sope->cnx, &msgerr );
+
+	if( !mysql ){
+		g_warning( "%s: %s", thisfn, msgerr );
+		send_message( sope->msg_cb, sope->user_data, msgerr );
+
+	} else {
+		sope->stmt = g_string_sized_new( BACKUP_MAX_STATEMENT+BACKUP_BUFSIZE );
+		sope->comment = g_string_new( "" );
+		ok = TRUE;
+
+		while( ok ){
+			bytes = g_async_queue_pop( sope->buffers );
+			g_main_context_wakeup( NULL );
+			data = g_bytes_get_data( bytes, &length );
+			if( length == 0 ){
+				g_bytes_unref( bytes );
+				break;
+			}
+			ok = restore_parse( sope, mysql, data, length );
+			g_bytes_unref( bytes );
+		}
+
+		/* a truncated archive would not have the trailer */
+		if( ok && ( sope->read_failed || !sope->trailer_seen )){
+			g_warning( "%s: the archive is incomplete", thisfn );
+			send_message( sope->msg_cb, sope->user_data, g_strdup( _( "-- The archive is incomplete\n" )));
+			ok = FALSE;
+		}
+
+		if( ok ){
+			ok = restore_swap( sope, mysql );
+		}
+
+		sope->ok = ok;
+
+		g_string_free( sope->comment, TRUE );
+		g_string_free( sope->stmt, TRUE );
+		mysql_close( mysql );
+	}
+
+	mysql_thread_end();
+
+	g_idle_add(( GSourceFunc ) restore_on_done, sope );
+
+	return( NULL );
+}
+
+/*
+ * Split the SQL script into statements, taking care of the quoted
+ * strings and identifiers, and of the comment lines.
+ *
+ * Returns: %FALSE if a statement has failed.
+ */
+static gboolean
+restore_parse( sRestore *sope, MYSQL *mysql, const gchar *buffer, gsize length )
+{
+	gsize i;
+	gchar c;
+
+	for( i=0 ; i<length ; ++i ){
+		c = buffer[i];
+
+		if( sope->in_comment ){
+			if( c == '\n' ){
+				restore_on_comment( sope );
+				sope->in_comment = FALSE;
+				g_string_truncate( sope->comment, 0 );
+			} else {
+				g_string_append_c( sope->comment, c );
+			}
+
+		} else if( sope->quote ){
+			g_string_append_c( sope->stmt, c );
+			if( sope->escaped ){
+				sope->escaped = FALSE;
+			} else if( c == '\\' && sope->quote != '`' ){
+				sope->escaped = TRUE;
+			} else if( c == sope->quote ){
+				sope->quote = 0;
+			}
+
+		} else if( sope->stmt->len == 0 && g_ascii_isspace( c )){
+			continue;
+
+		} else if( c == '-' && sope->stmt->len == 1 && sope->stmt->str[0] == '-' ){
+			g_string_truncate( sope->stmt, 0 );
+			g_string_assign( sope->comment, "--" );
+			sope->in_comment = TRUE;
+
+		} else if( c == ';' ){
+			if( !restore_execute( sope, mysql )){
+				return( FALSE );
+			}
+			g_string_truncate( sope->stmt, 0 );
+
+		} else {
+			if( c == '\'' || c == '"' || c == '`' ){
+				sope->quote = c;
+			}
+			g_string_append_c( sope->stmt, c );
+		}
+	}
+
+	return( TRUE );
+}
+
+static gboolean
+restore_execute( sRestore *sope, MYSQL *mysql )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_execute";
+	gchar *msg;
+
+	if( mysql_real_query( mysql, sope->stmt->str, sope->stmt->len ) != 0 ){
+		msg = g_strdup_printf( "%s\n", mysql_error( mysql ));
+		g_warning( "%s: %s", thisfn, msg );
+		send_message( sope->msg_cb, sope->user_data, msg );
+		return( FALSE );
+	}
+
+	sope->count += 1;
+
+	return( TRUE );
+}
+
+static void
+restore_on_comment( sRestore *sope )
+{
+	if( g_str_has_prefix( sope->comment->str, BACKUP_TABLE_PREFIX )){
+		send_message( sope->msg_cb, sope->user_data,
+				g_strdup_printf( _( "-- Restoring data for table %s\n" ),
+						sope->comment->str+strlen( BACKUP_TABLE_PREFIX )));
+
+	} else if( g_str_has_prefix( sope->comment->str, BACKUP_TRAILER )){
+		sope->trailer_seen = TRUE;
+	}
+}
+
+/*
+ * worker thread
+ *
+ * Move the previous tables of the target database to the old database,
+ * and the restored tables to the target database, in a single atomic
+ * statement.
+ */
+static gboolean
+restore_swap( sRestore *sope, MYSQL *mysql )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_swap";
+	GString *rename;
+	gchar *query, *msg;
+	gboolean ok;
+
+	rename = g_string_new( RESTORE_RENAME );
+	query = g_strdup_printf( "SHOW TABLES FROM `%s`", sope->database );
+
+	ok = restore_list_renames( mysql, query, sope->database, sope->old_database, rename ) &&
+			restore_list_renames( mysql, "SHOW TABLES", sope->tmp_database, sope->database, rename );
+
+	g_free( query );
+
+	if( ok && rename->len > strlen( RESTORE_RENAME )){
+		send_message( sope->msg_cb, sope->user_data,
+				g_strdup_printf( _( "-- Replacing the tables of %s\n" ), sope->database ));
+
+		if( mysql_real_query( mysql, rename->str, rename->len ) != 0 ){
+			msg = g_strdup_printf( "%s\n", mysql_error( mysql ));
+			g_warning( "%s: %s", thisfn, msg );
+			send_message( sope->msg_cb, sope->user_data, msg );
+			ok = FALSE;
+		}
+	}
+
+	g_string_free( rename, TRUE );
+
+	return( ok );
+}
+
+/*
+ * Append to @rename the renaming of each table listed by @query from
+ * the @from database to the @to database.
+ */
+static gboolean
+restore_list_renames( MYSQL *mysql, const gchar *query, const gchar *from, const gchar *to, GString *rename )
+{
+	static const gchar *thisfn = "ofa_mysql_backup_restore_list_renames";
+	MYSQL_RES *res;
+	MYSQL_ROW row;
+
+	res = NULL;
+	if( mysql_query( mysql, query ) != 0 || !( res = mysql_store_result( mysql ))){
+		g_warning( "%s: %s: %s", thisfn, query, mysql_error( mysql ));
+		return( FALSE );
+	}
+
+	while(( row = mysql_fetch_row( res ))){
+		g_string_append_printf( rename, "%s`%s`.`%s` TO `%s`.`%s`",
+				rename->len > strlen( RESTORE_RENAME ) ? "," : "", from, row[0], to, row[0] );
+	}
+
+	mysql_free_result( res );
+
+	return( TRUE );
+}
+
+/*
+ * main thread
+ */
+static gboolean
+restore_on_done( sRestore *sope )
+{
+	sope->done = TRUE;
+
+	return( G_SOURCE_REMOVE );
+}
+
+/*
+ * Have the message displayed from the main thread.
+ * Takes the ownership of @msg.
+ */
+static void
+send_message( ofaMsgCb msg_cb, void *user_data, gchar *msg )
+{
+	sMessage *smsg;
+
+	if( msg_cb ){
+		smsg = g_new0( sMessage, 1 );
+		smsg->msg_cb = msg_cb;
+		smsg->user_data = user_data;
+		smsg->msg = msg;
+		g_idle_add(( GSourceFunc ) on_message, smsg );
+
+	} else {
+		g_free( msg );
+	}
+}
+
+static gboolean
+on_message( sMessage *smsg )
+{
+	smsg->msg_cb( smsg->msg, smsg->user_data );
+
+	g_free( smsg->msg );
+	g_free( smsg );
+
+	return( G_SOURCE_REMOVE );
+}
@@ -0,0 +1,63 @@
+/*
+ * Open Firm Accounting
+ * A double-entry accounting application for professional services.
+ *
+ * Copyright (C) 2014-2020 Pierre Wieser (see AUTHORS)
+ *
+ * Open Firm Accounting is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * Open Firm Accounting is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Open Firm Accounting; see the file COPYING. If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Pierre Wieser <pwieser@trychlos.org>
+ */
+
+#ifndef __OFA_MYSQL_BACKUP_H__
+#define __OFA_MYSQL_BACKUP_H__
+
+/**
+ * SECTION: ofa_mysql_backup
+ * @short_description: Native backup and restore of a MySQL database.
+ *
+ * The native backup streams each table through the client library
+ * with mysql_use_result(), several tables being dumped in parallel
+ * over dedicated connections. The produced stream is a plain SQL
+ * script, made of multi-row INSERTs, so that it can also be restored
+ * with the mysql command-line client.
+ *
+ * The native restore is only able to load a stream produced by the
+ * native backup. Other archives are left to the command-line.
+ */
+
+#include "api/ofa-hub-def.h"
+
+#include "mysql/ofa-mysql-connect.h"
+#include "mysql/ofa-mysql-exercice-meta.h"
+
+G_BEGIN_DECLS
+
+gboolean ofa_mysql_backup_db_run        ( ofaMysqlConnect *connect,
+												ofaMsgCb msg_cb,
+												ofaDataCb data_cb,
+												void *user_data );
+
+gboolean ofa_mysql_backup_restore_db_run( ofaMysqlConnect *connect,
+												ofaMysqlExerciceMeta *period,
+												ofaMsgCb msg_cb,
+												ofaDataCb data_cb,
+												void *user_data,
+												gboolean *native );
+
+G_END_DECLS
+
+#endif /* __OFA_MYSQL_BACKUP_H__ */
@@ -29,18 +29,23 @@
 #include <glib/gi18n.h>
 #include <mysql/mysql.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "my/my-double.h"
 #include "my/my-utils.h"
 
+#include "api/ofa-backup-header.h"
 #include "api/ofa-idbconnect.h"
 #include "api/ofa-idbdossier-meta.h"
 #include "api/ofa-idbexercice-meta.h"
 #include "api/ofa-idbprovider.h"
 #include "api/ofa-idbsuperuser.h"
 
+#include "mysql/ofa-mysql-backup.h"
 #include "mysql/ofa-mysql-cmdline.h"
 #include "mysql/ofa-mysql-connect.h"
 #include "mysql/ofa-mysql-connect-display.h"
+#include "mysql/ofa-mysql-user-prefs.h"
 
 /* priv instance data
  */
@@ -54,9 +59,25 @@ typedef struct {
 	guint               port;
 	gchar              *socket;
 	gchar              *database;
+
+	/* prepared statements
+	 */
+	GHashTable         *statements;
+	gchar              *stmt_error;
 }
 	ofaMysqlConnectPrivate;
 
+/* MySQL 8 has replaced my_bool with the standard bool type
+ */
+#if !defined( MARIADB_BASE_VERSION ) && MYSQL_VERSION_ID >= 80001
+typedef bool my_bool;
+#endif
+
+/* the initial size of a column buffer when fetching a prepared statement
+ * result set; larger values are fetched again with the right size
+ */
+#define STMT_COLUMN_MIN_SIZE             64
+
 static gboolean   open_connection( ofaMysqlConnect *self, const gchar *account, const gchar *password, const gchar *host, guint port, const gchar *socket, const gchar *database, gchar **msg );
 static gboolean   does_dbname_exist( ofaMysqlConnect *self, const gchar *dbname );
 static gchar     *find_new_dbname( ofaMysqlConnect *self, const gchar *prev_database );
@@ -81,6 +102,14 @@ static gboolean   idbconnect_grant_user( const ofaIDBConnect *instance, const of
 static gboolean   idbconnect_transaction_start( const ofaIDBConnect *instance );
 static gboolean   idbconnect_transaction_cancel( const ofaIDBConnect *instance );
 static gboolean   idbconnect_transaction_commit( const ofaIDBConnect *instance );
+static gboolean   idbconnect_execute( const ofaIDBConnect *instance, const gchar *query, const ofsIDBParam *params, guint count, GSList **result );
+static void       idbconnect_thread_init( const ofaIDBConnect *instance );
+static void       idbconnect_thread_end( const ofaIDBConnect *instance );
+static MYSQL_STMT *stmt_get( ofaMysqlConnect *self, const gchar *query );
+static void       stmt_drop( ofaMysqlConnect *self, const gchar *query );
+static void       stmt_set_error( ofaMysqlConnect *self, const gchar *message );
+static gboolean   stmt_bind_params( MYSQL_STMT *stmt, const ofsIDBParam *params, guint count, MYSQL_TIME *times, unsigned long *lengths, gchar **strings );
+static gboolean   stmt_fetch_result( MYSQL_STMT *stmt, GSList **result );
 
 G_DEFINE_TYPE_EXTENDED( ofaMysqlConnect, ofa_mysql_connect, G_TYPE_OBJECT, 0,
 		G_ADD_PRIVATE( ofaMysqlConnect )
@@ -689,6 +718,15 @@ clear_datas( ofaMysqlConnect *self )
 
 	priv = ofa_mysql_connect_get_instance_private( self );
 
+	/* prepared statements must be closed before the connection */
+	if( priv->statements ){
+		g_hash_table_destroy( priv->statements );
+		priv->statements = NULL;
+	}
+
+	g_free( priv->stmt_error );
+	priv->stmt_error = NULL;
+
 	if( priv->mysql ){
 		mysql_close( priv->mysql );
 		g_free( priv->mysql );
@@ -734,12 +772,15 @@ idbconnect_iface_init( ofaIDBConnectInterface *iface )
 	iface->transaction_start = idbconnect_transaction_start;
 	iface->transaction_cancel = idbconnect_transaction_cancel;
 	iface->transaction_commit = idbconnect_transaction_commit;
+	iface->execute = idbconnect_execute;
+	iface->thread_init = idbconnect_thread_init;
+	iface->thread_end = idbconnect_thread_end;
 }
 
 static guint
 idbconnect_get_interface_version( void )
 {
-	return( 1 );
+	return( 2 );
 }
 
 /*
@@ -849,6 +890,8 @@ idbconnect_query( const ofaIDBConnect *instance, const gchar *query )
 
 	priv = ofa_mysql_connect_get_instance_private( OFA_MYSQL_CONNECT( instance ));
 
+	stmt_set_error( OFA_MYSQL_CONNECT( instance ), NULL );
+
 	ok = ( mysql_query( priv->mysql, query ) == 0 );
 
 	return( ok );
@@ -898,7 +941,7 @@ idbconnect_get_last_error( const ofaIDBConnect *instance )
 	gchar *msg;
 
 	priv = ofa_mysql_connect_get_instance_private( OFA_MYSQL_CONNECT( instance ));
-	msg = g_strdup( mysql_error( priv->mysql ));
+	msg = g_strdup( priv->stmt_error ? priv->stmt_error : mysql_error( priv->mysql ));
 
 	return( msg );
 }
@@ -907,20 +950,49 @@ static gboolean
 idbconnect_backup_db( const ofaIDBConnect *instance, const gchar *uri, ofaMsgCb msg_cb, ofaDataCb data_cb, void *user_data )
 {
 	static const gchar *thisfn = "ofa_mysql_connect_idbconnect_backup_db";
+	ofaIDBDossierMeta *dossier_meta;
+	ofaIDBProvider *provider;
+	ofaIGetter *getter;
 
 	g_debug( "%s: instance=%p (%s), msg_cb=%p, data_cb=%p, user_data=%p",
 			thisfn, ( void * ) instance, G_OBJECT_TYPE_NAME( instance ),
 			( void * ) msg_cb, ( void * ) data_cb, ( void * ) user_data );
 
-	return( ofa_mysql_cmdline_backup_db_run( OFA_MYSQL_CONNECT( instance ), uri, msg_cb, data_cb, user_data ));
+	dossier_meta = ofa_idbconnect_get_dossier_meta( instance );
+	provider = ofa_idbdossier_meta_get_provider( dossier_meta );
+	getter = ofa_idbprovider_get_getter( provider );
+
+	if( ofa_mysql_user_prefs_get_backup_use_cmdline( getter )){
+		return( ofa_mysql_cmdline_backup_db_run( OFA_MYSQL_CONNECT( instance ), uri, msg_cb, data_cb, user_data ));
+	}
+
+	return( ofa_mysql_backup_db_run( OFA_MYSQL_CONNECT( instance ), msg_cb, data_cb, user_data ));
 }
 
+/*
+ * Archives produced by the native backup are restored natively,
+ * while other archives are left to the restore command-line.
+ */
 static gboolean
 idbconnect_restore_db( const ofaIDBConnect *instance,
 				const ofaIDBExerciceMeta *period, const gchar *uri, guint format, ofaMsgCb msg_cb, ofaDataCb data_cb, void *user_data )
 {
-	return( ofa_mysql_cmdline_restore_db_run(
-					OFA_MYSQL_CONNECT( instance ), OFA_MYSQL_EXERCICE_META( period ), uri, format, msg_cb, data_cb, user_data ));
+	gboolean ok, native;
+
+	ok = FALSE;
+	native = FALSE;
+
+	if( format == OFA_BACKUP_HEADER_ZIP ){
+		ok = ofa_mysql_backup_restore_db_run(
+					OFA_MYSQL_CONNECT( instance ), OFA_MYSQL_EXERCICE_META( period ), msg_cb, data_cb, user_data, &native );
+	}
+
+	if( !native ){
+		ok = ofa_mysql_cmdline_restore_db_run(
+					OFA_MYSQL_CONNECT( instance ), OFA_MYSQL_EXERCICE_META( period ), uri, format, msg_cb, data_cb, user_data );
+	}
+
+	return( ok );
 }
 
 
@@ -1119,3 +1191,320 @@ idbconnect_transaction_commit( const ofaIDBConnect *instance )
 
 	return( ok );
 }
+
+/*
+ * @instance: a user connection on the DBMS server
+ *
+ * Execute a prepared statement, preparing it on first use.
+ */
+static gboolean
+idbconnect_execute( const ofaIDBConnect *instance, const gchar *query, const ofsIDBParam *params, guint count, GSList **result )
+{
+	static const gchar *thisfn = "ofa_mysql_connect_idbconnect_execute";
+	ofaMysqlConnect *self;
+	MYSQL_STMT *stmt;
+	MYSQL_TIME *times;
+	unsigned long *lengths;
+	gchar **strings;
+	gboolean ok;
+
+	g_return_val_if_fail( instance && OFA_IS_MYSQL_CONNECT( instance ), FALSE );
+
+	self = OFA_MYSQL_CONNECT( instance );
+	stmt_set_error( self, NULL );
+
+	if( result ){
+		*result = NULL;
+	}
+
+	stmt = stmt_get( self, query );
+	if( !stmt ){
+		return( FALSE );
+	}
+
+	if( mysql_stmt_param_count( stmt ) != count ){
+		g_warning( "%s: query='%s' expects %lu parameters, while %u have been bound",
+				thisfn, query, mysql_stmt_param_count( stmt ), count );
+		stmt_set_error( self, _( "Invalid count of bound parameters" ));
+		return( FALSE );
+	}
+
+	/* MySQL keeps pointers to the bound buffers, which are read at
+	 * execution time */
+	times = count ? g_new0( MYSQL_TIME, count ) : NULL;
+	lengths = count ? g_new0( unsigned long, count ) : NULL;
+	strings = g_new0( gchar *, count+1 );
+
+	ok = stmt_bind_params( stmt, params, count, times, lengths, strings ) &&
+			mysql_stmt_execute( stmt ) == 0 &&
+			( !result || stmt_fetch_result( stmt, result ));
+
+	g_free( times );
+	g_free( lengths );
+	g_strfreev( strings );
+
+	if( !ok ){
+		/* the error must be saved before the statement be closed */
+		stmt_set_error( self, mysql_stmt_error( stmt ));
+		stmt_drop( self, query );
+		if( result ){
+			ofa_idbconnect_free_results( *result );
+			*result = NULL;
+		}
+	}
+
+	return( ok );
+}
+
+/*
+ * libmysqlclient requires each thread, other than the main one, to
+ * initialize and release its own thread-specific data
+ */
+static void
+idbconnect_thread_init( const ofaIDBConnect *instance )
+{
+	mysql_thread_init();
+}
+
+static void
+idbconnect_thread_end( const ofaIDBConnect *instance )
+{
+	mysql_thread_end();
+}
+
+/*
+ * Returns: the cached prepared statement for @query, preparing it if
+ * needed, or %NULL on error.
+ */
+static MYSQL_STMT *
+stmt_get( ofaMysqlConnect *self, const gchar *query )
+{
+	ofaMysqlConnectPrivate *priv;
+	MYSQL_STMT *stmt;
+
+	priv = ofa_mysql_connect_get_instance_private( self );
+
+	if( !priv->statements ){
+		priv->statements = g_hash_table_new_full(
+				g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) mysql_stmt_close );
+	}
+
+	stmt = ( MYSQL_STMT * ) g_hash_table_lookup( priv->statements, query );
+
+	if( !stmt ){
+		stmt = mysql_stmt_init( priv->mysql );
+		if( !stmt ){
+			stmt_set_error( self, mysql_error( priv->mysql ));
+			return( NULL );
+		}
+		if( mysql_stmt_prepare( stmt, query, strlen( query )) != 0 ){
+			stmt_set_error( self, mysql_stmt_error( stmt ));
+			mysql_stmt_close( stmt );
+			return( NULL );
+		}
+		g_hash_table_insert( priv->statements, g_strdup( query ), stmt );
+	}
+
+	return( stmt );
+}
+
+static void
+stmt_drop( ofaMysqlConnect *self, const gchar *query )
+{
+	ofaMysqlConnectPrivate *priv;
+
+	priv = ofa_mysql_connect_get_instance_private( self );
+
+	if( priv->statements ){
+		g_hash_table_remove( priv->statements, query );
+	}
+}
+
+static void
+stmt_set_error( ofaMysqlConnect *self, const gchar *message )
+{
+	ofaMysqlConnectPrivate *priv;
+
+	priv = ofa_mysql_connect_get_instance_private( self );
+
+	g_free( priv->stmt_error );
+	priv->stmt_error = g_strdup( message );
+}
+
+/*
+ * @times, @lengths, @strings: arrays of @count items, which must stay
+ *  valid until the statement be executed; @strings is a NULL-terminated
+ *  array which receives the newly allocated amount strings.
+ *
+ * Amounts are sent as DECIMAL strings with their count of decimal
+ * digits, so that the DBMS does not see a rounded binary double.
+ */
+static gboolean
+stmt_bind_params( MYSQL_STMT *stmt, const ofsIDBParam *params, guint count, MYSQL_TIME *times, unsigned long *lengths, gchar **strings )
+{
+	MYSQL_BIND *binds;
+	gboolean ok;
+	guint i, n;
+
+	if( count == 0 ){
+		return( TRUE );
+	}
+
+	binds = g_new0( MYSQL_BIND, count );
+	n = 0;
+
+	for( i=0 ; i<count ; ++i ){
+		switch( params[i].type ){
+			case OFA_IDBPARAM_STRING:
+				lengths[i] = strlen( params[i].string );
+				binds[i].buffer_type = MYSQL_TYPE_STRING;
+				binds[i].buffer = params[i].string;
+				binds[i].buffer_length = lengths[i];
+				binds[i].length = &lengths[i];
+				break;
+
+			case OFA_IDBPARAM_INTEGER:
+				binds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+				binds[i].buffer = ( void * ) &params[i].integer;
+				break;
+
+			case OFA_IDBPARAM_AMOUNT:
+				strings[n] = my_double_to_sql_ex( params[i].amount, params[i].digits );
+				lengths[i] = strlen( strings[n] );
+				binds[i].buffer_type = MYSQL_TYPE_NEWDECIMAL;
+				binds[i].buffer = strings[n];
+				binds[i].buffer_length = lengths[i];
+				binds[i].length = &lengths[i];
+				n += 1;
+				break;
+
+			case OFA_IDBPARAM_DATE:
+				times[i].year = g_date_get_year( &params[i].date );
+				times[i].month = g_date_get_month( &params[i].date );
+				times[i].day = g_date_get_day( &params[i].date );
+				times[i].time_type = MYSQL_TIMESTAMP_DATE;
+				binds[i].buffer_type = MYSQL_TYPE_DATE;
+				binds[i].buffer = &times[i];
+				break;
+
+			case OFA_IDBPARAM_STAMP:
+				times[i].year = g_date_time_get_year( params[i].stamp );
+				times[i].month = g_date_time_get_month( params[i].stamp );
+				times[i].day = g_date_time_get_day_of_month( params[i].stamp );
+				times[i].hour = g_date_time_get_hour( params[i].stamp );
+				times[i].minute = g_date_time_get_minute( params[i].stamp );
+				times[i].second = g_date_time_get_second( params[i].stamp );
+				times[i].time_type = MYSQL_TIMESTAMP_DATETIME;
+				binds[i].buffer_type = MYSQL_TYPE_DATETIME;
+				binds[i].buffer = &times[i];
+				break;
+
+			default:
+				binds[i].buffer_type = MYSQL_TYPE_NULL;
+				break;
+		}
+	}
+
+	/* the MYSQL_BIND array itself is copied by MySQL */
+	ok = ( mysql_stmt_bind_param( stmt, binds ) == 0 );
+
+	g_free( binds );
+
+	return( ok );
+}
+
+/*
+ * Fetch the result set of an executed statement as a GSList of rows,
+ * each row being a GSList of string columns, as does query_ex().
+ *
+ * Columns are first fetched in a small buffer, and fetched again with
+ * the right size when they happen to be truncated.
+ */
+static gboolean
+stmt_fetch_result( MYSQL_STMT *stmt, GSList **result )
+{
+	MYSQL_RES *meta;
+	MYSQL_FIELD *fields;
+	MYSQL_BIND *binds;
+	MYSQL_BIND big;
+	unsigned long *lengths;
+	my_bool *nulls, update_max;
+	gchar **buffers, *value;
+	GSList *col;
+	guint fields_count, i;
+	gulong size;
+	gint rc;
+	gboolean ok;
+
+	meta = mysql_stmt_result_metadata( stmt );
+	if( !meta ){
+		return( TRUE );
+	}
+
+	update_max = 1;
+	mysql_stmt_attr_set( stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &update_max );
+
+	ok = ( mysql_stmt_store_result( stmt ) == 0 );
+
+	if( ok ){
+		fields_count = mysql_num_fields( meta );
+		fields = mysql_fetch_fields( meta );
+		binds = g_new0( MYSQL_BIND, fields_count );
+		buffers = g_new0( gchar *, fields_count );
+		lengths = g_new0( unsigned long, fields_count );
+		nulls = g_new0( my_bool, fields_count );
+
+		for( i=0 ; i<fields_count ; ++i ){
+			size = MAX( fields[i].max_length, STMT_COLUMN_MIN_SIZE )+1;
+			buffers[i] = g_malloc( size );
+			binds[i].buffer_type = MYSQL_TYPE_STRING;
+			binds[i].buffer = buffers[i];
+			binds[i].buffer_length = size;
+			binds[i].length = &lengths[i];
+			binds[i].is_null = &nulls[i];
+		}
+
+		ok = ( mysql_stmt_bind_result( stmt, binds ) == 0 );
+
+		while( ok ){
+			rc = mysql_stmt_fetch( stmt );
+			if( rc != 0 && rc != MYSQL_DATA_TRUNCATED ){
+				ok = ( rc == MYSQL_NO_DATA );
+				break;
+			}
+			col = NULL;
+			for( i=0 ; i<fields_count ; ++i ){
+				if( nulls[i] ){
+					value = NULL;
+				} else if( lengths[i] < binds[i].buffer_length ){
+					value = g_strndup( buffers[i], lengths[i] );
+				} else {
+					memset( &big, '\0', sizeof( big ));
+					value = g_malloc0( lengths[i]+1 );
+					big.buffer_type = MYSQL_TYPE_STRING;
+					big.buffer = value;
+					big.buffer_length = lengths[i]+1;
+					mysql_stmt_fetch_column( stmt, &big, i, 0 );
+				}
+				col = g_slist_prepend( col, value );
+			}
+			col = g_slist_reverse( col );
+			*result = g_slist_prepend( *result, col );
+		}
+		*result = g_slist_reverse( *result );
+
+		mysql_stmt_free_result( stmt );
+
+		for( i=0 ; i<fields_count ; ++i ){
+			g_free( buffers[i] );
+		}
+		g_free( buffers );
+		g_free( lengths );
+		g_free( nulls );
+		g_free( binds );
+	}
+
+	mysql_free_result( meta );
+
+	return( ok );
+}
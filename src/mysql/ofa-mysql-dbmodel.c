@@ -93,12 +93,15 @@ static void     iident_iface_init( myIIdentInterface *iface );
 static gchar   *iident_get_canon_name( const myIIdent *instance, void *user_data );
 static gchar   *iident_get_version( const myIIdent *instance, void *user_data );
 static void     idbmodel_iface_init( ofaIDBModelInterface *iface );
+static guint    idbmodel_get_interface_version( void );
 static guint    idbmodel_get_current_version( const ofaIDBModel *instance, const ofaIDBConnect *connect );
 static guint    idbmodel_get_last_version( const ofaIDBModel *instance, const ofaIDBConnect *connect );
+static const gchar *idbmodel_get_version_table( const ofaIDBModel *instance );
 static guint    get_last_version( void );
 static gboolean idbmodel_ddl_update( ofaIDBModel *instance, ofaIGetter *getter, myIProgress *window );
 static gboolean upgrade_to( ofaMysqlDBModel *self, sMigration *smig );
 static gboolean exec_query( ofaMysqlDBModel *self, const gchar *query );
+static gboolean exec_create_index( ofaMysqlDBModel *self, const gchar *table, const gchar *index, const gchar *columns );
 static gboolean version_begin( ofaMysqlDBModel *self, gint version );
 static gboolean version_end( ofaMysqlDBModel *self, gint version );
 static gboolean dbmodel_v20( ofaMysqlDBModel *self, gint version );
@@ -143,6 +146,10 @@ static gboolean dbmodel_v39( ofaMysqlDBModel *self, gint version );
 static gulong   count_v39( ofaMysqlDBModel *self );
 static gboolean dbmodel_v40( ofaMysqlDBModel *self, gint version );
 static gulong   count_v40( ofaMysqlDBModel *self );
+static gboolean dbmodel_v41( ofaMysqlDBModel *self, gint version );
+static gulong   count_v41( ofaMysqlDBModel *self );
+static gboolean dbmodel_v42( ofaMysqlDBModel *self, gint version );
+static gulong   count_v42( ofaMysqlDBModel *self );
 
 static sMigration st_migrates[] = {
 		{ 20, dbmodel_v20, count_v20 },
@@ -166,6 +173,8 @@ static sMigration st_migrates[] = {
 		{ 38, dbmodel_v38, count_v38 },
 		{ 39, dbmodel_v39, count_v39 },
 		{ 40, dbmodel_v40, count_v40 },
+		{ 41, dbmodel_v41, count_v41 },
+		{ 42, dbmodel_v42, count_v42 },
 		{ 0 }
 };
 
@@ -283,11 +292,22 @@ idbmodel_iface_init( ofaIDBModelInterface *iface )
 
 	g_debug( "%s: iface=%p", thisfn, ( void * ) iface );
 
+	iface->get_interface_version = idbmodel_get_interface_version;
 	iface->get_current_version = idbmodel_get_current_version;
 	iface->get_last_version = idbmodel_get_last_version;
+	iface->get_version_table = idbmodel_get_version_table;
 	iface->ddl_update = idbmodel_ddl_update;
 }
 
+/*
+ * the version of the #ofaIDBModel interface implemented by the module
+ */
+static guint
+idbmodel_get_interface_version( void )
+{
+	return( 2 );
+}
+
 static guint
 idbmodel_get_current_version( const ofaIDBModel *instance, const ofaIDBConnect *connect )
 {
@@ -306,6 +326,12 @@ idbmodel_get_last_version( const ofaIDBModel *instance, const ofaIDBConnect *con
 	return( get_last_version());
 }
 
+static const gchar *
+idbmodel_get_version_table( const ofaIDBModel *instance )
+{
+	return( "OFA_T_VERSION" );
+}
+
 static guint
 get_last_version( void )
 {
@@ -432,6 +458,43 @@ exec_query( ofaMysqlDBModel *self, const gchar *query )
 	return( ok );
 }
 
+/*
+ * MySQL does not know about 'CREATE INDEX IF NOT EXISTS': check first
+ * that the index does not exist yet, so that the migration may be
+ * safely re-run
+ */
+static gboolean
+exec_create_index( ofaMysqlDBModel *self, const gchar *table, const gchar *index, const gchar *columns )
+{
+	ofaMysqlDBModelPrivate *priv;
+	gchar *query;
+	gint count;
+	gboolean ok;
+
+	priv = ofa_mysql_dbmodel_get_instance_private( self );
+
+	query = g_strdup_printf(
+			"SELECT COUNT(*) FROM information_schema.STATISTICS "
+			"	WHERE TABLE_SCHEMA=DATABASE() AND TABLE_NAME='%s' AND INDEX_NAME='%s'",
+			table, index );
+	ok = ofa_idbconnect_query_int( priv->connect, query, &count, TRUE );
+	g_free( query );
+
+	if( ok ){
+		if( count > 0 ){
+			priv->current += 1;
+			my_iprogress_pulse( priv->window, self, priv->current, priv->total );
+
+		} else {
+			query = g_strdup_printf( "CREATE INDEX %s ON %s (%s)", index, table, columns );
+			ok = exec_query( self, query );
+			g_free( query );
+		}
+	}
+
+	return( ok );
+}
+
 static gboolean
 version_begin( ofaMysqlDBModel *self, gint version )
 {
@@ -3070,3 +3133,131 @@ count_v40( ofaMysqlDBModel *self )
 {
 	return( 1 );
 }
+
+/*
+ * ofa_ddl_update_dbmodel_v41:
+ *
+ * - OFA_T_ENTRIES: add secondary indexes on the columns used as
+ *   selection criteria (account, ledger, operation, settlement, period)
+ * - OFA_T_BAT_LINES: add secondary indexes on BAT identifier and
+ *   effect date
+ * - OFA_T_CONCIL_IDS: add a secondary index on (type,other) as the
+ *   reconciliation group is most often searched from the entry or the
+ *   BAT line
+ */
+static gboolean
+dbmodel_v41( ofaMysqlDBModel *self, gint version )
+{
+	static const gchar *thisfn = "ofa_ddl_update_dbmodel_v41";
+
+	g_debug( "%s: self=%p, version=%d", thisfn, ( void * ) self, version );
+
+	/* 1. account balances, account books, use_account() */
+	if( !exec_create_index( self, "OFA_T_ENTRIES", "ENT_ACCOUNT_DEFFECT", "ENT_ACCOUNT,ENT_DEFFECT" )){
+		return( FALSE );
+	}
+
+	/* 2. ledger books, ledger last entry, use_ledger() */
+	if( !exec_create_index( self, "OFA_T_ENTRIES", "ENT_LEDGER_DEFFECT", "ENT_LEDGER,ENT_DEFFECT" )){
+		return( FALSE );
+	}
+
+	/* 3. operation number validation */
+	if( !exec_create_index( self, "OFA_T_ENTRIES", "ENT_OPE_NUMBER", "ENT_OPE_NUMBER" )){
+		return( FALSE );
+	}
+
+	/* 4. settlement groups */
+	if( !exec_create_index( self, "OFA_T_ENTRIES", "ENT_STLMT_NUMBER", "ENT_STLMT_NUMBER" )){
+		return( FALSE );
+	}
+
+	/* 5. period and status selections (closings, balances) */
+	if( !exec_create_index( self, "OFA_T_ENTRIES", "ENT_IPERIOD_STATUS", "ENT_IPERIOD,ENT_STATUS" )){
+		return( FALSE );
+	}
+
+	/* 6. lines of a BAT file */
+	if( !exec_create_index( self, "OFA_T_BAT_LINES", "BAT_ID", "BAT_ID" )){
+		return( FALSE );
+	}
+
+	/* 7. BAT lines by effect date */
+	if( !exec_create_index( self, "OFA_T_BAT_LINES", "BAT_LINE_DEFFECT", "BAT_LINE_DEFFECT" )){
+		return( FALSE );
+	}
+
+	/* 8. reconciliation group of an entry or a BAT line */
+	if( !exec_create_index( self, "OFA_T_CONCIL_IDS", "REC_IDS_TYPE_OTHER", "REC_IDS_TYPE,REC_IDS_OTHER" )){
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * returns the count of queries in the dbmodel_vxx
+ * to be used as the progression indicator
+ */
+static gulong
+count_v41( ofaMysqlDBModel *self )
+{
+	return( 8 );
+}
+
+/*
+ * ofa_ddl_update_dbmodel_v42:
+ *
+ * - OFA_T_LEDGERS_MONTHS: the per-month balances of the non-deleted
+ *   entries of each ledger and currency, so that the balances between
+ *   two effect dates do not have to re-aggregate all the entries
+ */
+static gboolean
+dbmodel_v42( ofaMysqlDBModel *self, gint version )
+{
+	static const gchar *thisfn = "ofa_ddl_update_dbmodel_v42";
+
+	g_debug( "%s: self=%p, version=%d", thisfn, ( void * ) self, version );
+
+	/* 1. create LedgersMonths table */
+	if( !exec_query( self,
+			"CREATE TABLE IF NOT EXISTS OFA_T_LEDGERS_MONTHS ("
+			"	LED_MNEMO           VARCHAR(64)    BINARY NOT NULL   COMMENT 'Ledger identifier',"
+			"	LED_CUR_CODE        VARCHAR(3)            NOT NULL   COMMENT 'ISO 3A identifier of the currency',"
+			"	LED_MONTH           DATE                  NOT NULL   COMMENT 'First day of the effect month',"
+			"	LED_MONTH_DEBIT     DECIMAL(20,5)         NOT NULL DEFAULT 0 COMMENT 'Sum of the debits of the month',"
+			"	LED_MONTH_CREDIT    DECIMAL(20,5)         NOT NULL DEFAULT 0 COMMENT 'Sum of the credits of the month',"
+			"	CONSTRAINT PRIMARY KEY (LED_MNEMO,LED_CUR_CODE,LED_MONTH)"
+			") CHARACTER SET utf8" )){
+		return( FALSE );
+	}
+
+	/* 2. (re)initialize it from the existing entries */
+	if( !exec_query( self,
+			"DELETE FROM OFA_T_LEDGERS_MONTHS" )){
+		return( FALSE );
+	}
+
+	/* 3. the deleted entries are not counted */
+	if( !exec_query( self,
+			"INSERT INTO OFA_T_LEDGERS_MONTHS "
+			"	(LED_MNEMO,LED_CUR_CODE,LED_MONTH,LED_MONTH_DEBIT,LED_MONTH_CREDIT) "
+			"	SELECT ENT_LEDGER,ENT_CURRENCY,DATE_FORMAT(ENT_DEFFECT,'%Y-%m-01'),"
+			"		SUM(IFNULL(ENT_DEBIT,0)),SUM(IFNULL(ENT_CREDIT,0)) "
+			"	FROM OFA_T_ENTRIES WHERE ENT_STATUS!='D' "
+			"	GROUP BY ENT_LEDGER,ENT_CURRENCY,DATE_FORMAT(ENT_DEFFECT,'%Y-%m-01')" )){
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * returns the count of queries in the dbmodel_vxx
+ * to be used as the progression indicator
+ */
+static gulong
+count_v42( ofaMysqlDBModel *self )
+{
+	return( 3 );
+}
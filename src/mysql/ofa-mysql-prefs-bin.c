@@ -49,9 +49,11 @@ typedef struct {
 	/* UI
 	 */
 	GtkSizeGroup *group0;
+	GtkWidget    *backup_entry;
 
 	/* runtime data
 	 */
+	gboolean      backup_use_cmdline;
 	gchar        *backup_cmdline;
 	gchar        *restore_gz;
 	gchar        *restore_zip;
@@ -70,6 +72,7 @@ static guint st_signals[ N_SIGNALS ]    = { 0 };
 static const gchar *st_resource_ui      = "/org/trychlos/openbook/mysql/ofa-mysql-prefs-bin.ui";
 
 static void     setup_bin( ofaMySQLPrefsBin *self );
+static void     on_backup_use_cmdline_toggled( GtkToggleButton *button, ofaMySQLPrefsBin *self );
 static void     on_backup_changed( GtkEntry *entry, ofaMySQLPrefsBin *self );
 static void     on_restore_gz_changed( GtkEntry *entry, ofaMySQLPrefsBin *self );
 static void     on_restore_zip_changed( GtkEntry *entry, ofaMySQLPrefsBin *self );
@@ -202,7 +205,7 @@ setup_bin( ofaMySQLPrefsBin *self )
 	ofaMySQLPrefsBinPrivate *priv;
 	GtkBuilder *builder;
 	GObject *object;
-	GtkWidget *toplevel, *entry, *label;
+	GtkWidget *toplevel, *entry, *label, *button;
 	gchar *cmdline;
 
 	priv = ofa_mysql_prefs_bin_get_instance_private( self );
@@ -222,6 +225,7 @@ setup_bin( ofaMySQLPrefsBin *self )
 	entry = my_utils_container_get_child_by_name( GTK_CONTAINER( self ), "mpb-backup-entry" );
 	g_return_if_fail( entry && GTK_IS_ENTRY( entry ));
 	g_signal_connect( G_OBJECT( entry ), "changed", G_CALLBACK( on_backup_changed ), self );
+	priv->backup_entry = entry;
 	label = my_utils_container_get_child_by_name( GTK_CONTAINER( self ), "mpb-backup-label" );
 	g_return_if_fail( label && GTK_IS_LABEL( label ));
 	gtk_label_set_mnemonic_widget( GTK_LABEL( label ), entry );
@@ -229,6 +233,12 @@ setup_bin( ofaMySQLPrefsBin *self )
 	gtk_entry_set_text( GTK_ENTRY( entry ), cmdline );
 	g_free( cmdline );
 
+	button = my_utils_container_get_child_by_name( GTK_CONTAINER( self ), "mpb-backup-cmdline-btn" );
+	g_return_if_fail( button && GTK_IS_CHECK_BUTTON( button ));
+	g_signal_connect( G_OBJECT( button ), "toggled", G_CALLBACK( on_backup_use_cmdline_toggled ), self );
+	gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( button ), ofa_mysql_user_prefs_get_backup_use_cmdline( priv->getter ));
+	on_backup_use_cmdline_toggled( GTK_TOGGLE_BUTTON( button ), self );
+
 	entry = my_utils_container_get_child_by_name( GTK_CONTAINER( self ), "mpb-restore-gz-entry" );
 	g_return_if_fail( entry && GTK_IS_ENTRY( entry ));
 	g_signal_connect( G_OBJECT( entry ), "changed", G_CALLBACK( on_restore_gz_changed ), self );
@@ -253,6 +263,19 @@ setup_bin( ofaMySQLPrefsBin *self )
 	g_object_unref( builder );
 }
 
+static void
+on_backup_use_cmdline_toggled( GtkToggleButton *button, ofaMySQLPrefsBin *self )
+{
+	ofaMySQLPrefsBinPrivate *priv;
+
+	priv = ofa_mysql_prefs_bin_get_instance_private( self );
+
+	priv->backup_use_cmdline = gtk_toggle_button_get_active( button );
+	gtk_widget_set_sensitive( priv->backup_entry, priv->backup_use_cmdline );
+
+	g_signal_emit_by_name( self, "ofa-changed" );
+}
+
 static void
 on_backup_changed( GtkEntry *entry, ofaMySQLPrefsBin *self )
 {
@@ -353,6 +376,7 @@ do_apply( ofaMySQLPrefsBin *self )
 
 	priv = ofa_mysql_prefs_bin_get_instance_private( self );
 
+	ofa_mysql_user_prefs_set_backup_use_cmdline( priv->getter, priv->backup_use_cmdline );
 	ofa_mysql_user_prefs_set_backup_command( priv->getter, priv->backup_cmdline );
 	ofa_mysql_user_prefs_set_restore_command( priv->getter, OFA_BACKUP_HEADER_GZ, priv->restore_gz );
 	ofa_mysql_user_prefs_set_restore_command( priv->getter, OFA_BACKUP_HEADER_ZIP, priv->restore_zip );
@@ -37,6 +37,7 @@
 
 #define PREFS_GROUP                     "MySQL"
 #define PREFS_BACKUP_CMDLINE            "BackupCommand"
+#define PREFS_BACKUP_USE_CMDLINE        "BackupUseCommand"
 #define PREFS_RESTORE_CMDLINE_GZ        "RestoreCommandGz"
 #define PREFS_RESTORE_CMDLINE_ZIP       "RestoreCommandZip"
 
@@ -81,6 +82,41 @@ ofa_mysql_user_prefs_set_backup_command( ofaIGetter *getter, const gchar *comman
 	my_isettings_set_string( settings, PREFS_GROUP, PREFS_BACKUP_CMDLINE, command );
 }
 
+/**
+ * ofa_mysql_user_prefs_get_backup_use_cmdline:
+ * @getter: a #ofaIGetter instance.
+ *
+ * Returns: %TRUE if the backup should be run through the backup
+ * command-line rather than through the native client library.
+ *
+ * Defaults to %FALSE.
+ */
+gboolean
+ofa_mysql_user_prefs_get_backup_use_cmdline( ofaIGetter *getter )
+{
+	myISettings *settings;
+
+	settings = ofa_igetter_get_user_settings( getter );
+
+	return( my_isettings_get_boolean( settings, PREFS_GROUP, PREFS_BACKUP_USE_CMDLINE ));
+}
+
+/**
+ * ofa_mysql_user_prefs_set_backup_use_cmdline:
+ * @getter: a #ofaIGetter instance.
+ * @use_cmdline: whether to use the backup command-line.
+ *
+ * Records the @use_cmdline indicator in the user settings.
+ */
+void
+ofa_mysql_user_prefs_set_backup_use_cmdline( ofaIGetter *getter, gboolean use_cmdline )
+{
+	myISettings *settings;
+
+	settings = ofa_igetter_get_user_settings( getter );
+	my_isettings_set_boolean( settings, PREFS_GROUP, PREFS_BACKUP_USE_CMDLINE, use_cmdline );
+}
+
 /**
  * ofa_mysql_user_prefs_get_restore_command:
  * @getter: a #ofaIGetter instance.
@@ -38,17 +38,22 @@
 
 G_BEGIN_DECLS
 
-gchar *ofa_mysql_user_prefs_get_backup_command ( ofaIGetter *getter );
+gchar   *ofa_mysql_user_prefs_get_backup_command    ( ofaIGetter *getter );
 
-void   ofa_mysql_user_prefs_set_backup_command ( ofaIGetter *getter,
-													const gchar *command );
+void     ofa_mysql_user_prefs_set_backup_command    ( ofaIGetter *getter,
+														const gchar *command );
 
-gchar *ofa_mysql_user_prefs_get_restore_command( ofaIGetter *getter,
-													guint format );
+gboolean ofa_mysql_user_prefs_get_backup_use_cmdline( ofaIGetter *getter );
 
-void   ofa_mysql_user_prefs_set_restore_command( ofaIGetter *getter,
-													guint format,
-													const gchar *command );
+void     ofa_mysql_user_prefs_set_backup_use_cmdline( ofaIGetter *getter,
+														gboolean use_cmdline );
+
+gchar   *ofa_mysql_user_prefs_get_restore_command   ( ofaIGetter *getter,
+														guint format );
+
+void     ofa_mysql_user_prefs_set_restore_command   ( ofaIGetter *getter,
+														guint format,
+														const gchar *command );
 
 G_END_DECLS
 
@@ -131,6 +131,7 @@ static void       idbmodel_iface_init( ofaIDBModelInterface *iface );
 static guint      idbmodel_get_interface_version( void );
 static guint      idbmodel_get_current_version( const ofaIDBModel *instance, const ofaIDBConnect *connect );
 static guint      idbmodel_get_last_version( const ofaIDBModel *instance, const ofaIDBConnect *connect );
+static const gchar *idbmodel_get_version_table( const ofaIDBModel *instance );
 static guint      get_last_version( void );
 static gboolean   idbmodel_ddl_update( ofaIDBModel *instance, ofaIGetter *getter, myIProgress *window );
 static gboolean   upgrade_to( ofaRecurrentDBModel *self, sMigration *smig );
@@ -255,6 +256,7 @@ idbmodel_iface_init( ofaIDBModelInterface *iface )
 	iface->get_interface_version = idbmodel_get_interface_version;
 	iface->get_current_version = idbmodel_get_current_version;
 	iface->get_last_version = idbmodel_get_last_version;
+	iface->get_version_table = idbmodel_get_version_table;
 	iface->ddl_update = idbmodel_ddl_update;
 	iface->check_dbms_integrity = idbmodel_check_dbms_integrity;
 }
@@ -265,7 +267,7 @@ idbmodel_iface_init( ofaIDBModelInterface *iface )
 static guint
 idbmodel_get_interface_version( void )
 {
-	return( 1 );
+	return( 2 );
 }
 
 static guint
@@ -286,6 +288,12 @@ idbmodel_get_last_version( const ofaIDBModel *instance, const ofaIDBConnect *con
 	return( get_last_version());
 }
 
+static const gchar *
+idbmodel_get_version_table( const ofaIDBModel *instance )
+{
+	return( "REC_T_VERSION" );
+}
+
 static guint
 get_last_version( void )
 {
@@ -41,6 +41,7 @@
 #include "api/ofa-icontext.h"
 #include "api/ofa-igetter.h"
 #include "api/ofa-ipage-manager.h"
+#include "api/ofa-isignaler.h"
 #include "api/ofa-itvcolumnable.h"
 #include "api/ofa-prefs.h"
 #include "api/ofo-base.h"
@@ -819,6 +820,7 @@ generate_do_opes( ofaRecurrentGenerate *self, ofoRecurrentModel *model, const GD
 static void
 generate_enum_dates_cb( const GDate *date, sEnumBetween *data )
 {
+	ofaRecurrentGeneratePrivate *priv;
 	ofoRecurrentRun *recrun;
 	const gchar *mnemo, *csdef;
 	ofsOpe *ope;
@@ -827,7 +829,16 @@ generate_enum_dates_cb( const GDate *date, sEnumBetween *data )
 	guint count;
 	ofxAmount amount;
 
+	priv = ofa_recurrent_generate_get_instance_private( data->self );
+
 	mnemo = ofo_recurrent_model_get_mnemo( data->model );
+
+	/* do not generate twice the same operation */
+	if( ofo_recurrent_run_get_by_id( priv->getter, mnemo, date )){
+		data->already += 1;
+		return;
+	}
+
 	recrun = ofo_recurrent_run_new( data->model );
 	ofo_recurrent_run_set_date( recrun, date );
 
@@ -943,11 +954,14 @@ on_ok_clicked( ofaRecurrentGenerate *self )
 	gint count;
 	gboolean ok;
 	ofaIPageManager *page_manager;
+	ofaISignaler *signaler;
 
 	priv = ofa_recurrent_generate_get_instance_private( self );
 
 	ok = TRUE;
 	count = 0;
+	signaler = ofa_igetter_get_signaler( priv->getter );
+	ofa_isignaler_begin_batch( signaler );
 
 	for( it=priv->dataset ; it ; it=it->next ){
 		object = OFO_RECURRENT_RUN( it->data );
@@ -964,6 +978,8 @@ on_ok_clicked( ofaRecurrentGenerate *self )
 		}
 	}
 
+	ofa_isignaler_end_batch( signaler );
+
 	if( ok ){
 		ofo_recurrent_gen_set_last_run_date( priv->getter, &priv->end_date );
 
@@ -39,17 +39,11 @@
 #include "api/ofa-iactionable.h"
 #include "api/ofa-icontext.h"
 #include "api/ofa-idate-filter.h"
-#include "api/ofa-idbconnect.h"
 #include "api/ofa-igetter.h"
+#include "api/ofa-isignaler.h"
 #include "api/ofa-itvcolumnable.h"
 #include "api/ofa-page.h"
 #include "api/ofa-page-prot.h"
-#include "api/ofo-counters.h"
-#include "api/ofo-dossier.h"
-#include "api/ofo-entry.h"
-#include "api/ofo-ledger.h"
-#include "api/ofo-ope-template.h"
-#include "api/ofs-ope.h"
 
 #include "ofa-recurrent-run-page.h"
 #include "ofa-recurrent-run-store.h"
@@ -83,12 +77,8 @@ typedef struct {
 
 	/* update status input
 	 */
-	guint                    update_ope_count;
-	guint                    update_entry_count;
-	GSourceFunc              update_cb;
 	ofeRecurrentStatus       update_old_status;
 	ofeRecurrentStatus       update_new_status;
-	gboolean                 update_with_progress;
 	void                    *update_worker;
 	const gchar             *update_title;
 
@@ -97,7 +87,6 @@ typedef struct {
 	GtkWidget               *update_dialog;
 	myProgressBar           *update_bar;
 	GtkWidget               *update_close_btn;
-	ofoRecurrentRun         *update_recrun;
 }
 	ofaRecurrentRunPagePrivate;
 
@@ -122,8 +111,8 @@ static void       action_on_wait_activated( GSimpleAction *action, GVariant *emp
 static void       action_on_accounting_activated( GSimpleAction *action, GVariant *empty, ofaRecurrentRunPage *self );
 static gboolean   action_user_confirm( ofaRecurrentRunPage *self );
 static gboolean   action_update_status( ofaRecurrentRunPage *self );
+static gboolean   action_validate( ofaRecurrentRunPage *self );
 static gboolean   actualize_selection( ofaRecurrentRunPage *self );
-static gboolean   action_on_object_validated( ofaRecurrentRunPage *self );
 static void       read_settings( ofaRecurrentRunPage *self );
 static void       write_settings( ofaRecurrentRunPage *self );
 static void       iprogress_iface_init( myIProgressInterface *iface );
@@ -535,13 +524,8 @@ action_on_cancel_activated( GSimpleAction *action, GVariant *empty, ofaRecurrent
 
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
-	priv->update_ope_count = 0;
-	priv->update_entry_count = 0;
 	priv->update_old_status = REC_STATUS_WAITING;
 	priv->update_new_status = REC_STATUS_CANCELLED;
-	priv->update_cb = NULL;
-	priv->update_with_progress = FALSE;
-	priv->update_title = NULL;
 
 	g_idle_add(( GSourceFunc ) action_update_status, self );
 }
@@ -556,13 +540,8 @@ action_on_wait_activated( GSimpleAction *action, GVariant *empty, ofaRecurrentRu
 
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
-	priv->update_ope_count = 0;
-	priv->update_entry_count = 0;
 	priv->update_old_status = REC_STATUS_CANCELLED;
 	priv->update_new_status = REC_STATUS_WAITING;
-	priv->update_cb = NULL;
-	priv->update_with_progress = FALSE;
-	priv->update_title = NULL;
 
 	g_idle_add(( GSourceFunc ) action_update_status, self );
 }
@@ -575,17 +554,11 @@ action_on_accounting_activated( GSimpleAction *action, GVariant *empty, ofaRecur
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
 	if( action_user_confirm( self )){
-		priv->update_ope_count = 0;
-		priv->update_entry_count = 0;
-		priv->update_old_status = REC_STATUS_WAITING;
-		priv->update_new_status = REC_STATUS_VALIDATED;
-		priv->update_cb = ( GSourceFunc ) action_on_object_validated;
-		priv->update_with_progress = TRUE;
 		priv->update_title = _( " Recording operations " );
-		priv->update_worker = GUINT_TO_POINTER( priv->update_new_status );
+		priv->update_worker = GUINT_TO_POINTER( REC_STATUS_VALIDATED );
 		my_iprogress_start_work( MY_IPROGRESS( self ), priv->update_worker, NULL );
 
-		g_idle_add(( GSourceFunc ) action_update_status, self );
+		g_idle_add(( GSourceFunc ) action_validate, self );
 	}
 }
 
@@ -621,46 +594,41 @@ action_user_confirm( ofaRecurrentRunPage *self )
 }
 
 /*
- * if this a validation and concerns more than one waiting operation,
- * then display a progress bar
+ * cancel or uncancel the selected operations
  */
 static gboolean
 action_update_status( ofaRecurrentRunPage *self )
 {
+	static const gchar *thisfn = "ofa_recurrent_run_page_action_update_status";
 	ofaRecurrentRunPagePrivate *priv;
 	GList *selected, *it;
 	ofeRecurrentStatus cur_status;
 	ofoRecurrentRun *run_obj;
-	gint count, i;
+	ofaISignaler *signaler;
 
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
 	selected = ofa_recurrent_run_treeview_get_selected( priv->tview );
-	count = g_list_length( selected );
-	i = 0;
+	signaler = ofa_igetter_get_signaler( priv->getter );
+	ofa_isignaler_begin_batch( signaler );
 
 	for( it=selected ; it ; it=it->next ){
+		if( !it->data || !OFO_IS_RECURRENT_RUN( it->data )){
+			g_warning( "%s: unexpected object %p in the selection", thisfn, it->data );
+			break;
+		}
 		run_obj = OFO_RECURRENT_RUN( it->data );
-		g_return_val_if_fail( run_obj && OFO_IS_RECURRENT_RUN( run_obj ), G_SOURCE_REMOVE );
 
 		cur_status = ofo_recurrent_run_get_status( run_obj );
 		if( cur_status == priv->update_old_status ){
 			ofo_recurrent_run_set_status( run_obj, priv->update_new_status );
-			if( ofo_recurrent_run_update_status( run_obj ) && priv->update_cb ){
-				priv->update_recrun = run_obj;
-				//g_idle_add(( GSourceFunc ) priv->update_cb, self );
-				( *priv->update_cb )( self );
-			}
-			if( priv->update_with_progress ){
-				my_iprogress_pulse( MY_IPROGRESS( self ), priv->update_worker, ++i, count );
-			}
+			ofo_recurrent_run_update_status( run_obj );
 		}
 	}
 
+	ofa_isignaler_end_batch( signaler );
+
 	ofa_recurrent_run_treeview_free_selected( selected );
-	if( priv->update_with_progress ){
-		my_iprogress_set_ok( MY_IPROGRESS( self ), priv->update_worker, NULL, 0 );
-	}
 
 	/* actualize the actions state */
 	g_idle_add(( GSourceFunc ) actualize_selection, self );
@@ -670,117 +638,56 @@ action_update_status( ofaRecurrentRunPage *self )
 }
 
 /*
- * After having updated all status, try to renew the state of the actions
+ * send the selected waiting operations to the accounting
+ *
+ * The whole selection is validated as a batch, in one transaction.
  */
 static gboolean
-actualize_selection( ofaRecurrentRunPage *self )
+action_validate( ofaRecurrentRunPage *self )
 {
+	static const gchar *thisfn = "ofa_recurrent_run_page_action_validate";
 	ofaRecurrentRunPagePrivate *priv;
 	GList *selected;
+	guint count, ope_count, entry_count;
+	gboolean ok;
 
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
 	selected = ofa_recurrent_run_treeview_get_selected( priv->tview );
-	on_row_selected( priv->tview, selected, self );
+	count = g_list_length( selected );
+	my_iprogress_pulse( MY_IPROGRESS( self ), priv->update_worker, 0, count );
+
+	ok = ofo_recurrent_run_validate_list( priv->getter, selected, &ope_count, &entry_count );
+
+	g_debug( "%s: ok=%s, ope_count=%u, entry_count=%u",
+			thisfn, ok ? "True":"False", ope_count, entry_count );
+
 	ofa_recurrent_run_treeview_free_selected( selected );
 
+	my_iprogress_pulse( MY_IPROGRESS( self ), priv->update_worker, count, count );
+	my_iprogress_set_ok( MY_IPROGRESS( self ), priv->update_worker, NULL, ok ? 0 : 1 );
+
+	/* actualize the actions state */
+	g_idle_add(( GSourceFunc ) actualize_selection, self );
+
 	/* do not continue and remove from idle callbacks list */
 	return( G_SOURCE_REMOVE );
 }
 
 /*
- * Not a GSourceFunc, but just a function sync-called after each validation
+ * After having updated all status, try to renew the state of the actions
  */
 static gboolean
-action_on_object_validated( ofaRecurrentRunPage *self )
+actualize_selection( ofaRecurrentRunPage *self )
 {
 	ofaRecurrentRunPagePrivate *priv;
-	const gchar *rec_id, *tmpl_id, *ledger_id;
-	ofaIDBConnect *connect;
-	gboolean ok;
-	ofoRecurrentModel *model;
-	ofoOpeTemplate *template_obj;
-	ofoLedger *ledger_obj;
-	ofsOpe *ope;
-	GList *entries, *it;
-	GDate dmin;
-	ofoEntry *entry;
-	ofxCounter ope_number;
-	const gchar *csdef;
-	ofxAmount amount;
-	ofaHub *hub;
-	ofoDossier *dossier;
+	GList *selected;
 
 	priv = ofa_recurrent_run_page_get_instance_private( self );
 
-	hub = ofa_igetter_get_hub( priv->getter );
-	dossier = ofa_hub_get_dossier( hub );
-	g_return_val_if_fail( dossier && OFO_IS_DOSSIER( dossier ), G_SOURCE_REMOVE );
-
-	connect = ofa_hub_get_connect( hub );
-	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), G_SOURCE_REMOVE );
-
-	rec_id = ofo_recurrent_run_get_mnemo( priv->update_recrun );
-	model = ofo_recurrent_model_get_by_mnemo( priv->getter, rec_id );
-	g_return_val_if_fail( model && OFO_IS_RECURRENT_MODEL( model ), G_SOURCE_REMOVE );
-
-	tmpl_id = ofo_recurrent_model_get_ope_template( model );
-	template_obj = ofo_ope_template_get_by_mnemo( priv->getter, tmpl_id );
-	g_return_val_if_fail( template_obj && OFO_IS_OPE_TEMPLATE( template_obj ), G_SOURCE_REMOVE );
-
-	ledger_id = ofo_ope_template_get_ledger( template_obj );
-	ledger_obj = ofo_ledger_get_by_mnemo( priv->getter, ledger_id );
-	g_return_val_if_fail( ledger_obj && OFO_IS_LEDGER( ledger_obj ), G_SOURCE_REMOVE );
-
-	ope = ofs_ope_new( template_obj );
-	my_date_set_from_date( &ope->dope, ofo_recurrent_run_get_date( priv->update_recrun ));
-	ope->dope_user_set = TRUE;
-	ofo_dossier_get_min_deffect( dossier, ledger_obj, &dmin );
-	my_date_set_from_date( &ope->deffect, my_date_compare( &ope->dope, &dmin ) >= 0 ? &ope->dope : &dmin );
-
-	csdef = ofo_recurrent_model_get_def_amount1( model );
-	if( my_strlen( csdef )){
-		amount = ofo_recurrent_run_get_amount1( priv->update_recrun );
-		ofs_ope_set_amount( ope, csdef, amount );
-	}
-
-	csdef = ofo_recurrent_model_get_def_amount2( model );
-	if( my_strlen( csdef )){
-		amount = ofo_recurrent_run_get_amount2( priv->update_recrun );
-		ofs_ope_set_amount( ope, csdef, amount );
-	}
-
-	csdef = ofo_recurrent_model_get_def_amount3( model );
-	if( my_strlen( csdef )){
-		amount = ofo_recurrent_run_get_amount3( priv->update_recrun );
-		ofs_ope_set_amount( ope, csdef, amount );
-	}
-
-	ofs_ope_apply_template( ope );
-	entries = ofs_ope_generate_entries( ope );
-
-	ok = ofa_idbconnect_transaction_start( connect, FALSE, NULL );
-
-	if( ok ){
-		ope_number = ofo_counters_get_next_ope_id( priv->getter );
-		priv->update_ope_count += 1;
-
-		for( it=entries ; it && ok ; it=it->next ){
-			entry = OFO_ENTRY( it->data );
-			ofo_entry_set_ope_number( entry, ope_number );
-			ok = ofo_entry_insert( entry );
-			priv->update_entry_count += 1;
-		}
-	}
-
-	if( ok ){
-		ofa_idbconnect_transaction_commit( connect, FALSE, NULL );
-		g_list_free( entries );
-
-	} else {
-		ok = ofa_idbconnect_transaction_cancel( connect, FALSE, NULL );
-		g_list_free_full( entries, g_object_unref );
-	}
+	selected = ofa_recurrent_run_treeview_get_selected( priv->tview );
+	on_row_selected( priv->tview, selected, self );
+	ofa_recurrent_run_treeview_free_selected( selected );
 
 	/* do not continue and remove from idle callbacks list */
 	return( G_SOURCE_REMOVE );
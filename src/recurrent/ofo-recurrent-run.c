@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "my/my-date.h"
 #include "my/my-icollectionable.h"
 #include "my/my-icollector.h"
 #include "my/my-stamp.h"
@@ -45,6 +46,12 @@
 #include "api/ofa-isignaler.h"
 #include "api/ofo-base.h"
 #include "api/ofo-base-prot.h"
+#include "api/ofo-counters.h"
+#include "api/ofo-dossier.h"
+#include "api/ofo-entry.h"
+#include "api/ofo-ledger.h"
+#include "api/ofo-ope-template.h"
+#include "api/ofs-ope.h"
 
 #include "ofo-recurrent-gen.h"
 #include "ofo-recurrent-model.h"
@@ -187,6 +194,56 @@ static sStatus st_status[] = {
 		{ 0 },
 };
 
+/* an index on the collection of recurrent runs, attached to the
+ * collector:
+ * - by_id: "mnemo<tab>date" -> the waiting or validated run
+ * - by_model: mnemo -> sModelIndex
+ *
+ * The indexed runs are owned by the collection.
+ * The index keeps a weak reference on the first run of the collection
+ * it has been built from: when the collection is freed or reloaded,
+ * this run is finalized or is no more the first of the collection, and
+ * the index is rebuilt.
+ */
+#define RUN_INDEX_DATA                  "ofo-recurrent-run-index"
+
+typedef struct {
+	ofoRecurrentRun *head;
+	gboolean         stale;
+	GHashTable      *by_id;
+	GHashTable      *by_model;
+}
+	sRunIndex;
+
+/* the runs of a model, and their last date per status
+ * the last dates are recomputed when @dirty is set, i.e. after a
+ * status change
+ */
+typedef struct {
+	GList           *runs;
+	gboolean         dirty;
+	GDate            last_cancelled;
+	GDate            last_waiting;
+	GDate            last_validated;
+}
+	sModelIndex;
+
+/* ofo_recurrent_run_validate_list():
+ * the accounting data of a recurrent model, resolved once per batch
+ * @model is left %NULL when the model, its operation template or its
+ * ledger cannot be found
+ */
+typedef struct {
+	ofoRecurrentModel *model;
+	ofoOpeTemplate    *template;
+	GDate              dmin;
+}
+	sValidateModel;
+
+/* max count of runs updated by one UPDATE statement
+ */
+#define RUN_UPDATE_BATCH                500
+
 static void       recurrent_run_set_numseq( ofoRecurrentRun *model, ofxCounter numseq );
 static void       recurrent_run_set_period( ofoRecurrentRun *run, myPeriod *period );
 static void       recurrent_run_set_cre_user( ofoRecurrentRun *model, const gchar *user );
@@ -199,6 +256,9 @@ static GList     *get_orphans( ofaIGetter *getter, const gchar *table );
 static gboolean   recurrent_run_do_insert( ofoRecurrentRun *model, ofaIGetter *getter );
 static gboolean   recurrent_run_insert_main( ofoRecurrentRun *model, ofaIGetter *getter );
 static gboolean   recurrent_run_do_update_status( ofoRecurrentRun *model, ofaIGetter *getter );
+static gboolean   recurrent_run_do_update_status_list( GList *runs, ofeRecurrentStatus status, const gchar *userid, const myStampVal *stamp, ofaIGetter *getter );
+static sValidateModel *validate_get_model( ofaIGetter *getter, ofoDossier *dossier, GHashTable *models, const gchar *mnemo );
+static GList     *validate_generate_entries( ofoRecurrentRun *run, sValidateModel *smodel );
 static gboolean   recurrent_run_do_update_amounts( ofoRecurrentRun *model, ofaIGetter *getter );
 static gint       recurrent_run_cmp_by_mnemo_date( const ofoRecurrentRun *a, const gchar *mnemo, const GDate *date, ofeRecurrentStatus status );
 static gint       recurrent_run_cmp_by_ptr( const ofoRecurrentRun *a, const ofoRecurrentRun *b );
@@ -214,6 +274,16 @@ static gboolean   signaler_is_deletable_recurrent_model( ofaISignaler *signaler,
 static void       signaler_on_updated_base( ofaISignaler *signaler, ofoBase *object, const gchar *prev_id, void *empty );
 static gboolean   signaler_on_updated_rec_model_mnemo( ofaISignaler *signaler, ofoBase *object, const gchar *mnemo, const gchar *prev_id );
 static void       free_collection( ofaISignaler *signaler );
+static sRunIndex *run_index_get( ofaIGetter *getter );
+static void       run_index_free( sRunIndex *index );
+static void       run_index_set_head( sRunIndex *index, GList *dataset );
+static void       run_index_on_head_finalized( sRunIndex *index, GObject *finalized_run );
+static void       run_index_add( sRunIndex *index, ofoRecurrentRun *run );
+static void       run_index_update( sRunIndex *index, ofoRecurrentRun *run );
+static gchar     *run_index_get_key( const gchar *mnemo, const GDate *date );
+static void       model_index_free( sModelIndex *model );
+static void       model_index_set_last( sModelIndex *model, ofoRecurrentRun *run );
+static void       model_index_compute_last( sModelIndex *model );
 
 G_DEFINE_TYPE_EXTENDED( ofoRecurrentRun, ofo_recurrent_run, OFO_TYPE_BASE, 0,
 		G_ADD_PRIVATE( ofoRecurrentRun )
@@ -311,11 +381,9 @@ ofo_recurrent_run_get_dataset( ofaIGetter *getter )
 ofoRecurrentRun *
 ofo_recurrent_run_get_by_id( ofaIGetter *getter, const gchar *mnemo, const GDate *date )
 {
-	GList *dataset, *it;
+	sRunIndex *index;
 	ofoRecurrentRun *ope;
-	const gchar *mnemo_ope;
-	const GDate *date_ope;
-	ofeRecurrentStatus status_ope;
+	gchar *key;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 
@@ -323,31 +391,13 @@ ofo_recurrent_run_get_by_id( ofaIGetter *getter, const gchar *mnemo, const GDate
 		return( NULL );
 	}
 
-	dataset = ofo_recurrent_run_get_dataset( getter );
-
-	for( it=dataset ; it ; it=it->next ){
-		ope = OFO_RECURRENT_RUN( it->data );
-
-		status_ope = ofo_recurrent_run_get_status( ope );
-		if( status_ope == REC_STATUS_CANCELLED ){
-			continue;
-		}
-		g_return_val_if_fail(
-				status_ope == REC_STATUS_WAITING || status_ope == REC_STATUS_VALIDATED,
-				NULL );
-
-		mnemo_ope = ofo_recurrent_run_get_mnemo( ope );
-		g_return_val_if_fail( my_strlen( mnemo_ope ), NULL );
+	index = run_index_get( getter );
 
-		date_ope = ofo_recurrent_run_get_date( ope );
-		g_return_val_if_fail( my_date_is_valid( date_ope ), NULL );
+	key = run_index_get_key( mnemo, date );
+	ope = ( ofoRecurrentRun * ) g_hash_table_lookup( index->by_id, key );
+	g_free( key );
 
-		if( !my_collate( mnemo_ope, mnemo ) && !my_date_compare( date_ope, date )){
-			return( ope );
-		}
-	}
-
-	return( NULL );
+	return( ope );
 }
 
 /**
@@ -674,11 +724,8 @@ ofo_recurrent_run_compare( const ofoRecurrentRun *a, const ofoRecurrentRun *b )
 const GDate *
 ofo_recurrent_run_get_last( ofaIGetter *getter, GDate *dlast, const gchar *mnemo, guint status )
 {
-	GString *query;
-	guint count;
-	ofaHub *hub;
-	ofaIDBConnect *connect;
-	GSList *result, *irow, *icol;
+	sRunIndex *index;
+	sModelIndex *model;
 
 	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), NULL );
 	g_return_val_if_fail( dlast, NULL );
@@ -686,56 +733,28 @@ ofo_recurrent_run_get_last( ofaIGetter *getter, GDate *dlast, const gchar *mnemo
 
 	g_date_clear( dlast, 1 );
 
-	query = g_string_new( "SELECT MAX(REC_DATE) FROM REC_T_RUN WHERE " );
-	g_string_append_printf( query, "REC_MNEMO='%s'", mnemo );
-	count = 0;
-	if( status & REC_STATUS_CANCELLED ){
-		if( count == 0 ){
-			count += 1;
-			query = g_string_append( query, " AND (" );
-		}
-		g_string_append_printf( query, "REC_STATUS='%s'", ofo_recurrent_run_status_get_dbms( REC_STATUS_CANCELLED ));
-	}
-	if( status & REC_STATUS_WAITING ){
-		if( count == 0 ){
-			count += 1;
-			query = g_string_append( query, " AND (" );
-		} else if( count == 1 ){
-			count += 1;
-			query = g_string_append( query, " OR " );
-		}
-		g_string_append_printf( query, "REC_STATUS='%s'", ofo_recurrent_run_status_get_dbms( REC_STATUS_WAITING ));
-	}
-	if( status & REC_STATUS_VALIDATED ){
-		if( count == 0 ){
-			count += 1;
-			query = g_string_append( query, " AND (" );
-		} else if( count == 1 ){
-			count += 1;
-			query = g_string_append( query, " OR " );
-		}
-		g_string_append_printf( query, "REC_STATUS='%s'", ofo_recurrent_run_status_get_dbms( REC_STATUS_VALIDATED ));
-	}
-	if( count > 0 ){
-		query = g_string_append( query, ")" );
+	if( status == 0 ){
+		status = REC_STATUS_CANCELLED | REC_STATUS_WAITING | REC_STATUS_VALIDATED;
 	}
 
-	hub = ofa_igetter_get_hub( getter );
-	g_return_val_if_fail( hub && OFA_IS_HUB( hub ), NULL );
+	index = run_index_get( getter );
+	model = ( sModelIndex * ) g_hash_table_lookup( index->by_model, mnemo );
 
-	connect = ofa_hub_get_connect( hub );
-	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), NULL );
-
-	if( ofa_idbconnect_query_ex( connect, query->str, &result, TRUE )){
-		for( irow=result ; irow ; irow=irow->next ){
-			icol = irow->data;
-			my_date_set_from_str( dlast, ( const gchar * ) icol->data, MY_DATE_SQL );
+	if( model ){
+		if( model->dirty ){
+			model_index_compute_last( model );
+		}
+		if(( status & REC_STATUS_CANCELLED ) && my_date_compare_ex( &model->last_cancelled, dlast, TRUE ) > 0 ){
+			my_date_set_from_date( dlast, &model->last_cancelled );
+		}
+		if(( status & REC_STATUS_WAITING ) && my_date_compare_ex( &model->last_waiting, dlast, TRUE ) > 0 ){
+			my_date_set_from_date( dlast, &model->last_waiting );
+		}
+		if(( status & REC_STATUS_VALIDATED ) && my_date_compare_ex( &model->last_validated, dlast, TRUE ) > 0 ){
+			my_date_set_from_date( dlast, &model->last_validated );
 		}
-		ofa_idbconnect_free_results( result );
 	}
 
-	g_string_free( query, TRUE );
-
 	return( dlast );
 }
 
@@ -962,6 +981,7 @@ ofo_recurrent_run_insert( ofoRecurrentRun *recurrent_run )
 	static const gchar *thisfn = "ofo_recurrent_run_insert";
 	ofaIGetter *getter;
 	ofaISignaler *signaler;
+	sRunIndex *index;
 	gboolean ok;
 
 	g_debug( "%s: model=%p", thisfn, ( void * ) recurrent_run );
@@ -975,10 +995,13 @@ ofo_recurrent_run_insert( ofoRecurrentRun *recurrent_run )
 
 	/* rationale: see ofo-account.c */
 	ofo_recurrent_run_get_dataset( getter );
+	index = run_index_get( getter );
 
 	if( recurrent_run_do_insert( recurrent_run, getter )){
 		my_icollector_collection_add_object(
 				ofa_igetter_get_collector( getter ), MY_ICOLLECTIONABLE( recurrent_run ), NULL, getter );
+		run_index_add( index, recurrent_run );
+		run_index_set_head( index, ofo_recurrent_run_get_dataset( getter ));
 		g_signal_emit_by_name( signaler, SIGNALER_BASE_NEW, recurrent_run );
 		ok = TRUE;
 	}
@@ -1168,6 +1191,7 @@ ofo_recurrent_run_update_status( ofoRecurrentRun *recurrent_run )
 	signaler = ofa_igetter_get_signaler( getter );
 
 	if( recurrent_run_do_update_status( recurrent_run, getter )){
+		run_index_update( run_index_get( getter ), recurrent_run );
 		g_signal_emit_by_name( signaler, SIGNALER_BASE_UPDATED, recurrent_run, NULL );
 		ok = TRUE;
 	}
@@ -1232,6 +1256,283 @@ recurrent_run_do_update_status( ofoRecurrentRun *recrun, ofaIGetter *getter )
 	return( ok );
 }
 
+/**
+ * ofo_recurrent_run_validate_list:
+ * @getter: a #ofaIGetter instance.
+ * @runs: a list of #ofoRecurrentRun objects.
+ * @ope_count: [out][allow-none]: the count of generated operations.
+ * @entry_count: [out][allow-none]: the count of generated entries.
+ *
+ * Validates the waiting runs of the @runs list, generating and
+ * recording the corresponding accounting entries.
+ *
+ * The recurrent models, their operation templates and their ledgers
+ * are resolved only once per model. The operations and entries
+ * identifiers are reserved as a whole, and the status updates and the
+ * entries are recorded in one single transaction: either all the runs
+ * are validated, or none is.
+ *
+ * The runs which are not waiting, or whose model cannot be resolved,
+ * are just ignored.
+ *
+ * Returns: %TRUE if the validation has been successfully recorded.
+ */
+gboolean
+ofo_recurrent_run_validate_list( ofaIGetter *getter, GList *runs, guint *ope_count, guint *entry_count )
+{
+	static const gchar *thisfn = "ofo_recurrent_run_validate_list";
+	ofaHub *hub;
+	ofoDossier *dossier;
+	ofaIDBConnect *connect;
+	ofaISignaler *signaler;
+	GHashTable *models;
+	sValidateModel *smodel;
+	GList *validated, *opes, *entries, *it, *ite;
+	ofoRecurrentRun *run;
+	ofxCounter ope_number;
+	const gchar *userid;
+	myStampVal *stamp;
+	guint count;
+	gboolean ok;
+
+	g_debug( "%s: getter=%p, runs=%p, count=%u",
+			thisfn, ( void * ) getter, ( void * ) runs, g_list_length( runs ));
+
+	g_return_val_if_fail( getter && OFA_IS_IGETTER( getter ), FALSE );
+
+	if( ope_count ){
+		*ope_count = 0;
+	}
+	if( entry_count ){
+		*entry_count = 0;
+	}
+
+	hub = ofa_igetter_get_hub( getter );
+	dossier = ofa_hub_get_dossier( hub );
+	g_return_val_if_fail( dossier && OFO_IS_DOSSIER( dossier ), FALSE );
+
+	connect = ofa_hub_get_connect( hub );
+	g_return_val_if_fail( connect && OFA_IS_IDBCONNECT( connect ), FALSE );
+
+	/* generate the entries of each operation, without any DBMS access */
+	models = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
+	validated = NULL;
+	opes = NULL;
+
+	for( it=runs ; it ; it=it->next ){
+		run = OFO_RECURRENT_RUN( it->data );
+		g_return_val_if_fail( run && OFO_IS_RECURRENT_RUN( run ), FALSE );
+
+		if( ofo_recurrent_run_get_status( run ) == REC_STATUS_WAITING ){
+			smodel = validate_get_model( getter, dossier, models, ofo_recurrent_run_get_mnemo( run ));
+			if( smodel->model ){
+				opes = g_list_prepend( opes, validate_generate_entries( run, smodel ));
+				validated = g_list_prepend( validated, run );
+			}
+		}
+	}
+
+	g_hash_table_destroy( models );
+
+	if( !validated ){
+		return( TRUE );
+	}
+
+	/* the new entries and the updated runs are notified together */
+	signaler = ofa_igetter_get_signaler( getter );
+	ofa_isignaler_begin_batch( signaler );
+
+	/* number the operations from one reserved range, and record all */
+	ok = ofa_idbconnect_transaction_start( connect, FALSE, NULL );
+	entries = NULL;
+	count = g_list_length( opes );
+	userid = ofa_idbconnect_get_account( connect );
+	stamp = my_stamp_new_now();
+
+	if( ok ){
+		ope_number = ofo_counters_reserve_ope_ids( getter, count );
+		opes = g_list_reverse( opes );
+		for( it=opes ; it ; it=it->next, ++ope_number ){
+			for( ite=( GList * ) it->data ; ite ; ite=ite->next ){
+				ofo_entry_set_ope_number( OFO_ENTRY( ite->data ), ope_number );
+				entries = g_list_prepend( entries, ite->data );
+			}
+			g_list_free(( GList * ) it->data );
+		}
+		g_list_free( opes );
+		opes = NULL;
+		entries = g_list_reverse( entries );
+
+		ok = recurrent_run_do_update_status_list( validated, REC_STATUS_VALIDATED, userid, stamp, getter ) &&
+				ofo_entry_insert_list( getter, entries );
+	}
+
+	if( ok ){
+		ok = ofa_idbconnect_transaction_commit( connect, FALSE, NULL );
+	}
+	if( !ok ){
+		ofa_idbconnect_transaction_cancel( connect, FALSE, NULL );
+	}
+
+	/* the entries are only published once committed */
+	if( ok ){
+		if( ope_count ){
+			*ope_count = count;
+		}
+		if( entry_count ){
+			*entry_count = g_list_length( entries );
+		}
+		ofo_entry_insert_list_notify( getter, entries );
+		g_list_free( entries );
+
+		for( it=validated ; it ; it=it->next ){
+			run = OFO_RECURRENT_RUN( it->data );
+			ofo_recurrent_run_set_status( run, REC_STATUS_VALIDATED );
+			recurrent_run_set_sta_user( run, userid );
+			recurrent_run_set_sta_stamp( run, stamp );
+			run_index_update( run_index_get( getter ), run );
+			g_signal_emit_by_name( signaler, SIGNALER_BASE_UPDATED, run, NULL );
+		}
+
+	} else {
+		for( it=opes ; it ; it=it->next ){
+			g_list_free_full(( GList * ) it->data, g_object_unref );
+		}
+		g_list_free( opes );
+		g_list_free_full( entries, g_object_unref );
+	}
+
+	ofa_isignaler_end_batch( signaler );
+
+	g_list_free( validated );
+	my_stamp_free( stamp );
+
+	return( ok );
+}
+
+/*
+ * Resolve the accounting data of a recurrent model once per batch
+ */
+static sValidateModel *
+validate_get_model( ofaIGetter *getter, ofoDossier *dossier, GHashTable *models, const gchar *mnemo )
+{
+	static const gchar *thisfn = "ofo_recurrent_run_validate_get_model";
+	sValidateModel *smodel;
+	ofoRecurrentModel *model;
+	ofoOpeTemplate *template;
+	ofoLedger *ledger;
+
+	smodel = g_hash_table_lookup( models, mnemo );
+
+	if( !smodel ){
+		smodel = g_new0( sValidateModel, 1 );
+		g_hash_table_insert( models, g_strdup( mnemo ), smodel );
+
+		model = ofo_recurrent_model_get_by_mnemo( getter, mnemo );
+		template = model ? ofo_ope_template_get_by_mnemo( getter, ofo_recurrent_model_get_ope_template( model )) : NULL;
+		ledger = template ? ofo_ledger_get_by_mnemo( getter, ofo_ope_template_get_ledger( template )) : NULL;
+
+		if( ledger ){
+			smodel->model = model;
+			smodel->template = template;
+			ofo_dossier_get_min_deffect( dossier, ledger, &smodel->dmin );
+
+		} else {
+			g_warning( "%s: unable to resolve the accounting data of the recurrent model %s", thisfn, mnemo );
+		}
+	}
+
+	return( smodel );
+}
+
+/*
+ * Generate the entries of the operation of @run
+ */
+static GList *
+validate_generate_entries( ofoRecurrentRun *run, sValidateModel *smodel )
+{
+	ofsOpe *ope;
+	const gchar *csdef;
+	GList *entries;
+
+	ope = ofs_ope_new( smodel->template );
+	my_date_set_from_date( &ope->dope, ofo_recurrent_run_get_date( run ));
+	ope->dope_user_set = TRUE;
+	my_date_set_from_date( &ope->deffect, my_date_compare( &ope->dope, &smodel->dmin ) >= 0 ? &ope->dope : &smodel->dmin );
+
+	csdef = ofo_recurrent_model_get_def_amount1( smodel->model );
+	if( my_strlen( csdef )){
+		ofs_ope_set_amount( ope, csdef, ofo_recurrent_run_get_amount1( run ));
+	}
+
+	csdef = ofo_recurrent_model_get_def_amount2( smodel->model );
+	if( my_strlen( csdef )){
+		ofs_ope_set_amount( ope, csdef, ofo_recurrent_run_get_amount2( run ));
+	}
+
+	csdef = ofo_recurrent_model_get_def_amount3( smodel->model );
+	if( my_strlen( csdef )){
+		ofs_ope_set_amount( ope, csdef, ofo_recurrent_run_get_amount3( run ));
+	}
+
+	ofs_ope_apply_template( ope );
+	entries = ofs_ope_generate_entries( ope );
+	ofs_ope_free( ope );
+
+	return( entries );
+}
+
+/*
+ * Update the status of the @runs in the DBMS, by chunks of
+ * RUN_UPDATE_BATCH rows.
+ * The runs themselves are left unchanged.
+ */
+static gboolean
+recurrent_run_do_update_status_list( GList *runs, ofeRecurrentStatus status, const gchar *userid, const myStampVal *stamp, ofaIGetter *getter )
+{
+	ofaHub *hub;
+	const ofaIDBConnect *connect;
+	GString *query;
+	const gchar *cdbms;
+	gchar *stamp_str;
+	GList *it;
+	guint i;
+	gboolean ok;
+
+	hub = ofa_igetter_get_hub( getter );
+	connect = ofa_hub_get_connect( hub );
+
+	cdbms = ofo_recurrent_run_status_get_dbms( status );
+	stamp_str = my_stamp_to_str( stamp, MY_STAMP_YYMDHMS );
+	query = g_string_new( "" );
+	ok = TRUE;
+
+	for( it=runs ; it && ok ; ){
+		g_string_assign( query, "UPDATE REC_T_RUN SET " );
+		if( my_strlen( cdbms )){
+			g_string_append_printf( query, "REC_STATUS='%s',", cdbms );
+		} else {
+			query = g_string_append( query, "REC_STATUS=NULL," );
+		}
+		g_string_append_printf( query,
+				"	REC_STA_USER='%s',REC_STA_STAMP='%s'"
+				"	WHERE REC_NUMSEQ IN (", userid, stamp_str );
+
+		for( i=0 ; it && i<RUN_UPDATE_BATCH ; ++i, it=it->next ){
+			g_string_append_printf( query, "%s%ld",
+					i ? "," : "", ofo_recurrent_run_get_numseq( OFO_RECURRENT_RUN( it->data )));
+		}
+		query = g_string_append( query, ")" );
+
+		ok = ofa_idbconnect_query( connect, query->str, TRUE );
+	}
+
+	g_string_free( query, TRUE );
+	g_free( stamp_str );
+
+	return( ok );
+}
+
 /**
  * ofo_recurrent_run_update_amounts:
  * @model:
@@ -1589,4 +1890,202 @@ free_collection( ofaISignaler *signaler )
 	getter = ofa_isignaler_get_getter( signaler );
 	collector = ofa_igetter_get_collector( getter );
 	my_icollector_collection_free( collector, OFO_TYPE_RECURRENT_RUN );
+	g_object_set_data( G_OBJECT( collector ), RUN_INDEX_DATA, NULL );
+}
+
+/*
+ * Returns: the index of the runs collection, building it if needed.
+ */
+static sRunIndex *
+run_index_get( ofaIGetter *getter )
+{
+	myICollector *collector;
+	GList *dataset, *it;
+	sRunIndex *index;
+
+	dataset = ofo_recurrent_run_get_dataset( getter );
+	collector = ofa_igetter_get_collector( getter );
+	index = ( sRunIndex * ) g_object_get_data( G_OBJECT( collector ), RUN_INDEX_DATA );
+
+	if( index && !index->stale && index->head == ( dataset ? dataset->data : NULL )){
+		return( index );
+	}
+
+	index = g_new0( sRunIndex, 1 );
+	index->by_id = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	index->by_model = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) model_index_free );
+
+	for( it=dataset ; it ; it=it->next ){
+		run_index_add( index, OFO_RECURRENT_RUN( it->data ));
+	}
+	run_index_set_head( index, dataset );
+
+	g_object_set_data_full( G_OBJECT( collector ), RUN_INDEX_DATA, index, ( GDestroyNotify ) run_index_free );
+
+	return( index );
+}
+
+static void
+run_index_free( sRunIndex *index )
+{
+	if( index->head ){
+		g_object_weak_unref( G_OBJECT( index->head ), ( GWeakNotify ) run_index_on_head_finalized, index );
+	}
+	g_hash_table_destroy( index->by_id );
+	g_hash_table_destroy( index->by_model );
+	g_free( index );
+}
+
+static void
+run_index_set_head( sRunIndex *index, GList *dataset )
+{
+	ofoRecurrentRun *head;
+
+	head = dataset ? OFO_RECURRENT_RUN( dataset->data ) : NULL;
+
+	if( head != index->head ){
+		if( index->head ){
+			g_object_weak_unref( G_OBJECT( index->head ), ( GWeakNotify ) run_index_on_head_finalized, index );
+		}
+		index->head = head;
+		if( head ){
+			g_object_weak_ref( G_OBJECT( head ), ( GWeakNotify ) run_index_on_head_finalized, index );
+		}
+	}
+}
+
+static void
+run_index_on_head_finalized( sRunIndex *index, GObject *finalized_run )
+{
+	index->head = NULL;
+	index->stale = TRUE;
+}
+
+static void
+run_index_add( sRunIndex *index, ofoRecurrentRun *run )
+{
+	const gchar *mnemo;
+	const GDate *date;
+	sModelIndex *model;
+
+	mnemo = ofo_recurrent_run_get_mnemo( run );
+	date = ofo_recurrent_run_get_date( run );
+
+	if( !my_strlen( mnemo ) || !my_date_is_valid( date )){
+		return;
+	}
+
+	model = ( sModelIndex * ) g_hash_table_lookup( index->by_model, mnemo );
+	if( !model ){
+		model = g_new0( sModelIndex, 1 );
+		g_date_clear( &model->last_cancelled, 1 );
+		g_date_clear( &model->last_waiting, 1 );
+		g_date_clear( &model->last_validated, 1 );
+		g_hash_table_insert( index->by_model, g_strdup( mnemo ), model );
+	}
+
+	model->runs = g_list_prepend( model->runs, run );
+	model_index_set_last( model, run );
+
+	if( ofo_recurrent_run_get_status( run ) != REC_STATUS_CANCELLED ){
+		g_hash_table_insert( index->by_id, run_index_get_key( mnemo, date ), run );
+	}
+}
+
+/*
+ * The status of the @run has been updated.
+ */
+static void
+run_index_update( sRunIndex *index, ofoRecurrentRun *run )
+{
+	const gchar *mnemo;
+	const GDate *date;
+	sModelIndex *model;
+	gchar *key;
+
+	mnemo = ofo_recurrent_run_get_mnemo( run );
+	date = ofo_recurrent_run_get_date( run );
+
+	if( !my_strlen( mnemo ) || !my_date_is_valid( date )){
+		return;
+	}
+
+	key = run_index_get_key( mnemo, date );
+
+	if( ofo_recurrent_run_get_status( run ) == REC_STATUS_CANCELLED ){
+		if( g_hash_table_lookup( index->by_id, key ) == run ){
+			g_hash_table_remove( index->by_id, key );
+		}
+		g_free( key );
+
+	} else {
+		g_hash_table_insert( index->by_id, key, run );
+	}
+
+	model = ( sModelIndex * ) g_hash_table_lookup( index->by_model, mnemo );
+	if( model ){
+		model->dirty = TRUE;
+	}
+}
+
+static gchar *
+run_index_get_key( const gchar *mnemo, const GDate *date )
+{
+	gchar *sdate, *key;
+
+	sdate = my_date_to_str( date, MY_DATE_SQL );
+	key = g_strdup_printf( "%s\t%s", mnemo, sdate );
+	g_free( sdate );
+
+	return( key );
+}
+
+static void
+model_index_free( sModelIndex *model )
+{
+	g_list_free( model->runs );
+	g_free( model );
+}
+
+static void
+model_index_set_last( sModelIndex *model, ofoRecurrentRun *run )
+{
+	const GDate *date;
+	GDate *last;
+
+	switch( ofo_recurrent_run_get_status( run )){
+		case REC_STATUS_CANCELLED:
+			last = &model->last_cancelled;
+			break;
+		case REC_STATUS_WAITING:
+			last = &model->last_waiting;
+			break;
+		case REC_STATUS_VALIDATED:
+			last = &model->last_validated;
+			break;
+		default:
+			return;
+	}
+
+	date = ofo_recurrent_run_get_date( run );
+
+	if( my_date_compare_ex( date, last, TRUE ) > 0 ){
+		my_date_set_from_date( last, date );
+	}
+}
+
+static void
+model_index_compute_last( sModelIndex *model )
+{
+	GList *it;
+
+	g_date_clear( &model->last_cancelled, 1 );
+	g_date_clear( &model->last_waiting, 1 );
+	g_date_clear( &model->last_validated, 1 );
+
+	for( it=model->runs ; it ; it=it->next ){
+		model_index_set_last( model, OFO_RECURRENT_RUN( it->data ));
+	}
+
+	model->dirty = FALSE;
 }
@@ -130,6 +130,8 @@ gboolean           ofo_recurrent_run_insert                ( ofoRecurrentRun *mo
 gboolean           ofo_recurrent_run_update_status         ( ofoRecurrentRun *model );
 gboolean           ofo_recurrent_run_update_amounts        ( ofoRecurrentRun *model );
 
+gboolean           ofo_recurrent_run_validate_list         ( ofaIGetter *getter, GList *runs, guint *ope_count, guint *entry_count );
+
 G_END_DECLS
 
 #endif /* __OPENBOOK_API_OFO_RECURRENT_RUN_H__ */
@@ -101,7 +101,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,					/* importable */
-				FALSE },				/* export zero as empty */
+				FALSE,					/* export zero as empty */
+				TRUE },
 		{ OFA_BOX_CSV( TFO_END ),
 				OFA_TYPE_DATE,
 				TRUE,
@@ -113,7 +114,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_CRE_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( TFO_CRE_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -137,7 +139,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_UPD_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( TFO_UPD_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -149,7 +152,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_OPE_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( TFO_OPE_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -157,7 +161,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_STATUS ),
 				OFA_TYPE_STRING,
 				TRUE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( TFO_STA_CLOSING ),
 				OFA_TYPE_DATE,
 				TRUE,
@@ -165,7 +170,8 @@ static const ofsBoxDef st_boxed_defs[] = {
 		{ OFA_BOX_CSV( TFO_STA_USER ),
 				OFA_TYPE_STRING,
 				FALSE,
-				FALSE },
+				FALSE,
+				TRUE },
 		{ OFA_BOX_CSV( TFO_STA_STAMP ),
 				OFA_TYPE_TIMESTAMP,
 				FALSE,
@@ -177,7 +183,8 @@ static const ofsBoxDef st_bools_defs[] = {
 		{ OFA_BOX_CSV( TFO_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,					/* importable */
-				FALSE },				/* export zero as empty */
+				FALSE,					/* export zero as empty */
+				TRUE },
 		{ OFA_BOX_CSV( TFO_END ),
 				OFA_TYPE_DATE,
 				TRUE,
@@ -201,7 +208,8 @@ static const ofsBoxDef st_details_defs[] = {
 		{ OFA_BOX_CSV( TFO_MNEMO ),
 				OFA_TYPE_STRING,
 				TRUE,					/* importable */
-				FALSE },				/* export zero as empty */
+				FALSE,					/* export zero as empty */
+				TRUE },
 		{ OFA_BOX_CSV( TFO_END ),
 				OFA_TYPE_DATE,
 				TRUE,
@@ -58,6 +58,8 @@ typedef struct {
 	/* runtime
 	 */
 	GList       *signaler_handlers;
+	GHashTable  *account_rows;			/* account number -> GtkTreeIter */
+	GHashTable  *entry_rows;			/* entry number -> sEntryRow */
 
 	/* while inserting entries
 	 */
@@ -68,6 +70,15 @@ typedef struct {
 
 /* store data types
  */
+/* an entry row, indexed by its entry number
+ * NB: GtkTreeStore iters persist as long as the row exists
+ */
+typedef struct {
+	ofxCounter  number;
+	GtkTreeIter iter;
+}
+	sEntryRow;
+
 static GType st_col_types[ACCENTRY_N_COLUMNS] = {
 	G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING,		/* account, label, currency */
 	G_TYPE_STRING, G_TYPE_STRING,						/* upd_user, upd_stamp */
@@ -82,13 +93,15 @@ static GType st_col_types[ACCENTRY_N_COLUMNS] = {
 
 static gint     on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaAccentryStore *self );
 static void     load_store( ofaAccentryStore *self );
+static gint     cmp_by_account( const ofoEntry *a, const ofoEntry *b );
 static void     account_insert_row( ofaAccentryStore *self, ofoAccount *account );
+static void     account_index_row( ofaAccentryStore *self, const gchar *number, GtkTreeIter *iter );
 static void     account_set_row_by_iter( ofaAccentryStore *self, ofoAccount *account, GtkTreeIter *iter );
 static void     entry_insert_row( ofaAccentryStore *self, const ofoEntry *entry );
+static void     entry_insert_row_with_parent( ofaAccentryStore *self, const ofoEntry *entry, GtkTreeIter *parent_iter );
 static void     entry_set_row_by_iter( ofaAccentryStore *store, const ofoEntry *entry, GtkTreeIter *iter );
 static gboolean find_account_by_number( ofaAccentryStore *self, const gchar *account, GtkTreeIter *iter );
 static gboolean find_entry_by_number( ofaAccentryStore *self, ofxCounter number, GtkTreeIter *iter );
-static gboolean find_entry_by_number_rec( ofaAccentryStore *self, ofxCounter number, GtkTreeIter *iter );
 static void     set_currency_new_id( ofaAccentryStore *self, const gchar *prev_id, const gchar *new_id );
 static void     set_ledger_new_id( ofaAccentryStore *self, const gchar *prev_id, const gchar *new_id );
 static void     set_ope_template_new_id( ofaAccentryStore *self, const gchar *prev_id, const gchar *new_id );
@@ -117,6 +130,8 @@ accentry_store_finalize( GObject *instance )
 	priv = ofa_accentry_store_get_instance_private( OFA_ACCENTRY_STORE( instance ));
 
 	g_free( priv->currency_code );
+	g_hash_table_unref( priv->account_rows );
+	g_hash_table_unref( priv->entry_rows );
 
 	/* chain up to the parent class */
 	G_OBJECT_CLASS( ofa_accentry_store_parent_class )->finalize( instance );
@@ -162,6 +177,8 @@ ofa_accentry_store_init( ofaAccentryStore *self )
 
 	priv->dispose_has_run = FALSE;
 	priv->signaler_handlers = NULL;
+	priv->account_rows = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
+	priv->entry_rows = g_hash_table_new_full( g_int64_hash, g_int64_equal, NULL, g_free );
 }
 
 static void
@@ -256,12 +273,19 @@ on_sort_model( GtkTreeModel *tmodel, GtkTreeIter *a, GtkTreeIter *b, ofaAccentry
 /*
  * load_store:
  * @self: this #ofaAccentryStore instance.
+ *
+ * Entries are inserted from a list sorted by account, so that the
+ * parent account row is only searched once per account.
  */
 static void
 load_store( ofaAccentryStore *self )
 {
+	static const gchar *thisfn = "ofa_accentry_store_load_store";
 	ofaAccentryStorePrivate *priv;
-	GList *dataset, *it;
+	GList *dataset, *sorted, *it;
+	GtkTreeIter parent_iter;
+	const gchar *account, *prev_account;
+	gboolean found;
 
 	priv = ofa_accentry_store_get_instance_private( self );
 
@@ -272,10 +296,31 @@ load_store( ofaAccentryStore *self )
 	}
 
 	dataset = ofo_entry_get_dataset( priv->getter );
-
-	for( it=dataset ; it ; it=it->next ){
-		entry_insert_row( self, OFO_ENTRY( it->data ));
+	sorted = g_list_sort( g_list_copy( dataset ), ( GCompareFunc ) cmp_by_account );
+	prev_account = NULL;
+	found = FALSE;
+
+	for( it=sorted ; it ; it=it->next ){
+		account = ofo_entry_get_account( OFO_ENTRY( it->data ));
+		if( !prev_account || g_strcmp0( account, prev_account )){
+			prev_account = account;
+			found = find_account_by_number( self, account, &parent_iter );
+			if( !found ){
+				g_warning( "%s: unable to find the account %s", thisfn, account );
+			}
+		}
+		if( found ){
+			entry_insert_row_with_parent( self, OFO_ENTRY( it->data ), &parent_iter );
+		}
 	}
+
+	g_list_free( sorted );
+}
+
+static gint
+cmp_by_account( const ofoEntry *a, const ofoEntry *b )
+{
+	return( g_strcmp0( ofo_entry_get_account( a ), ofo_entry_get_account( b )));
 }
 
 static void
@@ -285,6 +330,21 @@ account_insert_row( ofaAccentryStore *self, ofoAccount *account )
 
 	gtk_tree_store_insert( GTK_TREE_STORE( self ), &iter, NULL, -1 );
 	account_set_row_by_iter( self, account, &iter );
+
+	account_index_row( self, ofo_account_get_number( account ), &iter );
+}
+
+static void
+account_index_row( ofaAccentryStore *self, const gchar *number, GtkTreeIter *iter )
+{
+	ofaAccentryStorePrivate *priv;
+	GtkTreeIter *row_iter;
+
+	priv = ofa_accentry_store_get_instance_private( self );
+
+	row_iter = g_new( GtkTreeIter, 1 );
+	*row_iter = *iter;
+	g_hash_table_insert( priv->account_rows, g_strdup( number ), row_iter );
 }
 
 static void
@@ -317,20 +377,36 @@ static void
 entry_insert_row( ofaAccentryStore *self, const ofoEntry *entry )
 {
 	static const gchar *thisfn = "ofa_accentry_store_entry_insert_row";
-	GtkTreeIter iter, parent_iter;
+	GtkTreeIter parent_iter;
 	const gchar *account;
 
 	account = ofo_entry_get_account( entry );
 
 	if( find_account_by_number( self, account, &parent_iter )){
-		gtk_tree_store_insert( GTK_TREE_STORE( self ), &iter, &parent_iter, -1 );
-		entry_set_row_by_iter( self, entry, &iter );
+		entry_insert_row_with_parent( self, entry, &parent_iter );
 
 	} else {
 		g_warning( "%s: unable to find the account %s", thisfn, account );
 	}
 }
 
+static void
+entry_insert_row_with_parent( ofaAccentryStore *self, const ofoEntry *entry, GtkTreeIter *parent_iter )
+{
+	ofaAccentryStorePrivate *priv;
+	sEntryRow *row;
+
+	priv = ofa_accentry_store_get_instance_private( self );
+
+	row = g_new0( sEntryRow, 1 );
+	row->number = ofo_entry_get_number( entry );
+
+	gtk_tree_store_insert( GTK_TREE_STORE( self ), &row->iter, parent_iter, -1 );
+	entry_set_row_by_iter( self, entry, &row->iter );
+
+	g_hash_table_insert( priv->entry_rows, &row->number, row );
+}
+
 static void
 entry_set_row_by_iter( ofaAccentryStore *self, const ofoEntry *entry, GtkTreeIter *iter )
 {
@@ -344,7 +420,7 @@ entry_set_row_by_iter( ofaAccentryStore *self, const ofoEntry *entry, GtkTreeIte
 	priv = ofa_accentry_store_get_instance_private( self );
 
 	ccur = ofo_entry_get_currency( entry );
-	if( !my_collate( ccur, priv->currency_code )){
+	if( g_strcmp0( ccur, priv->currency_code )){
 		g_free( priv->currency_code );
 		priv->currency_code = g_strdup( ccur );
 		priv->currency = ofo_currency_get_by_code( priv->getter, ccur );
@@ -433,34 +509,23 @@ ofa_accentry_store_is_empty( ofaAccentryStore *store )
  * Returns: %TRUE if the account has been found.
  *
  * NB: as of 2017-09-26 (Fedora 26), it happens that the GtkTreeStore
- * doesn't resort itself when inserting a new row. So finding an account
- * implies to look at each row.
+ * doesn't resort itself when inserting a new row. Account rows are so
+ * indexed by their number rather than searched for.
  */
 static gboolean
 find_account_by_number( ofaAccentryStore *self, const gchar *account, GtkTreeIter *iter )
 {
-	gchar *row_account;
-	gint cmp;
+	ofaAccentryStorePrivate *priv;
+	GtkTreeIter *row_iter;
 
-	if( gtk_tree_model_get_iter_first( GTK_TREE_MODEL( self ), iter )){
-		while( TRUE ){
-			gtk_tree_model_get( GTK_TREE_MODEL( self ), iter, ACCENTRY_COL_ACCOUNT, &row_account, -1 );
-			cmp = my_collate( row_account, account );
-			if( 0 ){
-				g_debug( "find_account_by_number: account=%s, row_account=%s", account, row_account );
-			}
-			g_free( row_account );
-			//if( cmp >= 0 ){
-			if( cmp == 0 ){
-				return( cmp == 0 );
-			}
-			if( !gtk_tree_model_iter_next( GTK_TREE_MODEL( self ), iter )){
-				break;
-			}
-		}
+	priv = ofa_accentry_store_get_instance_private( self );
+
+	row_iter = account ? g_hash_table_lookup( priv->account_rows, account ) : NULL;
+	if( row_iter ){
+		*iter = *row_iter;
 	}
 
-	return( FALSE );
+	return( row_iter != NULL );
 }
 
 /*
@@ -469,37 +534,17 @@ find_account_by_number( ofaAccentryStore *self, const gchar *account, GtkTreeIte
 static gboolean
 find_entry_by_number( ofaAccentryStore *self, ofxCounter number, GtkTreeIter *iter )
 {
-	if( gtk_tree_model_get_iter_first( GTK_TREE_MODEL( self ), iter )){
-		if( find_entry_by_number_rec( self, number, iter )){
-			return( TRUE );
-		}
-	}
-	return( FALSE );
-}
+	ofaAccentryStorePrivate *priv;
+	sEntryRow *row;
 
-static gboolean
-find_entry_by_number_rec( ofaAccentryStore *self, ofxCounter number, GtkTreeIter *iter )
-{
-	ofxCounter row_id;
-	GtkTreeIter child_iter;
+	priv = ofa_accentry_store_get_instance_private( self );
 
-	while( TRUE ){
-		if( gtk_tree_model_iter_children( GTK_TREE_MODEL( self ), &child_iter, iter )){
-			if( find_entry_by_number_rec( self, number, &child_iter )){
-				*iter = child_iter;
-				return( TRUE );
-			}
-		}
-		gtk_tree_model_get( GTK_TREE_MODEL( self ), iter, ACCENTRY_COL_ENT_NUMBER_I, &row_id, -1 );
-		if( row_id == number ){
-			return( TRUE );
-		}
-		if( !gtk_tree_model_iter_next( GTK_TREE_MODEL( self ), iter )){
-			break;
-		}
+	row = g_hash_table_lookup( priv->entry_rows, &number );
+	if( row ){
+		*iter = row->iter;
 	}
 
-	return( FALSE );
+	return( row != NULL );
 }
 
 static void
@@ -565,13 +610,13 @@ signaler_connect_to_signaling_system( ofaAccentryStore *self )
 
 	signaler = ofa_igetter_get_signaler( priv->getter );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_NEW, G_CALLBACK( signaler_on_new_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_UPDATED, G_CALLBACK( signaler_on_updated_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 
-	handler = g_signal_connect( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
+	handler = ofa_isignaler_connect_deferrable( signaler, SIGNALER_BASE_DELETED, G_CALLBACK( signaler_on_deleted_base ), self );
 	priv->signaler_handlers = g_list_prepend( priv->signaler_handlers, ( gpointer ) handler );
 }
 
@@ -607,7 +652,9 @@ static void
 signaler_on_updated_base( ofaISignaler *signaler, ofoBase *object, const gchar *prev_id, ofaAccentryStore *self )
 {
 	static const gchar *thisfn = "ofa_accentry_store_signaler_on_updated_base";
+	ofaAccentryStorePrivate *priv;
 	GtkTreeIter iter;
+	const gchar *acc_number;
 
 	g_debug( "%s: signaler=%p, object=%p (%s), prev_id=%s, self=%p",
 			thisfn,
@@ -616,9 +663,16 @@ signaler_on_updated_base( ofaISignaler *signaler, ofoBase *object, const gchar *
 			prev_id,
 			( void * ) self );
 
+	priv = ofa_accentry_store_get_instance_private( self );
+
 	if( OFO_IS_ACCOUNT( object )){
-		if( find_account_by_number( self, prev_id, &iter )){
+		acc_number = ofo_account_get_number( OFO_ACCOUNT( object ));
+		if( find_account_by_number( self, prev_id ? prev_id : acc_number, &iter )){
 			account_set_row_by_iter( self, OFO_ACCOUNT( object ), &iter );
+			if( prev_id && g_strcmp0( prev_id, acc_number )){
+				g_hash_table_remove( priv->account_rows, prev_id );
+				account_index_row( self, acc_number, &iter );
+			}
 		}
 
 	} else if( OFO_IS_ENTRY( object )){
@@ -646,8 +700,10 @@ static void
 signaler_on_deleted_base( ofaISignaler *signaler, ofoBase *object, ofaAccentryStore *self )
 {
 	static const gchar *thisfn = "ofa_accentry_store_signaler_on_deleted_base";
+	ofaAccentryStorePrivate *priv;
 	GtkTreeIter iter;
 	const gchar *acc_number;
+	ofxCounter ent_number;
 
 	g_debug( "%s: signaler=%p, object=%p (%s), self=%p",
 			thisfn,
@@ -655,12 +711,15 @@ signaler_on_deleted_base( ofaISignaler *signaler, ofoBase *object, ofaAccentrySt
 			( void * ) object, G_OBJECT_TYPE_NAME( object ),
 			( void * ) self );
 
+	priv = ofa_accentry_store_get_instance_private( self );
+
 	if( OFO_IS_ACCOUNT( object )){
 		acc_number = ofo_account_get_number( OFO_ACCOUNT( object ));
 		if( find_account_by_number( self, acc_number, &iter )){
 			if( gtk_tree_model_iter_has_child( GTK_TREE_MODEL( self ), &iter )){
 				g_warning( "%s: deleted account %s has still at least one child", thisfn, acc_number );
 			} else {
+				g_hash_table_remove( priv->account_rows, acc_number );
 				gtk_tree_store_remove( GTK_TREE_STORE( self ), &iter );
 				g_debug( "%s: removing account %s from store", thisfn, acc_number );
 				g_signal_emit_by_name( self, "ofa-istore-need-refilter" );
@@ -670,7 +729,9 @@ signaler_on_deleted_base( ofaISignaler *signaler, ofoBase *object, ofaAccentrySt
 		}
 
 	} else if( OFO_IS_ENTRY( object )){
-		if( find_entry_by_number( self, ofo_entry_get_number( OFO_ENTRY( object )), &iter )){
+		ent_number = ofo_entry_get_number( OFO_ENTRY( object ));
+		if( find_entry_by_number( self, ent_number, &iter )){
+			g_hash_table_remove( priv->entry_rows, &ent_number );
 			gtk_tree_store_remove( GTK_TREE_STORE( self ), &iter );
 			g_signal_emit_by_name( self, "ofa-istore-need-refilter" );
 		}
@@ -148,7 +148,8 @@ static GtkWidget         *render_page_v_get_args_widget( ofaRenderPage *page );
 static const gchar       *render_page_v_get_paper_name( ofaRenderPage *page );
 static GtkPageOrientation render_page_v_get_page_orientation( ofaRenderPage *page );
 static void               render_page_v_get_print_settings( ofaRenderPage *page, GKeyFile **keyfile, gchar **group_name );
-static GList             *render_page_v_get_dataset( ofaRenderPage *page );
+static void               render_page_v_get_dataset_async( ofaRenderPage *page, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data );
+static GList             *render_page_v_get_dataset_finish( ofaRenderPage *page, GAsyncResult *result, GError **error );
 static gint               entry_cmp( ofoEntry *a, ofoEntry *b, ofaAccountBookRender *self );
 static void               render_page_v_free_dataset( ofaRenderPage *page, GList *dataset );
 static void               on_args_changed( ofaAccountBookArgs *bin, ofaAccountBookRender *page );
@@ -256,7 +257,8 @@ ofa_account_book_render_class_init( ofaAccountBookRenderClass *klass )
 	OFA_RENDER_PAGE_CLASS( klass )->get_paper_name = render_page_v_get_paper_name;
 	OFA_RENDER_PAGE_CLASS( klass )->get_page_orientation = render_page_v_get_page_orientation;
 	OFA_RENDER_PAGE_CLASS( klass )->get_print_settings = render_page_v_get_print_settings;
-	OFA_RENDER_PAGE_CLASS( klass )->get_dataset = render_page_v_get_dataset;
+	OFA_RENDER_PAGE_CLASS( klass )->get_dataset_async = render_page_v_get_dataset_async;
+	OFA_RENDER_PAGE_CLASS( klass )->get_dataset_finish = render_page_v_get_dataset_finish;
 	OFA_RENDER_PAGE_CLASS( klass )->free_dataset = render_page_v_free_dataset;
 }
 
@@ -337,11 +339,10 @@ on_args_changed( ofaAccountBookArgs *bin, ofaAccountBookRender *page )
 	g_free( message );
 }
 
-static GList *
-render_page_v_get_dataset( ofaRenderPage *page )
+static void
+render_page_v_get_dataset_async( ofaRenderPage *page, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
 {
 	ofaAccountBookRenderPrivate *priv;
-	GList *dataset, *sorted, *it;
 	ofaIAccountFilter *account_filter;
 	ofaIDateFilter *date_filter;
 
@@ -358,27 +359,35 @@ render_page_v_get_dataset( ofaRenderPage *page )
 	my_date_set_from_date( &priv->from_date, ofa_idate_filter_get_date( date_filter, IDATE_FILTER_FROM ));
 	my_date_set_from_date( &priv->to_date, ofa_idate_filter_get_date( date_filter, IDATE_FILTER_TO ));
 
-	dataset = ofo_entry_get_dataset_for_print_by_account(
-						priv->getter,
-						priv->all_accounts ? NULL : priv->from_account,
-						priv->all_accounts ? NULL : priv->to_account,
-						my_date_is_valid( &priv->from_date ) ? &priv->from_date : NULL,
-						my_date_is_valid( &priv->to_date ) ? &priv->to_date : NULL );
-
-	priv->count = g_list_length( dataset );
-
 	priv->account_new_page = ofa_account_book_args_get_new_page_per_account( priv->args_bin );
 	priv->class_new_page = ofa_account_book_args_get_new_page_per_class( priv->args_bin );
 	priv->class_subtotal = ofa_account_book_args_get_subtotal_per_class( priv->args_bin );
 
 	priv->sort_ind = ofa_account_book_args_get_sort_ind( priv->args_bin );
-	sorted = NULL;
-	for( it=dataset ; it ; it=it->next ){
-		sorted = g_list_insert_sorted_with_data( sorted, it->data, ( GCompareDataFunc ) entry_cmp, page );
-	}
-	g_list_free( dataset );
 
-	return( sorted );
+	ofo_entry_get_dataset_for_print_by_account_async(
+			priv->getter,
+			priv->all_accounts ? NULL : priv->from_account,
+			priv->all_accounts ? NULL : priv->to_account,
+			my_date_is_valid( &priv->from_date ) ? &priv->from_date : NULL,
+			my_date_is_valid( &priv->to_date ) ? &priv->to_date : NULL,
+			cancellable, callback, user_data );
+}
+
+static GList *
+render_page_v_get_dataset_finish( ofaRenderPage *page, GAsyncResult *result, GError **error )
+{
+	ofaAccountBookRenderPrivate *priv;
+	GList *dataset;
+
+	priv = ofa_account_book_render_get_instance_private( OFA_ACCOUNT_BOOK_RENDER( page ));
+
+	dataset = ofo_entry_get_dataset_for_print_finish( result, error );
+	priv->count = g_list_length( dataset );
+
+	/* the dataset comes sorted by account from the DBMS: a merge sort is
+	 * enough to apply the requested date order inside each account */
+	return( g_list_sort_with_data( dataset, ( GCompareDataFunc ) entry_cmp, page ));
 }
 
 static gint
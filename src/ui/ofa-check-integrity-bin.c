@@ -42,7 +42,6 @@
 #include "api/ofa-prefs.h"
 #include "api/ofo-account.h"
 #include "api/ofo-bat.h"
-#include "api/ofo-bat-line.h"
 #include "api/ofo-class.h"
 #include "api/ofo-concil.h"
 #include "api/ofo-currency.h"
@@ -53,7 +52,6 @@
 #include "api/ofo-ope-template.h"
 #include "api/ofo-paimean.h"
 #include "api/ofo-rate.h"
-#include "api/ofs-concil-id.h"
 #include "api/ofs-currency.h"
 
 #include "ui/ofa-check-integrity-bin.h"
@@ -89,6 +87,8 @@ typedef struct {
 	gulong         total_errs;
 
 	GList         *workers;
+	guint          sql_running;
+	gboolean       objects_done;
 
 	/* UI
 	 */
@@ -110,6 +110,43 @@ typedef struct {
 }
 	sWorker;
 
+/* a referential check run as a SQL query
+ * the query returns one row per error, the (at most SQL_MAX_ARGS)
+ * columns being the arguments of the @msgerr message
+ */
+typedef struct {
+	const gchar   *query;
+	const gchar   *msgerr;
+	const gchar   *msgok;
+}
+	sSqlCheck;
+
+#define SQL_MAX_ARGS                      3
+
+/* a group of SQL checks, run in its own thread
+ */
+typedef struct {
+	GType        ( *get_type )( void );
+	const gchar   *label;
+	const sSqlCheck *checks;
+	glong          errs_offset;
+}
+	sSqlGroup;
+
+/* the runtime data of a SQL checks group
+ */
+typedef struct {
+	ofaCheckIntegrityBin *self;
+	const sSqlGroup      *group;
+	const void           *worker;
+	ofaIDBConnect        *connect;
+	GThread              *thread;
+	gboolean              all_messages;
+	gulong                errs;
+	gulong               *priv_errs;
+}
+	sSqlRun;
+
 /* signals defined here
  */
 enum {
@@ -129,6 +166,7 @@ static void     read_settings( ofaCheckIntegrityBin *self );
 static void     write_settings( ofaCheckIntegrityBin *self );
 static gchar   *get_settings_key( ofaCheckIntegrityBin *self );
 static gboolean do_run( ofaCheckIntegrityBin *self );
+static void     do_end( ofaCheckIntegrityBin *self );
 static void     check_dossier_run( ofaCheckIntegrityBin *self );
 static void     check_class_run( ofaCheckIntegrityBin *self );
 static void     check_currency_run( ofaCheckIntegrityBin *self );
@@ -137,9 +175,10 @@ static void     check_ledgers_run( ofaCheckIntegrityBin *self );
 static void     check_ope_templates_run( ofaCheckIntegrityBin *self );
 static void     check_paimean_run( ofaCheckIntegrityBin *self );
 static void     check_rate_run( ofaCheckIntegrityBin *self );
-static void     check_entries_run( ofaCheckIntegrityBin *self );
-static void     check_bat_run( ofaCheckIntegrityBin *self );
-static void     check_concil_run( ofaCheckIntegrityBin *self );
+static void     sql_groups_start( ofaCheckIntegrityBin *self );
+static gpointer sql_group_thread( sSqlRun *srun );
+static void     sql_group_run( sSqlRun *srun );
+static gboolean sql_group_on_done( sSqlRun *srun );
 static void     set_checks_result( ofaCheckIntegrityBin *self );
 static void     on_grid_size_allocate( GtkWidget *grid, GdkRectangle *allocation, ofaCheckIntegrityBin *self );
 static void     iprogress_iface_init( myIProgressInterface *iface );
@@ -163,9 +202,6 @@ static checkfn st_fn[] = {
 		check_ope_templates_run,
 		check_paimean_run,
 		check_rate_run,
-		check_entries_run,
-		check_bat_run,
-		check_concil_run,
 		0
 };
 
@@ -439,15 +475,40 @@ do_run( ofaCheckIntegrityBin *self )
 {
 	ofaCheckIntegrityBinPrivate *priv;
 	gint i;
-	ofaExtenderCollection *extenders;
-	GList *plugins, *it;
 
 	priv = ofa_check_integrity_bin_get_instance_private( self );
 
+	priv->sql_running = 0;
+	priv->objects_done = FALSE;
+
+	sql_groups_start( self );
+
 	for( i=0 ; st_fn[i] ; ++i ){
 		( *st_fn[i] )( self );
 	}
 
+	priv->objects_done = TRUE;
+
+	if( priv->sql_running == 0 ){
+		do_end( self );
+	}
+
+	/* do not continue and remove from idle callbacks list */
+	return( G_SOURCE_REMOVE );
+}
+
+/*
+ * Called when both the objects checks and the SQL checks are done.
+ */
+static void
+do_end( ofaCheckIntegrityBin *self )
+{
+	ofaCheckIntegrityBinPrivate *priv;
+	ofaExtenderCollection *extenders;
+	GList *plugins, *it;
+
+	priv = ofa_check_integrity_bin_get_instance_private( self );
+
 	extenders = ofa_igetter_get_extender_collection( priv->getter );
 	plugins = ofa_extender_collection_get_for_type( extenders, OFA_TYPE_IDBMODEL );
 	for( it=plugins ; it ; it=it->next ){
@@ -458,9 +519,6 @@ do_run( ofaCheckIntegrityBin *self )
 	set_checks_result( self );
 
 	g_signal_emit_by_name( self, "ofa-done", priv->total_errs );
-
-	/* do not continue and remove from idle callbacks list */
-	return( G_SOURCE_REMOVE );
 }
 
 /*
@@ -1497,448 +1555,286 @@ check_rate_run( ofaCheckIntegrityBin *self )
 }
 
 /*
- * check for entries integrity
+ * Entries, BAT files and conciliation groups are checked with SQL
+ * anti-join queries rather than by loading their whole dataset.
+ *
+ * Each group of checks is run in its own thread, on its own connection,
+ * so that the groups are checked concurrently, while the other checks
+ * are run from the main thread. The myIProgress interface takes care
+ * of forwarding the progression to the main thread.
+ */
+static const sSqlCheck st_entries_checks[] = {
+		{ "SELECT ENT_NUMBER FROM OFA_T_ENTRIES "
+			"	WHERE ENT_ACCOUNT IS NULL OR ENT_ACCOUNT=''",
+			N_( "Entry %s doesn't have account" ),
+			N_( "All entries have an account: OK" ) },
+		{ "SELECT e.ENT_NUMBER,e.ENT_ACCOUNT FROM OFA_T_ENTRIES e "
+			"	LEFT JOIN OFA_T_ACCOUNTS a ON a.ACC_NUMBER=e.ENT_ACCOUNT "
+			"	WHERE e.ENT_ACCOUNT!='' AND a.ACC_NUMBER IS NULL",
+			N_( "Entry %s has account %s which doesn't exist" ),
+			N_( "All entry accounts exist: OK" ) },
+		{ "SELECT ENT_NUMBER FROM OFA_T_ENTRIES "
+			"	WHERE ENT_CURRENCY IS NULL OR ENT_CURRENCY=''",
+			N_( "Entry %s doesn't have a currency" ),
+			N_( "All entries have a currency: OK" ) },
+		{ "SELECT e.ENT_NUMBER,e.ENT_CURRENCY FROM OFA_T_ENTRIES e "
+			"	LEFT JOIN OFA_T_CURRENCIES c ON c.CUR_CODE=e.ENT_CURRENCY "
+			"	WHERE e.ENT_CURRENCY!='' AND c.CUR_CODE IS NULL",
+			N_( "Entry %s has currency '%s' which doesn't exist" ),
+			N_( "All entry currencies exist: OK" ) },
+		{ "SELECT ENT_NUMBER FROM OFA_T_ENTRIES "
+			"	WHERE ENT_LEDGER IS NULL OR ENT_LEDGER=''",
+			N_( "Entry %s doesn't have a ledger" ),
+			N_( "All entries have a ledger: OK" ) },
+		{ "SELECT e.ENT_NUMBER,e.ENT_LEDGER FROM OFA_T_ENTRIES e "
+			"	LEFT JOIN OFA_T_LEDGERS l ON l.LED_MNEMO=e.ENT_LEDGER "
+			"	WHERE e.ENT_LEDGER!='' AND l.LED_MNEMO IS NULL",
+			N_( "Entry %s has ledger '%s' which doesn't exist" ),
+			N_( "All entry ledgers exist: OK" ) },
+		{ "SELECT e.ENT_NUMBER,e.ENT_OPE_TEMPLATE FROM OFA_T_ENTRIES e "
+			"	LEFT JOIN OFA_T_OPE_TEMPLATES o ON o.OTE_MNEMO=e.ENT_OPE_TEMPLATE "
+			"	WHERE e.ENT_OPE_TEMPLATE!='' AND o.OTE_MNEMO IS NULL",
+			N_( "Entry %s has operation template '%s' which doesn't exist" ),
+			N_( "All entry operation templates exist: OK" ) },
+		{ "SELECT d.ENT_DOC_ID,d.ENT_NUMBER FROM OFA_T_ENTRIES_DOC d "
+			"	LEFT JOIN OFA_T_DOCS o ON o.DOC_ID=d.ENT_DOC_ID "
+			"	WHERE o.DOC_ID IS NULL",
+			N_( "Found orphan entry document with DocId %s (entry %s)" ),
+			N_( "All entry documents exist: OK" ) },
+		{ "SELECT DISTINCT(d.ENT_NUMBER) FROM OFA_T_ENTRIES_DOC d "
+			"	LEFT JOIN OFA_T_ENTRIES e ON e.ENT_NUMBER=d.ENT_NUMBER "
+			"	WHERE e.ENT_NUMBER IS NULL",
+			N_( "Found orphan entry document with EntNumber %s" ),
+			N_( "No orphan entry document found: OK" ) },
+		{ 0 }
+};
+
+static const sSqlCheck st_bat_checks[] = {
+		{ "SELECT b.BAT_ID,b.BAT_CURRENCY FROM OFA_T_BAT b "
+			"	LEFT JOIN OFA_T_CURRENCIES c ON c.CUR_CODE=b.BAT_CURRENCY "
+			"	WHERE b.BAT_CURRENCY!='' AND c.CUR_CODE IS NULL",
+			N_( "BAT file %s currency '%s' doesn't exist" ),
+			N_( "All BAT file currencies exist: OK" ) },
+		{ "SELECT b.BAT_ID,b.BAT_ACCOUNT FROM OFA_T_BAT b "
+			"	LEFT JOIN OFA_T_ACCOUNTS a ON a.ACC_NUMBER=b.BAT_ACCOUNT "
+			"	WHERE b.BAT_ACCOUNT!='' AND a.ACC_NUMBER IS NULL",
+			N_( "BAT file %s account '%s' doesn't exist" ),
+			N_( "All BAT file accounts exist: OK" ) },
+		{ "SELECT l.BAT_LINE_ID,l.BAT_ID,l.BAT_LINE_CURRENCY FROM OFA_T_BAT_LINES l "
+			"	LEFT JOIN OFA_T_CURRENCIES c ON c.CUR_CODE=l.BAT_LINE_CURRENCY "
+			"	WHERE l.BAT_LINE_CURRENCY!='' AND c.CUR_CODE IS NULL",
+			N_( "BAT line %s (from BAT file %s) currency '%s' doesn't exist" ),
+			N_( "All BAT line currencies exist: OK" ) },
+		{ "SELECT DISTINCT(l.BAT_ID) FROM OFA_T_BAT_LINES l "
+			"	LEFT JOIN OFA_T_BAT b ON b.BAT_ID=l.BAT_ID "
+			"	WHERE b.BAT_ID IS NULL",
+			N_( "Found orphan BAT detail line with BatId %s" ),
+			N_( "No orphan BAT line found: OK" ) },
+		{ "SELECT d.BAT_DOC_ID,d.BAT_ID FROM OFA_T_BAT_DOC d "
+			"	LEFT JOIN OFA_T_DOCS o ON o.DOC_ID=d.BAT_DOC_ID "
+			"	WHERE o.DOC_ID IS NULL",
+			N_( "Found orphan document(s) with DocId %s (BAT file %s)" ),
+			N_( "All BAT documents exist: OK" ) },
+		{ "SELECT DISTINCT(d.BAT_ID) FROM OFA_T_BAT_DOC d "
+			"	LEFT JOIN OFA_T_BAT b ON b.BAT_ID=d.BAT_ID "
+			"	WHERE b.BAT_ID IS NULL",
+			N_( "Found orphan document(s) with BatId %s" ),
+			N_( "No orphan BAT document found: OK" ) },
+		{ 0 }
+};
+
+static const sSqlCheck st_concil_checks[] = {
+		{ "SELECT REC_IDS_TYPE,REC_ID FROM OFA_T_CONCIL_IDS "
+			"	WHERE REC_IDS_TYPE NOT IN ('" CONCIL_TYPE_BAT "','" CONCIL_TYPE_ENTRY "')",
+			N_( "Found invalid type '%s' in a detail of conciliation group %s" ),
+			N_( "All conciliation members have a valid type: OK" ) },
+		{ "SELECT i.REC_IDS_OTHER,i.REC_ID FROM OFA_T_CONCIL_IDS i "
+			"	LEFT JOIN OFA_T_BAT_LINES l ON l.BAT_LINE_ID=i.REC_IDS_OTHER "
+			"	WHERE i.REC_IDS_TYPE='" CONCIL_TYPE_BAT "' AND l.BAT_LINE_ID IS NULL",
+			N_( "Found orphan conciliation member with BatLineId %s in conciliation group %s" ),
+			N_( "All conciliated BAT lines exist: OK" ) },
+		{ "SELECT i.REC_IDS_OTHER,i.REC_ID FROM OFA_T_CONCIL_IDS i "
+			"	LEFT JOIN OFA_T_ENTRIES e ON e.ENT_NUMBER=i.REC_IDS_OTHER "
+			"	WHERE i.REC_IDS_TYPE='" CONCIL_TYPE_ENTRY "' AND e.ENT_NUMBER IS NULL",
+			N_( "Found orphan conciliation member with EntryId %s in conciliation group %s" ),
+			N_( "All conciliated entries exist: OK" ) },
+		{ "SELECT DISTINCT(i.REC_ID) FROM OFA_T_CONCIL_IDS i "
+			"	LEFT JOIN OFA_T_CONCIL c ON c.REC_ID=i.REC_ID "
+			"	WHERE c.REC_ID IS NULL",
+			N_( "Found orphan conciliation member with ConcilId %s" ),
+			N_( "No orphan conciliation member found: OK" ) },
+		{ 0 }
+};
+
+static const sSqlGroup st_sql_groups[] = {
+		{ ofo_entry_get_type,
+				N_( " Check for entries integrity " ),
+				st_entries_checks,
+				G_STRUCT_OFFSET( ofaCheckIntegrityBinPrivate, entries_errs ) },
+		{ ofo_bat_get_type,
+				N_( " Check for BAT files and lines integrity " ),
+				st_bat_checks,
+				G_STRUCT_OFFSET( ofaCheckIntegrityBinPrivate, bat_errs ) },
+		{ ofo_concil_get_type,
+				N_( " Check for conciliation groups integrity " ),
+				st_concil_checks,
+				G_STRUCT_OFFSET( ofaCheckIntegrityBinPrivate, concil_errs ) },
+		{ 0 }
+};
+
+/*
+ * Run the SQL checks groups, each in its own thread.
+ *
+ * If a dedicated connection cannot be opened, the group is run
+ * synchronously on the dossier connection.
  */
 static void
-check_entries_run( ofaCheckIntegrityBin *self )
+sql_groups_start( ofaCheckIntegrityBin *self )
 {
 	ofaCheckIntegrityBinPrivate *priv;
-	const void *worker;
+	ofaHub *hub;
+	ofaIDBConnect *connect;
+	sSqlRun *srun;
 	GtkWidget *label;
-	GList *entries, *it, *orphans, *ito;
-	gulong count, i, enterrs;
-	ofoEntry *entry;
-	gchar *str;
-	ofxCounter number, docid;
-	const gchar *acc_number, *cur_code, *led_mnemo, *ope_mnemo;
-	ofoAccount *acc_obj;
-	ofoCurrency *cur_obj;
-	ofoLedger *led_obj;
-	ofoOpeTemplate *ope_obj;
+	gint i;
 
 	priv = ofa_check_integrity_bin_get_instance_private( self );
 
-	worker = GUINT_TO_POINTER( OFO_TYPE_ENTRY );
-
-	if( priv->display ){
-		label = gtk_label_new( _( " Check for entries integrity " ));
-		my_iprogress_start_work( MY_IPROGRESS( self ), worker, label );
-		my_iprogress_start_progress( MY_IPROGRESS( self ), worker, NULL, TRUE );
-	}
-
-	priv->entries_errs = 0;
-	entries = ofo_entry_get_dataset( priv->getter );
-	count = 1 + 5*g_list_length( entries );
-	i = 0;
-
-	if( count == 0 ){
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, 0, 0 );
-	}
-
-	for( it=entries ; it ; it=it->next ){
-		entry = OFO_ENTRY( it->data );
-		number = ofo_entry_get_number( entry );
-		enterrs = 0;
-
-		/* account must be set and exist */
-		acc_number = ofo_entry_get_account( entry );
-		if( !my_strlen( acc_number )){
-			str = g_strdup_printf(
-					_( "Entry %lu doesn't have account" ), number );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->entries_errs += 1;
-			enterrs += 1;
-		} else {
-			acc_obj = ofo_account_get_by_number( priv->getter, acc_number );
-			if( !acc_obj || !OFO_IS_ACCOUNT( acc_obj )){
-				str = g_strdup_printf(
-						_( "Entry %lu has account %s which doesn't exist" ), number, acc_number );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->entries_errs += 1;
-				enterrs += 1;
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+	hub = ofa_igetter_get_hub( priv->getter );
+	connect = ofa_hub_get_connect( hub );
 
-		/* currency must be set and exist */
-		cur_code = ofo_entry_get_currency( entry );
-		if( !my_strlen( cur_code )){
-			str = g_strdup_printf( _( "Entry %lu doesn't have a currency" ), number );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->entries_errs += 1;
-			enterrs += 1;
-		} else {
-			cur_obj = ofo_currency_get_by_code( priv->getter, cur_code );
-			if( !cur_obj || !OFO_IS_CURRENCY( cur_obj )){
-				str = g_strdup_printf(
-						_( "Entry %lu has currency '%s' which doesn't exist" ), number, cur_code );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->entries_errs += 1;
-				enterrs += 1;
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+	for( i=0 ; st_sql_groups[i].checks ; ++i ){
+		srun = g_new0( sSqlRun, 1 );
+		srun->self = g_object_ref( self );
+		srun->group = &st_sql_groups[i];
+		srun->worker = GUINT_TO_POINTER( srun->group->get_type());
+		srun->all_messages = priv->all_messages;
+		srun->priv_errs = ( gulong * )(( guchar * ) priv + srun->group->errs_offset );
+		*srun->priv_errs = 0;
 
-		/* ledger must be set and exist */
-		led_mnemo = ofo_entry_get_ledger( entry );
-		if( !my_strlen( led_mnemo )){
-			str = g_strdup_printf( _( "Entry %lu doesn't have a ledger" ), number );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->entries_errs += 1;
-			enterrs += 1;
-		} else {
-			led_obj = ofo_ledger_get_by_mnemo( priv->getter, led_mnemo );
-			if( !led_obj || !OFO_IS_LEDGER( led_obj )){
-				str = g_strdup_printf(
-						_( "Entry %lu has ledger '%s' which doesn't exist" ), number, led_mnemo );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->entries_errs += 1;
-				enterrs += 1;
-			}
+		/* widgets are created from the main thread */
+		if( priv->display ){
+			label = gtk_label_new( _( srun->group->label ));
+			my_iprogress_start_work( MY_IPROGRESS( self ), srun->worker, label );
+			my_iprogress_start_progress( MY_IPROGRESS( self ), srun->worker, NULL, TRUE );
 		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
 
-		/* ope template is not mandatory, but must exist if set */
-		ope_mnemo = ofo_entry_get_ope_template( entry );
-		if( my_strlen( ope_mnemo )){
-			ope_obj = ofo_ope_template_get_by_mnemo( priv->getter, ope_mnemo );
-			if( !ope_obj || !OFO_IS_OPE_TEMPLATE( ope_obj )){
-				str = g_strdup_printf(
-						_( "Entry %lu has operation template '%s' which doesn't exist" ), number, ope_mnemo );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->entries_errs += 1;
-				enterrs += 1;
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+		priv->sql_running += 1;
+		srun->connect = ofa_idbconnect_duplicate( connect );
 
-		/* check for referenced documents which actually do not exist */
-		orphans = ofa_idoc_get_orphans( OFA_IDOC( entry ));
-		if( g_list_length( orphans ) > 0 ){
-			for( ito=orphans ; ito ; ito=ito->next ){
-				docid = ( ofxCounter ) ito->data;
-				str = g_strdup_printf( _( "Found orphan entry document with DocId %lu" ), docid );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->entries_errs += 1;
-				enterrs += 1;
-			}
-		}
-		ofa_idoc_free_orphans( orphans );
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+		if( srun->connect ){
+			srun->thread = g_thread_new( "ofa-check-integrity", ( GThreadFunc ) sql_group_thread, srun );
 
-		if( enterrs == 0 && priv->all_messages ){
-			str = g_strdup_printf( _( "Entry %lu does not exhibit any error: OK" ), number );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, str );
-			g_free( str );
+		} else {
+			srun->connect = g_object_ref( connect );
+			sql_group_run( srun );
+			sql_group_on_done( srun );
 		}
 	}
+}
 
-	/* check for orphans which no more have an entry parent */
-	orphans = ofo_entry_doc_get_orphans( priv->getter );
-	if( g_list_length( orphans ) > 0 ){
-		for( it=orphans ; it ; it=it->next ){
-			str = g_strdup_printf( _( "Found orphan entry document with EntNumber %lu" ), ( ofxCounter ) it->data );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->entries_errs += 1;
-		}
-	} else if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, _( "No orphan entry document found: OK" ));
-	}
-	ofo_entry_doc_free_orphans( orphans );
-	my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+static gpointer
+sql_group_thread( sSqlRun *srun )
+{
+	ofa_idbconnect_thread_init( srun->connect );
+	sql_group_run( srun );
+	ofa_idbconnect_thread_end( srun->connect );
 
-	/* progress end */
-	if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NONE, "" );
-	}
-	my_iprogress_set_ok( MY_IPROGRESS( self ), worker, NULL, priv->entries_errs );
+	/* idle callbacks being dispatched in the order they have been
+	 * added, this one comes after the last progression of the group */
+	g_idle_add(( GSourceFunc ) sql_group_on_done, srun );
+
+	return( NULL );
 }
 
 /*
- * Check that BAT files are OK
- *
- * for each BAT file:
- * - check that currency exists (but may be empty)
- * - check that account exists (but may be empty)
- * - check that referenced documents exist
- * - for each BAT line:
- *   > check that currency exists (but may be empty)
- * +
- * - check for orphan referenced documents
- * - check for orphan BAT lines
+ * Each query returns one row per error, the columns being the
+ * arguments of the error message.
  */
 static void
-check_bat_run( ofaCheckIntegrityBin *self )
+sql_group_run( sSqlRun *srun )
 {
-	ofaCheckIntegrityBinPrivate *priv;
-	const void *worker;
-	GtkWidget *label;
-	gulong count, i, baterrs;
-	GList *bats, *it, *lines, *itl, *orphans, *ito;
-	ofoBat *bat;
-	ofoBatLine *line;
-	const gchar *cur_code, *acc_number;
-	ofoCurrency *cur_obj;
-	ofoAccount *acc_obj;
+	myIProgress *instance;
+	const sSqlCheck *check;
+	gulong count, i, errs, checkerrs;
+	GSList *result, *irow, *icol;
+	const gchar *args[SQL_MAX_ARGS];
 	gchar *str;
-	ofxCounter id, idline, docid;
-
-	priv = ofa_check_integrity_bin_get_instance_private( self );
-
-	worker = GUINT_TO_POINTER( OFO_TYPE_BAT );
+	guint j;
 
-	if( priv->display ){
-		label = gtk_label_new( _( " Check for BAT files and lines integrity " ));
-		my_iprogress_start_work( MY_IPROGRESS( self ), worker, label );
-		my_iprogress_start_progress( MY_IPROGRESS( self ), worker, NULL, TRUE );
-	}
+	instance = MY_IPROGRESS( srun->self );
 
-	priv->bat_errs = 0;
-	bats = ofo_bat_get_dataset( priv->getter );
-	count = 2 + 4*g_list_length( bats );
+	for( count=0 ; srun->group->checks[count].query ; ++count )
+		;
 	i = 0;
+	errs = 0;
 
-	if( count == 0 ){
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, 0, 0 );
-	}
-
-	for( it=bats ; it ; it=it->next ){
-		bat = OFO_BAT( it->data );
-		id = ofo_bat_get_id( bat );
-		baterrs = 0;
-
-		/* it is ok for a BAT file to not have a currency set */
-		cur_code = ofo_bat_get_currency( bat );
-		if( my_strlen( cur_code )){
-			cur_obj = ofo_currency_get_by_code( priv->getter, cur_code );
-			if( !cur_obj || !OFO_IS_CURRENCY( cur_obj )){
-				str = g_strdup_printf( _( "BAT file %lu currency '%s' doesn't exist" ), id, cur_code );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->bat_errs += 1;
-				baterrs += 1;
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
-
-		/* it is ok for a BAT file to not have an account set */
-		acc_number = ofo_bat_get_account( bat );
-		if( my_strlen( acc_number )){
-			acc_obj = ofo_account_get_by_number( priv->getter, acc_number );
-			if( !acc_obj || !OFO_IS_ACCOUNT( acc_obj )){
-				str = g_strdup_printf( _( "BAT file %lu account '%s' doesn't exist" ), id, acc_number );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->bat_errs += 1;
-				baterrs += 1;
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
-
-		lines = ofo_bat_line_get_dataset( priv->getter, id );
-		for( itl=lines ; itl ; itl=itl->next ){
-			line = OFO_BAT_LINE( itl->data );
-			idline = ofo_bat_line_get_line_id( line );
+	for( check=srun->group->checks ; check->query ; ++check ){
+		checkerrs = 0;
 
-			/* it is ok for a BAT line to not have a currency */
-			cur_code = ofo_bat_line_get_currency( line );
-			if( my_strlen( cur_code )){
-				cur_obj = ofo_currency_get_by_code( priv->getter, cur_code );
-				if( !cur_obj || !OFO_IS_CURRENCY( cur_obj )){
-					str = g_strdup_printf(
-							_( "BAT line %lu (from BAT file %lu) currency '%s' doesn't exist" ),
-							idline, id, cur_code );
-					my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-					g_free( str );
-					priv->bat_errs += 1;
-					baterrs += 1;
+		if( ofa_idbconnect_query_ex( srun->connect, check->query, &result, FALSE )){
+			for( irow=result ; irow ; irow=irow->next ){
+				for( j=0, icol=irow->data ; j<SQL_MAX_ARGS ; ++j ){
+					args[j] = icol && icol->data ? ( const gchar * ) icol->data : "";
+					icol = icol ? icol->next : NULL;
 				}
-			}
-		}
-		ofo_bat_line_free_dataset( lines );
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
-
-		/* check for referenced documents which actually do not exist */
-		orphans = ofa_idoc_get_orphans( OFA_IDOC( bat ));
-		if( g_list_length( orphans ) > 0 ){
-			for( ito=orphans ; ito ; ito=ito->next ){
-				docid = ( ofxCounter ) ito->data;
-				str = g_strdup_printf( _( "Found orphan document(s) with DocId %lu" ), docid );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
+				str = g_strdup_printf( _( check->msgerr ), args[0], args[1], args[2] );
+				my_iprogress_set_text( instance, srun->worker, MY_PROGRESS_ERROR, str );
 				g_free( str );
-				priv->bat_errs += 1;
-				baterrs += 1;
+				checkerrs += 1;
 			}
-		}
-		ofa_idoc_free_orphans( orphans );
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
+			ofa_idbconnect_free_results( result );
 
-		if( baterrs == 0 && priv->all_messages ){
-			str = g_strdup_printf( _( "BAT file %lu does not exhibit any error: OK" ), id );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, str );
+		} else {
+			str = ofa_idbconnect_get_last_error( srun->connect );
+			my_iprogress_set_text( instance, srun->worker, MY_PROGRESS_ERROR, str ? str : check->query );
 			g_free( str );
+			checkerrs += 1;
 		}
-	}
 
-	/* check that all details have a parent */
-	orphans = ofo_bat_line_get_orphans( priv->getter );
-	if( g_list_length( orphans ) > 0 ){
-		for( ito=orphans ; ito ; ito=ito->next ){
-			str = g_strdup_printf( _( "Found orphan BAT detail line with BatId %lu" ), ( ofxCounter ) ito->data );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->bat_errs += 1;
+		if( checkerrs == 0 && srun->all_messages ){
+			my_iprogress_set_text( instance, srun->worker, MY_PROGRESS_NORMAL, _( check->msgok ));
 		}
-	} else if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, _( "No orphan BAT line found: OK" ));
-	}
-	ofo_bat_line_free_orphans( orphans );
-	my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
 
-	/* check that all BAT documents have a parent */
-	orphans = ofo_bat_doc_get_orphans( priv->getter );
-	if( g_list_length( orphans ) > 0 ){
-		for( it=orphans ; it ; it=it->next ){
-			g_debug( "check_bat_run: data=%s data=%p data=%lu",
-					( const gchar * ) it->data, ( void * ) it->data, ( gulong ) it->data );
-			str = g_strdup_printf( _( "Found orphan document(s) with BatId %lu" ), ( ofxCounter ) it->data );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->bat_errs += 1;
-		}
-	} else if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, _( "No orphan BAT document found: OK" ));
+		errs += checkerrs;
+		my_iprogress_pulse( instance, srun->worker, ++i, count );
 	}
-	ofo_bat_doc_free_orphans( orphans );
-	my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
 
 	/* progress end */
-	if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NONE, "" );
+	if( srun->all_messages ){
+		my_iprogress_set_text( instance, srun->worker, MY_PROGRESS_NONE, "" );
 	}
-	my_iprogress_set_ok( MY_IPROGRESS( self ), worker, NULL, priv->bat_errs );
+	my_iprogress_set_ok( instance, srun->worker, NULL, errs );
+
+	srun->errs = errs;
 }
 
 /*
- * Check ofoConcil conciliation groups
- *
- * For each concilitation group:
- * - for each conciliation detail:
- *   > check type validity
- *   > check that other exists
- * +
- * check for detail orphans
+ * Called from the main thread at the end of a SQL checks group.
  */
-static void
-check_concil_run( ofaCheckIntegrityBin *self )
+static gboolean
+sql_group_on_done( sSqlRun *srun )
 {
 	ofaCheckIntegrityBinPrivate *priv;
-	const void *worker;
-	GtkWidget *label;
-	gulong count, i, concilerrs;
-	GList *concils, *it, *details, *itd, *orphans;
-	gchar *str;
-	ofoConcil *concil;
-	ofxCounter id, batid;
-	ofsConcilId *sid;
-	ofoEntry *entry;
-
-	priv = ofa_check_integrity_bin_get_instance_private( self );
 
-	worker = GUINT_TO_POINTER( OFO_TYPE_BAT );
+	priv = ofa_check_integrity_bin_get_instance_private( srun->self );
 
-	if( priv->display ){
-		label = gtk_label_new( _( " Check for conciliation groups integrity " ));
-		my_iprogress_start_work( MY_IPROGRESS( self ), worker, label );
-		my_iprogress_start_progress( MY_IPROGRESS( self ), worker, NULL, TRUE );
+	if( srun->thread ){
+		g_thread_join( srun->thread );
 	}
 
-	priv->concil_errs = 0;
-	concils = ofo_concil_get_dataset( priv->getter );
-	count = 1 + g_list_length( concils );
-	i = 0;
+	*srun->priv_errs = srun->errs;
+	priv->sql_running -= 1;
 
-	if( count == 0 ){
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, 0, 0 );
+	if( priv->sql_running == 0 && priv->objects_done && !priv->dispose_has_run ){
+		do_end( srun->self );
 	}
 
-	for( it=concils ; it ; it=it->next ){
-		concil = OFO_CONCIL( it->data );
-		id = ofo_concil_get_id( concil );
-		concilerrs = 0;
+	g_object_unref( srun->connect );
+	g_object_unref( srun->self );
+	g_free( srun );
 
-		/* check each detail lines */
-		details = ofo_concil_get_ids( concil );
-		for( itd=details ; itd ; itd=itd->next ){
-			sid = ( ofsConcilId * ) itd->data;
-
-			/* check type validity */
-			if( g_utf8_collate( sid->type, CONCIL_TYPE_BAT ) && g_utf8_collate( sid->type, CONCIL_TYPE_ENTRY )){
-				str = g_strdup_printf( _( "Found invalid type '%s' in a detail of conciliation group %lu" ), sid->type, id );
-				my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-				g_free( str );
-				priv->concil_errs += 1;
-				concilerrs += 1;
-			}
-
-			/* check that referenced line exists */
-			if( !g_utf8_collate( sid->type, CONCIL_TYPE_BAT )){
-				batid = ofo_bat_line_get_bat_id_from_bat_line_id( priv->getter, sid->other_id );
-				if( !batid ){
-					str = g_strdup_printf( _( "Found orphan conciliation member with BatLineId %lu in conciliation group %lu" ), sid->other_id, id );
-					my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-					g_free( str );
-					priv->concil_errs += 1;
-					concilerrs += 1;
-				}
-			}
-			if( !g_utf8_collate( sid->type, CONCIL_TYPE_ENTRY )){
-				entry = ofo_entry_get_by_number( priv->getter, sid->other_id );
-				if( !entry ){
-					str = g_strdup_printf( _( "Found orphan conciliation member with EntryId %lu in conciliation group %lu" ), sid->other_id, id );
-					my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-					g_free( str );
-					priv->concil_errs += 1;
-					concilerrs += 1;
-				}
-			}
-		}
-		my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
-
-		if( priv->all_messages ){
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, _( "No error found in conciliation group: OK" ));
-		}
-	}
-
-	/* check that all details have a parent */
-	orphans = ofo_concil_get_concil_orphans( priv->getter );
-	if( g_list_length( orphans ) > 0 ){
-		for( it=orphans ; it ; it=it->next ){
-			str = g_strdup_printf( _( "Found orphan conciliation member with ConcilId %lu" ), ( ofxCounter ) it->data );
-			my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_ERROR, str );
-			g_free( str );
-			priv->concil_errs += 1;
-		}
-	} else if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NORMAL, _( "No orphan conciliation member found: OK" ));
-	}
-	ofo_concil_free_concil_orphans( orphans );
-	my_iprogress_pulse( MY_IPROGRESS( self ), worker, ++i, count );
-
-	/* progress end */
-	if( priv->all_messages ){
-		my_iprogress_set_text( MY_IPROGRESS( self ), worker, MY_PROGRESS_NONE, "" );
-	}
-	my_iprogress_set_ok( MY_IPROGRESS( self ), worker, NULL, priv->concil_errs );
+	return( G_SOURCE_REMOVE );
 }
 
 /*
@@ -29,8 +29,10 @@
 #include <glib/gi18n.h>
 #include <glib/gstdio.h>
 #include <math.h>
+#include <stdlib.h>
 
 #include "my/my-date-editable.h"
+#include "my/my-double.h"
 #include "my/my-iassistant.h"
 #include "my/my-ibin.h"
 #include "my/my-iwindow.h"
@@ -151,6 +153,31 @@ typedef struct {
 }
 	sClose;
 
+/* the balances of an account in the current exercice, as read from
+ * the entries by p6_get_account_soldes()
+ */
+typedef struct {
+	ofxAmount   rough_debit;			/* rough entries, but solde ones */
+	ofxAmount   rough_credit;
+	ofxAmount   bal_debit;				/* validated entries, plus solde ones */
+	ofxAmount   bal_credit;
+	ofxAmount   close_debit;			/* solde entries (with closing rule) */
+	ofxAmount   close_credit;
+	ofxCounter  close_stlmt;
+}
+	sAccountSolde;
+
+/* the solde and forward operations prepared for an account
+ */
+typedef struct {
+	ofoAccount *account;
+	gboolean    is_ran;
+	GList      *sld_entries;
+	GList      *for_entries;
+	ofxCounter  stlmt_number;
+}
+	sSoldeOpe;
+
 #define EXECLOSE_CLOSING_DATA           "execlose-closing-data"
 #define EXECLOSE_OPENING_DATA           "execlose-opening-data"
 
@@ -200,7 +227,10 @@ static gboolean       p6_plugin_closing( ofaExerciceCloseAssistant *self );
 static gboolean       p6_validate_entries( ofaExerciceCloseAssistant *self );
 static gboolean       p6_solde_accounts( ofaExerciceCloseAssistant *self );
 static gint           p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui );
+static GHashTable    *p6_get_account_soldes( ofaExerciceCloseAssistant *self );
+static GList         *p6_generate_entries( ofoOpeTemplate *template, const gchar *account, const GDate *deffect, ofxAmount debit, ofxAmount credit, gint *errors );
 static void           p6_set_forward_settlement_number( GList *entries, const gchar *account, ofxCounter counter );
+static void           p6_reload_concils( ofaExerciceCloseAssistant *self );
 static gboolean       p6_close_ledgers( ofaExerciceCloseAssistant *self );
 static gboolean       p6_archive_exercice( ofaExerciceCloseAssistant *self );
 static gboolean       p6_do_archive_db_open_new( ofaExerciceCloseAssistant *self, gboolean with_ui );
@@ -1236,6 +1266,7 @@ p6_validate_entries( ofaExerciceCloseAssistant *self )
 	gchar *sstart, *send;
 	gulong udelay;
 	myStampVal *stamp_start, *stamp_end;
+	ofaISignaler *signaler;
 
 	g_debug( "%s: self=%p", thisfn, ( void * ) self );
 
@@ -1248,12 +1279,26 @@ p6_validate_entries( ofaExerciceCloseAssistant *self )
 	bar = get_new_bar( self, "p6-validating" );
 	gtk_widget_show_all( priv->p6_page );
 
+	signaler = ofa_igetter_get_signaler( priv->getter );
+	ofa_isignaler_begin_batch( signaler );
+
 	for( it=entries ; it ; it=it->next ){
 		entry = OFO_ENTRY( it->data );
-		g_return_val_if_fail( ofo_entry_get_period( entry ) == ENT_PERIOD_CURRENT, G_SOURCE_REMOVE );
+		if( ofo_entry_get_period( entry ) != ENT_PERIOD_CURRENT ){
+			g_warning( "%s: entry %lu is not in the current period", thisfn, ofo_entry_get_number( entry ));
+			break;
+		}
 		ofo_entry_validate( entry );
 		update_bar( bar, &i, count, thisfn );
 	}
+
+	ofa_isignaler_end_batch( signaler );
+
+	if( it ){
+		ofo_entry_free_dataset( entries );
+		my_stamp_free( stamp_start );
+		return( G_SOURCE_REMOVE );
+	}
 	if( count == 0 ){
 		g_signal_emit_by_name( bar, "my-text", "0/0" );
 	}
@@ -1300,6 +1345,15 @@ p6_solde_accounts( ofaExerciceCloseAssistant *self )
  * As all remaining rough entries have been previously validated, the
  * accounts rough balances should be zero.
  *
+ * The balances are read from the entries with only one aggregate
+ * query. The solde entries are then all inserted inside of a single
+ * transaction, so that nothing is written if an error occurs.
+ *
+ * The forward entries are computed from the balance of the account
+ * before the solde entries (those with the closing rule): this makes
+ * the step restartable, as an account which has been already soldeed
+ * is not soldeed again, but still gets its forward entries.
+ *
  * Note: forward entries on settleable accounts are automatically set
  * as settled, being balanced with the corresponding solde entry
  */
@@ -1308,23 +1362,23 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 {
 	static const gchar *thisfn = "ofa_exercice_close_assistant_p6_do_solde_accounts";
 	ofaExerciceCloseAssistantPrivate *priv;
-	GList *accounts, *sld_entries, *for_entries, *it, *ite, *currencies;
+	GList *accounts, *sld_list, *all_entries, *it, *ite;
+	GHashTable *soldes;
 	myProgressBar *bar;
-	guint count, i;
+	guint count, i, ope_count, stlmt_count;
 	gchar *msg;
 	ofoAccount *account;
 	ofoOpeTemplate *sld_template, *for_template;
 	const gchar *sld_ope, *for_ope, *acc_number, *acc_cur;
 	const GDate *end_cur, *begin_next;
-	gboolean is_ran;
-	ofsOpe *ope;
-	ofsOpeDetail *detail;
 	gint errors;
-	ofxCounter counter, solde_ope;
+	ofxCounter ope_number, stlmt_number;
 	ofoEntry *entry;
 	ofoCurrency *cur_obj;
-	ofsCurrency *scur;
-	ofxAmount amount;
+	sAccountSolde *solde;
+	sSoldeOpe *sope;
+	ofsCurrency scur;
+	gboolean ok, inserted, published;
 
 	g_debug( "%s: self=%p", thisfn, ( void * ) self );
 
@@ -1342,6 +1396,9 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 	}
 
 	priv->p6_forwards = NULL;
+	sld_list = NULL;
+	ope_count = 0;
+	stlmt_count = 0;
 
 	end_cur = ofo_dossier_get_exe_end( priv->dossier );
 	begin_next = my_date_editable_get_date( GTK_EDITABLE( priv->p1_begin_next ), NULL );
@@ -1354,6 +1411,9 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 	for_template = ofo_ope_template_get_by_mnemo( priv->getter, for_ope );
 	g_return_val_if_fail( for_template && OFO_IS_OPE_TEMPLATE( for_template ), 1 );
 
+	soldes = p6_get_account_soldes( self );
+
+	/* first prepare all the operations, without writing anything */
 	for( it=accounts ; it ; it=it->next ){
 		account = OFO_ACCOUNT( it->data );
 		g_return_val_if_fail( account && OFO_IS_ACCOUNT( account ), errors );
@@ -1363,92 +1423,71 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 		cur_obj = ofo_currency_get_by_code( priv->getter, acc_cur );
 		g_return_val_if_fail( cur_obj && OFO_IS_CURRENCY( cur_obj ), errors );
 
-		/* check that rough soldes are zero */
-		amount = ofo_account_get_current_rough_debit( account );
-		if( !ofa_amount_is_zero( amount, cur_obj )){
-			g_warning( "%s: account=%s current_rough_debit=%lf (should be zero)",
-					thisfn, acc_number, amount );
-		}
-		amount = ofo_account_get_current_rough_credit( account );
-		if( !ofa_amount_is_zero( amount, cur_obj )){
-			g_warning( "%s: account=%s current_rough_credit=%lf (should be zero)",
-					thisfn, acc_number, amount );
-		}
-
-		/* setup ofsCurrency */
-		scur = g_new0( ofsCurrency, 1 );
-		scur->currency = cur_obj;
-		scur->debit = ofo_account_get_current_val_debit( account );
-		scur->credit = ofo_account_get_current_val_credit( account );
+		solde = ( sAccountSolde * ) g_hash_table_lookup( soldes, acc_number );
 
-		if( !ofs_currency_is_balanced( scur )){
+		if( solde ){
+			/* check that rough soldes are zero */
+			if( !ofa_amount_is_zero( solde->rough_debit, cur_obj )){
+				g_warning( "%s: account=%s current_rough_debit=%lf (should be zero)",
+						thisfn, acc_number, solde->rough_debit );
+			}
+			if( !ofa_amount_is_zero( solde->rough_credit, cur_obj )){
+				g_warning( "%s: account=%s current_rough_credit=%lf (should be zero)",
+						thisfn, acc_number, solde->rough_credit );
+			}
 
-			sld_entries = NULL;
-			for_entries = NULL;
-			counter = 0;
-			solde_ope = 0;
+			sope = g_new0( sSoldeOpe, 1 );
+			sope->account = account;
+			sope->is_ran = ofo_account_is_forwardable( account );
+			sope->stlmt_number = solde->close_stlmt;
+			scur.currency = cur_obj;
 
 			/* create solde operation
 			 * and generate corresponding solde entries */
-			ope = ofs_ope_new( sld_template );
-			my_date_set_from_date( &ope->deffect, end_cur );
-			ope->deffect_user_set = TRUE;
-			detail = ( ofsOpeDetail * ) ope->detail->data;
-			detail->account = g_strdup( acc_number );
-			detail->account_user_set = TRUE;
-			if( scur->debit > scur->credit ){
-				detail->credit = scur->debit - scur->credit;
-				detail->credit_user_set = TRUE;
-			} else {
-				detail->debit = scur->credit - scur->debit;
-				detail->debit_user_set = TRUE;
+			scur.debit = solde->bal_debit;
+			scur.credit = solde->bal_credit;
+			if( !ofs_currency_is_balanced( &scur )){
+				sope->sld_entries = p6_generate_entries(
+						sld_template, acc_number, end_cur, scur.credit, scur.debit, &errors );
+				if( sope->sld_entries ){
+					ope_count += 1;
+					if( sope->is_ran && ofo_account_is_settleable( account )){
+						stlmt_count += 1;
+					}
+				}
 			}
 
-			ofs_ope_apply_template( ope );
-			//ofs_ope_dump( ope );
-
-			if( ofs_ope_is_valid( ope, &msg, &currencies )){
-				sld_entries = ofs_ope_generate_entries( ope );
-				solde_ope = ofo_counters_get_next_ope_id( priv->getter );
-
-			} else {
-				g_warning( "%s: %s", thisfn, msg );
-				g_free( msg );
-				ofs_currency_list_dump( currencies );
-				errors += 1;
-				continue;
+			/* create forward operation
+			 * and generate corresponding entries
+			 * from the balance before the solde entries */
+			scur.debit = solde->bal_debit - solde->close_debit;
+			scur.credit = solde->bal_credit - solde->close_credit;
+			if( sope->is_ran && !ofs_currency_is_balanced( &scur )){
+				sope->for_entries = p6_generate_entries(
+						for_template, acc_number, begin_next, scur.debit, scur.credit, NULL );
 			}
 
-			ofs_currency_list_free( &currencies );
-			ofs_ope_free( ope );
+			sld_list = g_list_prepend( sld_list, sope );
+		}
 
-			/* create forward operation
-			 * and generate corresponding entries */
-			is_ran = ofo_account_is_forwardable( account );
-			if( is_ran ){
-				ope = ofs_ope_new( for_template );
-				my_date_set_from_date( &ope->deffect, begin_next );
-				ope->deffect_user_set = TRUE;
-				detail = ( ofsOpeDetail * ) ope->detail->data;
-				detail->account = g_strdup( acc_number );
-				detail->account_user_set = TRUE;
-				if( scur->debit > scur->credit ){
-					detail->debit = scur->debit - scur->credit;
-					detail->debit_user_set = TRUE;
-				} else {
-					detail->credit = scur->credit - scur->debit;
-					detail->credit_user_set = TRUE;
-				}
+		if( with_ui ){
+			update_bar( bar, &i, count, thisfn );
+		}
+	}
 
-				ofs_ope_apply_template( ope );
+	sld_list = g_list_reverse( sld_list );
+	all_entries = NULL;
+	inserted = FALSE;
+	published = FALSE;
+	ok = ( errors == 0 );
 
-				if( ofs_ope_is_valid( ope, NULL, NULL )){
-					for_entries = ofs_ope_generate_entries( ope );
-					priv->p6_forwards = g_list_prepend( priv->p6_forwards, for_entries );
-				}
+	/* then write all the solde entries in one transaction */
+	if( ok && ope_count > 0 ){
+		ok = ofa_idbconnect_transaction_start( priv->connect, FALSE, NULL );
 
-				ofs_ope_free( ope );
-			}
+		if( ok ){
+			ope_number = ofo_counters_reserve_ope_ids( priv->getter, ope_count );
+			stlmt_number = stlmt_count ? ofo_counters_reserve_settlement_ids( priv->getter, stlmt_count ) : 0;
 
 			/* all entries have been prepared
 			 *
@@ -1457,39 +1496,94 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 			 *    + take care of setting the same counter on the solde
 			 *    and the forward entries to have an audit track
 			 *
-			 * -> set a reconciliation date on the solde entries which
-			 *    are to be written on a reconciliable account, so that
-			 *    they will not be reported on the next exercice
-			 *
 			 * -> set closing rule indicator
 			 */
-			for( ite=sld_entries ; ite ; ite=ite->next ){
-				entry = OFO_ENTRY( ite->data );
-				ofo_entry_set_ope_number( entry, solde_ope );
-				ofo_entry_set_rule( entry, ENT_RULE_CLOSE );
-				ofo_entry_insert( entry );
-				if( is_ran &&
-						ofo_account_is_settleable( account ) &&
-						!g_utf8_collate( ofo_entry_get_account( entry ), acc_number )){
-					counter = ofo_counters_get_next_settlement_id( priv->getter );
-					ofo_entry_update_settlement( entry, counter );
-					p6_set_forward_settlement_number( for_entries, acc_number, counter );
+			for( it=sld_list ; it ; it=it->next ){
+				sope = ( sSoldeOpe * ) it->data;
+				if( !sope->sld_entries ){
+					continue;
 				}
-				if( ofo_account_is_reconciliable( account ) &&
-						!g_utf8_collate( ofo_entry_get_account( entry ), acc_number )){
-					ofa_iconcil_new_concil( OFA_ICONCIL( entry ), end_cur );
+				acc_number = ofo_account_get_number( sope->account );
+				sope->stlmt_number = 0;
+				for( ite=sope->sld_entries ; ite ; ite=ite->next ){
+					entry = OFO_ENTRY( ite->data );
+					ofo_entry_set_ope_number( entry, ope_number );
+					ofo_entry_set_rule( entry, ENT_RULE_CLOSE );
+					if( sope->is_ran &&
+							ofo_account_is_settleable( sope->account ) &&
+							!g_utf8_collate( ofo_entry_get_account( entry ), acc_number ) &&
+							sope->stlmt_number == 0 ){
+						sope->stlmt_number = stlmt_number++;
+						ofo_entry_set_settlement_number( entry, sope->stlmt_number );
+					}
 				}
+				ope_number += 1;
+				all_entries = g_list_concat( all_entries, g_list_copy( sope->sld_entries ));
 			}
-			g_list_free( sld_entries );
+
+			ok = ofo_entry_insert_list( priv->getter, all_entries );
+			inserted = ok;
 		}
 
-		g_free( scur );
+		/* -> set a reconciliation date on the solde entries which
+		 *    are to be written on a reconciliable account, so that
+		 *    they will not be reported on the next exercice */
+		for( it=sld_list ; it && ok ; it=it->next ){
+			sope = ( sSoldeOpe * ) it->data;
+			if( sope->sld_entries && ofo_account_is_reconciliable( sope->account )){
+				acc_number = ofo_account_get_number( sope->account );
+				for( ite=sope->sld_entries ; ite && ok ; ite=ite->next ){
+					entry = OFO_ENTRY( ite->data );
+					if( !g_utf8_collate( ofo_entry_get_account( entry ), acc_number )){
+						ok = ( ofa_iconcil_new_concil( OFA_ICONCIL( entry ), end_cur ) != NULL );
+					}
+				}
+			}
+		}
 
-		if( with_ui ){
-			update_bar( bar, &i, count, thisfn );
+		if( ok ){
+			ok = ofa_idbconnect_transaction_commit( priv->connect, FALSE, NULL );
+		}
+
+		/* the solde entries are only published once committed */
+		if( ok ){
+			ofo_entry_insert_list_notify( priv->getter, all_entries );
+			published = TRUE;
+
+		} else {
+			ofa_idbconnect_transaction_cancel( priv->connect, FALSE, NULL );
+			if( inserted ){
+				p6_reload_concils( self );
+			}
+			errors += 1;
+		}
+	}
+
+	/* keep the forward entries for the new exercice */
+	for( it=sld_list ; it ; it=it->next ){
+		sope = ( sSoldeOpe * ) it->data;
+		if( sope->for_entries ){
+			if( ok ){
+				if( sope->stlmt_number > 0 && ofo_account_is_settleable( sope->account )){
+					p6_set_forward_settlement_number(
+							sope->for_entries, ofo_account_get_number( sope->account ), sope->stlmt_number );
+				}
+				priv->p6_forwards = g_list_prepend( priv->p6_forwards, sope->for_entries );
+			} else {
+				g_list_free_full( sope->for_entries, ( GDestroyNotify ) g_object_unref );
+			}
+		}
+		/* published entries are owned by the collection */
+		if( published ){
+			g_list_free( sope->sld_entries );
+		} else {
+			g_list_free_full( sope->sld_entries, ( GDestroyNotify ) g_object_unref );
 		}
 	}
 
+	g_list_free( all_entries );
+	g_list_free_full( sld_list, ( GDestroyNotify ) g_free );
+	g_hash_table_destroy( soldes );
 	ofo_account_free_dataset( accounts );
 
 	if( with_ui ){
@@ -1508,6 +1602,132 @@ p6_do_solde_accounts( ofaExerciceCloseAssistant *self, gboolean with_ui )
 	return( errors );
 }
 
+/*
+ * Read the balances of all the accounts from the entries of the
+ * current exercice, with only one aggregate query.
+ *
+ * Returns: a hash table account number -> sAccountSolde, which should
+ * be g_hash_table_destroy() by the caller.
+ */
+static GHashTable *
+p6_get_account_soldes( ofaExerciceCloseAssistant *self )
+{
+	ofaExerciceCloseAssistantPrivate *priv;
+	GHashTable *soldes;
+	GSList *result, *irow, *icol;
+	sAccountSolde *solde;
+	gchar *query;
+	const gchar *rough, *validated, *closing;
+
+	priv = ofa_exercice_close_assistant_get_instance_private( self );
+
+	soldes = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
+
+	rough = ofo_entry_status_get_dbms( ENT_STATUS_ROUGH );
+	validated = ofo_entry_status_get_dbms( ENT_STATUS_VALIDATED );
+	closing = ofo_entry_rule_get_dbms( ENT_RULE_CLOSE );
+
+	/* solde entries are inserted with a rough status: they must be
+	 * considered as part of the balance if the step is restarted */
+	query = g_strdup_printf( "SELECT ENT_ACCOUNT,"
+			"	SUM(CASE WHEN ENT_STATUS='%s' AND ENT_RULE!='%s' THEN ENT_DEBIT ELSE 0 END),"
+			"	SUM(CASE WHEN ENT_STATUS='%s' AND ENT_RULE!='%s' THEN ENT_CREDIT ELSE 0 END),"
+			"	SUM(CASE WHEN ENT_STATUS='%s' OR ENT_RULE='%s' THEN ENT_DEBIT ELSE 0 END),"
+			"	SUM(CASE WHEN ENT_STATUS='%s' OR ENT_RULE='%s' THEN ENT_CREDIT ELSE 0 END),"
+			"	SUM(CASE WHEN ENT_RULE='%s' THEN ENT_DEBIT ELSE 0 END),"
+			"	SUM(CASE WHEN ENT_RULE='%s' THEN ENT_CREDIT ELSE 0 END),"
+			"	MAX(CASE WHEN ENT_RULE='%s' THEN ENT_STLMT_NUMBER ELSE NULL END) "
+			"	FROM OFA_T_ENTRIES "
+			"	WHERE ENT_IPERIOD='%s' AND ENT_STATUS IN ('%s','%s') "
+			"	GROUP BY ENT_ACCOUNT",
+			rough, closing, rough, closing,
+			validated, closing, validated, closing,
+			closing, closing, closing,
+			ofo_entry_period_get_dbms( ENT_PERIOD_CURRENT ), rough, validated );
+
+	if( ofa_idbconnect_query_ex( priv->connect, query, &result, TRUE )){
+		for( irow=result ; irow ; irow=irow->next ){
+			icol = ( GSList * ) irow->data;
+			solde = g_new0( sAccountSolde, 1 );
+			g_hash_table_insert( soldes, g_strdup(( const gchar * ) icol->data ), solde );
+			icol = icol->next;
+			solde->rough_debit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->rough_credit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->bal_debit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->bal_credit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->close_debit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->close_credit = my_double_set_from_sql(( const gchar * ) icol->data );
+			icol = icol->next;
+			solde->close_stlmt = icol->data ? atol(( const gchar * ) icol->data ) : 0;
+		}
+		ofa_idbconnect_free_results( result );
+	}
+
+	g_free( query );
+
+	return( soldes );
+}
+
+/*
+ * Generate the entries of an operation which writes the @debit and
+ * @credit amounts on the @account, the counterpart being provided by
+ * the @template.
+ *
+ * Only the greatest of @debit and @credit is written, minored by the
+ * other one.
+ *
+ * Returns: the list of generated entries, or %NULL.
+ */
+static GList *
+p6_generate_entries( ofoOpeTemplate *template, const gchar *account, const GDate *deffect, ofxAmount debit, ofxAmount credit, gint *errors )
+{
+	static const gchar *thisfn = "ofa_exercice_close_assistant_p6_generate_entries";
+	ofsOpe *ope;
+	ofsOpeDetail *detail;
+	GList *entries, *currencies;
+	gchar *msg;
+
+	entries = NULL;
+	msg = NULL;
+	currencies = NULL;
+
+	ope = ofs_ope_new( template );
+	my_date_set_from_date( &ope->deffect, deffect );
+	ope->deffect_user_set = TRUE;
+	detail = ( ofsOpeDetail * ) ope->detail->data;
+	detail->account = g_strdup( account );
+	detail->account_user_set = TRUE;
+	if( debit > credit ){
+		detail->debit = debit - credit;
+		detail->debit_user_set = TRUE;
+	} else {
+		detail->credit = credit - debit;
+		detail->credit_user_set = TRUE;
+	}
+
+	ofs_ope_apply_template( ope );
+
+	if( ofs_ope_is_valid( ope, errors ? &msg : NULL, errors ? &currencies : NULL )){
+		entries = ofs_ope_generate_entries( ope );
+
+	} else if( errors ){
+		g_warning( "%s: %s", thisfn, msg );
+		ofs_currency_list_dump( currencies );
+		*errors += 1;
+	}
+
+	g_free( msg );
+	ofs_currency_list_free( &currencies );
+	ofs_ope_free( ope );
+
+	return( entries );
+}
+
 /*
  * set the specified settlement number on the forward entry for the
  * specified account - as there should only be one entry per account,
@@ -1859,6 +2079,10 @@ p6_cleanup( ofaExerciceCloseAssistant *self )
 		g_free( query );
 	}
 
+	if( ok ){
+		ok = ofo_entry_ledger_months_remove( priv->connect,
+					"ENT_NUMBER NOT IN (SELECT ENT_NUMBER FROM ARCHIVE_T_KEEP_ENTRIES)" );
+	}
 	if( ok ){
 		query = g_strdup( "DELETE FROM OFA_T_ENTRIES "
 					"WHERE ENT_NUMBER NOT IN (SELECT ENT_NUMBER FROM ARCHIVE_T_KEEP_ENTRIES)" );
@@ -2035,6 +2259,8 @@ p6_cleanup( ofaExerciceCloseAssistant *self )
  * + entries on reconciliable accounts are set reconciliated
  *   on the first day of the exercice (which is also the operation date
  *   and the effect date)
+ *
+ * All the entries are inserted inside of a single transaction.
  */
 static gboolean
 p6_insert_forward( ofaExerciceCloseAssistant *self )
@@ -2044,11 +2270,12 @@ p6_insert_forward( ofaExerciceCloseAssistant *self )
 	ofaISignaler *signaler;
 	myProgressBar *bar;
 	guint count, i;
-	GList *itf, *for_entries, *ite;
+	GList *itf, *ite, *entries;
 	ofoEntry *entry;
 	ofoAccount *account;
 	ofxCounter number;
 	const GDate *dbegin;
+	gboolean ok, inserted;
 
 	priv = ofa_exercice_close_assistant_get_instance_private( self );
 
@@ -2057,51 +2284,108 @@ p6_insert_forward( ofaExerciceCloseAssistant *self )
 
 	bar = get_new_bar( self, "p6-forward" );
 	gtk_widget_show_all( priv->p6_page );
-	/* each forward operation carried out two entries */
-	count = 2*g_list_length( priv->p6_forwards );
-	i = 0;
 
+	entries = NULL;
 	for( itf=priv->p6_forwards ; itf ; itf=itf->next ){
-		for_entries = ( GList * ) itf->data;
-		for( ite=for_entries ; ite ; ite=ite->next ){
-			entry = OFO_ENTRY( ite->data );
+		entries = g_list_concat( entries, g_list_copy(( GList * ) itf->data ));
+	}
+	count = g_list_length( entries );
+	i = 0;
+	ok = TRUE;
+	inserted = FALSE;
+
+	if( count > 0 ){
+		ok = ofa_idbconnect_transaction_start( priv->connect, FALSE, NULL );
 
+		if( ok ){
 			/* only update the ope number here so that it will increment in the new exercice */
-			number = ofo_counters_get_next_ope_id( priv->getter );
-			ofo_entry_set_ope_number( entry, number );
+			number = ofo_counters_reserve_ope_ids( priv->getter, count );
 
-			/* set forward rule */
-			ofo_entry_set_rule( entry, ENT_RULE_FORWARD );
-			ofo_entry_insert( entry );
+			for( ite=entries ; ite ; ite=ite->next ){
+				entry = OFO_ENTRY( ite->data );
+				ofo_entry_set_ope_number( entry, number++ );
 
-			/* update settlement number if any */
-			number = ofo_entry_get_settlement_number( entry );
-			if( number ){
-				ofo_entry_update_settlement( entry, number );
+				/* set forward rule */
+				ofo_entry_set_rule( entry, ENT_RULE_FORWARD );
 			}
 
-			/* set reconciliation on reconciliable account */
+			/* the settlement number, if any, is inserted with the entry */
+			ok = ofo_entry_insert_list( priv->getter, entries );
+			inserted = ok;
+		}
+
+		/* set reconciliation on reconciliable account */
+		for( ite=entries ; ite && ok ; ite=ite->next ){
+			entry = OFO_ENTRY( ite->data );
 			account = ofo_account_get_by_number( priv->getter, ofo_entry_get_account( entry ));
-			g_return_val_if_fail( account && OFO_IS_ACCOUNT( account ), FALSE );
-			if( ofo_account_is_reconciliable( account )){
-				ofa_iconcil_new_concil( OFA_ICONCIL( entry ), dbegin );
+			if( !account ){
+				g_warning( "%s: account %s not found", thisfn, ofo_entry_get_account( entry ));
+				ok = FALSE;
+			} else if( ofo_account_is_reconciliable( account )){
+				ok = ( ofa_iconcil_new_concil( OFA_ICONCIL( entry ), dbegin ) != NULL );
 			}
+		}
 
-			g_signal_emit_by_name( signaler, SIGNALER_PERIOD_STATUS_CHANGE, entry, -1, ENT_STATUS_ROUGH, -1, ENT_STATUS_VALIDATED );
+		if( ok ){
+			ok = ofa_idbconnect_transaction_commit( priv->connect, FALSE, NULL );
+		}
+		if( !ok ){
+			ofa_idbconnect_transaction_cancel( priv->connect, FALSE, NULL );
+			if( inserted ){
+				p6_reload_concils( self );
+			}
+		}
+	}
 
+	/* the forward entries are only published once committed, the
+	 * collection then taking their ownership: keep a reference while
+	 * sending the status change messages */
+	if( ok ){
+		g_list_foreach( entries, ( GFunc ) g_object_ref, NULL );
+		ofo_entry_insert_list_notify( priv->getter, entries );
+		for( ite=entries ; ite ; ite=ite->next ){
+			entry = OFO_ENTRY( ite->data );
+			g_signal_emit_by_name( signaler, SIGNALER_PERIOD_STATUS_CHANGE, entry, -1, ENT_STATUS_ROUGH, -1, ENT_STATUS_VALIDATED );
 			update_bar( bar, &i, count, thisfn );
 		}
 	}
 
+	g_list_free_full( entries, ( GDestroyNotify ) g_object_unref );
+
 	g_list_free_full( priv->p6_forwards, ( GDestroyNotify ) g_list_free );
+	priv->p6_forwards = NULL;
 
 	gtk_widget_show_all( GTK_WIDGET( bar ));
-	g_idle_add(( GSourceFunc ) p6_close_ran_ledger, self );
+
+	if( ok ){
+		g_idle_add(( GSourceFunc ) p6_close_ran_ledger, self );
+
+	} else {
+		my_utils_msg_dialog( GTK_WINDOW( self ), GTK_MESSAGE_WARNING,
+				_( "Unable to insert the carried forward entries" ));
+		my_iassistant_set_current_page_type( MY_IASSISTANT( self ), GTK_ASSISTANT_PAGE_SUMMARY );
+		my_iassistant_set_current_page_complete( MY_IASSISTANT( self ), TRUE );
+	}
 
 	/* do not continue and remove from idle callbacks list */
 	return( G_SOURCE_REMOVE );
 }
 
+/*
+ * The conciliation groups created inside of a cancelled transaction
+ * have already been added to their collection: reload it from the DBMS.
+ */
+static void
+p6_reload_concils( ofaExerciceCloseAssistant *self )
+{
+	ofaExerciceCloseAssistantPrivate *priv;
+
+	priv = ofa_exercice_close_assistant_get_instance_private( self );
+
+	my_icollector_collection_free( ofa_igetter_get_collector( priv->getter ), OFO_TYPE_CONCIL );
+	g_signal_emit_by_name( ofa_igetter_get_signaler( priv->getter ), SIGNALER_COLLECTION_RELOAD, OFO_TYPE_CONCIL );
+}
+
 /*
  * close the opening ledger
  *
@@ -2198,40 +2482,32 @@ p6_future_to_current( ofaExerciceCloseAssistant *self )
 {
 	static const gchar *thisfn = "ofa_exercice_close_assistant_p6_future";
 	ofaExerciceCloseAssistantPrivate *priv;
-	ofaISignaler *signaler;
 	myProgressBar *bar;
-	guint count, i;
-	GList *entries, *it;
-	ofoEntry *entry;
-	const GDate *dos_dend, *ent_deffect;
+	guint i;
+	gboolean ok;
 
 	g_debug( "%s: self=%p", thisfn, ( void * ) self );
 
 	priv = ofa_exercice_close_assistant_get_instance_private( self );
 
-	signaler = ofa_igetter_get_signaler( priv->getter );
-	dos_dend = ofo_dossier_get_exe_end( priv->dossier );
-	entries = ofo_entry_get_dataset_for_exercice_by_status( priv->getter, -1 );
-	count = g_list_length( entries );
-	i = 0;
 	bar = get_new_bar( self, "p6-future" );
 	gtk_widget_show_all( priv->p6_page );
+	i = 0;
 
-	for( it=entries ; it ; it=it->next ){
-		entry = OFO_ENTRY( it->data );
-		ent_deffect = ofo_entry_get_deffect( entry );
-		g_return_val_if_fail( my_date_compare( ent_deffect, dos_dend ) <= 0, G_SOURCE_REMOVE );
-		g_signal_emit_by_name( signaler, SIGNALER_EXERCICE_RECOMPUTE, entry );
-		update_bar( bar, &i, count, thisfn );
-	}
-	if( count == 0 ){
-		g_signal_emit_by_name( bar, "my-text", "0/0" );
-	}
-
-	ofo_entry_free_dataset( entries );
+	ok = ofo_entry_future_to_current( priv->getter );
+	update_bar( bar, &i, 1, thisfn );
 
 	gtk_widget_show_all( GTK_WIDGET( bar ));
-	g_idle_add(( GSourceFunc ) p6_plugin_opening, self );
+
+	if( ok ){
+		g_idle_add(( GSourceFunc ) p6_plugin_opening, self );
+
+	} else {
+		my_utils_msg_dialog( GTK_WINDOW( self ), GTK_MESSAGE_WARNING,
+				_( "Unable to move the future entries to the current exercice" ));
+		my_iassistant_set_current_page_type( MY_IASSISTANT( self ), GTK_ASSISTANT_PAGE_SUMMARY );
+		my_iassistant_set_current_page_complete( MY_IASSISTANT( self ), TRUE );
+	}
 
 	/* do not continue and remove from idle callbacks list */
 	return( G_SOURCE_REMOVE );
@@ -108,6 +108,11 @@ typedef struct {
 	ofoLedger         *ledger_object;
 	GList             *ledger_totals;		/* totals per currency for the ledger */
 
+	/* for each line
+	 */
+	const gchar       *line_currency_code;	/* the last seen (interned) code */
+	ofoCurrency       *line_currency;
+
 	/* total general
 	 */
 	GList             *report_totals;		/* all totals per currency */
@@ -142,7 +147,8 @@ static GtkWidget         *render_page_v_get_args_widget( ofaRenderPage *page );
 static const gchar       *render_page_v_get_paper_name( ofaRenderPage *page );
 static GtkPageOrientation render_page_v_get_page_orientation( ofaRenderPage *page );
 static void               render_page_v_get_print_settings( ofaRenderPage *page, GKeyFile **keyfile, gchar **group_name );
-static GList             *render_page_v_get_dataset( ofaRenderPage *page );
+static void               render_page_v_get_dataset_async( ofaRenderPage *page, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data );
+static GList             *render_page_v_get_dataset_finish( ofaRenderPage *page, GAsyncResult *result, GError **error );
 static void               render_page_v_free_dataset( ofaRenderPage *page, GList *dataset );
 static void               on_args_changed( ofaLedgerBookArgs *bin, ofaLedgerBookRender *page );
 static void               irenderable_iface_init( ofaIRenderableInterface *iface );
@@ -246,7 +252,8 @@ ofa_ledger_book_render_class_init( ofaLedgerBookRenderClass *klass )
 	OFA_RENDER_PAGE_CLASS( klass )->get_paper_name = render_page_v_get_paper_name;
 	OFA_RENDER_PAGE_CLASS( klass )->get_page_orientation = render_page_v_get_page_orientation;
 	OFA_RENDER_PAGE_CLASS( klass )->get_print_settings = render_page_v_get_print_settings;
-	OFA_RENDER_PAGE_CLASS( klass )->get_dataset = render_page_v_get_dataset;
+	OFA_RENDER_PAGE_CLASS( klass )->get_dataset_async = render_page_v_get_dataset_async;
+	OFA_RENDER_PAGE_CLASS( klass )->get_dataset_finish = render_page_v_get_dataset_finish;
 	OFA_RENDER_PAGE_CLASS( klass )->free_dataset = render_page_v_free_dataset;
 }
 
@@ -313,15 +320,14 @@ render_page_v_get_print_settings( ofaRenderPage *page, GKeyFile **keyfile, gchar
 	*group_name = g_strdup_printf( "%s-print", priv->settings_prefix );
 }
 
-static GList *
-render_page_v_get_dataset( ofaRenderPage *page )
+static void
+render_page_v_get_dataset_async( ofaRenderPage *page, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data )
 {
 	ofaLedgerBookRenderPrivate *priv;
 	ofaLedgerTreeview *tview;
 	GSList *mnemos;
 	GList *list, *it;
 	ofoLedger *ledger;
-	GList *dataset;
 	ofaIDateFilter *date_filter;
 
 	priv = ofa_ledger_book_render_get_instance_private( OFA_LEDGER_BOOK_RENDER( page ));
@@ -336,7 +342,7 @@ render_page_v_get_dataset( ofaRenderPage *page )
 		priv->selected = NULL;
 		for( it=list ; it ; it=it->next ){
 			ledger = ( ofoLedger * ) it->data;
-			g_return_val_if_fail( ledger && OFO_IS_LEDGER( ledger ), FALSE );
+			g_return_if_fail( ledger && OFO_IS_LEDGER( ledger ));
 			priv->selected = g_list_append( priv->selected, ledger );
 		}
 		ofa_ledger_treeview_free_selected( list );
@@ -349,18 +355,30 @@ render_page_v_get_dataset( ofaRenderPage *page )
 	my_date_set_from_date( &priv->from_date, ofa_idate_filter_get_date( date_filter, IDATE_FILTER_FROM ));
 	my_date_set_from_date( &priv->to_date, ofa_idate_filter_get_date( date_filter, IDATE_FILTER_TO ));
 
-	dataset = ofo_entry_get_dataset_for_print_by_ledger(
-						priv->getter, mnemos,
-						my_date_is_valid( &priv->from_date ) ? &priv->from_date : NULL,
-						my_date_is_valid( &priv->to_date ) ? &priv->to_date : NULL );
-
-	priv->count = g_list_length( dataset );
-	g_slist_free_full( mnemos, ( GDestroyNotify ) g_free );
-
 	priv->new_page = ofa_ledger_book_args_get_new_page_per_ledger( priv->args_bin );
 	priv->with_summary = ofa_ledger_book_args_get_with_summary( priv->args_bin );
 	priv->only_summary = ofa_ledger_book_args_get_only_summary( priv->args_bin );
 
+	ofo_entry_get_dataset_for_print_by_ledger_async(
+			priv->getter, mnemos,
+			my_date_is_valid( &priv->from_date ) ? &priv->from_date : NULL,
+			my_date_is_valid( &priv->to_date ) ? &priv->to_date : NULL,
+			cancellable, callback, user_data );
+
+	g_slist_free_full( mnemos, ( GDestroyNotify ) g_free );
+}
+
+static GList *
+render_page_v_get_dataset_finish( ofaRenderPage *page, GAsyncResult *result, GError **error )
+{
+	ofaLedgerBookRenderPrivate *priv;
+	GList *dataset;
+
+	priv = ofa_ledger_book_render_get_instance_private( OFA_LEDGER_BOOK_RENDER( page ));
+
+	dataset = ofo_entry_get_dataset_for_print_finish( result, error );
+	priv->count = g_list_length( dataset );
+
 	return( dataset );
 }
 
@@ -735,9 +753,15 @@ irenderable_draw_line( ofaIRenderable *instance )
 		debit = ofo_entry_get_debit( entry );
 		credit = ofo_entry_get_credit( entry );
 
-		/* get currency properties */
+		/* get currency properties
+		 * the entry currency codes are interned strings, so that the
+		 * lookup is only done when the currency changes */
 		code = ofo_entry_get_currency( entry );
-		currency = ofo_currency_get_by_code( priv->getter, code );
+		if( code != priv->line_currency_code ){
+			priv->line_currency = ofo_currency_get_by_code( priv->getter, code );
+			priv->line_currency_code = code;
+		}
+		currency = priv->line_currency;
 		g_return_if_fail( currency && OFO_IS_CURRENCY( currency ));
 
 		if( !priv->only_summary ){
@@ -814,8 +838,8 @@ irenderable_draw_line( ofaIRenderable *instance )
 					priv->body_currency_rtab, y, code, PANGO_ALIGN_RIGHT );
 		}
 
-		ofs_currency_add_by_code(
-				&priv->ledger_totals, priv->getter, code, debit, credit );
+		ofs_currency_add_by_object(
+				&priv->ledger_totals, currency, debit, credit );
 	}
 }
 
@@ -1056,6 +1080,9 @@ irenderable_clear_runtime_data( ofaIRenderable *instance )
 	ofs_currency_list_free( &priv->report_totals );
 	free_ledgers( &priv->ledgers_summary );
 
+	priv->line_currency_code = NULL;
+	priv->line_currency = NULL;
+
 	clear_ledger_data( OFA_LEDGER_BOOK_RENDER( instance ));
 }
 
@@ -35,8 +35,10 @@
 #include "my/my-dnd-book.h"
 #include "my/my-dnd-window.h"
 
+#include "my/my-iprogress.h"
 #include "my/my-iscope-map.h"
 #include "my/my-iwindow.h"
+#include "my/my-progress-bar.h"
 #include "my/my-scope-mapper.h"
 #include "my/my-style.h"
 #include "my/my-tab.h"
@@ -136,6 +138,10 @@ typedef struct {
 	/* ofaIPageManager interface
 	 */
 	GList           *themes;			/* registered themes */
+
+	/* myIProgress interface: collections preloading
+	 */
+	myProgressBar   *preload_bar;
 }
 	ofaMainWindowPrivate;
 
@@ -348,10 +354,15 @@ static void         ipage_manager_define( ofaIPageManager *instance, GType type,
 static ofaPage     *ipage_manager_activate( ofaIPageManager *instance, GType type );
 static sThemeDef   *theme_get_by_type( GList **list, GType type, gboolean create );
 static void         theme_free( sThemeDef *def );
+static void         iprogress_iface_init( myIProgressInterface *iface );
+static void         iprogress_start_work( myIProgress *instance, const void *worker, GtkWidget *widget );
+static void         iprogress_pulse( myIProgress *instance, const void *worker, gulong count, gulong total );
+static void         iprogress_set_ok( myIProgress *instance, const void *worker, GtkWidget *widget, gulong errs_count );
 
 G_DEFINE_TYPE_EXTENDED( ofaMainWindow, ofa_main_window, GTK_TYPE_APPLICATION_WINDOW, 0,
 		G_ADD_PRIVATE( ofaMainWindow )
-		G_IMPLEMENT_INTERFACE( OFA_TYPE_IPAGE_MANAGER, ipage_manager_iface_init ))
+		G_IMPLEMENT_INTERFACE( OFA_TYPE_IPAGE_MANAGER, ipage_manager_iface_init )
+		G_IMPLEMENT_INTERFACE( MY_TYPE_IPROGRESS, iprogress_iface_init ))
 
 static void
 main_window_finalize( GObject *instance )
@@ -1006,6 +1017,11 @@ ofa_main_window_dossier_apply_actions( ofaMainWindow *main_window )
 	group = ofa_idbdossier_meta_get_settings_group( dossier_meta );
 	prefs = ofa_open_prefs_new( settings, group, OPEN_PREFS_DOSSIER_KEY );
 
+	/* preload the collections in the background ? */
+	if( ofa_open_prefs_get_preload_collections( prefs )){
+		ofa_hub_preload_collections( hub, MY_IPROGRESS( main_window ));
+	}
+
 	/* display dossier notes ? */
 	if( ofa_open_prefs_get_display_notes( prefs )){
 
@@ -2366,3 +2382,74 @@ theme_free( sThemeDef *def )
 	g_free( def->label );
 	g_free( def );
 }
+
+/*
+ * myIProgress interface management
+ *
+ * The collections preloading is displayed as a progress bar at the
+ * bottom of the main window.
+ */
+static void
+iprogress_iface_init( myIProgressInterface *iface )
+{
+	static const gchar *thisfn = "ofa_main_window_iprogress_iface_init";
+
+	g_debug( "%s: iface=%p", thisfn, ( void * ) iface );
+
+	iface->start_work = iprogress_start_work;
+	iface->pulse = iprogress_pulse;
+	iface->set_ok = iprogress_set_ok;
+}
+
+/*
+ * @widget: ignored
+ */
+static void
+iprogress_start_work( myIProgress *instance, const void *worker, GtkWidget *widget )
+{
+	ofaMainWindowPrivate *priv;
+
+	priv = ofa_main_window_get_instance_private( OFA_MAIN_WINDOW( instance ));
+
+	if( !priv->dispose_has_run && !priv->preload_bar ){
+		priv->preload_bar = my_progress_bar_new();
+		my_utils_widget_set_margins( GTK_WIDGET( priv->preload_bar ), 2, 2, 4, 4 );
+		gtk_grid_attach( GTK_GRID( priv->grid ), GTK_WIDGET( priv->preload_bar ), 0, 2, 1, 1 );
+		g_object_add_weak_pointer( G_OBJECT( priv->preload_bar ), ( gpointer * ) &priv->preload_bar );
+		gtk_widget_show_all( GTK_WIDGET( priv->preload_bar ));
+	}
+}
+
+static void
+iprogress_pulse( myIProgress *instance, const void *worker, gulong count, gulong total )
+{
+	ofaMainWindowPrivate *priv;
+	gdouble progress;
+	gchar *str;
+
+	priv = ofa_main_window_get_instance_private( OFA_MAIN_WINDOW( instance ));
+
+	if( priv->preload_bar ){
+		progress = total ? ( gdouble ) count / ( gdouble ) total : 0;
+		g_signal_emit_by_name( priv->preload_bar, "my-double", progress );
+
+		str = g_strdup_printf( _( "Loading collections: %lu/%lu" ), count, total );
+		g_signal_emit_by_name( priv->preload_bar, "my-text", str );
+		g_free( str );
+	}
+}
+
+/*
+ * @widget: ignored
+ */
+static void
+iprogress_set_ok( myIProgress *instance, const void *worker, GtkWidget *widget, gulong errs_count )
+{
+	ofaMainWindowPrivate *priv;
+
+	priv = ofa_main_window_get_instance_private( OFA_MAIN_WINDOW( instance ));
+
+	if( priv->preload_bar ){
+		gtk_widget_destroy( GTK_WIDGET( priv->preload_bar ));
+	}
+}
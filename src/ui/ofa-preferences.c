@@ -39,6 +39,8 @@
 #include "my/my-utils.h"
 
 #include "api/ofa-extender-collection.h"
+#include "api/ofa-hub.h"
+#include "api/ofa-idbconnect.h"
 #include "api/ofa-igetter.h"
 #include "api/ofa-iproperties.h"
 #include "api/ofa-isignaler.h"
@@ -84,6 +86,7 @@ typedef struct {
 	GtkWidget                *p1_pin_detach_btn;
 	GSList                   *p1_close_group;
 	GtkWidget                *p1_display_all_btn;
+	GSList                   *p1_audit_group;
 	GtkWidget                *p1_quit_on_escape_btn;
 	GtkWidget                *p1_confirm_on_escape_btn;
 	GtkWidget                *p1_confirm_on_cancel_btn;
@@ -131,6 +134,7 @@ typedef struct {
 #define PREFERENCES_MAINBOOK_OPEN_MODE    "ofaPreferences-mainbook-open-mode"
 #define PREFERENCES_MAINBOOK_TABS_MODE    "ofaPreferences-mainbook-tabs-mode"
 #define PREFERENCES_MAINBOOK_CLOSE_MODE   "ofaPreferences-mainbook-close-mode"
+#define PREFERENCES_AUDIT_MODE            "ofaPreferences-audit-mode"
 
 static const gchar *st_resource_ui      = "/org/trychlos/openbook/ui/ofa-preferences.ui";
 
@@ -510,6 +514,18 @@ init_user_interface_page( ofaPreferences *self )
 	gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( button ), !bvalue );
 	on_display_all_toggled( GTK_TOGGLE_BUTTON( button ), self );
 
+	/* writing the audit trail */
+	mode = ofa_prefs_audit_get_mode( priv->getter );
+	radio_button_init( self,
+			PREFERENCES_AUDIT_MODE, mode,
+			"p1-audit-sync", OFA_IDBAUDIT_SYNC, NULL, &priv->p1_audit_group );
+	radio_button_init( self,
+			PREFERENCES_AUDIT_MODE, mode,
+			"p1-audit-commit", OFA_IDBAUDIT_COMMIT, NULL, NULL );
+	radio_button_init( self,
+			PREFERENCES_AUDIT_MODE, mode,
+			"p1-audit-async", OFA_IDBAUDIT_ASYNC, NULL, NULL );
+
 	/* quitting an assistant */
 	/* priv->confirm_on_escape_btn is set before acting on
 	 *  quit-on-escape button as triggered signal use the variable */
@@ -1152,6 +1168,9 @@ do_update_user_interface_page( ofaPreferences *self, gchar **msgerr )
 	ofeMainbookOpen open_mode;
 	ofeMainbookTabs tabs_mode;
 	ofeMainbookClose close_mode;
+	ofeIDBAuditMode audit_mode;
+	ofaHub *hub;
+	ofaIDBConnect *connect;
 	gboolean detach_pin, display_all, quit_on_escape, confirm_on_escape, confirm_on_cancel;
 	gboolean confirm_altf4, confirm_quit;
 
@@ -1170,6 +1189,15 @@ do_update_user_interface_page( ofaPreferences *self, gchar **msgerr )
 	display_all = gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( priv->p1_display_all_btn ));
 	ofa_prefs_check_integrity_set_user_settings( priv->getter, display_all );
 
+	/* the audit mode also applies to the currently opened dossier */
+	audit_mode = radio_button_group_get_value( self, PREFERENCES_AUDIT_MODE, priv->p1_audit_group );
+	ofa_prefs_audit_set_user_settings( priv->getter, audit_mode );
+	hub = ofa_igetter_get_hub( priv->getter );
+	connect = hub ? ofa_hub_get_connect( hub ) : NULL;
+	if( connect ){
+		ofa_idbconnect_set_audit_mode( connect, audit_mode );
+	}
+
 	quit_on_escape = gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( priv->p1_quit_on_escape_btn ));
 	confirm_on_escape = gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( priv->p1_confirm_on_escape_btn ));
 	confirm_on_cancel = gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( priv->p1_confirm_on_cancel_btn ));